@@ -1348,6 +1348,11 @@ static void gdextension_object_method_bind_ptrcall(GDExtensionMethodBindPtr p_me
 	mb->ptrcall(o, (const void **)p_args, p_ret);
 }
 
+static GDExtensionPtrMethodBindCall gdextension_object_method_bind_get_ptrcall(GDExtensionMethodBindPtr p_method_bind) {
+	const MethodBind *mb = reinterpret_cast<const MethodBind *>(p_method_bind);
+	return (GDExtensionPtrMethodBindCall)mb->get_ptrcall_func();
+}
+
 static void gdextension_object_destroy(GDExtensionObjectPtr p_o) {
 	memdelete((Object *)p_o);
 }
@@ -1826,6 +1831,7 @@ void gdextension_setup_interface() {
 	REGISTER_INTERFACE_FUNC(dictionary_set_typed);
 	REGISTER_INTERFACE_FUNC(object_method_bind_call);
 	REGISTER_INTERFACE_FUNC(object_method_bind_ptrcall);
+	REGISTER_INTERFACE_FUNC(object_method_bind_get_ptrcall);
 	REGISTER_INTERFACE_FUNC(object_destroy);
 	REGISTER_INTERFACE_FUNC(global_get_singleton);
 	REGISTER_INTERFACE_FUNC(object_get_instance_binding);
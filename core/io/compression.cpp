@@ -41,11 +41,20 @@
 #include <brotli/decode.h>
 #endif
 
-// Caches for zstd.
-static BinaryMutex mutex;
-static ZSTD_DCtx *current_zstd_d_ctx = nullptr;
-static bool current_zstd_long_distance_matching;
-static int current_zstd_window_log_size;
+// Caches for zstd. Each thread keeps its own decompression context, so that independent
+// streams (such as the blocks of a FileAccessCompressed) can be decompressed concurrently.
+struct ZstdDecompressionContext {
+	ZSTD_DCtx *ctx = nullptr;
+	bool long_distance_matching = false;
+	int window_log_size = 0;
+
+	~ZstdDecompressionContext() {
+		if (ctx) {
+			ZSTD_freeDCtx(ctx);
+		}
+	}
+};
+static thread_local ZstdDecompressionContext current_zstd_d_ctx;
 
 int64_t Compression::compress(uint8_t *p_dst, const uint8_t *p_src, int64_t p_src_size, Mode p_mode) {
 	switch (p_mode) {
@@ -198,22 +207,22 @@ int64_t Compression::decompress(uint8_t *p_dst, int64_t p_dst_max_size, const ui
 			return total;
 		} break;
 		case MODE_ZSTD: {
-			MutexLock lock(mutex);
+			ZstdDecompressionContext &zstd_d_ctx = current_zstd_d_ctx;
 
-			if (!current_zstd_d_ctx || current_zstd_long_distance_matching != zstd_long_distance_matching || current_zstd_window_log_size != zstd_window_log_size) {
-				if (current_zstd_d_ctx) {
-					ZSTD_freeDCtx(current_zstd_d_ctx);
+			if (!zstd_d_ctx.ctx || zstd_d_ctx.long_distance_matching != zstd_long_distance_matching || zstd_d_ctx.window_log_size != zstd_window_log_size) {
+				if (zstd_d_ctx.ctx) {
+					ZSTD_freeDCtx(zstd_d_ctx.ctx);
 				}
 
-				current_zstd_d_ctx = ZSTD_createDCtx();
+				zstd_d_ctx.ctx = ZSTD_createDCtx();
 				if (zstd_long_distance_matching) {
-					ZSTD_DCtx_setParameter(current_zstd_d_ctx, ZSTD_d_windowLogMax, zstd_window_log_size);
+					ZSTD_DCtx_setParameter(zstd_d_ctx.ctx, ZSTD_d_windowLogMax, zstd_window_log_size);
 				}
-				current_zstd_long_distance_matching = zstd_long_distance_matching;
-				current_zstd_window_log_size = zstd_window_log_size;
+				zstd_d_ctx.long_distance_matching = zstd_long_distance_matching;
+				zstd_d_ctx.window_log_size = zstd_window_log_size;
 			}
 
-			size_t ret = ZSTD_decompressDCtx(current_zstd_d_ctx, p_dst, p_dst_max_size, p_src, p_src_size);
+			size_t ret = ZSTD_decompressDCtx(zstd_d_ctx.ctx, p_dst, p_dst_max_size, p_src, p_src_size);
 			return (int64_t)ret;
 		} break;
 	}
@@ -192,6 +192,19 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0; ///< get an array of bytes, needs to be overwritten by children.
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+
+	/**
+	 * Memory maps the whole file for reading, when the platform supports it. Once a file is mapped,
+	 * subsequent reads are served from the mapping instead of going through the OS.
+	 * Returns `ERR_UNAVAILABLE` if the file can't be mapped, in which case reads are unaffected.
+	 */
+	virtual Error map() { return ERR_UNAVAILABLE; }
+	/**
+	 * Returns a read-only view of the whole file if it was mapped with `map()`, or an empty span otherwise.
+	 * The span stays valid until the file is closed.
+	 */
+	virtual Span<uint8_t> get_mapped_span() const { return Span<uint8_t>(); }
+
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
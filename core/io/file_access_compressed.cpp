@@ -30,6 +30,8 @@
 
 #include "file_access_compressed.h"
 
+#include "core/object/worker_thread_pool.h"
+
 void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
 	magic = p_magic.ascii().get_data();
 	magic = (magic + "    ").substr(0, 4);
@@ -61,18 +63,77 @@ Error FileAccessCompressed::open_after_magic(Ref<FileAccess> p_base) {
 
 	comp_buffer.resize(max_bs);
 	buffer.resize(block_size);
-	read_ptr = buffer.ptrw();
-	f->get_buffer(comp_buffer.ptrw(), read_blocks[0].csize);
 	at_end = false;
 	read_eof = false;
 	read_block_count = bc;
-	read_block_size = read_blocks.size() == 1 ? read_total : block_size;
-
-	const int64_t ret = Compression::decompress(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize, cmode);
-	read_block = 0;
+	read_ahead_count = 0;
 	read_pos = 0;
 
-	return ret == -1 ? ERR_FILE_CORRUPT : OK;
+	return _load_block(0, true);
+}
+
+Error FileAccessCompressed::_load_block(uint32_t p_block, bool p_read_ahead) const {
+	read_block = p_block;
+	read_block_size = p_block == read_block_count - 1 ? read_total % block_size : block_size;
+
+	if (p_block >= read_ahead_first && p_block - read_ahead_first < read_ahead_count) {
+		// Already decompressed by an earlier read-ahead.
+		read_ptr = read_ahead_buffer.ptr() + (uint64_t)(p_block - read_ahead_first) * block_size;
+		return OK;
+	}
+
+	const uint64_t decompressed_size = read_blocks.size() == 1 ? read_total : block_size;
+	const ReadBlock &first = read_blocks[p_block];
+	if (f->get_position() != first.offset) {
+		f->seek(first.offset);
+	}
+
+	uint32_t count = 1;
+	if (p_read_ahead) {
+		count = MIN(MAX(READ_AHEAD_SIZE / block_size, (uint64_t)1), (uint64_t)(read_block_count - p_block));
+	}
+
+	if (count == 1) {
+		f->get_buffer(comp_buffer.ptrw(), first.csize);
+		const int64_t ret = Compression::decompress(buffer.ptrw(), decompressed_size, comp_buffer.ptr(), first.csize, cmode);
+		read_ptr = buffer.ptr();
+		return ret == -1 ? ERR_FILE_CORRUPT : OK;
+	}
+
+	// Blocks are stored back to back, so the whole window is read with a single call.
+	const ReadBlock &last = read_blocks[p_block + count - 1];
+	read_ahead_comp_buffer.resize(last.offset + last.csize - first.offset);
+	read_ahead_buffer.resize(count * block_size);
+	read_ahead_results.resize(count);
+	f->get_buffer(read_ahead_comp_buffer.ptr(), read_ahead_comp_buffer.size());
+	read_ahead_first = p_block;
+	read_ahead_count = count;
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (pool) {
+		const uint32_t grain = MAX(READ_AHEAD_GRAIN_SIZE / block_size, (uint64_t)1);
+		pool->parallel_for(this, &FileAccessCompressed::_decompress_read_ahead_blocks, decompressed_size, 0, count, grain, true, SNAME("FileAccessCompressedReadAhead"));
+	} else {
+		_decompress_read_ahead_blocks(0, count, 0, decompressed_size);
+	}
+
+	for (const int64_t ret : read_ahead_results) {
+		if (ret == -1) {
+			read_ahead_count = 0;
+			return ERR_FILE_CORRUPT;
+		}
+	}
+
+	read_ptr = read_ahead_buffer.ptr();
+	return OK;
+}
+
+void FileAccessCompressed::_decompress_read_ahead_blocks(uint32_t p_from, uint32_t p_to, uint32_t p_participant, uint64_t p_decompressed_size) const {
+	const uint64_t window_offset = read_blocks[read_ahead_first].offset;
+	for (uint32_t i = p_from; i < p_to; i++) {
+		const ReadBlock &rb = read_blocks[read_ahead_first + i];
+		read_ahead_results[i] = Compression::decompress(read_ahead_buffer.ptr() + (uint64_t)i * block_size, p_decompressed_size, read_ahead_comp_buffer.ptr() + (rb.offset - window_offset), rb.csize, cmode);
+	}
 }
 
 Error FileAccessCompressed::open_internal(const String &p_path, int p_mode_flags) {
@@ -159,6 +220,10 @@ void FileAccessCompressed::_close() {
 	} else {
 		comp_buffer.clear();
 		read_blocks.clear();
+		read_ahead_comp_buffer.reset();
+		read_ahead_buffer.reset();
+		read_ahead_results.reset();
+		read_ahead_count = 0;
 	}
 	buffer.clear();
 	f.unref();
@@ -201,12 +266,9 @@ void FileAccessCompressed::seek(uint64_t p_position) {
 			read_eof = false;
 			uint32_t block_idx = p_position / block_size;
 			if (block_idx != read_block) {
-				read_block = block_idx;
-				f->seek(read_blocks[read_block].offset);
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				const int64_t ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_MSG(ret == -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+				// Random access only decompresses the block it lands in; read-ahead resumes on sequential reads.
+				const Error err = _load_block(block_idx, false);
+				ERR_FAIL_COND_MSG(err != OK, "Compressed file is corrupt.");
 			}
 
 			read_pos = p_position % block_size;
@@ -290,11 +352,9 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 			return dst_idx;
 		}
 
-		// Read the next block of compressed data.
-		f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-		const int64_t ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-		ERR_FAIL_COND_V_MSG(ret == -1, -1, "Compressed file is corrupt.");
-		read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+		// Move on to the next block, decompressing the upcoming ones ahead of time.
+		const Error err = _load_block(read_block, true);
+		ERR_FAIL_COND_V_MSG(err != OK, -1, "Compressed file is corrupt.");
 		read_pos = 0;
 	}
 
@@ -32,6 +32,7 @@
 
 #include "core/io/compression.h"
 #include "core/io/file_access.h"
+#include "core/templates/local_vector.h"
 
 class FileAccessCompressed : public FileAccess {
 	GDSOFTCLASS(FileAccessCompressed, FileAccess);
@@ -51,7 +52,7 @@ class FileAccessCompressed : public FileAccess {
 	};
 
 	mutable Vector<uint8_t> comp_buffer;
-	uint8_t *read_ptr = nullptr;
+	mutable const uint8_t *read_ptr = nullptr;
 	mutable uint32_t read_block = 0;
 	uint32_t read_block_count = 0;
 	mutable uint32_t read_block_size = 0;
@@ -59,6 +60,18 @@ class FileAccessCompressed : public FileAccess {
 	Vector<ReadBlock> read_blocks;
 	uint64_t read_total = 0;
 
+	// Sequential reads decompress a window of upcoming blocks at once, in parallel on the WorkerThreadPool.
+	static constexpr uint64_t READ_AHEAD_SIZE = 1024 * 1024;
+	static constexpr uint64_t READ_AHEAD_GRAIN_SIZE = 64 * 1024;
+	mutable LocalVector<uint8_t> read_ahead_comp_buffer;
+	mutable LocalVector<uint8_t> read_ahead_buffer;
+	mutable LocalVector<int64_t> read_ahead_results;
+	mutable uint32_t read_ahead_first = 0;
+	mutable uint32_t read_ahead_count = 0;
+
+	Error _load_block(uint32_t p_block, bool p_read_ahead) const;
+	void _decompress_read_ahead_blocks(uint32_t p_from, uint32_t p_to, uint32_t p_participant, uint64_t p_decompressed_size) const;
+
 	String magic = "GCMP";
 	mutable Vector<uint8_t> buffer;
 	Ref<FileAccess> f;
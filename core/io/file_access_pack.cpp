@@ -221,6 +221,9 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		return false;
 	}
 
+	// Parse the file table from a memory mapping when the platform supports it.
+	f->map();
+
 	bool pck_header_found = false;
 
 	// Search for the header at the start offset - standalone PCK file.
@@ -440,7 +443,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (mapped.is_empty()) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -474,12 +479,18 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
+	const uint64_t read_pos = pos;
 	pos += to_read;
 
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+
+	if (!mapped.is_empty()) {
+		memcpy(p_dst, mapped.ptr() + read_pos, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
 
 	return to_read;
 }
@@ -511,6 +522,7 @@ bool FileAccessPack::file_exists(const String &p_name) {
 }
 
 void FileAccessPack::close() {
+	mapped = Span<uint8_t>();
 	f = Ref<FileAccess>();
 }
 
@@ -548,6 +560,14 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		ERR_FAIL_COND_MSG(err, vformat(R"(Can't open encrypted pack-referenced file "%s" from pack "%s".)", p_path, pf.pack));
 		f = fae;
 		off = 0;
+	} else {
+		// Serve reads straight from the mapped pack, skipping a seek and a copy through stdio per read.
+		if (f->map() == OK) {
+			Span<uint8_t> pack_span = f->get_mapped_span();
+			if (pack_span.size() >= off + pf.size) {
+				mapped = Span<uint8_t>(pack_span.ptr() + off, pf.size);
+			}
+		}
 	}
 	pos = 0;
 	eof = false;
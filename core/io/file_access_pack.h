@@ -179,6 +179,8 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+	Span<uint8_t> mapped; // This file's bytes within the memory-mapped pack, if available.
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual uint64_t _get_access_time(const String &p_file) override { return 0; }
@@ -205,6 +207,8 @@ public:
 	virtual bool eof_reached() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual Error map() override { return mapped.is_empty() ? ERR_UNAVAILABLE : OK; }
+	virtual Span<uint8_t> get_mapped_span() const override { return mapped; }
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
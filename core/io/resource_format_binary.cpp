@@ -1001,6 +1001,10 @@ void ResourceLoaderBinary::open(Ref<FileAccess> p_f, bool p_no_resources, bool p
 		error = ERR_FILE_UNRECOGNIZED;
 		f.unref();
 		ERR_FAIL_MSG(vformat("Unrecognized binary resource file: '%s'.", local_path));
+	} else {
+		// Uncompressed resources are parsed from a memory mapping when available, which turns
+		// the many small reads below into plain copies.
+		f->map();
 	}
 
 	bool big_endian = f->get_32();
@@ -0,0 +1,480 @@
+/**************************************************************************/
+/*  bulk_math.cpp                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "bulk_math.h"
+
+#include "core/math/transform_2d.h"
+#include "core/math/transform_3d.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BULK_MATH_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define BULK_MATH_NEON
+#include <arm_neon.h>
+#endif
+
+namespace BulkMath {
+
+// Flat kernels work on blocks of 12 scalars, which hold a whole number of elements for
+// every component count from 1 to 4, so the per-component patterns line up with each block.
+static constexpr int BLOCK_SIZE = 12;
+
+template <typename T>
+static void _fill_pattern(const T *p_values, int p_components, T *r_pattern) {
+	for (int i = 0; i < BLOCK_SIZE; i++) {
+		r_pattern[i] = p_values[i % p_components];
+	}
+}
+
+template <typename T>
+static void _multiply_add_scalar(const T *p_src, T *p_dst, int64_t p_from, int64_t p_count, int p_components, const T *p_multiplier, const T *p_addend) {
+	int c = p_from % p_components;
+	for (int64_t i = p_from; i < p_count; i++) {
+		p_dst[i] = p_src[i] * p_multiplier[c] + p_addend[c];
+		c = c + 1 == p_components ? 0 : c + 1;
+	}
+}
+
+template <typename T>
+static void _clamp_scalar(const T *p_src, T *p_dst, int64_t p_from, int64_t p_count, int p_components, const T *p_min, const T *p_max) {
+	int c = p_from % p_components;
+	for (int64_t i = p_from; i < p_count; i++) {
+		p_dst[i] = CLAMP(p_src[i], p_min[c], p_max[c]);
+		c = c + 1 == p_components ? 0 : c + 1;
+	}
+}
+
+template <typename T>
+static void _lerp_scalar(const T *p_from, const T *p_to, T *p_dst, int64_t p_start, int64_t p_count, T p_weight) {
+	for (int64_t i = p_start; i < p_count; i++) {
+		p_dst[i] = Math::lerp(p_from[i], p_to[i], p_weight);
+	}
+}
+
+enum Reduction {
+	REDUCTION_SUM,
+	REDUCTION_MIN,
+	REDUCTION_MAX,
+};
+
+template <Reduction R, typename T>
+static _FORCE_INLINE_ T _reduce(T p_a, T p_b) {
+	if constexpr (R == REDUCTION_SUM) {
+		return p_a + p_b;
+	} else if constexpr (R == REDUCTION_MIN) {
+		return MIN(p_a, p_b);
+	} else {
+		return MAX(p_a, p_b);
+	}
+}
+
+// Folds the scalars in [p_from, p_count) into `r_result`, which must already hold a value per component.
+template <Reduction R, typename T>
+static void _reduce_scalar(const T *p_src, int64_t p_from, int64_t p_count, int p_components, T *r_result) {
+	int c = p_from % p_components;
+	for (int64_t i = p_from; i < p_count; i++) {
+		r_result[c] = _reduce<R>(r_result[c], p_src[i]);
+		c = c + 1 == p_components ? 0 : c + 1;
+	}
+}
+
+template <Reduction R, typename T>
+static void _reduce_all_scalar(const T *p_src, int64_t p_count, int p_components, T *r_result) {
+	if (p_count == 0) {
+		for (int i = 0; i < p_components; i++) {
+			r_result[i] = T(0);
+		}
+		return;
+	}
+	for (int i = 0; i < p_components; i++) {
+		r_result[i] = p_src[i];
+	}
+	_reduce_scalar<R>(p_src, p_components, p_count, p_components, r_result);
+}
+
+#if defined(BULK_MATH_SSE2) || defined(BULK_MATH_NEON)
+
+#ifdef BULK_MATH_SSE2
+typedef __m128 float4;
+#define F4_LOAD(m_ptr) _mm_loadu_ps(m_ptr)
+#define F4_STORE(m_ptr, m_v) _mm_storeu_ps(m_ptr, m_v)
+#define F4_SET1(m_v) _mm_set1_ps(m_v)
+#define F4_ADD(m_a, m_b) _mm_add_ps(m_a, m_b)
+#define F4_SUB(m_a, m_b) _mm_sub_ps(m_a, m_b)
+#define F4_MUL(m_a, m_b) _mm_mul_ps(m_a, m_b)
+#define F4_MIN(m_a, m_b) _mm_min_ps(m_a, m_b)
+#define F4_MAX(m_a, m_b) _mm_max_ps(m_a, m_b)
+// Same as CLAMP(), including NaN and inverted ranges.
+static _FORCE_INLINE_ float4 _clamp4(float4 p_v, float4 p_min, float4 p_max) {
+	const __m128 above = _mm_cmpgt_ps(p_v, p_max);
+	const __m128 below = _mm_cmplt_ps(p_v, p_min);
+	const __m128 upper = _mm_or_ps(_mm_and_ps(above, p_max), _mm_andnot_ps(above, p_v));
+	return _mm_or_ps(_mm_and_ps(below, p_min), _mm_andnot_ps(below, upper));
+}
+#else
+typedef float32x4_t float4;
+#define F4_LOAD(m_ptr) vld1q_f32(m_ptr)
+#define F4_STORE(m_ptr, m_v) vst1q_f32(m_ptr, m_v)
+#define F4_SET1(m_v) vdupq_n_f32(m_v)
+#define F4_ADD(m_a, m_b) vaddq_f32(m_a, m_b)
+#define F4_SUB(m_a, m_b) vsubq_f32(m_a, m_b)
+#define F4_MUL(m_a, m_b) vmulq_f32(m_a, m_b)
+#define F4_MIN(m_a, m_b) vminq_f32(m_a, m_b)
+#define F4_MAX(m_a, m_b) vmaxq_f32(m_a, m_b)
+static _FORCE_INLINE_ float4 _clamp4(float4 p_v, float4 p_min, float4 p_max) {
+	const float32x4_t upper = vbslq_f32(vcgtq_f32(p_v, p_max), p_max, p_v);
+	return vbslq_f32(vcltq_f32(p_v, p_min), p_min, upper);
+}
+#endif
+
+void multiply_add(const float *p_src, float *p_dst, int64_t p_count, int p_components, const float *p_multiplier, const float *p_addend) {
+	float multiplier[BLOCK_SIZE];
+	float addend[BLOCK_SIZE];
+	_fill_pattern(p_multiplier, p_components, multiplier);
+	_fill_pattern(p_addend, p_components, addend);
+	const float4 m0 = F4_LOAD(multiplier), m1 = F4_LOAD(multiplier + 4), m2 = F4_LOAD(multiplier + 8);
+	const float4 a0 = F4_LOAD(addend), a1 = F4_LOAD(addend + 4), a2 = F4_LOAD(addend + 8);
+
+	int64_t i = 0;
+	for (; i + BLOCK_SIZE <= p_count; i += BLOCK_SIZE) {
+		const float4 v0 = F4_LOAD(p_src + i), v1 = F4_LOAD(p_src + i + 4), v2 = F4_LOAD(p_src + i + 8);
+		F4_STORE(p_dst + i, F4_ADD(F4_MUL(v0, m0), a0));
+		F4_STORE(p_dst + i + 4, F4_ADD(F4_MUL(v1, m1), a1));
+		F4_STORE(p_dst + i + 8, F4_ADD(F4_MUL(v2, m2), a2));
+	}
+	_multiply_add_scalar(p_src, p_dst, i, p_count, p_components, p_multiplier, p_addend);
+}
+
+void clamp(const float *p_src, float *p_dst, int64_t p_count, int p_components, const float *p_min, const float *p_max) {
+	float min[BLOCK_SIZE];
+	float max[BLOCK_SIZE];
+	_fill_pattern(p_min, p_components, min);
+	_fill_pattern(p_max, p_components, max);
+	const float4 lo0 = F4_LOAD(min), lo1 = F4_LOAD(min + 4), lo2 = F4_LOAD(min + 8);
+	const float4 hi0 = F4_LOAD(max), hi1 = F4_LOAD(max + 4), hi2 = F4_LOAD(max + 8);
+
+	int64_t i = 0;
+	for (; i + BLOCK_SIZE <= p_count; i += BLOCK_SIZE) {
+		const float4 v0 = F4_LOAD(p_src + i), v1 = F4_LOAD(p_src + i + 4), v2 = F4_LOAD(p_src + i + 8);
+		F4_STORE(p_dst + i, _clamp4(v0, lo0, hi0));
+		F4_STORE(p_dst + i + 4, _clamp4(v1, lo1, hi1));
+		F4_STORE(p_dst + i + 8, _clamp4(v2, lo2, hi2));
+	}
+	_clamp_scalar(p_src, p_dst, i, p_count, p_components, p_min, p_max);
+}
+
+void lerp(const float *p_from, const float *p_to, float *p_dst, int64_t p_count, float p_weight) {
+	const float4 weight = F4_SET1(p_weight);
+
+	int64_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		const float4 from = F4_LOAD(p_from + i);
+		F4_STORE(p_dst + i, F4_ADD(from, F4_MUL(F4_SUB(F4_LOAD(p_to + i), from), weight)));
+	}
+	_lerp_scalar(p_from, p_to, p_dst, i, p_count, p_weight);
+}
+
+template <Reduction R>
+static _FORCE_INLINE_ float4 _reduce4(float4 p_a, float4 p_b) {
+	if constexpr (R == REDUCTION_SUM) {
+		return F4_ADD(p_a, p_b);
+	} else if constexpr (R == REDUCTION_MIN) {
+		return F4_MIN(p_a, p_b);
+	} else {
+		return F4_MAX(p_a, p_b);
+	}
+}
+
+template <Reduction R>
+static void _reduce_float(const float *p_src, int64_t p_count, int p_components, float *r_result) {
+	if (p_count < BLOCK_SIZE) {
+		_reduce_all_scalar<R>(p_src, p_count, p_components, r_result);
+		return;
+	}
+
+	// Every lane keeps folding the same component, the lanes are merged at the end.
+	float4 acc0 = F4_LOAD(p_src), acc1 = F4_LOAD(p_src + 4), acc2 = F4_LOAD(p_src + 8);
+	int64_t i = BLOCK_SIZE;
+	for (; i + BLOCK_SIZE <= p_count; i += BLOCK_SIZE) {
+		acc0 = _reduce4<R>(acc0, F4_LOAD(p_src + i));
+		acc1 = _reduce4<R>(acc1, F4_LOAD(p_src + i + 4));
+		acc2 = _reduce4<R>(acc2, F4_LOAD(p_src + i + 8));
+	}
+
+	float lanes[BLOCK_SIZE];
+	F4_STORE(lanes, acc0);
+	F4_STORE(lanes + 4, acc1);
+	F4_STORE(lanes + 8, acc2);
+	_reduce_all_scalar<R>(lanes, BLOCK_SIZE, p_components, r_result);
+	_reduce_scalar<R>(p_src, i, p_count, p_components, r_result);
+}
+
+void sum(const float *p_src, int64_t p_count, int p_components, float *r_result) {
+	_reduce_float<REDUCTION_SUM>(p_src, p_count, p_components, r_result);
+}
+
+void min(const float *p_src, int64_t p_count, int p_components, float *r_result) {
+	_reduce_float<REDUCTION_MIN>(p_src, p_count, p_components, r_result);
+}
+
+void max(const float *p_src, int64_t p_count, int p_components, float *r_result) {
+	_reduce_float<REDUCTION_MAX>(p_src, p_count, p_components, r_result);
+}
+
+#else
+
+void multiply_add(const float *p_src, float *p_dst, int64_t p_count, int p_components, const float *p_multiplier, const float *p_addend) {
+	_multiply_add_scalar(p_src, p_dst, 0, p_count, p_components, p_multiplier, p_addend);
+}
+
+void clamp(const float *p_src, float *p_dst, int64_t p_count, int p_components, const float *p_min, const float *p_max) {
+	_clamp_scalar(p_src, p_dst, 0, p_count, p_components, p_min, p_max);
+}
+
+void lerp(const float *p_from, const float *p_to, float *p_dst, int64_t p_count, float p_weight) {
+	_lerp_scalar(p_from, p_to, p_dst, 0, p_count, p_weight);
+}
+
+void sum(const float *p_src, int64_t p_count, int p_components, float *r_result) {
+	_reduce_all_scalar<REDUCTION_SUM>(p_src, p_count, p_components, r_result);
+}
+
+void min(const float *p_src, int64_t p_count, int p_components, float *r_result) {
+	_reduce_all_scalar<REDUCTION_MIN>(p_src, p_count, p_components, r_result);
+}
+
+void max(const float *p_src, int64_t p_count, int p_components, float *r_result) {
+	_reduce_all_scalar<REDUCTION_MAX>(p_src, p_count, p_components, r_result);
+}
+
+#endif // BULK_MATH_SSE2 || BULK_MATH_NEON
+
+// Double precision is only used by `real_t` vectors in double builds, plain loops are enough there.
+
+void multiply_add(const double *p_src, double *p_dst, int64_t p_count, int p_components, const double *p_multiplier, const double *p_addend) {
+	_multiply_add_scalar(p_src, p_dst, 0, p_count, p_components, p_multiplier, p_addend);
+}
+
+void clamp(const double *p_src, double *p_dst, int64_t p_count, int p_components, const double *p_min, const double *p_max) {
+	_clamp_scalar(p_src, p_dst, 0, p_count, p_components, p_min, p_max);
+}
+
+void lerp(const double *p_from, const double *p_to, double *p_dst, int64_t p_count, double p_weight) {
+	_lerp_scalar(p_from, p_to, p_dst, 0, p_count, p_weight);
+}
+
+void sum(const double *p_src, int64_t p_count, int p_components, double *r_result) {
+	_reduce_all_scalar<REDUCTION_SUM>(p_src, p_count, p_components, r_result);
+}
+
+void min(const double *p_src, int64_t p_count, int p_components, double *r_result) {
+	_reduce_all_scalar<REDUCTION_MIN>(p_src, p_count, p_components, r_result);
+}
+
+void max(const double *p_src, int64_t p_count, int p_components, double *r_result) {
+	_reduce_all_scalar<REDUCTION_MAX>(p_src, p_count, p_components, r_result);
+}
+
+/* Transforms */
+
+void xform(const Transform2D &p_transform, const Vector2 *p_src, Vector2 *p_dst, int64_t p_count) {
+	int64_t i = 0;
+#if !defined(REAL_T_IS_DOUBLE) && defined(BULK_MATH_SSE2)
+	// Two vectors per register, as (x0, y0, x1, y1).
+	const Vector2 *c = p_transform.columns;
+	const __m128 col0 = _mm_setr_ps(c[0].x, c[0].y, c[0].x, c[0].y);
+	const __m128 col1 = _mm_setr_ps(c[1].x, c[1].y, c[1].x, c[1].y);
+	const __m128 origin = _mm_setr_ps(c[2].x, c[2].y, c[2].x, c[2].y);
+	for (; i + 2 <= p_count; i += 2) {
+		const __m128 v = _mm_loadu_ps(&p_src[i].x);
+		const __m128 xs = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 0, 0));
+		const __m128 ys = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 1, 1));
+		_mm_storeu_ps(&p_dst[i].x, _mm_add_ps(_mm_add_ps(_mm_mul_ps(col0, xs), _mm_mul_ps(col1, ys)), origin));
+	}
+#elif !defined(REAL_T_IS_DOUBLE) && defined(BULK_MATH_NEON)
+	const Vector2 *c = p_transform.columns;
+	for (; i + 4 <= p_count; i += 4) {
+		const float32x4x2_t v = vld2q_f32(&p_src[i].x);
+		float32x4x2_t r;
+		r.val[0] = vaddq_f32(vaddq_f32(vmulq_n_f32(v.val[0], c[0].x), vmulq_n_f32(v.val[1], c[1].x)), vdupq_n_f32(c[2].x));
+		r.val[1] = vaddq_f32(vaddq_f32(vmulq_n_f32(v.val[0], c[0].y), vmulq_n_f32(v.val[1], c[1].y)), vdupq_n_f32(c[2].y));
+		vst2q_f32(&p_dst[i].x, r);
+	}
+#endif
+	for (; i < p_count; i++) {
+		p_dst[i] = p_transform.xform(p_src[i]);
+	}
+}
+
+void xform_inv(const Transform2D &p_transform, const Vector2 *p_src, Vector2 *p_dst, int64_t p_count) {
+	int64_t i = 0;
+#if !defined(REAL_T_IS_DOUBLE) && defined(BULK_MATH_SSE2)
+	const Vector2 *c = p_transform.columns;
+	const __m128 row0 = _mm_setr_ps(c[0].x, c[1].x, c[0].x, c[1].x);
+	const __m128 row1 = _mm_setr_ps(c[0].y, c[1].y, c[0].y, c[1].y);
+	const __m128 origin = _mm_setr_ps(c[2].x, c[2].y, c[2].x, c[2].y);
+	for (; i + 2 <= p_count; i += 2) {
+		const __m128 v = _mm_sub_ps(_mm_loadu_ps(&p_src[i].x), origin);
+		const __m128 xs = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 0, 0));
+		const __m128 ys = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 1, 1));
+		_mm_storeu_ps(&p_dst[i].x, _mm_add_ps(_mm_mul_ps(row0, xs), _mm_mul_ps(row1, ys)));
+	}
+#elif !defined(REAL_T_IS_DOUBLE) && defined(BULK_MATH_NEON)
+	const Vector2 *c = p_transform.columns;
+	for (; i + 4 <= p_count; i += 4) {
+		const float32x4x2_t v = vld2q_f32(&p_src[i].x);
+		const float32x4_t x = vsubq_f32(v.val[0], vdupq_n_f32(c[2].x));
+		const float32x4_t y = vsubq_f32(v.val[1], vdupq_n_f32(c[2].y));
+		float32x4x2_t r;
+		r.val[0] = vaddq_f32(vmulq_n_f32(x, c[0].x), vmulq_n_f32(y, c[0].y));
+		r.val[1] = vaddq_f32(vmulq_n_f32(x, c[1].x), vmulq_n_f32(y, c[1].y));
+		vst2q_f32(&p_dst[i].x, r);
+	}
+#endif
+	for (; i < p_count; i++) {
+		p_dst[i] = p_transform.xform_inv(p_src[i]);
+	}
+}
+
+#if !defined(REAL_T_IS_DOUBLE) && defined(BULK_MATH_SSE2)
+// Splits four packed Vector3 (12 floats in `p_a`, `p_b`, `p_c`) into one register per component.
+static _FORCE_INLINE_ void _deinterleave3(__m128 p_a, __m128 p_b, __m128 p_c, __m128 &r_x, __m128 &r_y, __m128 &r_z) {
+	const __m128 x23 = _mm_shuffle_ps(p_b, p_c, _MM_SHUFFLE(1, 1, 2, 2));
+	r_x = _mm_shuffle_ps(p_a, x23, _MM_SHUFFLE(2, 0, 3, 0));
+	const __m128 y01 = _mm_shuffle_ps(p_a, p_b, _MM_SHUFFLE(0, 0, 1, 1));
+	const __m128 y23 = _mm_shuffle_ps(p_b, p_c, _MM_SHUFFLE(2, 2, 3, 3));
+	r_y = _mm_shuffle_ps(y01, y23, _MM_SHUFFLE(2, 0, 2, 0));
+	const __m128 z01 = _mm_shuffle_ps(p_a, p_b, _MM_SHUFFLE(1, 1, 2, 2));
+	const __m128 z23 = _mm_shuffle_ps(p_c, p_c, _MM_SHUFFLE(3, 3, 0, 0));
+	r_z = _mm_shuffle_ps(z01, z23, _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+static _FORCE_INLINE_ void _interleave3(__m128 p_x, __m128 p_y, __m128 p_z, __m128 &r_a, __m128 &r_b, __m128 &r_c) {
+	r_a = _mm_shuffle_ps(_mm_shuffle_ps(p_x, p_y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(p_z, p_x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+	r_b = _mm_shuffle_ps(_mm_shuffle_ps(p_y, p_z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(p_x, p_y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+	r_c = _mm_shuffle_ps(_mm_shuffle_ps(p_z, p_x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(p_y, p_z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+// `p_m[0] * x + p_m[1] * y + p_m[2] * z`, in the same order as Vector3::dot().
+static _FORCE_INLINE_ __m128 _dot3(const __m128 *p_m, __m128 p_x, __m128 p_y, __m128 p_z) {
+	return _mm_add_ps(_mm_add_ps(_mm_mul_ps(p_m[0], p_x), _mm_mul_ps(p_m[1], p_y)), _mm_mul_ps(p_m[2], p_z));
+}
+#endif
+
+void xform(const Transform3D &p_transform, const Vector3 *p_src, Vector3 *p_dst, int64_t p_count) {
+	int64_t i = 0;
+#if !defined(REAL_T_IS_DOUBLE) && defined(BULK_MATH_SSE2)
+	const Basis &b = p_transform.basis;
+	const __m128 m[3][3] = {
+		{ _mm_set1_ps(b.rows[0][0]), _mm_set1_ps(b.rows[0][1]), _mm_set1_ps(b.rows[0][2]) },
+		{ _mm_set1_ps(b.rows[1][0]), _mm_set1_ps(b.rows[1][1]), _mm_set1_ps(b.rows[1][2]) },
+		{ _mm_set1_ps(b.rows[2][0]), _mm_set1_ps(b.rows[2][1]), _mm_set1_ps(b.rows[2][2]) },
+	};
+	const __m128 ox = _mm_set1_ps(p_transform.origin.x);
+	const __m128 oy = _mm_set1_ps(p_transform.origin.y);
+	const __m128 oz = _mm_set1_ps(p_transform.origin.z);
+	for (; i + 4 <= p_count; i += 4) {
+		const float *src = &p_src[i].x;
+		__m128 x, y, z;
+		_deinterleave3(_mm_loadu_ps(src), _mm_loadu_ps(src + 4), _mm_loadu_ps(src + 8), x, y, z);
+		__m128 a, bb, c;
+		_interleave3(_mm_add_ps(_dot3(m[0], x, y, z), ox), _mm_add_ps(_dot3(m[1], x, y, z), oy), _mm_add_ps(_dot3(m[2], x, y, z), oz), a, bb, c);
+		float *dst = &p_dst[i].x;
+		_mm_storeu_ps(dst, a);
+		_mm_storeu_ps(dst + 4, bb);
+		_mm_storeu_ps(dst + 8, c);
+	}
+#elif !defined(REAL_T_IS_DOUBLE) && defined(BULK_MATH_NEON)
+	const Basis &b = p_transform.basis;
+	const Vector3 &o = p_transform.origin;
+	for (; i + 4 <= p_count; i += 4) {
+		const float32x4x3_t v = vld3q_f32(&p_src[i].x);
+		float32x4x3_t r;
+		for (int j = 0; j < 3; j++) {
+			const float32x4_t d = vaddq_f32(vaddq_f32(vmulq_n_f32(v.val[0], b.rows[j][0]), vmulq_n_f32(v.val[1], b.rows[j][1])), vmulq_n_f32(v.val[2], b.rows[j][2]));
+			r.val[j] = vaddq_f32(d, vdupq_n_f32(o[j]));
+		}
+		vst3q_f32(&p_dst[i].x, r);
+	}
+#endif
+	for (; i < p_count; i++) {
+		p_dst[i] = p_transform.xform(p_src[i]);
+	}
+}
+
+void xform_inv(const Transform3D &p_transform, const Vector3 *p_src, Vector3 *p_dst, int64_t p_count) {
+	int64_t i = 0;
+#if !defined(REAL_T_IS_DOUBLE) && defined(BULK_MATH_SSE2)
+	// Multiplies by the transposed basis.
+	const Basis &b = p_transform.basis;
+	const __m128 m[3][3] = {
+		{ _mm_set1_ps(b.rows[0][0]), _mm_set1_ps(b.rows[1][0]), _mm_set1_ps(b.rows[2][0]) },
+		{ _mm_set1_ps(b.rows[0][1]), _mm_set1_ps(b.rows[1][1]), _mm_set1_ps(b.rows[2][1]) },
+		{ _mm_set1_ps(b.rows[0][2]), _mm_set1_ps(b.rows[1][2]), _mm_set1_ps(b.rows[2][2]) },
+	};
+	const __m128 ox = _mm_set1_ps(p_transform.origin.x);
+	const __m128 oy = _mm_set1_ps(p_transform.origin.y);
+	const __m128 oz = _mm_set1_ps(p_transform.origin.z);
+	for (; i + 4 <= p_count; i += 4) {
+		const float *src = &p_src[i].x;
+		__m128 x, y, z;
+		_deinterleave3(_mm_loadu_ps(src), _mm_loadu_ps(src + 4), _mm_loadu_ps(src + 8), x, y, z);
+		x = _mm_sub_ps(x, ox);
+		y = _mm_sub_ps(y, oy);
+		z = _mm_sub_ps(z, oz);
+		__m128 a, bb, c;
+		_interleave3(_dot3(m[0], x, y, z), _dot3(m[1], x, y, z), _dot3(m[2], x, y, z), a, bb, c);
+		float *dst = &p_dst[i].x;
+		_mm_storeu_ps(dst, a);
+		_mm_storeu_ps(dst + 4, bb);
+		_mm_storeu_ps(dst + 8, c);
+	}
+#elif !defined(REAL_T_IS_DOUBLE) && defined(BULK_MATH_NEON)
+	const Basis &b = p_transform.basis;
+	const Vector3 &o = p_transform.origin;
+	for (; i + 4 <= p_count; i += 4) {
+		const float32x4x3_t v = vld3q_f32(&p_src[i].x);
+		const float32x4_t x = vsubq_f32(v.val[0], vdupq_n_f32(o.x));
+		const float32x4_t y = vsubq_f32(v.val[1], vdupq_n_f32(o.y));
+		const float32x4_t z = vsubq_f32(v.val[2], vdupq_n_f32(o.z));
+		float32x4x3_t r;
+		for (int j = 0; j < 3; j++) {
+			r.val[j] = vaddq_f32(vaddq_f32(vmulq_n_f32(x, b.rows[0][j]), vmulq_n_f32(y, b.rows[1][j])), vmulq_n_f32(z, b.rows[2][j]));
+		}
+		vst3q_f32(&p_dst[i].x, r);
+	}
+#endif
+	for (; i < p_count; i++) {
+		p_dst[i] = p_transform.xform_inv(p_src[i]);
+	}
+}
+
+} // namespace BulkMath
@@ -0,0 +1,68 @@
+/**************************************************************************/
+/*  bulk_math.h                                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/typedefs.h"
+
+struct Transform2D;
+struct Transform3D;
+struct Vector2;
+struct Vector3;
+
+// Bulk math on arrays of scalars and vectors, used by the packed array methods and the
+// array transforms. Uses SSE2 or NEON where available, with a scalar fallback.
+namespace BulkMath {
+
+// Element-wise operations on `p_count` scalars. The per-component parameters repeat every
+// `p_components` scalars (1 to 4), so a Vector3 array has `p_components == 3`.
+void multiply_add(const float *p_src, float *p_dst, int64_t p_count, int p_components, const float *p_multiplier, const float *p_addend);
+void multiply_add(const double *p_src, double *p_dst, int64_t p_count, int p_components, const double *p_multiplier, const double *p_addend);
+void clamp(const float *p_src, float *p_dst, int64_t p_count, int p_components, const float *p_min, const float *p_max);
+void clamp(const double *p_src, double *p_dst, int64_t p_count, int p_components, const double *p_min, const double *p_max);
+void lerp(const float *p_from, const float *p_to, float *p_dst, int64_t p_count, float p_weight);
+void lerp(const double *p_from, const double *p_to, double *p_dst, int64_t p_count, double p_weight);
+
+// Per-component reductions of `p_count` scalars, which must be a multiple of `p_components`.
+// Write `p_components` results. `min()` and `max()` need at least one element.
+void sum(const float *p_src, int64_t p_count, int p_components, float *r_result);
+void sum(const double *p_src, int64_t p_count, int p_components, double *r_result);
+void min(const float *p_src, int64_t p_count, int p_components, float *r_result);
+void min(const double *p_src, int64_t p_count, int p_components, double *r_result);
+void max(const float *p_src, int64_t p_count, int p_components, float *r_result);
+void max(const double *p_src, int64_t p_count, int p_components, double *r_result);
+
+// Same results as transforming each vector on its own. `p_src` and `p_dst` may be the same array.
+void xform(const Transform2D &p_transform, const Vector2 *p_src, Vector2 *p_dst, int64_t p_count);
+void xform_inv(const Transform2D &p_transform, const Vector2 *p_src, Vector2 *p_dst, int64_t p_count);
+void xform(const Transform3D &p_transform, const Vector3 *p_src, Vector3 *p_dst, int64_t p_count);
+void xform_inv(const Transform3D &p_transform, const Vector3 *p_src, Vector3 *p_dst, int64_t p_count);
+
+} // namespace BulkMath
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/math/bulk_math.h"
 #include "core/math/math_funcs.h"
 #include "core/math/rect2.h"
 #include "core/math/vector2.h"
@@ -272,26 +273,16 @@ Rect2 Transform2D::xform_inv(const Rect2 &p_rect) const {
 
 Vector<Vector2> Transform2D::xform(const Vector<Vector2> &p_array) const {
 	Vector<Vector2> array;
-	array.resize(p_array.size());
+	array.resize_uninitialized(p_array.size());
 
-	const Vector2 *r = p_array.ptr();
-	Vector2 *w = array.ptrw();
-
-	for (int i = 0; i < p_array.size(); ++i) {
-		w[i] = xform(r[i]);
-	}
+	BulkMath::xform(*this, p_array.ptr(), array.ptrw(), p_array.size());
 	return array;
 }
 
 Vector<Vector2> Transform2D::xform_inv(const Vector<Vector2> &p_array) const {
 	Vector<Vector2> array;
-	array.resize(p_array.size());
+	array.resize_uninitialized(p_array.size());
 
-	const Vector2 *r = p_array.ptr();
-	Vector2 *w = array.ptrw();
-
-	for (int i = 0; i < p_array.size(); ++i) {
-		w[i] = xform_inv(r[i]);
-	}
+	BulkMath::xform_inv(*this, p_array.ptr(), array.ptrw(), p_array.size());
 	return array;
 }
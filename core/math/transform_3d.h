@@ -32,6 +32,7 @@
 
 #include "core/math/aabb.h"
 #include "core/math/basis.h"
+#include "core/math/bulk_math.h"
 #include "core/math/plane.h"
 #include "core/templates/vector.h"
 
@@ -257,27 +258,17 @@ _FORCE_INLINE_ AABB Transform3D::xform_inv(const AABB &p_aabb) const {
 
 Vector<Vector3> Transform3D::xform(const Vector<Vector3> &p_array) const {
 	Vector<Vector3> array;
-	array.resize(p_array.size());
+	array.resize_uninitialized(p_array.size());
 
-	const Vector3 *r = p_array.ptr();
-	Vector3 *w = array.ptrw();
-
-	for (int i = 0; i < p_array.size(); ++i) {
-		w[i] = xform(r[i]);
-	}
+	BulkMath::xform(*this, p_array.ptr(), array.ptrw(), p_array.size());
 	return array;
 }
 
 Vector<Vector3> Transform3D::xform_inv(const Vector<Vector3> &p_array) const {
 	Vector<Vector3> array;
-	array.resize(p_array.size());
+	array.resize_uninitialized(p_array.size());
 
-	const Vector3 *r = p_array.ptr();
-	Vector3 *w = array.ptrw();
-
-	for (int i = 0; i < p_array.size(); ++i) {
-		w[i] = xform_inv(r[i]);
-	}
+	BulkMath::xform_inv(*this, p_array.ptr(), array.ptrw(), p_array.size());
 	return array;
 }
 
@@ -122,7 +122,7 @@ Callable create_custom_callable_function_pointer(T *p_instance,
 #endif // DEBUG_ENABLED
 		void (T::*p_method)(P...)) {
 	typedef CallableCustomMethodPointer<T, void, P...> CCMP; // Messes with memnew otherwise.
-	CCMP *ccmp = memnew(CCMP(p_instance, p_method));
+	CCMP *ccmp = CallableCustom::create<CCMP>(p_instance, p_method);
 #ifdef DEBUG_ENABLED
 	ccmp->set_text(p_func_text + 1); // Try to get rid of the ampersand.
 #endif // DEBUG_ENABLED
@@ -136,7 +136,7 @@ Callable create_custom_callable_function_pointer(T *p_instance,
 #endif // DEBUG_ENABLED
 		R (T::*p_method)(P...)) {
 	typedef CallableCustomMethodPointer<T, R, P...> CCMP; // Messes with memnew otherwise.
-	CCMP *ccmp = memnew(CCMP(p_instance, p_method));
+	CCMP *ccmp = CallableCustom::create<CCMP>(p_instance, p_method);
 #ifdef DEBUG_ENABLED
 	ccmp->set_text(p_func_text + 1); // Try to get rid of the ampersand.
 #endif // DEBUG_ENABLED
@@ -191,7 +191,7 @@ Callable create_custom_callable_function_pointer(T *p_instance,
 #endif // DEBUG_ENABLED
 		void (T::*p_method)(P...) const) {
 	typedef CallableCustomMethodPointerC<T, void, P...> CCMP; // Messes with memnew otherwise.
-	CCMP *ccmp = memnew(CCMP(p_instance, p_method));
+	CCMP *ccmp = CallableCustom::create<CCMP>(p_instance, p_method);
 #ifdef DEBUG_ENABLED
 	ccmp->set_text(p_func_text + 1); // Try to get rid of the ampersand.
 #endif // DEBUG_ENABLED
@@ -205,7 +205,7 @@ Callable create_custom_callable_function_pointer(T *p_instance,
 #endif
 		R (T::*p_method)(P...) const) {
 	typedef CallableCustomMethodPointerC<T, R, P...> CCMP; // Messes with memnew otherwise.
-	CCMP *ccmp = memnew(CCMP(p_instance, p_method));
+	CCMP *ccmp = CallableCustom::create<CCMP>(p_instance, p_method);
 #ifdef DEBUG_ENABLED
 	ccmp->set_text(p_func_text + 1); // Try to get rid of the ampersand.
 #endif // DEBUG_ENABLED
@@ -262,7 +262,7 @@ Callable create_custom_callable_static_function_pointer(
 #endif // DEBUG_ENABLED
 		void (*p_method)(P...)) {
 	typedef CallableCustomStaticMethodPointer<void, P...> CCMP; // Messes with memnew otherwise.
-	CCMP *ccmp = memnew(CCMP(p_method));
+	CCMP *ccmp = CallableCustom::create<CCMP>(p_method);
 #ifdef DEBUG_ENABLED
 	ccmp->set_text(p_func_text + 1); // Try to get rid of the ampersand.
 #endif // DEBUG_ENABLED
@@ -276,7 +276,7 @@ Callable create_custom_callable_static_function_pointer(
 #endif // DEBUG_ENABLED
 		R (*p_method)(P...)) {
 	typedef CallableCustomStaticMethodPointer<R, P...> CCMP; // Messes with memnew otherwise.
-	CCMP *ccmp = memnew(CCMP(p_method));
+	CCMP *ccmp = CallableCustom::create<CCMP>(p_method);
 #ifdef DEBUG_ENABLED
 	ccmp->set_text(p_func_text + 1); // Try to get rid of the ampersand.
 #endif // DEBUG_ENABLED
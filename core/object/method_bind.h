@@ -50,11 +50,21 @@ class MethodBind {
 	bool _returns = false;
 	bool _returns_raw_obj_ptr = false;
 
+public:
+	typedef void (*PtrCallFunc)(const MethodBind *p_method_bind, Object *p_object, const void **p_args, void *r_ret);
+
 protected:
 	Variant::Type *argument_types = nullptr;
 #ifdef DEBUG_ENABLED
 	Vector<StringName> arg_names;
 #endif // DEBUG_ENABLED
+	// Set by the templated binds to a function specialized for the method signature.
+	PtrCallFunc ptrcall_func = &_ptrcall_dispatch;
+
+	static void _ptrcall_dispatch(const MethodBind *p_method_bind, Object *p_object, const void **p_args, void *r_ret) {
+		p_method_bind->ptrcall(p_object, p_args, r_ret);
+	}
+
 	void _set_const(bool p_const);
 	void _set_static(bool p_static);
 	void _set_returns(bool p_returns);
@@ -119,6 +129,9 @@ public:
 
 	virtual void ptrcall(Object *p_object, const void **p_args, void *r_ret) const = 0;
 
+	// Same as ptrcall(), but can be resolved once and then called without the virtual dispatch.
+	_FORCE_INLINE_ PtrCallFunc get_ptrcall_func() const { return ptrcall_func; }
+
 	StringName get_name() const;
 	void set_name(const StringName &p_name);
 	_FORCE_INLINE_ int get_method_id() const { return method_id; }
@@ -350,21 +363,27 @@ public:
 #endif
 	}
 
-	virtual void ptrcall(Object *p_object, const void **p_args, void *r_ret) const override {
+	static void _ptrcall(const MethodBind *p_method_bind, Object *p_object, const void **p_args, void *r_ret) {
+		const MethodBindT *self = static_cast<const MethodBindT *>(p_method_bind);
 #ifdef TOOLS_ENABLED
-		ERR_FAIL_COND_MSG(p_object && p_object->is_extension_placeholder() && p_object->get_class_name() == get_instance_class(), vformat("Cannot call method bind '%s' on placeholder instance.", MethodBind::get_name()));
+		ERR_FAIL_COND_MSG(p_object && p_object->is_extension_placeholder() && p_object->get_class_name() == self->get_instance_class(), vformat("Cannot call method bind '%s' on placeholder instance.", self->get_name()));
 #endif
 #ifdef TYPED_METHOD_BIND
-		call_with_ptr_args<T, P...>(static_cast<T *>(p_object), method, p_args);
+		call_with_ptr_args<T, P...>(static_cast<T *>(p_object), self->method, p_args);
 #else
-		call_with_ptr_args<MB_T, P...>(reinterpret_cast<MB_T *>(p_object), method, p_args);
+		call_with_ptr_args<MB_T, P...>(reinterpret_cast<MB_T *>(p_object), self->method, p_args);
 #endif
 	}
 
+	virtual void ptrcall(Object *p_object, const void **p_args, void *r_ret) const override {
+		_ptrcall(this, p_object, p_args, r_ret);
+	}
+
 	MethodBindT(void (MB_T::*p_method)(P...)) {
 		method = p_method;
 		_generate_argument_types(sizeof...(P));
 		set_argument_count(sizeof...(P));
+		ptrcall_func = &_ptrcall;
 	}
 };
 
@@ -434,22 +453,28 @@ public:
 #endif
 	}
 
-	virtual void ptrcall(Object *p_object, const void **p_args, void *r_ret) const override {
+	static void _ptrcall(const MethodBind *p_method_bind, Object *p_object, const void **p_args, void *r_ret) {
+		const MethodBindTC *self = static_cast<const MethodBindTC *>(p_method_bind);
 #ifdef TOOLS_ENABLED
-		ERR_FAIL_COND_MSG(p_object && p_object->is_extension_placeholder() && p_object->get_class_name() == get_instance_class(), vformat("Cannot call method bind '%s' on placeholder instance.", MethodBind::get_name()));
+		ERR_FAIL_COND_MSG(p_object && p_object->is_extension_placeholder() && p_object->get_class_name() == self->get_instance_class(), vformat("Cannot call method bind '%s' on placeholder instance.", self->get_name()));
 #endif
 #ifdef TYPED_METHOD_BIND
-		call_with_ptr_argsc<T, P...>(static_cast<T *>(p_object), method, p_args);
+		call_with_ptr_argsc<T, P...>(static_cast<T *>(p_object), self->method, p_args);
 #else
-		call_with_ptr_argsc<MB_T, P...>(reinterpret_cast<MB_T *>(p_object), method, p_args);
+		call_with_ptr_argsc<MB_T, P...>(reinterpret_cast<MB_T *>(p_object), self->method, p_args);
 #endif
 	}
 
+	virtual void ptrcall(Object *p_object, const void **p_args, void *r_ret) const override {
+		_ptrcall(this, p_object, p_args, r_ret);
+	}
+
 	MethodBindTC(void (MB_T::*p_method)(P...) const) {
 		method = p_method;
 		_set_const(true);
 		_generate_argument_types(sizeof...(P));
 		set_argument_count(sizeof...(P));
+		ptrcall_func = &_ptrcall;
 	}
 };
 
@@ -528,22 +553,28 @@ public:
 #endif
 	}
 
-	virtual void ptrcall(Object *p_object, const void **p_args, void *r_ret) const override {
+	static void _ptrcall(const MethodBind *p_method_bind, Object *p_object, const void **p_args, void *r_ret) {
+		const MethodBindTR *self = static_cast<const MethodBindTR *>(p_method_bind);
 #ifdef TOOLS_ENABLED
-		ERR_FAIL_COND_MSG(p_object && p_object->is_extension_placeholder() && p_object->get_class_name() == get_instance_class(), vformat("Cannot call method bind '%s' on placeholder instance.", MethodBind::get_name()));
+		ERR_FAIL_COND_MSG(p_object && p_object->is_extension_placeholder() && p_object->get_class_name() == self->get_instance_class(), vformat("Cannot call method bind '%s' on placeholder instance.", self->get_name()));
 #endif
 #ifdef TYPED_METHOD_BIND
-		call_with_ptr_args_ret<T, R, P...>(static_cast<T *>(p_object), method, p_args, r_ret);
+		call_with_ptr_args_ret<T, R, P...>(static_cast<T *>(p_object), self->method, p_args, r_ret);
 #else
-		call_with_ptr_args_ret<MB_T, R, P...>(reinterpret_cast<MB_T *>(p_object), method, p_args, r_ret);
+		call_with_ptr_args_ret<MB_T, R, P...>(reinterpret_cast<MB_T *>(p_object), self->method, p_args, r_ret);
 #endif
 	}
 
+	virtual void ptrcall(Object *p_object, const void **p_args, void *r_ret) const override {
+		_ptrcall(this, p_object, p_args, r_ret);
+	}
+
 	MethodBindTR(R (MB_T::*p_method)(P...)) {
 		method = p_method;
 		_set_returns(true);
 		_generate_argument_types(sizeof...(P));
 		set_argument_count(sizeof...(P));
+		ptrcall_func = &_ptrcall;
 	}
 };
 
@@ -623,23 +654,29 @@ public:
 #endif
 	}
 
-	virtual void ptrcall(Object *p_object, const void **p_args, void *r_ret) const override {
+	static void _ptrcall(const MethodBind *p_method_bind, Object *p_object, const void **p_args, void *r_ret) {
+		const MethodBindTRC *self = static_cast<const MethodBindTRC *>(p_method_bind);
 #ifdef TOOLS_ENABLED
-		ERR_FAIL_COND_MSG(p_object && p_object->is_extension_placeholder() && p_object->get_class_name() == get_instance_class(), vformat("Cannot call method bind '%s' on placeholder instance.", MethodBind::get_name()));
+		ERR_FAIL_COND_MSG(p_object && p_object->is_extension_placeholder() && p_object->get_class_name() == self->get_instance_class(), vformat("Cannot call method bind '%s' on placeholder instance.", self->get_name()));
 #endif
 #ifdef TYPED_METHOD_BIND
-		call_with_ptr_args_retc<T, R, P...>(static_cast<T *>(p_object), method, p_args, r_ret);
+		call_with_ptr_args_retc<T, R, P...>(static_cast<T *>(p_object), self->method, p_args, r_ret);
 #else
-		call_with_ptr_args_retc<MB_T, R, P...>(reinterpret_cast<MB_T *>(p_object), method, p_args, r_ret);
+		call_with_ptr_args_retc<MB_T, R, P...>(reinterpret_cast<MB_T *>(p_object), self->method, p_args, r_ret);
 #endif
 	}
 
+	virtual void ptrcall(Object *p_object, const void **p_args, void *r_ret) const override {
+		_ptrcall(this, p_object, p_args, r_ret);
+	}
+
 	MethodBindTRC(R (MB_T::*p_method)(P...) const) {
 		method = p_method;
 		_set_returns(true);
 		_set_const(true);
 		_generate_argument_types(sizeof...(P));
 		set_argument_count(sizeof...(P));
+		ptrcall_func = &_ptrcall;
 	}
 };
 
@@ -694,10 +731,15 @@ public:
 		call_with_validated_variant_args_static_method(function, p_args);
 	}
 
-	virtual void ptrcall(Object *p_object, const void **p_args, void *r_ret) const override {
+	static void _ptrcall(const MethodBind *p_method_bind, Object *p_object, const void **p_args, void *r_ret) {
+		const MethodBindTS *self = static_cast<const MethodBindTS *>(p_method_bind);
 		(void)p_object;
 		(void)r_ret;
-		call_with_ptr_args_static_method(function, p_args);
+		call_with_ptr_args_static_method(self->function, p_args);
+	}
+
+	virtual void ptrcall(Object *p_object, const void **p_args, void *r_ret) const override {
+		_ptrcall(this, p_object, p_args, r_ret);
 	}
 
 	MethodBindTS(void (*p_function)(P...)) {
@@ -705,6 +747,7 @@ public:
 		_generate_argument_types(sizeof...(P));
 		set_argument_count(sizeof...(P));
 		_set_static(true);
+		ptrcall_func = &_ptrcall;
 	}
 };
 
@@ -760,9 +803,14 @@ public:
 		call_with_validated_variant_args_static_method_ret(function, p_args, r_ret);
 	}
 
-	virtual void ptrcall(Object *p_object, const void **p_args, void *r_ret) const override {
+	static void _ptrcall(const MethodBind *p_method_bind, Object *p_object, const void **p_args, void *r_ret) {
+		const MethodBindTRS *self = static_cast<const MethodBindTRS *>(p_method_bind);
 		(void)p_object;
-		call_with_ptr_args_static_method_ret(function, p_args, r_ret);
+		call_with_ptr_args_static_method_ret(self->function, p_args, r_ret);
+	}
+
+	virtual void ptrcall(Object *p_object, const void **p_args, void *r_ret) const override {
+		_ptrcall(this, p_object, p_args, r_ret);
 	}
 
 	MethodBindTRS(R (*p_function)(P...)) {
@@ -771,6 +819,7 @@ public:
 		set_argument_count(sizeof...(P));
 		_set_static(true);
 		_set_returns(true);
+		ptrcall_func = &_ptrcall;
 	}
 };
 
@@ -867,9 +867,82 @@ Variant Object::callv(const StringName &p_method, const Array &p_args) {
 	return ret;
 }
 
+thread_local MethodCallCache *MethodCallCache::current = nullptr;
+
+MethodBind *MethodCallCache::get_method(const StringName &p_class, const StringName &p_method) {
+	const void *class_name = p_class.data_unique_pointer();
+	const void *method_name = p_method.data_unique_pointer();
+	const uint32_t current_version = global_version.get();
+
+	uint32_t seq = sequence.load(std::memory_order_acquire);
+	if (!(seq & 1) && version.load(std::memory_order_relaxed) == current_version) {
+		for (const Entry &entry : entries) {
+			if (entry.class_name.load(std::memory_order_relaxed) == class_name && entry.method_name.load(std::memory_order_relaxed) == method_name) {
+				MethodBind *method = entry.method.load(std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (likely(sequence.load(std::memory_order_relaxed) == seq)) {
+					return method;
+				}
+				break;
+			}
+		}
+	}
+
+	MethodBind *method = ClassDB::get_method(p_class, p_method);
+	if (!method || (seq & 1)) {
+		return method;
+	}
+
+	// If another thread is already updating the entries, just don't cache this one.
+	if (sequence.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire)) {
+		if (version.load(std::memory_order_relaxed) != current_version) {
+			for (Entry &entry : entries) {
+				entry.class_name.store(nullptr, std::memory_order_relaxed);
+			}
+			version.store(current_version, std::memory_order_relaxed);
+			next_entry = 0;
+		}
+		Entry &entry = entries[next_entry];
+		next_entry = (next_entry + 1) % ENTRY_COUNT;
+		entry.class_name.store(class_name, std::memory_order_relaxed);
+		entry.method_name.store(method_name, std::memory_order_relaxed);
+		entry.method.store(method, std::memory_order_relaxed);
+		sequence.store(seq + 2, std::memory_order_release);
+	}
+
+	return method;
+}
+
+MethodCallCache &MethodCallCache::operator=(const MethodCallCache &p_other) {
+	if (this == &p_other) {
+		return *this;
+	}
+
+	const uint32_t seq = p_other.sequence.load(std::memory_order_acquire);
+	for (uint32_t i = 0; i < ENTRY_COUNT; i++) {
+		entries[i].class_name.store(p_other.entries[i].class_name.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		entries[i].method_name.store(p_other.entries[i].method_name.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		entries[i].method.store(p_other.entries[i].method.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+	version.store(p_other.version.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if ((seq & 1) || p_other.sequence.load(std::memory_order_relaxed) != seq) {
+		// Copied halfway through an update, start empty instead.
+		version.store(0, std::memory_order_relaxed);
+	}
+
+	sequence.store(0, std::memory_order_relaxed);
+	next_entry = 0;
+	return *this;
+}
+
 Variant Object::callp(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
 	r_error.error = Callable::CallError::CALL_OK;
 
+	// Only meant for this call, not for the ones the script may make.
+	MethodCallCache *call_cache = MethodCallCache::current;
+	MethodCallCache::current = nullptr;
+
 	if (p_method == CoreStringName(free_)) {
 //free must be here, before anything, always ready
 #ifdef DEBUG_ENABLED
@@ -919,7 +992,7 @@ Variant Object::callp(const StringName &p_method, const Variant **p_args, int p_
 
 	//extension does not need this, because all methods are registered in MethodBind
 
-	MethodBind *method = ClassDB::get_method(get_class_name(), p_method);
+	MethodBind *method = call_cache ? call_cache->get_method(get_class_name(), p_method) : ClassDB::get_method(get_class_name(), p_method);
 
 	if (method) {
 		ret = method->call(this, p_args, p_argcount, r_error);
@@ -933,6 +1006,9 @@ Variant Object::callp(const StringName &p_method, const Variant **p_args, int p_
 Variant Object::call_const(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
 	r_error.error = Callable::CallError::CALL_OK;
 
+	MethodCallCache *call_cache = MethodCallCache::current;
+	MethodCallCache::current = nullptr;
+
 	if (p_method == CoreStringName(free_)) {
 		// Free is not const, so fail.
 		r_error.error = Callable::CallError::CALL_ERROR_METHOD_NOT_CONST;
@@ -963,7 +1039,7 @@ Variant Object::call_const(const StringName &p_method, const Variant **p_args, i
 
 	//extension does not need this, because all methods are registered in MethodBind
 
-	MethodBind *method = ClassDB::get_method(get_class_name(), p_method);
+	MethodBind *method = call_cache ? call_cache->get_method(get_class_name(), p_method) : ClassDB::get_method(get_class_name(), p_method);
 
 	if (method) {
 		if (!method->is_const()) {
@@ -1205,31 +1281,89 @@ void Object::get_meta_list(List<StringName> *p_list) const {
 	}
 }
 
+Object::SignalData::EmitSlots *Object::SignalData::ref_emit_slots() {
+	if (!emit_slots) {
+		emit_slots = memnew(EmitSlots);
+		emit_slots->refcount.init();
+		emit_slots->slots.resize(slot_map.size());
+		uint32_t i = 0;
+		for (const KeyValue<Callable, Slot> &slot_kv : slot_map) {
+			EmitSlot &emit_slot = emit_slots->slots[i++];
+			emit_slot.callable = slot_kv.value.conn.callable;
+			emit_slot.flags = slot_kv.value.conn.flags;
+			emit_slots->has_one_shot = emit_slots->has_one_shot || (emit_slot.flags & CONNECT_ONE_SHOT);
+		}
+	}
+	emit_slots->refcount.ref();
+	return emit_slots;
+}
+
+void Object::SignalData::unref_emit_slots(EmitSlots *p_emit_slots) {
+	if (p_emit_slots->refcount.unref()) {
+		memdelete(p_emit_slots);
+	}
+}
+
+void Object::SignalData::clear_emit_slots() {
+	// Emissions in progress keep the old array alive until they're done with it.
+	if (emit_slots) {
+		unref_emit_slots(emit_slots);
+		emit_slots = nullptr;
+	}
+}
+
+Object::SignalData *Object::_get_signal_data(const StringName &p_name) const {
+	for (const SignalEntry &entry : signal_table) {
+		if (entry.name == p_name) {
+			return entry.data;
+		}
+	}
+	return nullptr;
+}
+
+Object::SignalData *Object::_add_signal_data(const StringName &p_name) {
+	SignalEntry entry;
+	entry.name = p_name;
+	entry.data = memnew(SignalData);
+	signal_table.push_back(entry);
+	return entry.data;
+}
+
+void Object::_remove_signal_data(const StringName &p_name) {
+	for (uint32_t i = 0; i < signal_table.size(); i++) {
+		if (signal_table[i].name == p_name) {
+			memdelete(signal_table[i].data);
+			signal_table.remove_at(i);
+			return;
+		}
+	}
+}
+
 void Object::add_user_signal(const MethodInfo &p_signal) {
 	ERR_FAIL_COND_MSG(p_signal.name.is_empty(), "Signal name cannot be empty.");
 	ERR_FAIL_COND_MSG(ClassDB::has_signal(get_class_name(), p_signal.name), vformat("User signal's name conflicts with a built-in signal of '%s'.", get_class_name()));
 
 	OBJ_SIGNAL_LOCK
 
-	ERR_FAIL_COND_MSG(signal_map.has(p_signal.name), vformat("Trying to add already existing signal '%s'.", p_signal.name));
-	SignalData s;
-	s.user = p_signal;
-	signal_map[p_signal.name] = s;
+	ERR_FAIL_COND_MSG(_get_signal_data(p_signal.name), vformat("Trying to add already existing signal '%s'.", p_signal.name));
+	SignalData *s = _add_signal_data(p_signal.name);
+	s->user = p_signal;
 }
 
 bool Object::_has_user_signal(const StringName &p_name) const {
 	OBJ_SIGNAL_LOCK
 
-	if (!signal_map.has(p_name)) {
+	const SignalData *s = _get_signal_data(p_name);
+	if (!s) {
 		return false;
 	}
-	return signal_map[p_name].user.name.length() > 0;
+	return s->user.name.length() > 0;
 }
 
 void Object::_remove_user_signal(const StringName &p_name) {
 	OBJ_SIGNAL_LOCK
 
-	SignalData *s = signal_map.getptr(p_name);
+	SignalData *s = _get_signal_data(p_name);
 	ERR_FAIL_NULL_MSG(s, "Provided signal does not exist.");
 	ERR_FAIL_COND_MSG(!s->removable, "Signal is not removable (not added with add_user_signal).");
 	for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
@@ -1239,7 +1373,7 @@ void Object::_remove_user_signal(const StringName &p_name) {
 		}
 	}
 
-	signal_map.erase(p_name);
+	_remove_signal_data(p_name);
 }
 
 Error Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
@@ -1275,19 +1409,12 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
 	}
 
-	constexpr int MAX_SLOTS_ON_STACK = 5;
-	// Don't default initialize the Callable objects on the stack, just reserve the space - we'll memnew_placement() them later.
-	alignas(Callable) uint8_t slot_callable_stack[sizeof(Callable) * MAX_SLOTS_ON_STACK];
-	uint32_t slot_flags_stack[MAX_SLOTS_ON_STACK];
-
-	Callable *slot_callables = (Callable *)slot_callable_stack;
-	uint32_t *slot_flags = slot_flags_stack;
-	uint32_t slot_count = 0;
+	SignalData::EmitSlots *emit_slots = nullptr;
 
 	{
 		OBJ_SIGNAL_LOCK
 
-		SignalData *s = signal_map.getptr(p_name);
+		SignalData *s = _get_signal_data(p_name);
 		if (!s) {
 #ifdef DEBUG_ENABLED
 			bool signal_is_valid = ClassDB::has_signal(get_class_name(), p_name);
@@ -1298,32 +1425,27 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 			return ERR_UNAVAILABLE;
 		}
 
-		if (s->slot_map.size() > MAX_SLOTS_ON_STACK) {
-			slot_callables = (Callable *)memalloc(sizeof(Callable) * s->slot_map.size());
-			slot_flags = (uint32_t *)memalloc(sizeof(uint32_t) * s->slot_map.size());
+		if (s->slot_map.is_empty()) {
+			return OK;
 		}
 
 		// Ensure that disconnecting the signal or even deleting the object
 		// will not affect the signal calling.
-		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-			memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
-			slot_flags[slot_count] = slot_kv.value.conn.flags;
-			++slot_count;
-		}
-
-		DEV_ASSERT(slot_count == s->slot_map.size());
+		emit_slots = s->ref_emit_slots();
 
 		// Disconnect all one-shot connections before emitting to prevent recursion.
-		for (uint32_t i = 0; i < slot_count; ++i) {
-			bool disconnect = slot_flags[i] & CONNECT_ONE_SHOT;
+		if (emit_slots->has_one_shot) {
+			for (const SignalData::EmitSlot &slot : emit_slots->slots) {
+				bool disconnect = slot.flags & CONNECT_ONE_SHOT;
 #ifdef TOOLS_ENABLED
-			if (disconnect && (slot_flags[i] & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
-				// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
-				disconnect = false;
-			}
+				if (disconnect && (slot.flags & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
+					// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
+					disconnect = false;
+				}
 #endif
-			if (disconnect) {
-				_disconnect(p_name, slot_callables[i]);
+				if (disconnect) {
+					_disconnect(p_name, slot.callable);
+				}
 			}
 		}
 	}
@@ -1339,12 +1461,12 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 
 	Error err = OK;
 
-	Vector<const Variant *> append_source_mem;
+	const Variant **append_source_args = (const Variant **)alloca(sizeof(const Variant *) * (p_argcount + 1));
 	Variant source = this;
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		const Callable &callable = slot_callables[i];
-		const uint32_t &flags = slot_flags[i];
+	for (SignalData::EmitSlot &slot : emit_slots->slots) {
+		const Callable &callable = slot.callable;
+		const uint32_t flags = slot.flags;
 
 		if (!callable.is_valid()) {
 			// Target might have been deleted during signal callback, this is expected and OK.
@@ -1359,18 +1481,15 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 			// Implemented by inserting before the first to-be-unbinded arg.
 			int source_index = p_argcount - callable.get_unbound_arguments_count();
 			if (source_index >= 0) {
-				append_source_mem.resize(p_argcount + 1);
-				const Variant **args_mem = append_source_mem.ptrw();
-
 				for (int j = 0; j < source_index; j++) {
-					args_mem[j] = p_args[j];
+					append_source_args[j] = p_args[j];
 				}
-				args_mem[source_index] = &source;
+				append_source_args[source_index] = &source;
 				for (int j = source_index; j < p_argcount; j++) {
-					args_mem[j + 1] = p_args[j];
+					append_source_args[j + 1] = p_args[j];
 				}
 
-				args = args_mem;
+				args = append_source_args;
 				argc = p_argcount + 1;
 			} else {
 				// More args unbound than provided, call will fail.
@@ -1385,7 +1504,10 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 			Callable::CallError ce;
 			_emitting = true;
 			Variant ret;
-			callable.callp(args, argc, ret, ce);
+			{
+				MethodCallCache::Scope call_cache_scope(slot.call_cache);
+				callable.callp(args, argc, ret, ce);
+			}
 			_emitting = false;
 
 			if (ce.error != Callable::CallError::CALL_OK) {
@@ -1409,14 +1531,7 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		}
 	}
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		slot_callables[i].~Callable();
-	}
-
-	if (slot_callables != (Callable *)slot_callable_stack) {
-		memfree(slot_callables);
-		memfree(slot_flags);
-	}
+	SignalData::unref_emit_slots(emit_slots);
 
 	if (pending_unref) {
 		// We have to do the same Ref<T> would do. We can't just use Ref<T>
@@ -1466,8 +1581,9 @@ void Object::_add_user_signal(const String &p_name, const Array &p_args) {
 
 	add_user_signal(mi);
 
-	if (signal_map.has(p_name)) {
-		signal_map.getptr(p_name)->removable = true;
+	SignalData *s = _get_signal_data(p_name);
+	if (s) {
+		s->removable = true;
 	}
 }
 
@@ -1533,10 +1649,10 @@ void Object::get_signal_list(List<MethodInfo> *p_signals) const {
 	ClassDB::get_signal_list(get_class_name(), p_signals);
 	//find maybe usersignals?
 
-	for (const KeyValue<StringName, SignalData> &E : signal_map) {
-		if (!E.value.user.name.is_empty()) {
+	for (const SignalEntry &entry : signal_table) {
+		if (!entry.data->user.name.is_empty()) {
 			//user signal
-			p_signals->push_back(E.value.user);
+			p_signals->push_back(entry.data->user);
 		}
 	}
 }
@@ -1544,10 +1660,8 @@ void Object::get_signal_list(List<MethodInfo> *p_signals) const {
 void Object::get_all_signal_connections(List<Connection> *p_connections) const {
 	OBJ_SIGNAL_LOCK
 
-	for (const KeyValue<StringName, SignalData> &E : signal_map) {
-		const SignalData *s = &E.value;
-
-		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
+	for (const SignalEntry &entry : signal_table) {
+		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : entry.data->slot_map) {
 			p_connections->push_back(slot_kv.value.conn);
 		}
 	}
@@ -1556,7 +1670,7 @@ void Object::get_all_signal_connections(List<Connection> *p_connections) const {
 void Object::get_signal_connection_list(const StringName &p_signal, List<Connection> *p_connections) const {
 	OBJ_SIGNAL_LOCK
 
-	const SignalData *s = signal_map.getptr(p_signal);
+	const SignalData *s = _get_signal_data(p_signal);
 	if (!s) {
 		return; //nothing
 	}
@@ -1570,10 +1684,8 @@ int Object::get_persistent_signal_connection_count() const {
 	OBJ_SIGNAL_LOCK
 	int count = 0;
 
-	for (const KeyValue<StringName, SignalData> &E : signal_map) {
-		const SignalData *s = &E.value;
-
-		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
+	for (const SignalEntry &entry : signal_table) {
+		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : entry.data->slot_map) {
 			if (slot_kv.value.conn.flags & CONNECT_PERSIST) {
 				count += 1;
 			}
@@ -1585,7 +1697,7 @@ int Object::get_persistent_signal_connection_count() const {
 
 uint32_t Object::get_signal_connection_flags(const StringName &p_name, const Callable &p_callable) const {
 	OBJ_SIGNAL_LOCK
-	const SignalData *signal_data = signal_map.getptr(p_name);
+	const SignalData *signal_data = _get_signal_data(p_name);
 	if (signal_data) {
 		const SignalData::Slot *slot = signal_data->slot_map.getptr(p_callable);
 		if (slot) {
@@ -1616,7 +1728,7 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 		ERR_FAIL_COND_V_MSG(!p_callable.is_valid(), ERR_INVALID_PARAMETER, vformat("Cannot connect to '%s': the provided callable is not valid: '%s'.", p_signal, p_callable));
 	}
 
-	SignalData *s = signal_map.getptr(p_signal);
+	SignalData *s = _get_signal_data(p_signal);
 	if (!s) {
 		bool signal_is_valid = ClassDB::has_signal(get_class_name(), p_signal);
 		//check in script
@@ -1636,8 +1748,7 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 		ERR_FAIL_COND_V_MSG(!signal_is_valid, ERR_INVALID_PARAMETER, vformat("In Object of type '%s': Attempt to connect nonexistent signal '%s' to callable '%s'.", String(get_class()), p_signal, p_callable));
 
-		signal_map[p_signal] = SignalData();
-		s = &signal_map[p_signal];
+		s = _add_signal_data(p_signal);
 	}
 
 	//compare with the base callable, so binds can be ignored
@@ -1668,6 +1779,7 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
+	s->clear_emit_slots();
 
 	return OK;
 }
@@ -1676,7 +1788,7 @@ bool Object::is_connected(const StringName &p_signal, const Callable &p_callable
 	ERR_FAIL_COND_V_MSG(p_callable.is_null(), false, vformat("Cannot determine if connected to '%s': the provided callable is null.", p_signal)); // Should use `is_null`, see note in `connect` about the use of `is_valid`.
 	OBJ_SIGNAL_LOCK
 
-	const SignalData *s = signal_map.getptr(p_signal);
+	const SignalData *s = _get_signal_data(p_signal);
 	if (!s) {
 		bool signal_is_valid = ClassDB::has_signal(get_class_name(), p_signal);
 		if (signal_is_valid) {
@@ -1696,7 +1808,7 @@ bool Object::is_connected(const StringName &p_signal, const Callable &p_callable
 bool Object::has_connections(const StringName &p_signal) const {
 	OBJ_SIGNAL_LOCK
 
-	const SignalData *s = signal_map.getptr(p_signal);
+	const SignalData *s = _get_signal_data(p_signal);
 	if (!s) {
 		bool signal_is_valid = ClassDB::has_signal(get_class_name(), p_signal);
 		if (signal_is_valid) {
@@ -1721,7 +1833,7 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	ERR_FAIL_COND_V_MSG(p_callable.is_null(), false, vformat("Cannot disconnect from '%s': the provided callable is null.", p_signal)); // Should use `is_null`, see note in `connect` about the use of `is_valid`.
 	OBJ_SIGNAL_LOCK
 
-	SignalData *s = signal_map.getptr(p_signal);
+	SignalData *s = _get_signal_data(p_signal);
 	if (!s) {
 		bool signal_is_valid = ClassDB::has_signal(get_class_name(), p_signal) ||
 				(script_instance && script_instance->get_script()->has_script_signal(p_signal));
@@ -1748,10 +1860,11 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	}
 
 	s->slot_map.erase(*p_callable.get_base_comparator());
+	s->clear_emit_slots();
 
 	if (s->slot_map.is_empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
 		//not user signal, delete
-		signal_map.erase(p_signal);
+		_remove_signal_data(p_signal);
 	}
 
 	return true;
@@ -2425,20 +2538,16 @@ Object::~Object() {
 	{
 		OBJ_SIGNAL_LOCK
 		// Drop all connections to the signals of this object.
-		while (signal_map.size()) {
-			// Avoid regular iteration so erasing is safe.
-			KeyValue<StringName, SignalData> &E = *signal_map.begin();
-			SignalData *s = &E.value;
-
-			for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
+		for (const SignalEntry &entry : signal_table) {
+			for (const KeyValue<Callable, SignalData::Slot> &slot_kv : entry.data->slot_map) {
 				Object *target = slot_kv.value.conn.callable.get_object();
 				if (likely(target)) {
 					target->connections.erase(slot_kv.value.cE);
 				}
 			}
-
-			signal_map.erase(E.key);
+			memdelete(entry.data);
 		}
+		signal_table.clear();
 
 		// Disconnect signals that connect to this object.
 		while (connections.size()) {
@@ -2488,8 +2597,9 @@ void ObjectDB::debug_objects(DebugFunc p_func, void *p_user_data) {
 	spin_lock.lock();
 
 	for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-		if (object_slots[i].validator) {
-			p_func(object_slots[i].object, p_user_data);
+		const ObjectSlot &object_slot = _get_slot(i);
+		if (object_slot.data.load(std::memory_order_relaxed) & OBJECTDB_VALIDATOR_MASK) {
+			p_func(object_slot.object.load(std::memory_order_relaxed), p_user_data);
 			count--;
 		}
 	}
@@ -2544,8 +2654,8 @@ void Object::get_argument_options(const StringName &p_function, int p_idx, List<
 
 SpinLock ObjectDB::spin_lock;
 uint32_t ObjectDB::slot_count = 0;
-uint32_t ObjectDB::slot_max = 0;
-ObjectDB::ObjectSlot *ObjectDB::object_slots = nullptr;
+std::atomic<uint32_t> ObjectDB::slot_max{ 0 };
+ObjectDB::ObjectSlot *ObjectDB::slot_blocks[OBJECTDB_SLOT_MAX_BLOCKS] = {};
 uint64_t ObjectDB::validator_counter = 0;
 
 int ObjectDB::get_object_count() {
@@ -2554,32 +2664,42 @@ int ObjectDB::get_object_count() {
 
 ObjectID ObjectDB::add_instance(Object *p_object) {
 	spin_lock.lock();
-	if (unlikely(slot_count == slot_max)) {
+	uint32_t current_slot_max = slot_max.load(std::memory_order_relaxed);
+	if (unlikely(slot_count == current_slot_max)) {
 		CRASH_COND(slot_count == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS));
 
-		uint32_t new_slot_max = slot_max > 0 ? slot_max * 2 : 1;
-		object_slots = (ObjectSlot *)memrealloc(object_slots, sizeof(ObjectSlot) * new_slot_max);
-		for (uint32_t i = slot_max; i < new_slot_max; i++) {
-			object_slots[i].object = nullptr;
-			object_slots[i].is_ref_counted = false;
-			object_slots[i].next_free = i;
-			object_slots[i].validator = 0;
+		// Add a block rather than growing, so lookups never see slots move.
+		ObjectSlot *block = (ObjectSlot *)memalloc(sizeof(ObjectSlot) * OBJECTDB_SLOT_BLOCK_SIZE);
+		for (uint32_t i = 0; i < OBJECTDB_SLOT_BLOCK_SIZE; i++) {
+			// Free slots past the count hold the free list, which starts as every new slot.
+			memnew_placement(&block[i].data, std::atomic<uint64_t>(uint64_t(current_slot_max + i) << OBJECTDB_SLOT_NEXT_FREE_SHIFT));
+			memnew_placement(&block[i].object, std::atomic<Object *>(nullptr));
 		}
-		slot_max = new_slot_max;
+		slot_blocks[current_slot_max >> OBJECTDB_SLOT_BLOCK_BITS] = block;
+		current_slot_max += OBJECTDB_SLOT_BLOCK_SIZE;
+		slot_max.store(current_slot_max, std::memory_order_release);
 	}
 
-	uint32_t slot = object_slots[slot_count].next_free;
-	if (object_slots[slot].object != nullptr) {
+	ObjectSlot &free_slot = _get_slot(slot_count);
+	uint32_t slot = (free_slot.data.load(std::memory_order_relaxed) >> OBJECTDB_SLOT_NEXT_FREE_SHIFT) & OBJECTDB_SLOT_MAX_COUNT_MASK;
+	ObjectSlot &object_slot = _get_slot(slot);
+	if (object_slot.object.load(std::memory_order_relaxed) != nullptr) {
 		spin_lock.unlock();
-		ERR_FAIL_COND_V(object_slots[slot].object != nullptr, ObjectID());
+		ERR_FAIL_COND_V(object_slot.object.load(std::memory_order_relaxed) != nullptr, ObjectID());
 	}
-	object_slots[slot].object = p_object;
-	object_slots[slot].is_ref_counted = p_object->is_ref_counted();
 	validator_counter = (validator_counter + 1) & OBJECTDB_VALIDATOR_MASK;
 	if (unlikely(validator_counter == 0)) {
 		validator_counter = 1;
 	}
-	object_slots[slot].validator = validator_counter;
+
+	uint64_t data = object_slot.data.load(std::memory_order_relaxed) & ~(OBJECTDB_VALIDATOR_MASK | OBJECTDB_SLOT_REF_COUNTED_BIT);
+	data |= validator_counter;
+	if (p_object->is_ref_counted()) {
+		data |= OBJECTDB_SLOT_REF_COUNTED_BIT;
+	}
+	// The object has to be visible before the validator that makes lookups return it.
+	object_slot.object.store(p_object, std::memory_order_release);
+	object_slot.data.store(data, std::memory_order_release);
 
 	uint64_t id = validator_counter;
 	id <<= OBJECTDB_SLOT_MAX_COUNT_BITS;
@@ -2602,17 +2722,19 @@ void ObjectDB::remove_instance(Object *p_object) {
 
 	spin_lock.lock();
 
+	ObjectSlot &object_slot = _get_slot(slot);
+
 #ifdef DEBUG_ENABLED
 
-	if (object_slots[slot].object != p_object) {
+	if (object_slot.object.load(std::memory_order_relaxed) != p_object) {
 		spin_lock.unlock();
-		ERR_FAIL_COND(object_slots[slot].object != p_object);
+		ERR_FAIL_COND(object_slot.object.load(std::memory_order_relaxed) != p_object);
 	}
 	{
 		uint64_t validator = (t >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
-		if (object_slots[slot].validator != validator) {
+		if ((object_slot.data.load(std::memory_order_relaxed) & OBJECTDB_VALIDATOR_MASK) != validator) {
 			spin_lock.unlock();
-			ERR_FAIL_COND(object_slots[slot].validator != validator);
+			ERR_FAIL_COND((object_slot.data.load(std::memory_order_relaxed) & OBJECTDB_VALIDATOR_MASK) != validator);
 		}
 	}
 
@@ -2620,11 +2742,13 @@ void ObjectDB::remove_instance(Object *p_object) {
 	//decrease slot count
 	slot_count--;
 	//set the free slot properly
-	object_slots[slot_count].next_free = slot;
+	ObjectSlot &free_slot = _get_slot(slot_count);
+	uint64_t free_data = free_slot.data.load(std::memory_order_relaxed) & ~(OBJECTDB_SLOT_MAX_COUNT_MASK << OBJECTDB_SLOT_NEXT_FREE_SHIFT);
+	free_slot.data.store(free_data | (uint64_t(slot) << OBJECTDB_SLOT_NEXT_FREE_SHIFT), std::memory_order_relaxed);
 	//invalidate, so checks against it fail
-	object_slots[slot].validator = 0;
-	object_slots[slot].is_ref_counted = false;
-	object_slots[slot].object = nullptr;
+	uint64_t data = object_slot.data.load(std::memory_order_relaxed) & ~(OBJECTDB_VALIDATOR_MASK | OBJECTDB_SLOT_REF_COUNTED_BIT);
+	object_slot.data.store(data, std::memory_order_relaxed);
+	object_slot.object.store(nullptr, std::memory_order_relaxed);
 
 	spin_lock.unlock();
 }
@@ -2647,8 +2771,10 @@ void ObjectDB::cleanup() {
 			Callable::CallError call_error;
 
 			for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-				if (object_slots[i].validator) {
-					Object *obj = object_slots[i].object;
+				const ObjectSlot &object_slot = _get_slot(i);
+				const uint64_t data = object_slot.data.load(std::memory_order_relaxed);
+				if (data & OBJECTDB_VALIDATOR_MASK) {
+					Object *obj = object_slot.object.load(std::memory_order_relaxed);
 
 					String extra_info;
 					if (obj->is_class("Node")) {
@@ -2661,7 +2787,7 @@ void ObjectDB::cleanup() {
 						extra_info = " - Reference count: " + itos((static_cast<RefCounted *>(obj))->get_reference_count());
 					}
 
-					uint64_t id = uint64_t(i) | (uint64_t(object_slots[i].validator) << OBJECTDB_SLOT_MAX_COUNT_BITS) | (object_slots[i].is_ref_counted ? OBJECTDB_REFERENCE_BIT : 0);
+					uint64_t id = uint64_t(i) | ((data & OBJECTDB_VALIDATOR_MASK) << OBJECTDB_SLOT_MAX_COUNT_BITS) | ((data & OBJECTDB_SLOT_REF_COUNTED_BIT) ? OBJECTDB_REFERENCE_BIT : 0);
 					DEV_ASSERT(id == (uint64_t)obj->get_instance_id()); // We could just use the id from the object, but this check may help catching memory corruption catastrophes.
 					print_line("Leaked instance: " + String(obj->get_class()) + ":" + uitos(id) + extra_info);
 
@@ -2672,9 +2798,11 @@ void ObjectDB::cleanup() {
 		}
 	}
 
-	if (object_slots) {
-		memfree(object_slots);
+	for (uint32_t i = 0; i < slot_max; i += OBJECTDB_SLOT_BLOCK_SIZE) {
+		memfree(slot_blocks[i >> OBJECTDB_SLOT_BLOCK_BITS]);
+		slot_blocks[i >> OBJECTDB_SLOT_BLOCK_BITS] = nullptr;
 	}
+	slot_max = 0;
 
 	spin_lock.unlock();
 }
@@ -38,6 +38,7 @@
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
@@ -566,6 +567,57 @@ private:
 class ClassDB;
 class ScriptInstance;
 
+// Remembers which MethodBind a method name resolved to on the last few classes it was
+// called on. Places that make the same dynamic call over and over (signal connections,
+// untyped script calls) keep one, and make it current with a Scope around callp(), so
+// Object::callp() can skip the ClassDB lookup. Script methods are still resolved by the
+// script instance.
+class MethodCallCache {
+	static constexpr uint32_t ENTRY_COUNT = 2;
+
+	struct Entry {
+		std::atomic<const void *> class_name = { nullptr };
+		std::atomic<const void *> method_name = { nullptr };
+		std::atomic<MethodBind *> method = { nullptr };
+	};
+
+	// Bumped whenever methods are bound or classes unregistered, invalidating every cache.
+	static inline SafeNumeric<uint32_t> global_version{ 1 };
+	static thread_local MethodCallCache *current;
+
+	// Odd while a thread is updating the entries.
+	std::atomic<uint32_t> sequence = { 0 };
+	std::atomic<uint32_t> version = { 0 };
+	uint32_t next_entry = 0;
+	Entry entries[ENTRY_COUNT];
+
+	friend class Object;
+	MethodBind *get_method(const StringName &p_class, const StringName &p_method);
+
+public:
+	class Scope {
+		MethodCallCache *previous = nullptr;
+
+	public:
+		_FORCE_INLINE_ Scope(MethodCallCache &p_cache) {
+			previous = current;
+			current = &p_cache;
+		}
+		_FORCE_INLINE_ ~Scope() {
+			current = previous;
+		}
+	};
+
+	static void invalidate_all() { global_version.increment(); }
+
+	// Whether entries were added since the cache was created or copied.
+	bool is_updated() const { return sequence.load(std::memory_order_relaxed) != 0; }
+
+	MethodCallCache &operator=(const MethodCallCache &p_other);
+	MethodCallCache(const MethodCallCache &p_other) { operator=(p_other); }
+	MethodCallCache() {}
+};
+
 class Object {
 public:
 	typedef Object self_type;
@@ -634,13 +686,45 @@ private:
 			List<Connection>::Element *cE = nullptr;
 		};
 
+		// What emitting needs from each slot, in connection order. Emissions share
+		// the array and it's only rebuilt after the connections change, so emitting
+		// neither allocates nor copies the callables.
+		struct EmitSlot {
+			Callable callable;
+			uint32_t flags = 0;
+			MethodCallCache call_cache;
+		};
+		struct EmitSlots {
+			SafeRefCount refcount;
+			LocalVector<EmitSlot> slots;
+			bool has_one_shot = false;
+		};
+
 		MethodInfo user;
 		HashMap<Callable, Slot> slot_map;
+		EmitSlots *emit_slots = nullptr;
 		bool removable = false;
+
+		EmitSlots *ref_emit_slots();
+		static void unref_emit_slots(EmitSlots *p_emit_slots);
+		void clear_emit_slots();
+
+		SignalData() {}
+		SignalData(const SignalData &) = delete;
+		~SignalData() { clear_emit_slots(); }
 	};
 	friend struct _ObjectSignalLock;
 	mutable Mutex *signal_mutex = nullptr;
-	HashMap<StringName, SignalData> signal_map;
+	// Most objects have few signals with connections, so they're kept in a small
+	// table searched linearly rather than in a hash map.
+	struct SignalEntry {
+		StringName name;
+		SignalData *data = nullptr;
+	};
+	LocalVector<SignalEntry> signal_table;
+	SignalData *_get_signal_data(const StringName &p_name) const;
+	SignalData *_add_signal_data(const StringName &p_name);
+	void _remove_signal_data(const StringName &p_name);
 	List<Connection> connections;
 #ifdef DEBUG_ENABLED
 	SafeRefCount _lock_index;
@@ -1077,19 +1161,32 @@ class ObjectDB {
 #define OBJECTDB_SLOT_MAX_COUNT_MASK ((uint64_t(1) << OBJECTDB_SLOT_MAX_COUNT_BITS) - 1)
 #define OBJECTDB_REFERENCE_BIT (uint64_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS + OBJECTDB_VALIDATOR_BITS))
 
+#define OBJECTDB_SLOT_BLOCK_BITS 12
+#define OBJECTDB_SLOT_BLOCK_SIZE (1 << OBJECTDB_SLOT_BLOCK_BITS)
+#define OBJECTDB_SLOT_BLOCK_MASK (OBJECTDB_SLOT_BLOCK_SIZE - 1)
+#define OBJECTDB_SLOT_MAX_BLOCKS (1 << (OBJECTDB_SLOT_MAX_COUNT_BITS - OBJECTDB_SLOT_BLOCK_BITS))
+#define OBJECTDB_SLOT_NEXT_FREE_SHIFT OBJECTDB_VALIDATOR_BITS
+#define OBJECTDB_SLOT_REF_COUNTED_BIT (uint64_t(1) << (OBJECTDB_VALIDATOR_BITS + OBJECTDB_SLOT_MAX_COUNT_BITS))
+
+	// Lookups don't lock. Slots are allocated in blocks that never move, and a lookup only
+	// returns the object if the slot still has the validator of the ID after reading it.
+	// Slots are only written while holding `spin_lock`.
 	struct ObjectSlot { // 128 bits per slot.
-		uint64_t validator : OBJECTDB_VALIDATOR_BITS;
-		uint64_t next_free : OBJECTDB_SLOT_MAX_COUNT_BITS;
-		uint64_t is_ref_counted : 1;
-		Object *object = nullptr;
+		// Validator, next free slot and whether the object is ref counted.
+		std::atomic<uint64_t> data;
+		std::atomic<Object *> object;
 	};
 
 	static SpinLock spin_lock;
 	static uint32_t slot_count;
-	static uint32_t slot_max;
-	static ObjectSlot *object_slots;
+	static std::atomic<uint32_t> slot_max;
+	static ObjectSlot *slot_blocks[OBJECTDB_SLOT_MAX_BLOCKS];
 	static uint64_t validator_counter;
 
+	_ALWAYS_INLINE_ static ObjectSlot &_get_slot(uint32_t p_slot) {
+		return slot_blocks[p_slot >> OBJECTDB_SLOT_BLOCK_BITS][p_slot & OBJECTDB_SLOT_BLOCK_MASK];
+	}
+
 	friend class Object;
 	friend void unregister_core_types();
 	static void cleanup();
@@ -1107,20 +1204,27 @@ public:
 		uint64_t id = p_instance_id;
 		uint32_t slot = id & OBJECTDB_SLOT_MAX_COUNT_MASK;
 
-		ERR_FAIL_COND_V(slot >= slot_max, nullptr); // This should never happen unless RID is corrupted.
+		uint64_t validator = (id >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
 
-		spin_lock.lock();
+		if (unlikely(validator == 0)) {
+			return nullptr; // Null ID, free slots have no validator.
+		}
 
-		uint64_t validator = (id >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
+		ERR_FAIL_COND_V(slot >= slot_max.load(std::memory_order_acquire), nullptr); // This should never happen unless RID is corrupted.
 
-		if (unlikely(object_slots[slot].validator != validator)) {
-			spin_lock.unlock();
+		const ObjectSlot &object_slot = _get_slot(slot);
+
+		if (unlikely((object_slot.data.load(std::memory_order_acquire) & OBJECTDB_VALIDATOR_MASK) != validator)) {
 			return nullptr;
 		}
 
-		Object *object = object_slots[slot].object;
+		Object *object = object_slot.object.load(std::memory_order_relaxed);
 
-		spin_lock.unlock();
+		// If the slot was freed or reused meanwhile, the validator changed too.
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (unlikely((object_slot.data.load(std::memory_order_relaxed) & OBJECTDB_VALIDATOR_MASK) != validator)) {
+			return nullptr;
+		}
 
 		return object;
 	}
@@ -87,6 +87,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 #ifdef THREADS_ENABLED
 	bool low_priority = p_task->low_priority;
 #endif
+	Dependents ready_dependents;
 
 	if (p_task->group) {
 		// Handling a group
@@ -119,8 +120,12 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		}
 
 		if (do_post) {
+			// The lock orders completion against dependents being registered.
+			MutexLock task_lock(task_mutex);
+			_release_dependents(p_task->group->dependents, ready_dependents);
 			p_task->group->done_semaphore.post();
 			p_task->group->completed.set_to(true);
+			_post_dependents(ready_dependents, task_lock);
 		}
 		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = p_task->group->finished.increment();
@@ -148,6 +153,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		task_mutex.lock();
 		p_task->completed = true;
 		p_task->pool_thread_index = -1;
+		_release_dependents(p_task->dependents, ready_dependents);
 		if (p_task->waiting_user) {
 			p_task->done_semaphore.post(p_task->waiting_user);
 		}
@@ -179,6 +185,11 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 	set_current_thread_safe_for_nodes(safe_for_nodes_backup);
 	MessageQueue::set_thread_singleton_override(call_queue_backup);
 #endif
+
+	if (!ready_dependents.tasks.is_empty() || !ready_dependents.groups.is_empty()) {
+		MutexLock task_lock(task_mutex);
+		_post_dependents(ready_dependents, task_lock);
+	}
 }
 
 void WorkerThreadPool::_thread_function(void *p_user) {
@@ -186,8 +197,9 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 	Thread::set_name(vformat("WorkerThread %d", thread_data->index));
 
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		// Tasks posted by pool threads can be picked up without locking.
+		Task *task_to_process = thread_data->pool->_take_or_steal_task(thread_data);
+		if (!task_to_process) {
 			// Create the lock outside the inner loop so it isn't needlessly unlocked and relocked
 			//  when no task was found to process, and the loop is re-entered.
 			MutexLock lock(thread_data->pool->task_mutex);
@@ -201,6 +213,11 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 				thread_data->signaled = false;
 
 				if (!thread_data->pool->task_queue.first()) {
+					if (thread_data->pool->_has_stealable_tasks()) {
+						// Lost the race against other thieves, but there is still work around.
+						break;
+					}
+
 					// There wasn't a task available yet.
 					// Let's wait for the next notification, then recheck.
 					thread_data->cond_var.wait(lock);
@@ -214,8 +231,9 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 			}
 		}
 
-		DEV_ASSERT(task_to_process);
-		thread_data->pool->_process_task(task_to_process);
+		if (task_to_process) {
+			thread_data->pool->_process_task(task_to_process);
+		}
 	}
 }
 
@@ -246,7 +264,11 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
-		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
+		if (p_high_priority && caller_pool_thread && !p_pump_task && caller_pool_thread->work_queue.push(p_tasks[i])) {
+			// Posted from a pool thread, keep it local. It will either be taken by this thread
+			// (e.g., while waiting for it) or stolen by an idle one.
+			to_process++;
+		} else if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
 			task_queue.add_last(&p_tasks[i]->task_elem);
 			if (!p_high_priority) {
 				low_priority_threads_used++;
@@ -326,6 +348,53 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 	}
 }
 
+WorkerThreadPool::Task *WorkerThreadPool::_take_or_steal_task(ThreadData *p_thread_data) {
+	Task *task = nullptr;
+	if (unlikely(_is_task_queue_poll_due(p_thread_data))) {
+		p_thread_data->work_queue_tasks_taken = 0;
+		MutexLock lock(task_mutex);
+		if (task_queue.first()) {
+			task = task_queue.first()->self();
+			task_queue.remove(task_queue.first());
+			return task;
+		}
+	}
+
+	// The most recently posted local task is the most likely to still be hot in the cache.
+	if (p_thread_data->work_queue.take(task)) {
+		p_thread_data->work_queue_tasks_taken++;
+		return task;
+	}
+	task = _steal_task(p_thread_data);
+	if (task) {
+		p_thread_data->work_queue_tasks_taken++;
+	}
+	return task;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_steal_task(ThreadData *p_thread_data) {
+	uint32_t thread_count = stealable_thread_count.load(std::memory_order_acquire);
+	Task *task = nullptr;
+	// Start from the next thread, so thieves don't all go after the same victim.
+	for (uint32_t i = 1; i < thread_count; i++) {
+		ThreadData &victim = threads[(p_thread_data->index + i) % thread_count];
+		if (victim.work_queue.steal(task)) {
+			return task;
+		}
+	}
+	return nullptr;
+}
+
+bool WorkerThreadPool::_has_stealable_tasks() const {
+	uint32_t thread_count = stealable_thread_count.load(std::memory_order_acquire);
+	for (uint32_t i = 0; i < thread_count; i++) {
+		if (!threads[i].work_queue.is_empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
@@ -338,11 +407,81 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	}
 }
 
+// Returns how many of the dependencies haven't finished yet, registering either p_task or p_group as their dependent.
+uint32_t WorkerThreadPool::_register_dependencies(Span<TaskID> p_dependencies, Task *p_task, Group *p_group) {
+	uint32_t unfinished = 0;
+	for (TaskID id : p_dependencies) {
+		Dependents *dependents = nullptr;
+		Task **taskp = tasks.getptr(id);
+		if (taskp) {
+			if (!(*taskp)->completed) {
+				dependents = &(*taskp)->dependents;
+			}
+		} else {
+			Group **groupp = groups.getptr(id);
+			if (groupp && !(*groupp)->completed.is_set()) {
+				dependents = &(*groupp)->dependents;
+			}
+		}
+		// Otherwise, it's either finished or already waited for.
+		if (dependents) {
+			if (p_task) {
+				dependents->tasks.push_back(p_task);
+			} else {
+				dependents->groups.push_back(p_group);
+			}
+			unfinished++;
+		}
+	}
+	return unfinished;
+}
+
+// Must be called with the task mutex locked, once the owner of p_dependents has finished.
+void WorkerThreadPool::_release_dependents(Dependents &p_dependents, Dependents &r_ready) {
+	for (Task *task : p_dependents.tasks) {
+		if (--task->unfinished_dependencies == 0) {
+			r_ready.tasks.push_back(task);
+		}
+	}
+	for (Group *group : p_dependents.groups) {
+		if (--group->unfinished_dependencies == 0) {
+			if (group->held_tasks.is_empty()) {
+				// Nothing to process, so it's done as soon as its dependencies are.
+				_release_dependents(group->dependents, r_ready);
+				group->done_semaphore.post();
+				group->completed.set_to(true);
+			} else {
+				r_ready.groups.push_back(group);
+			}
+		}
+	}
+	p_dependents.tasks.clear();
+	p_dependents.groups.clear();
+}
+
+void WorkerThreadPool::_post_dependents(Dependents &p_ready, MutexLock<BinaryMutex> &p_lock) {
+	for (Task *task : p_ready.tasks) {
+		_post_tasks(&task, 1, !task->low_priority, p_lock, false);
+	}
+	for (Group *group : p_ready.groups) {
+		// Posting may process the tasks right away, so the group can't be relied on afterwards.
+		LocalVector<Task *> group_tasks = std::move(group->held_tasks);
+		_post_tasks(group_tasks.ptr(), group_tasks.size(), group->held_high_priority, p_lock, false);
+	}
+	p_ready.tasks.clear();
+	p_ready.groups.clear();
+}
+
 WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task) {
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task_with_dependencies(void (*p_func)(void *), void *p_userdata, Span<TaskID> p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, false, p_dependencies);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task, Span<TaskID> p_dependencies) {
+	ERR_FAIL_COND_V_MSG(p_pump_task && !p_dependencies.is_empty(), INVALID_TASK_ID, "Pump tasks can't have dependencies.");
 	MutexLock<BinaryMutex> lock(task_mutex);
 
 	// Get a free task
@@ -369,12 +508,20 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 			threads.resize_initialized(thread_count + 1);
 			threads[thread_count].index = thread_count;
 			threads[thread_count].pool = this;
+			stealable_thread_count.store(thread_count + 1, std::memory_order_release);
 			threads[thread_count].thread.start(&WorkerThreadPool::_thread_function, &threads[thread_count]);
 			thread_ids.insert(threads[thread_count].thread.get_id(), thread_count);
 		}
 	}
 #endif
 
+	task->unfinished_dependencies = _register_dependencies(p_dependencies, task, nullptr);
+	if (task->unfinished_dependencies) {
+		// Posted by whatever finishes last.
+		task->low_priority = !p_high_priority;
+		return id;
+	}
+
 	_post_tasks(&task, 1, p_high_priority, lock, p_pump_task);
 
 	return id;
@@ -388,6 +535,10 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_task_bind(const Callable &p_actio
 	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, false);
 }
 
+WorkerThreadPool::TaskID WorkerThreadPool::add_task_with_dependencies(const Callable &p_action, const PackedInt64Array &p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, false, p_dependencies.span());
+}
+
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 	MutexLock task_lock(task_mutex);
 	const Task *const *taskp = tasks.getptr(p_task_id);
@@ -516,7 +667,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = (task_queue.first() || !p_caller_pool_thread->work_queue.is_empty()) ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -534,7 +685,16 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
-			if (p_caller_pool_thread->pool->task_queue.first()) {
+			// Local tasks first, since what is being awaited was likely posted by this thread.
+			// Those are never pump tasks. Every so often the global queue goes first, though.
+			const bool poll_task_queue = _is_task_queue_poll_due(p_caller_pool_thread) && task_queue.first();
+			if (poll_task_queue) {
+				p_caller_pool_thread->work_queue_tasks_taken = 0;
+			} else if (p_caller_pool_thread->work_queue.take(task_to_process)) {
+				p_caller_pool_thread->work_queue_tasks_taken++;
+			}
+
+			if (!task_to_process && p_caller_pool_thread->pool->task_queue.first()) {
 				task_to_process = task_queue.first()->self();
 				if ((p_task == ThreadData::YIELDING || p_caller_pool_thread->has_pump_task == true) && task_to_process->is_pump_task) {
 					task_to_process = nullptr;
@@ -544,7 +704,18 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
+			if (!task_to_process && poll_task_queue && p_caller_pool_thread->work_queue.take(task_to_process)) {
+				p_caller_pool_thread->work_queue_tasks_taken++;
+			}
+
 			if (!task_to_process) {
+				task_to_process = _steal_task(p_caller_pool_thread);
+				if (task_to_process) {
+					p_caller_pool_thread->work_queue_tasks_taken++;
+				}
+			}
+
+			if (!task_to_process && !_has_stealable_tasks()) {
 				p_caller_pool_thread->awaited_task = p_task;
 
 				if (this == singleton) {
@@ -587,7 +758,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!task_queue.first() && !low_priority_task_queue.first() && !_has_stealable_tasks()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -650,7 +821,7 @@ void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 	td.cond_var.notify_one();
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, Span<TaskID> p_dependencies) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
 		p_tasks = MAX(1u, threads.size());
@@ -662,12 +833,16 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 	GroupID id = last_task++;
 	group->max = p_elements;
 	group->self = id;
+	group->unfinished_dependencies = _register_dependencies(p_dependencies, nullptr, group);
 
 	Task **tasks_posted = nullptr;
 	if (p_elements == 0) {
 		// Should really not call it with zero Elements, but at least it should work.
-		group->completed.set_to(true);
-		group->done_semaphore.post();
+		// With dependencies, it's completed as soon as they are, which makes it useful for joining them.
+		if (!group->unfinished_dependencies) {
+			group->completed.set_to(true);
+			group->done_semaphore.post();
+		}
 		group->tasks_used = 0;
 		p_tasks = 0;
 		if (p_template_userdata) {
@@ -692,6 +867,16 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 
 	groups[id] = group;
 
+	if (group->unfinished_dependencies) {
+		// Posted by whatever finishes last.
+		group->held_tasks.resize(p_tasks);
+		for (int i = 0; i < p_tasks; i++) {
+			group->held_tasks[i] = tasks_posted[i];
+		}
+		group->held_high_priority = p_high_priority;
+		return id;
+	}
+
 	_post_tasks(tasks_posted, p_tasks, p_high_priority, lock, false);
 
 	return id;
@@ -705,6 +890,123 @@ WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_act
 	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description);
 }
 
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task_with_dependencies(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, Span<TaskID> p_dependencies, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
+WorkerThreadPool::GroupID WorkerThreadPool::add_group_task_with_dependencies(const Callable &p_action, int p_elements, const PackedInt64Array &p_dependencies, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies.span());
+}
+
+static _FORCE_INLINE_ uint64_t _pack_range(uint32_t p_from, uint32_t p_to) {
+	return ((uint64_t)p_to << 32) | p_from;
+}
+
+bool WorkerThreadPool::_parallel_for_take(ParallelFor::Partition &p_partition, uint32_t p_grain, uint32_t &r_from, uint32_t &r_to) {
+	uint64_t range = p_partition.range.load(std::memory_order_acquire);
+	while (true) {
+		uint32_t from = range & 0xFFFFFFFF;
+		uint32_t to = range >> 32;
+		if (from >= to) {
+			return false;
+		}
+		// Big chunks first to keep the overhead low, smaller ones as the slice drains so the load
+		// can still be balanced at the end. What is left behind can be stolen.
+		uint32_t remaining = to - from;
+		uint32_t chunk = MIN(remaining, MAX(p_grain, remaining / 4));
+		if (p_partition.range.compare_exchange_weak(range, _pack_range(from + chunk, to), std::memory_order_acq_rel, std::memory_order_acquire)) {
+			r_from = from;
+			r_to = from + chunk;
+			return true;
+		}
+	}
+}
+
+bool WorkerThreadPool::_parallel_for_steal(ParallelFor *p_parallel_for, uint32_t p_participant) {
+	for (uint32_t i = 1; i < p_parallel_for->partition_count; i++) {
+		ParallelFor::Partition &victim = p_parallel_for->partitions[(p_participant + i) % p_parallel_for->partition_count];
+		uint64_t range = victim.range.load(std::memory_order_acquire);
+		while (true) {
+			uint32_t from = range & 0xFFFFFFFF;
+			uint32_t to = range >> 32;
+			if (from >= to) {
+				break;
+			}
+			uint32_t remaining = to - from;
+			uint32_t split = remaining > p_parallel_for->grain ? from + remaining / 2 : from;
+			if (victim.range.compare_exchange_weak(range, _pack_range(from, split), std::memory_order_acq_rel, std::memory_order_acquire)) {
+				// Nobody touches an empty partition, so the stolen range can be published as our own.
+				// This way it can be split further by others.
+				p_parallel_for->partitions[p_participant].range.store(_pack_range(split, to), std::memory_order_release);
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void WorkerThreadPool::_parallel_for_participate(ParallelFor *p_parallel_for, uint32_t p_participant) {
+	ParallelFor::Partition &partition = p_parallel_for->partitions[p_participant];
+	uint32_t from = 0;
+	uint32_t to = 0;
+	while (true) {
+		if (_parallel_for_take(partition, p_parallel_for->grain, from, to)) {
+			p_parallel_for->func(p_parallel_for->userdata, from, to, p_participant);
+		} else if (!_parallel_for_steal(p_parallel_for, p_participant)) {
+			break;
+		}
+	}
+}
+
+void WorkerThreadPool::_parallel_for_task(void *p_parallel_for, uint32_t p_index) {
+	ParallelFor *parallel_for = (ParallelFor *)p_parallel_for;
+	int thread_index = parallel_for->pool->get_thread_index();
+	// The last partition belongs to the calling thread. A thread started after the call has no
+	// partition, but there is no need for it to help.
+	if (thread_index >= 0 && (uint32_t)thread_index < parallel_for->partition_count - 1) {
+		_parallel_for_participate(parallel_for, thread_index);
+	}
+}
+
+void WorkerThreadPool::_parallel_for(uint32_t p_begin, uint32_t p_end, uint32_t p_grain, void (*p_func)(void *, uint32_t, uint32_t, uint32_t), void *p_userdata, bool p_high_priority, const String &p_description) {
+	if (p_end <= p_begin) {
+		return;
+	}
+
+	p_grain = MAX(p_grain, 1u);
+	uint32_t count = p_end - p_begin;
+	uint32_t partition_count = get_parallel_for_participant_count();
+	int caller_thread_index = get_thread_index();
+	uint32_t caller_participant = caller_thread_index >= 0 ? (uint32_t)caller_thread_index : partition_count - 1;
+
+	// Other pool threads that can help. If the caller is one of them, it's already taking part.
+	uint32_t task_count = MIN(threads.size() - (caller_thread_index >= 0 ? 1 : 0), count / p_grain);
+	if (task_count == 0) {
+		p_func(p_userdata, p_begin, p_end, caller_participant);
+		return;
+	}
+
+	ParallelFor parallel_for;
+	parallel_for.pool = this;
+	parallel_for.partitions = (ParallelFor::Partition *)alloca(sizeof(ParallelFor::Partition) * partition_count);
+	parallel_for.partition_count = partition_count;
+	parallel_for.grain = p_grain;
+	parallel_for.func = p_func;
+	parallel_for.userdata = p_userdata;
+
+	// Slices only depend on the range and the thread count, so each thread gets the same one every time.
+	for (uint32_t i = 0; i < partition_count; i++) {
+		uint32_t from = p_begin + (uint32_t)((uint64_t)count * i / partition_count);
+		uint32_t to = p_begin + (uint32_t)((uint64_t)count * (i + 1) / partition_count);
+		memnew_placement(&parallel_for.partitions[i], ParallelFor::Partition);
+		parallel_for.partitions[i].range.store(_pack_range(from, to), std::memory_order_relaxed);
+	}
+
+	GroupID group = _add_group_task(Callable(), &WorkerThreadPool::_parallel_for_task, &parallel_for, nullptr, task_count, task_count, p_high_priority, p_description);
+	_parallel_for_participate(&parallel_for, caller_participant);
+	wait_for_group_task_completion(group);
+}
+
 uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) const {
 	MutexLock task_lock(task_mutex);
 	const Group *const *groupp = groups.getptr(p_group);
@@ -742,6 +1044,12 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 			_lock_unlockable_mutexes();
 		}
 
+		{
+			// Erase it before it may be freed, so it can't be found as a dependency anymore.
+			MutexLock task_lock(task_mutex); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
+			groups.erase(p_group);
+		}
+
 		uint32_t max_users = group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = group->finished.increment(); // fetch happens before inc, so increment later.
 
@@ -751,9 +1059,6 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 			group_allocator.free(group);
 		}
 	}
-
-	MutexLock task_lock(task_mutex); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
-	groups.erase(p_group);
 #endif
 }
 
@@ -832,6 +1137,7 @@ void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio)
 		threads[i].thread.start(&WorkerThreadPool::_thread_function, &threads[i]);
 		thread_ids.insert(threads[i].thread.get_id(), i);
 	}
+	stealable_thread_count.store(threads.size(), std::memory_order_release);
 }
 
 void WorkerThreadPool::exit_languages_threads() {
@@ -873,6 +1179,7 @@ void WorkerThreadPool::finish() {
 	for (ThreadData &data : threads) {
 		data.thread.wait_to_finish();
 	}
+	stealable_thread_count.store(0, std::memory_order_release);
 
 	{
 		MutexLock lock(task_mutex);
@@ -889,12 +1196,14 @@ void WorkerThreadPool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_task_completed", "task_id"), &WorkerThreadPool::is_task_completed);
 	ClassDB::bind_method(D_METHOD("wait_for_task_completion", "task_id"), &WorkerThreadPool::wait_for_task_completion);
 	ClassDB::bind_method(D_METHOD("get_caller_task_id"), &WorkerThreadPool::get_caller_task_id);
+	ClassDB::bind_method(D_METHOD("add_task_with_dependencies", "action", "dependencies", "high_priority", "description"), &WorkerThreadPool::add_task_with_dependencies, DEFVAL(false), DEFVAL(String()));
 
 	ClassDB::bind_method(D_METHOD("add_group_task", "action", "elements", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_group_task_completed", "group_id"), &WorkerThreadPool::is_group_task_completed);
 	ClassDB::bind_method(D_METHOD("get_group_processed_element_count", "group_id"), &WorkerThreadPool::get_group_processed_element_count);
 	ClassDB::bind_method(D_METHOD("wait_for_group_task_completion", "group_id"), &WorkerThreadPool::wait_for_group_task_completion);
 	ClassDB::bind_method(D_METHOD("get_caller_group_id"), &WorkerThreadPool::get_caller_group_id);
+	ClassDB::bind_method(D_METHOD("add_group_task_with_dependencies", "action", "elements", "dependencies", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task_with_dependencies, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
 }
 
 WorkerThreadPool *WorkerThreadPool::get_named_pool(const StringName &p_name) {
@@ -40,6 +40,8 @@
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
+#include "core/templates/span.h"
+#include "core/templates/work_stealing_deque.h"
 
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
@@ -53,6 +55,7 @@ public:
 
 private:
 	struct Task;
+	struct Group;
 
 	struct BaseTemplateUserdata {
 		virtual void callback() {}
@@ -60,6 +63,12 @@ private:
 		virtual ~BaseTemplateUserdata() {}
 	};
 
+	// Tasks and groups that can't start until a given task or group has finished.
+	struct Dependents {
+		LocalVector<Task *> tasks;
+		LocalVector<Group *> groups;
+	};
+
 	struct Group {
 		GroupID self = -1;
 		SafeNumeric<uint32_t> index;
@@ -69,6 +78,10 @@ private:
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+		uint32_t unfinished_dependencies = 0;
+		Dependents dependents;
+		LocalVector<Task *> held_tasks; // Posted once there are no unfinished dependencies left.
+		bool held_high_priority = false;
 	};
 
 	struct Task {
@@ -89,6 +102,8 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		int pool_thread_index = -1;
+		uint32_t unfinished_dependencies = 0;
+		Dependents dependents;
 
 		void free_template_userdata();
 		Task() :
@@ -100,6 +115,9 @@ private:
 
 	static const uint32_t TASKS_PAGE_SIZE = 1024;
 	static const uint32_t GROUPS_PAGE_SIZE = 256;
+	// Tasks a pool thread takes from the work queues before checking the global queue first,
+	// so tasks posted from outside the pool aren't starved by pool threads posting more work.
+	static const uint32_t TASK_QUEUE_POLL_INTERVAL = 16;
 
 	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
@@ -123,6 +141,9 @@ private:
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
 		WorkerThreadPool *pool = nullptr;
+		// High-priority tasks posted by this thread. Other threads can steal from it without locking.
+		WorkStealingDeque<Task *> work_queue;
+		uint32_t work_queue_tasks_taken = 0; // Since the global queue was last checked first.
 
 		ThreadData() :
 				signaled(false),
@@ -133,6 +154,8 @@ private:
 	};
 
 	TightLocalVector<ThreadData> threads;
+	// Threads whose data is fully constructed, so their work queues can be stolen from without locking.
+	std::atomic<uint32_t> stealable_thread_count = 0;
 	enum Runlevel {
 		RUNLEVEL_NORMAL,
 		RUNLEVEL_PRE_EXIT_LANGUAGES, // Block adding new tasks
@@ -183,6 +206,15 @@ private:
 
 	bool _try_promote_low_priority_task();
 
+	Task *_take_or_steal_task(ThreadData *p_thread_data);
+	Task *_steal_task(ThreadData *p_thread_data);
+	_FORCE_INLINE_ bool _is_task_queue_poll_due(ThreadData *p_thread_data) const { return p_thread_data->work_queue_tasks_taken >= TASK_QUEUE_POLL_INTERVAL; }
+	bool _has_stealable_tasks() const;
+
+	uint32_t _register_dependencies(Span<TaskID> p_dependencies, Task *p_task, Group *p_group);
+	void _release_dependents(Dependents &p_dependents, Dependents &r_ready);
+	void _post_dependents(Dependents &p_ready, MutexLock<BinaryMutex> &p_lock);
+
 	static WorkerThreadPool *singleton;
 
 #ifdef THREADS_ENABLED
@@ -194,8 +226,8 @@ private:
 	static thread_local UnlockableLocks unlockable_locks[MAX_UNLOCKABLE_LOCKS];
 #endif
 
-	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task = false);
-	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
+	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task = false, Span<TaskID> p_dependencies = Span<TaskID>());
+	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, Span<TaskID> p_dependencies = Span<TaskID>());
 
 	template <typename C, typename M, typename U>
 	struct TaskUserData : public BaseTemplateUserdata {
@@ -217,6 +249,55 @@ private:
 		}
 	};
 
+	struct ParallelFor {
+		// Each participant owns a slice of the range, packed as [begin, end) so it can be
+		// updated with a single compare-and-swap. The owner takes chunks from the front,
+		// while participants that ran out of work split off the back half.
+		struct Partition {
+			union {
+				std::atomic<uint64_t> range;
+				char aligner[Thread::CACHE_LINE_BYTES];
+			};
+			Partition() :
+					range(0) {}
+		};
+
+		WorkerThreadPool *pool = nullptr;
+		Partition *partitions = nullptr;
+		uint32_t partition_count = 0;
+		uint32_t grain = 1;
+		void (*func)(void *, uint32_t, uint32_t, uint32_t) = nullptr;
+		void *userdata = nullptr;
+	};
+
+	template <typename C, typename M, typename U>
+	struct ParallelForUserData {
+		C *instance;
+		M method;
+		U userdata;
+		static void callback(void *p_self, uint32_t p_from, uint32_t p_to, uint32_t p_participant) {
+			ParallelForUserData *self = (ParallelForUserData *)p_self;
+			(self->instance->*self->method)(p_from, p_to, p_participant, self->userdata);
+		}
+	};
+
+	template <typename T, typename C, typename M>
+	struct ParallelReduceUserData {
+		C *instance;
+		M method;
+		T *partials;
+		static void callback(void *p_self, uint32_t p_from, uint32_t p_to, uint32_t p_participant) {
+			ParallelReduceUserData *self = (ParallelReduceUserData *)p_self;
+			(self->instance->*self->method)(p_from, p_to, self->partials[p_participant]);
+		}
+	};
+
+	static void _parallel_for_task(void *p_parallel_for, uint32_t p_index);
+	static bool _parallel_for_take(ParallelFor::Partition &p_partition, uint32_t p_grain, uint32_t &r_from, uint32_t &r_to);
+	static bool _parallel_for_steal(ParallelFor *p_parallel_for, uint32_t p_participant);
+	static void _parallel_for_participate(ParallelFor *p_parallel_for, uint32_t p_participant);
+	void _parallel_for(uint32_t p_begin, uint32_t p_end, uint32_t p_grain, void (*p_func)(void *, uint32_t, uint32_t, uint32_t), void *p_userdata, bool p_high_priority, const String &p_description);
+
 	void _wait_collaboratively(ThreadData *p_caller_pool_thread, Task *p_task);
 
 	void _switch_runlevel(Runlevel p_runlevel);
@@ -246,6 +327,21 @@ public:
 	TaskID add_task(const Callable &p_action, bool p_high_priority = false, const String &p_description = String(), bool p_pump_task = false);
 	TaskID add_task_bind(const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
 
+	// The *_with_dependencies() variants hold the task or group back until every task and group
+	// in p_dependencies has finished, without blocking the calling thread. IDs that were already
+	// waited for count as finished. The returned ID still has to be waited for as usual.
+	template <typename C, typename M, typename U>
+	TaskID add_template_task_with_dependencies(C *p_instance, M p_method, U p_userdata, Span<TaskID> p_dependencies, bool p_high_priority = false, const String &p_description = String()) {
+		typedef TaskUserData<C, M, U> TUD;
+		TUD *ud = memnew(TUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description, false, p_dependencies);
+	}
+	TaskID add_native_task_with_dependencies(void (*p_func)(void *), void *p_userdata, Span<TaskID> p_dependencies, bool p_high_priority = false, const String &p_description = String());
+	TaskID add_task_with_dependencies(const Callable &p_action, const PackedInt64Array &p_dependencies, bool p_high_priority = false, const String &p_description = String());
+
 	bool is_task_completed(TaskID p_task_id) const;
 	Error wait_for_task_completion(TaskID p_task_id);
 
@@ -263,10 +359,65 @@ public:
 	}
 	GroupID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	GroupID add_group_task(const Callable &p_action, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+
+	template <typename C, typename M, typename U>
+	GroupID add_template_group_task_with_dependencies(C *p_instance, M p_method, U p_userdata, int p_elements, Span<TaskID> p_dependencies, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String()) {
+		typedef GroupUserData<C, M, U> GroupUD;
+		GroupUD *ud = memnew(GroupUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+	}
+	GroupID add_native_group_task_with_dependencies(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, Span<TaskID> p_dependencies, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+	GroupID add_group_task_with_dependencies(const Callable &p_action, int p_elements, const PackedInt64Array &p_dependencies, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	uint32_t get_group_processed_element_count(GroupID p_group) const;
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
 
+	// Runs `p_method(from, to, participant, userdata)` over [p_begin, p_end), in ranges of at least p_grain elements,
+	// and returns once the whole range has been processed. The calling thread takes part too.
+	// Each participant starts with the same slice every time the same range is processed, so data
+	// stays warm in its caches across frames, and steals half of another slice when it runs out.
+	// `participant` is below get_parallel_for_participant_count(), and is never in use by two threads at once.
+	template <typename C, typename M, typename U>
+	void parallel_for(C *p_instance, M p_method, U p_userdata, uint32_t p_begin, uint32_t p_end, uint32_t p_grain = 1, bool p_high_priority = true, const String &p_description = String()) {
+		ParallelForUserData<C, M, U> ud;
+		ud.instance = p_instance;
+		ud.method = p_method;
+		ud.userdata = p_userdata;
+		_parallel_for(p_begin, p_end, p_grain, &ParallelForUserData<C, M, U>::callback, &ud, p_high_priority, p_description);
+	}
+
+	// Same as parallel_for(), but `p_method(from, to, accumulator)` accumulates into a value per participant,
+	// initialized to p_identity. Partial results are combined with `p_join(a, b)`, in participant order.
+	template <typename T, typename C, typename M, typename J>
+	T parallel_reduce(C *p_instance, M p_method, const T &p_identity, J p_join, uint32_t p_begin, uint32_t p_end, uint32_t p_grain = 1, bool p_high_priority = true, const String &p_description = String()) {
+		uint32_t participant_count = get_parallel_for_participant_count();
+		LocalVector<T> partials;
+		partials.resize(participant_count);
+		for (T &partial : partials) {
+			partial = p_identity;
+		}
+
+		ParallelReduceUserData<T, C, M> ud;
+		ud.instance = p_instance;
+		ud.method = p_method;
+		ud.partials = partials.ptr();
+		_parallel_for(p_begin, p_end, p_grain, &ParallelReduceUserData<T, C, M>::callback, &ud, p_high_priority, p_description);
+
+		T result = p_identity;
+		for (const T &partial : partials) {
+			result = p_join(result, partial);
+		}
+		return result;
+	}
+
+	// Pool threads, plus one for a calling thread from outside the pool.
+	_FORCE_INLINE_ uint32_t get_parallel_for_participant_count() const {
+		return threads.size() + 1;
+	}
+
 	_FORCE_INLINE_ int get_thread_count() const {
 #ifdef THREADS_ENABLED
 		return threads.size();
@@ -0,0 +1,305 @@
+/**************************************************************************/
+/*  frame_arena.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_arena.h"
+
+#include "core/os/mutex.h"
+#include "core/string/ustring.h"
+
+static SafeNumeric<uint64_t> arena_frame;
+static SafeNumeric<uint64_t> arena_block_size(FrameArena::DEFAULT_BLOCK_SIZE);
+
+struct FrameArenaBlock {
+	FrameArenaBlock *next = nullptr; // Previously filled block.
+	size_t size = 0;
+	size_t offset = 0;
+
+	_FORCE_INLINE_ uint8_t *get_data();
+};
+
+static constexpr size_t BLOCK_DATA_OFFSET = Memory::get_aligned_address(sizeof(FrameArenaBlock), Memory::MAX_ALIGN);
+
+uint8_t *FrameArenaBlock::get_data() {
+	return reinterpret_cast<uint8_t *>(this) + BLOCK_DATA_OFFSET;
+}
+
+struct FrameArenaThread {
+	Thread::ID thread_id = Thread::UNASSIGNED_ID;
+
+	FrameArenaBlock *current = nullptr;
+	uint32_t block_count = 0;
+	uint64_t used_in_previous_blocks = 0;
+
+	uint64_t live_allocations = 0;
+	uint8_t *last_allocation = nullptr;
+	size_t last_offset = 0;
+
+	uint64_t frame = 0;
+	uint64_t frame_peak = 0;
+
+	// Read from other threads when gathering stats.
+	SafeNumeric<uint64_t> capacity;
+	SafeNumeric<uint64_t> frame_high_water_mark;
+	SafeNumeric<uint64_t> high_water_mark;
+
+	FrameArenaThread *prev = nullptr;
+	FrameArenaThread *next = nullptr;
+
+	void push_block(size_t p_min_size) {
+		const size_t size = MAX(p_min_size, (size_t)arena_block_size.get());
+		FrameArenaBlock *block = memnew_placement(Memory::alloc_static(BLOCK_DATA_OFFSET + size), FrameArenaBlock);
+		block->size = size;
+		if (current) {
+			used_in_previous_blocks += current->offset;
+		}
+		block->next = current;
+		current = block;
+		block_count++;
+		capacity.add(size);
+	}
+
+	void free_blocks() {
+		while (current) {
+			FrameArenaBlock *next = current->next;
+			Memory::free_static(current);
+			current = next;
+		}
+		block_count = 0;
+		used_in_previous_blocks = 0;
+		capacity.set(0);
+	}
+
+	// Only valid when there are no live allocations.
+	void reset() {
+		if (block_count > 1) {
+			// Merge into a single block large enough for the whole previous usage.
+			const size_t total = capacity.get();
+			free_blocks();
+			push_block(total);
+		} else if (current) {
+			current->offset = 0;
+		}
+		used_in_previous_blocks = 0;
+		last_allocation = nullptr;
+		last_offset = 0;
+	}
+
+	// With `p_force_reset`, allocations still alive are dropped as well.
+	void roll_frame(uint64_t p_frame, bool p_force_reset) {
+		frame_high_water_mark.set(frame_peak);
+		frame = p_frame;
+		if (p_force_reset && live_allocations > 0) {
+#ifdef DEBUG_ENABLED
+			ERR_PRINT(itos(live_allocations) + " frame arena allocation(s) outlived the frame they were made in.");
+#endif
+			live_allocations = 0;
+		}
+		if (live_allocations == 0) {
+			reset();
+		}
+		frame_peak = used_in_previous_blocks + (current ? current->offset : 0);
+	}
+
+	void *alloc(size_t p_bytes) {
+		const uint64_t global_frame = arena_frame.get();
+		if (unlikely(frame != global_frame)) {
+			roll_frame(global_frame, false);
+		}
+
+		const size_t bytes = Memory::get_aligned_address(MAX(p_bytes, (size_t)1), Memory::MAX_ALIGN);
+		if (unlikely(!current || current->offset + bytes > current->size)) {
+			push_block(bytes);
+		}
+
+		last_offset = current->offset;
+		last_allocation = current->get_data() + last_offset;
+		current->offset += bytes;
+		live_allocations++;
+
+		const uint64_t used = used_in_previous_blocks + current->offset;
+		if (used > frame_peak) {
+			frame_peak = used;
+			high_water_mark.exchange_if_greater(used);
+		}
+
+		return last_allocation;
+	}
+
+	void free(void *p_ptr) {
+		ERR_FAIL_COND_MSG(live_allocations == 0, "Freeing memory that was not allocated from this thread's frame arena.");
+		live_allocations--;
+		if (live_allocations == 0) {
+			reset();
+		} else if (p_ptr == last_allocation) {
+			current->offset = last_offset;
+			last_allocation = nullptr;
+		}
+	}
+
+	// Grows or shrinks the most recent allocation without moving it, if possible.
+	bool resize_in_place(void *p_ptr, size_t p_bytes) {
+		if (p_ptr != last_allocation) {
+			return false;
+		}
+		const size_t bytes = Memory::get_aligned_address(MAX(p_bytes, (size_t)1), Memory::MAX_ALIGN);
+		if (last_offset + bytes > current->size) {
+			return false;
+		}
+		current->offset = last_offset + bytes;
+
+		const uint64_t used = used_in_previous_blocks + current->offset;
+		if (used > frame_peak) {
+			frame_peak = used;
+			high_water_mark.exchange_if_greater(used);
+		}
+		return true;
+	}
+};
+
+static Mutex arenas_mutex;
+static FrameArenaThread *arenas = nullptr;
+
+struct FrameArenaThreadHolder {
+	FrameArenaThread *arena = nullptr;
+
+	~FrameArenaThreadHolder() {
+		if (!arena) {
+			return;
+		}
+		{
+			MutexLock lock(arenas_mutex);
+			if (arena->prev) {
+				arena->prev->next = arena->next;
+			} else {
+				arenas = arena->next;
+			}
+			if (arena->next) {
+				arena->next->prev = arena->prev;
+			}
+		}
+		if (arena->live_allocations > 0) {
+			WARN_PRINT("Thread exited while still holding frame arena allocations.");
+		}
+		arena->free_blocks();
+		memdelete(arena);
+	}
+};
+
+static thread_local FrameArenaThreadHolder thread_arena_holder;
+
+static FrameArenaThread *_get_thread_arena() {
+	FrameArenaThread *arena = thread_arena_holder.arena;
+	if (likely(arena)) {
+		return arena;
+	}
+
+	arena = memnew(FrameArenaThread);
+	arena->thread_id = Thread::get_caller_id();
+	arena->frame = arena_frame.get();
+	{
+		MutexLock lock(arenas_mutex);
+		arena->next = arenas;
+		if (arenas) {
+			arenas->prev = arena;
+		}
+		arenas = arena;
+	}
+	thread_arena_holder.arena = arena;
+	return arena;
+}
+
+void *FrameArena::alloc(size_t p_bytes) {
+	return _get_thread_arena()->alloc(p_bytes);
+}
+
+void *FrameArena::realloc(void *p_ptr, size_t p_old_bytes, size_t p_bytes) {
+	if (p_ptr == nullptr) {
+		return alloc(p_bytes);
+	}
+
+	FrameArenaThread *arena = _get_thread_arena();
+	if (p_bytes == 0) {
+		arena->free(p_ptr);
+		return nullptr;
+	}
+	if (arena->resize_in_place(p_ptr, p_bytes)) {
+		return p_ptr;
+	}
+
+	void *mem = arena->alloc(p_bytes);
+	memcpy(mem, p_ptr, MIN(p_old_bytes, p_bytes));
+	arena->free(p_ptr);
+	return mem;
+}
+
+void FrameArena::free(void *p_ptr) {
+	ERR_FAIL_NULL(p_ptr);
+	_get_thread_arena()->free(p_ptr);
+}
+
+void FrameArena::advance_frame() {
+	const uint64_t frame = arena_frame.increment();
+	_get_thread_arena()->roll_frame(frame, true);
+}
+
+uint64_t FrameArena::get_frame() {
+	return arena_frame.get();
+}
+
+void FrameArena::set_block_size(size_t p_bytes) {
+	ERR_FAIL_COND(p_bytes == 0);
+	arena_block_size.set(p_bytes);
+}
+
+size_t FrameArena::get_block_size() {
+	return arena_block_size.get();
+}
+
+static FrameArena::ThreadStats _make_thread_stats(const FrameArenaThread *p_arena) {
+	FrameArena::ThreadStats stats;
+	stats.thread_id = p_arena->thread_id;
+	stats.capacity = p_arena->capacity.get();
+	stats.frame_high_water_mark = p_arena->frame_high_water_mark.get();
+	stats.high_water_mark = p_arena->high_water_mark.get();
+	return stats;
+}
+
+FrameArena::ThreadStats FrameArena::get_thread_stats() {
+	return _make_thread_stats(_get_thread_arena());
+}
+
+Vector<FrameArena::ThreadStats> FrameArena::get_all_thread_stats() {
+	Vector<ThreadStats> stats;
+	MutexLock lock(arenas_mutex);
+	for (const FrameArenaThread *arena = arenas; arena; arena = arena->next) {
+		stats.push_back(_make_thread_stats(arena));
+	}
+	return stats;
+}
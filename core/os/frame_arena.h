@@ -0,0 +1,104 @@
+/**************************************************************************/
+/*  frame_arena.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/memory.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/vector.h"
+
+// Per-thread bump allocator for short-lived scratch memory.
+//
+// Every thread gets its own arena, so allocating never takes a lock. Memory is
+// carved linearly out of large blocks; freeing only rewinds the arena when the
+// freed allocation is the most recent one, or when the thread has no live
+// allocations left, in which case the whole arena is reset. If more than one
+// block was needed since the last reset, the blocks are merged into a single
+// one, so the arena converges to the size of the per-frame high-water mark.
+//
+// The main thread's arena is also reset at every frame boundary, whether its
+// allocations were freed or not, so allocations made from the main thread must
+// not outlive the `Main::iteration()` they were made in. Debug builds report
+// the ones that do. Other threads reset their arena at the first allocation
+// of a frame when they hold none, so their containers should be scoped to a
+// single task. Memory must be freed from the thread that allocated it.
+class FrameArena {
+public:
+	static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+	struct ThreadStats {
+		Thread::ID thread_id = Thread::UNASSIGNED_ID;
+		uint64_t capacity = 0; // Bytes currently reserved by the arena.
+		uint64_t frame_high_water_mark = 0; // Peak bytes used during the last completed frame.
+		uint64_t high_water_mark = 0; // Peak bytes used during any frame.
+	};
+
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_ptr, size_t p_old_bytes, size_t p_bytes);
+	static void free(void *p_ptr);
+
+	// Marks a frame boundary, called from the main thread at the end of
+	// `Main::iteration()`. Resets the calling thread's arena.
+	static void advance_frame();
+	static uint64_t get_frame();
+
+	static void set_block_size(size_t p_bytes);
+	static size_t get_block_size();
+
+	static ThreadStats get_thread_stats(); // Stats of the calling thread.
+	static Vector<ThreadStats> get_all_thread_stats();
+};
+
+// Allocator for `LocalVector`, `List`, `RBMap` and friends.
+class FrameArenaAllocator {
+public:
+	_FORCE_INLINE_ static void *alloc(size_t p_memory) { return FrameArena::alloc(p_memory); }
+	_FORCE_INLINE_ static void *realloc(void *p_ptr, size_t p_old_bytes, size_t p_bytes) { return FrameArena::realloc(p_ptr, p_old_bytes, p_bytes); }
+	_FORCE_INLINE_ static void free(void *p_ptr) { FrameArena::free(p_ptr); }
+};
+
+// Element allocator for `HashMap`. `FrameHashMap` also places its bucket arrays in the arena.
+template <typename T>
+class FrameArenaTypedAllocator {
+public:
+	template <typename... Args>
+	_FORCE_INLINE_ T *new_allocation(Args &&...p_args) { return memnew_allocator(T(p_args...), FrameArenaAllocator); }
+	_FORCE_INLINE_ void delete_allocation(T *p_allocation) { memdelete_allocator<T, FrameArenaAllocator>(p_allocation); }
+};
+
+template <typename T, typename U = uint32_t>
+using FrameLocalVector = LocalVector<T, U, false, false, FrameArenaAllocator>;
+
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+using FrameHashMap = HashMap<TKey, TValue, Hasher, Comparator, FrameArenaTypedAllocator<HashMapElement<TKey, TValue>>, FrameArenaAllocator>;
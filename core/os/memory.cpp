@@ -35,8 +35,30 @@
 
 #include <cstdlib>
 
+#if defined(DEBUG_ENABLED) && defined(_MSC_VER)
+#include <intrin.h>
+// From winnt.h, which isn't included in core.
+extern "C" __declspec(dllimport) unsigned short __stdcall RtlCaptureStackBackTrace(unsigned long p_frames_to_skip, unsigned long p_frames_to_capture, void **r_back_trace, unsigned long *r_back_trace_hash);
+#elif defined(DEBUG_ENABLED) && defined(__GNUC__) && !defined(WEB_ENABLED)
+#include <unwind.h>
+#define _HAS_UNWIND
+#endif
+
+// Where the allocating function returns to, used to tell apart sampled allocations
+// made from the same MEMORY_TAG_SCOPE().
+#if defined(DEBUG_ENABLED) && defined(_MSC_VER)
+#define _CALLER_ADDRESS() _ReturnAddress()
+#elif defined(DEBUG_ENABLED) && defined(__GNUC__)
+#define _CALLER_ADDRESS() __builtin_return_address(0)
+#else
+#define _CALLER_ADDRESS() nullptr
+#endif
+
+template <bool p_ensure_zero>
+static void *_alloc_static(size_t p_bytes, bool p_pad_align, const void *p_caller);
+
 void *operator new(size_t p_size, const char *p_description) {
-	return Memory::alloc_static(p_size, false);
+	return _alloc_static<false>(p_size, false, _CALLER_ADDRESS());
 }
 
 void *operator new(size_t p_size, void *(*p_allocfunc)(size_t p_size)) {
@@ -60,6 +82,149 @@ void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_d
 #ifdef DEBUG_ENABLED
 static SafeNumeric<uint64_t> _current_mem_usage;
 static SafeNumeric<uint64_t> _max_mem_usage;
+
+static SafeNumeric<uint64_t> _tag_mem_usage[Memory::TAG_MAX];
+static SafeNumeric<uint64_t> _tag_max_mem_usage[Memory::TAG_MAX];
+
+// Tags and sampling are off by default, so that allocating only costs this check.
+static std::atomic<bool> _tag_tracking_enabled = false;
+
+static thread_local const Memory::AllocationSite *_current_site = nullptr;
+static const Memory::AllocationSite _untagged_site;
+
+// Sampled sites, in an open-addressing table keyed by a hash of the scope site and the
+// callers, so recording a sample never allocates nor locks.
+static constexpr uint32_t SITE_TABLE_SIZE = 4096;
+struct SiteSlot {
+	std::atomic<uint64_t> key = 0;
+	// Set right after the key is claimed, the slot is skipped when reading samples until then.
+	std::atomic<const Memory::AllocationSite *> site = nullptr;
+	std::atomic<const void *> callers[Memory::SAMPLE_CALLER_COUNT] = {};
+	SafeNumeric<uint64_t> bytes;
+	SafeNumeric<uint64_t> samples;
+};
+static SiteSlot _site_table[SITE_TABLE_SIZE];
+static SafeNumeric<uint32_t> _sampling_interval;
+static thread_local int64_t _bytes_until_sample = 0;
+
+#ifdef _HAS_UNWIND
+struct UnwindState {
+	void **frames = nullptr;
+	uint32_t count = 0;
+	uint32_t max = 0;
+};
+
+static _Unwind_Reason_Code _unwind_frame(struct _Unwind_Context *p_context, void *p_state) {
+	UnwindState *state = (UnwindState *)p_state;
+	if (state->count == state->max) {
+		return _URC_END_OF_STACK;
+	}
+	state->frames[state->count++] = (void *)_Unwind_GetIP(p_context);
+	return _URC_NO_REASON;
+}
+#endif
+
+// The immediate caller is often a container or a memnew() helper, so the frames above it are kept too.
+static void _capture_callers(const void *p_caller, const void **r_callers) {
+	r_callers[0] = p_caller;
+	for (uint32_t i = 1; i < Memory::SAMPLE_CALLER_COUNT; i++) {
+		r_callers[i] = nullptr;
+	}
+
+	// The allocation functions may be inlined into each other, so rather than skipping a fixed
+	// number of frames, the stack is searched for the immediate caller.
+	void *frames[8 + Memory::SAMPLE_CALLER_COUNT];
+	uint32_t frame_count = 0;
+#if defined(_MSC_VER)
+	frame_count = RtlCaptureStackBackTrace(0, std_size(frames), frames, nullptr);
+#elif defined(_HAS_UNWIND)
+	UnwindState state;
+	state.frames = frames;
+	state.max = std_size(frames);
+	_Unwind_Backtrace(&_unwind_frame, &state);
+	frame_count = state.count;
+#endif
+	for (uint32_t i = 0; i < frame_count; i++) {
+		if (frames[i] == p_caller) {
+			for (uint32_t j = 1; j < Memory::SAMPLE_CALLER_COUNT && i + j < frame_count; j++) {
+				r_callers[j] = frames[i + j];
+			}
+			return;
+		}
+	}
+}
+
+static void _sample_allocation(size_t p_bytes, const void *p_caller) {
+	uint32_t interval = _sampling_interval.get();
+	if (likely(interval == 0)) {
+		return;
+	}
+	_bytes_until_sample -= p_bytes;
+	if (likely(_bytes_until_sample >= 0)) {
+		return;
+	}
+
+	// A big allocation can span several intervals, and is charged for all of them.
+	uint64_t samples = 1 + (uint64_t)(-_bytes_until_sample - 1) / interval;
+	_bytes_until_sample += samples * interval;
+
+	const Memory::AllocationSite *site = _current_site ? _current_site : &_untagged_site;
+	const void *callers[Memory::SAMPLE_CALLER_COUNT];
+	_capture_callers(p_caller, callers);
+
+	uint64_t key = (uint64_t)(uintptr_t)site;
+	for (const void *caller : callers) {
+		key = (key * 0x9E3779B97F4A7C15ull) ^ (uint64_t)(uintptr_t)caller;
+		key = (key ^ (key >> 33)) * 0xFF51AFD7ED558CCDull;
+		key ^= key >> 33;
+	}
+	key = key ? key : 1; // Zero marks a free slot.
+	uint32_t index = (uint32_t)(key % SITE_TABLE_SIZE);
+	for (uint32_t i = 0; i < SITE_TABLE_SIZE; i++) {
+		SiteSlot &slot = _site_table[(index + i) % SITE_TABLE_SIZE];
+		uint64_t slot_key = slot.key.load(std::memory_order_acquire);
+		if (!slot_key && slot.key.compare_exchange_strong(slot_key, key, std::memory_order_acq_rel)) {
+			for (uint32_t j = 0; j < Memory::SAMPLE_CALLER_COUNT; j++) {
+				slot.callers[j].store(callers[j], std::memory_order_relaxed);
+			}
+			slot.site.store(site, std::memory_order_release);
+			slot_key = key;
+		}
+		if (slot_key == key) {
+			slot.bytes.add(samples * interval);
+			slot.samples.add(samples);
+			return;
+		}
+	}
+	// The table is full, the sample is dropped.
+}
+
+static _FORCE_INLINE_ void _track_alloc(uint64_t *p_header, size_t p_bytes, const void *p_caller) {
+	uint64_t new_mem_usage = _current_mem_usage.add(p_bytes);
+	_max_mem_usage.exchange_if_greater(new_mem_usage);
+
+	if (likely(!_tag_tracking_enabled.load(std::memory_order_relaxed))) {
+		*p_header = p_bytes;
+		return;
+	}
+
+	// Stored off by one, so allocations made while tracking was disabled are told apart.
+	Memory::AllocationTag tag = _current_site ? _current_site->tag : Memory::TAG_UNTAGGED;
+	*p_header = p_bytes | ((uint64_t)(tag + 1) << Memory::TAG_SHIFT);
+	uint64_t new_tag_mem_usage = _tag_mem_usage[tag].add(p_bytes);
+	_tag_max_mem_usage[tag].exchange_if_greater(new_tag_mem_usage);
+
+	_sample_allocation(p_bytes, p_caller);
+}
+
+static _FORCE_INLINE_ void _track_free(uint64_t p_header) {
+	uint64_t bytes = p_header & Memory::SIZE_MASK;
+	_current_mem_usage.sub(bytes);
+	uint64_t tag_bits = p_header >> Memory::TAG_SHIFT;
+	if (tag_bits) {
+		_tag_mem_usage[tag_bits - 1].sub(bytes);
+	}
+}
 #endif
 
 void *Memory::alloc_aligned_static(size_t p_bytes, size_t p_alignment) {
@@ -97,7 +262,9 @@ void Memory::free_aligned_static(void *p_memory) {
 }
 
 template <bool p_ensure_zero>
-void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
+static void *_alloc_static(size_t p_bytes, bool p_pad_align, const void *p_caller) {
+	using namespace Memory;
+
 #ifdef DEBUG_ENABLED
 	bool prepad = true;
 #else
@@ -118,11 +285,10 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 		uint8_t *s8 = (uint8_t *)mem;
 
 		uint64_t *s = (uint64_t *)(s8 + SIZE_OFFSET);
-		*s = p_bytes;
-
 #ifdef DEBUG_ENABLED
-		uint64_t new_mem_usage = _current_mem_usage.add(p_bytes);
-		_max_mem_usage.exchange_if_greater(new_mem_usage);
+		_track_alloc(s, p_bytes, p_caller);
+#else
+		*s = p_bytes;
 #endif
 		return s8 + DATA_OFFSET;
 	} else {
@@ -130,12 +296,17 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 	}
 }
 
+template <bool p_ensure_zero>
+void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
+	return _alloc_static<p_ensure_zero>(p_bytes, p_pad_align, _CALLER_ADDRESS());
+}
+
 template void *Memory::alloc_static<true>(size_t p_bytes, bool p_pad_align);
 template void *Memory::alloc_static<false>(size_t p_bytes, bool p_pad_align);
 
 void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 	if (p_memory == nullptr) {
-		return alloc_static(p_bytes, p_pad_align);
+		return _alloc_static<false>(p_bytes, p_pad_align, _CALLER_ADDRESS());
 	}
 
 	uint8_t *mem = (uint8_t *)p_memory;
@@ -151,12 +322,28 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
 
 #ifdef DEBUG_ENABLED
-		if (p_bytes > *s) {
-			uint64_t new_mem_usage = _current_mem_usage.add(p_bytes - *s);
+		// The memory stays attributed to the tag it was allocated with, if any.
+		uint64_t tag_bits = *s & ~SIZE_MASK;
+		uint64_t tag = (tag_bits >> TAG_SHIFT) - 1;
+		uint64_t prev_bytes = *s & SIZE_MASK;
+		if (p_bytes > prev_bytes) {
+			uint64_t new_mem_usage = _current_mem_usage.add(p_bytes - prev_bytes);
 			_max_mem_usage.exchange_if_greater(new_mem_usage);
+			if (tag_bits) {
+				uint64_t new_tag_mem_usage = _tag_mem_usage[tag].add(p_bytes - prev_bytes);
+				_tag_max_mem_usage[tag].exchange_if_greater(new_tag_mem_usage);
+				if (_tag_tracking_enabled.load(std::memory_order_relaxed)) {
+					_sample_allocation(p_bytes - prev_bytes, _CALLER_ADDRESS());
+				}
+			}
 		} else {
-			_current_mem_usage.sub(*s - p_bytes);
+			_current_mem_usage.sub(prev_bytes - p_bytes);
+			if (tag_bits) {
+				_tag_mem_usage[tag].sub(prev_bytes - p_bytes);
+			}
 		}
+#else
+		uint64_t tag_bits = 0;
 #endif
 
 		if (p_bytes == 0) {
@@ -164,8 +351,6 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 			free(mem);
 			return nullptr;
 		} else {
-			*s = p_bytes;
-
 			GodotProfileFree(mem);
 			mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
 			ERR_FAIL_NULL_V(mem, nullptr);
@@ -173,7 +358,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 			s = (uint64_t *)(mem + SIZE_OFFSET);
 
-			*s = p_bytes;
+			*s = p_bytes | tag_bits;
 
 			return mem + DATA_OFFSET;
 		}
@@ -203,8 +388,7 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 		mem -= DATA_OFFSET;
 
 #ifdef DEBUG_ENABLED
-		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
-		_current_mem_usage.sub(*s);
+		_track_free(*(uint64_t *)(mem + SIZE_OFFSET));
 #endif
 
 		GodotProfileFree(mem);
@@ -235,6 +419,122 @@ uint64_t Memory::get_mem_max_usage() {
 #endif
 }
 
+const char *Memory::get_tag_name(AllocationTag p_tag) {
+	static const char *names[TAG_MAX] = {
+		"untagged",
+		"rendering",
+		"physics",
+		"script",
+		"resource",
+		"scene",
+		"audio",
+	};
+	ERR_FAIL_UNSIGNED_INDEX_V(p_tag, TAG_MAX, "");
+	return names[p_tag];
+}
+
+uint64_t Memory::get_tag_mem_usage(AllocationTag p_tag) {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_tag, TAG_MAX, 0);
+#ifdef DEBUG_ENABLED
+	return _tag_mem_usage[p_tag].get();
+#else
+	return 0;
+#endif
+}
+
+uint64_t Memory::get_tag_mem_max_usage(AllocationTag p_tag) {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_tag, TAG_MAX, 0);
+#ifdef DEBUG_ENABLED
+	return _tag_max_mem_usage[p_tag].get();
+#else
+	return 0;
+#endif
+}
+
+void Memory::set_tag_tracking_enabled(bool p_enabled) {
+#ifdef DEBUG_ENABLED
+	_tag_tracking_enabled.store(p_enabled);
+#endif
+}
+
+bool Memory::is_tag_tracking_enabled() {
+#ifdef DEBUG_ENABLED
+	return _tag_tracking_enabled.load();
+#else
+	return false;
+#endif
+}
+
+void Memory::set_allocation_sampling_interval(uint32_t p_bytes) {
+#ifdef DEBUG_ENABLED
+	_sampling_interval.set(p_bytes);
+#endif
+}
+
+uint32_t Memory::get_allocation_sampling_interval() {
+#ifdef DEBUG_ENABLED
+	return _sampling_interval.get();
+#else
+	return 0;
+#endif
+}
+
+uint32_t Memory::get_allocation_site_samples(AllocationSiteSample *r_samples, uint32_t p_max) {
+	uint32_t count = 0;
+#ifdef DEBUG_ENABLED
+	for (uint32_t i = 0; i < SITE_TABLE_SIZE; i++) {
+		const AllocationSite *site = _site_table[i].site.load(std::memory_order_acquire);
+		if (!site) {
+			continue;
+		}
+		AllocationSiteSample sample;
+		sample.site = site;
+		for (uint32_t j = 0; j < SAMPLE_CALLER_COUNT; j++) {
+			sample.callers[j] = _site_table[i].callers[j].load(std::memory_order_relaxed);
+		}
+		sample.bytes = _site_table[i].bytes.get();
+		sample.samples = _site_table[i].samples.get();
+		if (sample.samples == 0) {
+			continue;
+		}
+
+		// Insertion sort, keeping the biggest ones if there are too many.
+		uint32_t pos = count < p_max ? count++ : p_max;
+		while (pos > 0 && r_samples[pos - 1].bytes < sample.bytes) {
+			if (pos < p_max) {
+				r_samples[pos] = r_samples[pos - 1];
+			}
+			pos--;
+		}
+		if (pos < p_max) {
+			r_samples[pos] = sample;
+		}
+	}
+#endif
+	return count;
+}
+
+void Memory::clear_allocation_site_samples() {
+#ifdef DEBUG_ENABLED
+	// Sites stay in the table, so concurrent samples are never lost to a half-cleared slot.
+	for (uint32_t i = 0; i < SITE_TABLE_SIZE; i++) {
+		_site_table[i].bytes.set(0);
+		_site_table[i].samples.set(0);
+	}
+#endif
+}
+
+#ifdef DEBUG_ENABLED
+Memory::AllocationTagScope::AllocationTagScope(const AllocationSite *p_site) {
+	previous_site = _current_site;
+	_current_site = p_site;
+}
+
+Memory::AllocationTagScope::~AllocationTagScope() {
+	_current_site = previous_site;
+}
+#endif
+
 _GlobalNil::_GlobalNil() {
 	left = this;
 	right = this;
@@ -53,7 +53,7 @@ static constexpr size_t MAX_ALIGN = alignof(max_align_t);
 // Alignment:  ↓ max_align_t        ↓ uint64_t          ↓ MAX_ALIGN
 //             ┌─────────────────┬──┬────────────────┬──┬───────────...
 //             │ uint64_t        │░░│ uint64_t       │░░│ T[]
-//             │ alloc size      │░░│ element count  │░░│ data
+//             │ alloc size (*)  │░░│ element count  │░░│ data
 //             └─────────────────┴──┴────────────────┴──┴───────────...
 // Offset:     ↑ SIZE_OFFSET        ↑ ELEMENT_OFFSET    ↑ DATA_OFFSET
 
@@ -96,11 +96,82 @@ void free_aligned_static(void *p_memory);
 uint64_t get_mem_available();
 uint64_t get_mem_usage();
 uint64_t get_mem_max_usage();
+
+// (*) In debug builds, the allocation tag is kept in the top bits of the alloc size.
+//
+// Allocation tags, only tracked in debug builds, while enabled with set_tag_tracking_enabled().
+// Allocations are attributed to the innermost MEMORY_TAG_SCOPE() of the thread making them.
+// Reallocating or freeing them, from any thread, updates the same tag.
+enum AllocationTag : uint8_t {
+	TAG_UNTAGGED,
+	TAG_RENDERING,
+	TAG_PHYSICS,
+	TAG_SCRIPT,
+	TAG_RESOURCE,
+	TAG_SCENE,
+	TAG_AUDIO,
+	TAG_MAX,
+};
+
+inline constexpr uint32_t TAG_SHIFT = 56;
+inline constexpr uint64_t SIZE_MASK = (uint64_t(1) << TAG_SHIFT) - 1;
+
+inline constexpr uint32_t SAMPLE_CALLER_COUNT = 4;
+
+// Where a MEMORY_TAG_SCOPE() is. Sampled allocations are reported per site and callers.
+struct AllocationSite {
+	AllocationTag tag = TAG_UNTAGGED;
+	const char *file = "";
+	int line = 0;
+	const char *function = "";
+};
+
+struct AllocationSiteSample {
+	const AllocationSite *site = nullptr;
+	// Return addresses, starting from the allocation call, as far as the platform can walk the stack.
+	const void *callers[SAMPLE_CALLER_COUNT] = {};
+	uint64_t bytes = 0; // Estimated from the sampling interval.
+	uint64_t samples = 0;
+};
+
+const char *get_tag_name(AllocationTag p_tag);
+// Only allocations made while enabled are accounted for.
+void set_tag_tracking_enabled(bool p_enabled);
+bool is_tag_tracking_enabled();
+uint64_t get_tag_mem_usage(AllocationTag p_tag);
+uint64_t get_tag_mem_max_usage(AllocationTag p_tag);
+
+// Once every p_bytes allocated on a thread, on average, the allocation is charged to the current site.
+// Zero (the default) disables sampling. Only happens while tag tracking is enabled.
+void set_allocation_sampling_interval(uint32_t p_bytes);
+uint32_t get_allocation_sampling_interval();
+// Copies up to p_max samples, sorted by decreasing size. Returns the number of samples copied.
+uint32_t get_allocation_site_samples(AllocationSiteSample *r_samples, uint32_t p_max);
+void clear_allocation_site_samples();
+
+#ifdef DEBUG_ENABLED
+class AllocationTagScope {
+	const AllocationSite *previous_site = nullptr;
+
+public:
+	AllocationTagScope(const AllocationSite *p_site);
+	~AllocationTagScope();
+};
+#endif
 }; //namespace Memory
 
+#ifdef DEBUG_ENABLED
+#define MEMORY_TAG_SCOPE(m_tag) \
+	static const Memory::AllocationSite _GD_VARNAME_CONCAT_(_memory_tag_site_, _, __LINE__) = { Memory::TAG_##m_tag, __FILE__, __LINE__, __FUNCTION__ }; \
+	Memory::AllocationTagScope _GD_VARNAME_CONCAT_(_memory_tag_scope_, _, __LINE__)(&_GD_VARNAME_CONCAT_(_memory_tag_site_, _, __LINE__))
+#else
+#define MEMORY_TAG_SCOPE(m_tag)
+#endif
+
 class DefaultAllocator {
 public:
 	_FORCE_INLINE_ static void *alloc(size_t p_memory) { return Memory::alloc_static(p_memory, false); }
+	_FORCE_INLINE_ static void *realloc(void *p_ptr, size_t p_old_bytes, size_t p_bytes) { return Memory::realloc_static(p_ptr, p_bytes, false); }
 	_FORCE_INLINE_ static void free(void *p_ptr) { Memory::free_static(p_ptr, false); }
 };
 
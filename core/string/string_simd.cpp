@@ -0,0 +1,226 @@
+/**************************************************************************/
+/*  string_simd.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "string_simd.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STRING_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define STRING_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace StringSIMD {
+
+int64_t ascii_prefix_length(const uint8_t *p_src, int64_t p_len) {
+	int64_t i = 0;
+#if defined(STRING_SIMD_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 16 <= p_len; i += 16) {
+		const __m128i v = _mm_loadu_si128((const __m128i *)(p_src + i));
+		// The sign bits flag non-ASCII bytes.
+		const uint32_t mask = (uint32_t)_mm_movemask_epi8(v) | (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero));
+		if (mask) {
+			return i + count_trailing_zeros(mask);
+		}
+	}
+#elif defined(STRING_SIMD_NEON)
+	const uint8x16_t ascii_max = vdupq_n_u8(0x7F);
+	for (; i + 16 <= p_len; i += 16) {
+		const uint8x16_t v = vld1q_u8(p_src + i);
+		// Subtracting one wraps 0 around, so a single comparison catches both 0 and non-ASCII bytes.
+		if (vmaxvq_u8(vcgeq_u8(vsubq_u8(v, vdupq_n_u8(1)), ascii_max))) {
+			break;
+		}
+	}
+#endif
+	while (i < p_len && p_src[i] != 0 && p_src[i] < 0x80) {
+		i++;
+	}
+	return i;
+}
+
+int64_t ascii_prefix_length(const char32_t *p_src, int64_t p_len) {
+	int64_t i = 0;
+#if defined(STRING_SIMD_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 8 <= p_len; i += 8) {
+		const __m128i a = _mm_loadu_si128((const __m128i *)(p_src + i));
+		const __m128i b = _mm_loadu_si128((const __m128i *)(p_src + i + 4));
+		const __m128i high = _mm_or_si128(_mm_srli_epi32(a, 7), _mm_srli_epi32(b, 7));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(high, zero)) != 0xFFFF) {
+			break;
+		}
+	}
+#elif defined(STRING_SIMD_NEON)
+	for (; i + 8 <= p_len; i += 8) {
+		const uint32x4_t a = vld1q_u32((const uint32_t *)(p_src + i));
+		const uint32x4_t b = vld1q_u32((const uint32_t *)(p_src + i + 4));
+		if (vmaxvq_u32(vmaxq_u32(a, b)) > 0x7F) {
+			break;
+		}
+	}
+#endif
+	while (i < p_len && (uint32_t)p_src[i] < 0x80) {
+		i++;
+	}
+	return i;
+}
+
+void widen(const uint8_t *p_src, char32_t *p_dst, int64_t p_count) {
+	int64_t i = 0;
+#if defined(STRING_SIMD_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 16 <= p_count; i += 16) {
+		const __m128i v = _mm_loadu_si128((const __m128i *)(p_src + i));
+		const __m128i lo = _mm_unpacklo_epi8(v, zero);
+		const __m128i hi = _mm_unpackhi_epi8(v, zero);
+		_mm_storeu_si128((__m128i *)(p_dst + i), _mm_unpacklo_epi16(lo, zero));
+		_mm_storeu_si128((__m128i *)(p_dst + i + 4), _mm_unpackhi_epi16(lo, zero));
+		_mm_storeu_si128((__m128i *)(p_dst + i + 8), _mm_unpacklo_epi16(hi, zero));
+		_mm_storeu_si128((__m128i *)(p_dst + i + 12), _mm_unpackhi_epi16(hi, zero));
+	}
+#elif defined(STRING_SIMD_NEON)
+	for (; i + 16 <= p_count; i += 16) {
+		const uint8x16_t v = vld1q_u8(p_src + i);
+		const uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+		const uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+		vst1q_u32((uint32_t *)(p_dst + i), vmovl_u16(vget_low_u16(lo)));
+		vst1q_u32((uint32_t *)(p_dst + i + 4), vmovl_u16(vget_high_u16(lo)));
+		vst1q_u32((uint32_t *)(p_dst + i + 8), vmovl_u16(vget_low_u16(hi)));
+		vst1q_u32((uint32_t *)(p_dst + i + 12), vmovl_u16(vget_high_u16(hi)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		p_dst[i] = p_src[i];
+	}
+}
+
+void narrow(const char32_t *p_src, uint8_t *p_dst, int64_t p_count) {
+	int64_t i = 0;
+#if defined(STRING_SIMD_SSE2)
+	for (; i + 16 <= p_count; i += 16) {
+		// Values below 0x100 pass the signed saturation of the 32-bit pack unchanged.
+		const __m128i lo = _mm_packs_epi32(_mm_loadu_si128((const __m128i *)(p_src + i)), _mm_loadu_si128((const __m128i *)(p_src + i + 4)));
+		const __m128i hi = _mm_packs_epi32(_mm_loadu_si128((const __m128i *)(p_src + i + 8)), _mm_loadu_si128((const __m128i *)(p_src + i + 12)));
+		_mm_storeu_si128((__m128i *)(p_dst + i), _mm_packus_epi16(lo, hi));
+	}
+#elif defined(STRING_SIMD_NEON)
+	for (; i + 16 <= p_count; i += 16) {
+		const uint16x8_t lo = vcombine_u16(vmovn_u32(vld1q_u32((const uint32_t *)(p_src + i))), vmovn_u32(vld1q_u32((const uint32_t *)(p_src + i + 4))));
+		const uint16x8_t hi = vcombine_u16(vmovn_u32(vld1q_u32((const uint32_t *)(p_src + i + 8))), vmovn_u32(vld1q_u32((const uint32_t *)(p_src + i + 12))));
+		vst1q_u8(p_dst + i, vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		p_dst[i] = (uint8_t)p_src[i];
+	}
+}
+
+int64_t find(const char32_t *p_src, int64_t p_len, char32_t p_char) {
+	int64_t i = 0;
+#if defined(STRING_SIMD_SSE2)
+	const __m128i needle = _mm_set1_epi32((int)p_char);
+	for (; i + 8 <= p_len; i += 8) {
+		const __m128i a = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(p_src + i)), needle);
+		const __m128i b = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(p_src + i + 4)), needle);
+		const uint32_t mask = (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(a)) | ((uint32_t)_mm_movemask_ps(_mm_castsi128_ps(b)) << 4);
+		if (mask) {
+			return i + count_trailing_zeros(mask);
+		}
+	}
+#elif defined(STRING_SIMD_NEON)
+	const uint32x4_t needle = vdupq_n_u32((uint32_t)p_char);
+	for (; i + 8 <= p_len; i += 8) {
+		const uint32x4_t a = vceqq_u32(vld1q_u32((const uint32_t *)(p_src + i)), needle);
+		const uint32x4_t b = vceqq_u32(vld1q_u32((const uint32_t *)(p_src + i + 4)), needle);
+		if (vmaxvq_u32(vorrq_u32(a, b))) {
+			break;
+		}
+	}
+#endif
+	for (; i < p_len; i++) {
+		if (p_src[i] == p_char) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+// Adds `p_delta` to the code points from `p_from` to `p_to`, over the ASCII prefix of `p_src`.
+static int64_t _ascii_shift_case(const char32_t *p_src, char32_t *p_dst, int64_t p_len, char32_t p_from, char32_t p_to, int32_t p_delta) {
+	int64_t i = 0;
+#if defined(STRING_SIMD_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i below = _mm_set1_epi32((int)p_from - 1);
+	const __m128i above = _mm_set1_epi32((int)p_to + 1);
+	const __m128i delta = _mm_set1_epi32(p_delta);
+	for (; i + 4 <= p_len; i += 4) {
+		const __m128i v = _mm_loadu_si128((const __m128i *)(p_src + i));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_srli_epi32(v, 7), zero)) != 0xFFFF) {
+			break;
+		}
+		// All lanes are ASCII here, so signed comparisons are safe.
+		const __m128i in_range = _mm_and_si128(_mm_cmpgt_epi32(v, below), _mm_cmplt_epi32(v, above));
+		_mm_storeu_si128((__m128i *)(p_dst + i), _mm_add_epi32(v, _mm_and_si128(in_range, delta)));
+	}
+#elif defined(STRING_SIMD_NEON)
+	const uint32x4_t from = vdupq_n_u32(p_from);
+	const uint32x4_t to = vdupq_n_u32(p_to);
+	const uint32x4_t delta = vdupq_n_u32((uint32_t)p_delta);
+	for (; i + 4 <= p_len; i += 4) {
+		const uint32x4_t v = vld1q_u32((const uint32_t *)(p_src + i));
+		if (vmaxvq_u32(v) > 0x7F) {
+			break;
+		}
+		const uint32x4_t in_range = vandq_u32(vcgeq_u32(v, from), vcleq_u32(v, to));
+		vst1q_u32((uint32_t *)(p_dst + i), vaddq_u32(v, vandq_u32(in_range, delta)));
+	}
+#endif
+	for (; i < p_len; i++) {
+		const char32_t c = p_src[i];
+		if ((uint32_t)c >= 0x80) {
+			break;
+		}
+		p_dst[i] = (c >= p_from && c <= p_to) ? c + p_delta : c;
+	}
+	return i;
+}
+
+int64_t ascii_to_lower(const char32_t *p_src, char32_t *p_dst, int64_t p_len) {
+	return _ascii_shift_case(p_src, p_dst, p_len, 'A', 'Z', 'a' - 'A');
+}
+
+int64_t ascii_to_upper(const char32_t *p_src, char32_t *p_dst, int64_t p_len) {
+	return _ascii_shift_case(p_src, p_dst, p_len, 'a', 'z', 'A' - 'a');
+}
+
+} // namespace StringSIMD
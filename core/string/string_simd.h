@@ -0,0 +1,57 @@
+/**************************************************************************/
+/*  string_simd.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/typedefs.h"
+
+// Kernels for the hot loops of String, which scan, transcode or case fold runs of
+// characters. Uses SSE2 or NEON where available, with a scalar fallback.
+namespace StringSIMD {
+
+// Length of the prefix of `p_src` made of ASCII characters other than 0, up to `p_len`.
+int64_t ascii_prefix_length(const uint8_t *p_src, int64_t p_len);
+// Length of the prefix of `p_src` made of code points up to 0x7F, including 0, up to `p_len`.
+int64_t ascii_prefix_length(const char32_t *p_src, int64_t p_len);
+
+// Zero extends `p_count` bytes to code points.
+void widen(const uint8_t *p_src, char32_t *p_dst, int64_t p_count);
+// Truncates `p_count` code points, which must be below 0x100, to bytes.
+void narrow(const char32_t *p_src, uint8_t *p_dst, int64_t p_count);
+
+// Index of the first `p_char` in the `p_len` code points of `p_src`, or -1.
+int64_t find(const char32_t *p_src, int64_t p_len, char32_t p_char);
+
+// Case fold the ASCII prefix of `p_src` into `p_dst`, up to `p_len` code points.
+// Return the length of that prefix, the remaining code points are left to the caller.
+int64_t ascii_to_lower(const char32_t *p_src, char32_t *p_dst, int64_t p_len);
+int64_t ascii_to_upper(const char32_t *p_src, char32_t *p_dst, int64_t p_len);
+
+} // namespace StringSIMD
@@ -43,6 +43,7 @@ STATIC_ASSERT_INCOMPLETE_TYPE(class, Object);
 #include "core/os/os.h"
 #include "core/string/print_string.h"
 #include "core/string/string_name.h"
+#include "core/string/string_simd.h"
 #include "core/string/translation_server.h"
 #include "core/string/ucaps.h"
 #include "core/variant/variant.h"
@@ -1357,16 +1358,22 @@ String String::to_upper() const {
 		return *this;
 	}
 
+	const int len = length();
 	String upper;
 	upper.resize_uninitialized(size());
 	const char32_t *old_ptr = ptr();
 	char32_t *upper_ptrw = upper.ptrw();
 
-	while (*old_ptr) {
-		*upper_ptrw++ = _find_upper(*old_ptr++);
+	int i = 0;
+	while (i < len) {
+		i += StringSIMD::ascii_to_upper(old_ptr + i, upper_ptrw + i, len - i);
+		while (i < len && (uint32_t)old_ptr[i] >= 0x80) {
+			upper_ptrw[i] = _find_upper(old_ptr[i]);
+			i++;
+		}
 	}
 
-	*upper_ptrw = 0;
+	upper_ptrw[len] = 0;
 
 	return upper;
 }
@@ -1376,16 +1383,22 @@ String String::to_lower() const {
 		return *this;
 	}
 
+	const int len = length();
 	String lower;
 	lower.resize_uninitialized(size());
 	const char32_t *old_ptr = ptr();
 	char32_t *lower_ptrw = lower.ptrw();
 
-	while (*old_ptr) {
-		*lower_ptrw++ = _find_lower(*old_ptr++);
+	int i = 0;
+	while (i < len) {
+		i += StringSIMD::ascii_to_lower(old_ptr + i, lower_ptrw + i, len - i);
+		while (i < len && (uint32_t)old_ptr[i] >= 0x80) {
+			lower_ptrw[i] = _find_lower(old_ptr[i]);
+			i++;
+		}
 	}
 
-	*lower_ptrw = 0;
+	lower_ptrw[len] = 0;
 
 	return lower;
 }
@@ -1772,12 +1785,12 @@ Error String::append_utf8(const char *p_utf8, int p_len) {
 		uint32_t size = 1;
 
 		if ((c & 0b10000000) == 0) {
-			unicode = c;
-			if (unicode > 0x7F) {
-				unicode = _replacement_char;
-				print_unicode_error(vformat("Invalid unicode codepoint (%d)", unicode), true);
-				result = Error::ERR_INVALID_DATA;
-			}
+			// Copy whole runs of ASCII at once, they make up most text.
+			const int64_t ascii_length = StringSIMD::ascii_prefix_length(ptrtmp, ptr_limit - ptrtmp);
+			StringSIMD::widen(ptrtmp, dst, ascii_length);
+			dst += ascii_length;
+			ptrtmp += ascii_length;
+			continue;
 		} else if ((c & 0b11100000) == 0b11000000) {
 			if (ptrtmp + 1 >= ptr_limit) {
 				print_unicode_error(vformat("Missing %x UTF-8 continuation byte", c), true);
@@ -1921,8 +1934,14 @@ CharString String::utf8(Vector<uint8_t> *r_ch_length_map) const {
 	for (int i = 0; i < l; i++) {
 		uint32_t c = d[i];
 		int ch_w = 1;
-		if (c <= 0x7f) { // 7 bits.
-			ch_w = 1;
+		if (c <= 0x7f) { // 7 bits, counted a whole run at a time.
+			const int ascii_length = StringSIMD::ascii_prefix_length(d + i, l - i);
+			if (map_ptr) {
+				memset(map_ptr + i, 1, ascii_length);
+			}
+			fl += ascii_length;
+			i += ascii_length - 1;
+			continue;
 		} else if (c <= 0x7ff) { // 11 bits
 			ch_w = 2;
 		} else if (c <= 0xffff) { // 16 bits
@@ -1958,8 +1977,11 @@ CharString String::utf8(Vector<uint8_t> *r_ch_length_map) const {
 	for (int i = 0; i < l; i++) {
 		uint32_t c = d[i];
 
-		if (c <= 0x7f) { // 7 bits.
-			APPEND_CHAR(c);
+		if (c <= 0x7f) { // 7 bits, copied a whole run at a time.
+			const int ascii_length = StringSIMD::ascii_prefix_length(d + i, l - i);
+			StringSIMD::narrow(d + i, cdst, ascii_length);
+			cdst += ascii_length;
+			i += ascii_length - 1;
 		} else if (c <= 0x7ff) { // 11 bits
 			APPEND_CHAR(uint32_t(0xc0 | ((c >> 6) & 0x1f))); // Top 5 bits.
 			APPEND_CHAR(uint32_t(0x80 | (c & 0x3f))); // Bottom 6 bits.
@@ -2722,9 +2744,20 @@ uint32_t String::hash(const wchar_t *p_cstr) {
 	return hashv;
 }
 
+// djb2 over four characters at once: hash * 33^4 + c0 * 33^3 + c1 * 33^2 + c2 * 33 + c3.
+// Same result as one character at a time, but the products don't depend on each other.
+// SSE2 has no 32-bit multiply, so this is left to the compiler instead of vectorized.
+static _FORCE_INLINE_ uint32_t _hash_djb2_4(uint32_t p_hash, const char32_t *p_chars) {
+	return p_hash * 1185921u + (uint32_t)p_chars[0] * 35937u + (uint32_t)p_chars[1] * 1089u + (uint32_t)p_chars[2] * 33u + (uint32_t)p_chars[3];
+}
+
 uint32_t String::hash(const char32_t *p_cstr, int p_len) {
 	uint32_t hashv = 5381;
-	for (int i = 0; i < p_len; i++) {
+	int i = 0;
+	for (; i + 4 <= p_len; i += 4) {
+		hashv = _hash_djb2_4(hashv, p_cstr + i);
+	}
+	for (; i < p_len; i++) {
 		hashv = ((hashv << 5) + hashv) + p_cstr[i]; /* hash * 33 + c */
 	}
 
@@ -2748,6 +2781,15 @@ uint32_t String::hash() const {
 
 	const char32_t *chr = get_data();
 	uint32_t hashv = 5381;
+
+	// Stops at the first null character, like the loop below.
+	const int len = length();
+	int i = 0;
+	for (; i + 4 <= len && chr[i] && chr[i + 1] && chr[i + 2] && chr[i + 3]; i += 4) {
+		hashv = _hash_djb2_4(hashv, chr + i);
+	}
+	chr += i;
+
 	uint32_t c = *chr++;
 
 	while (c) {
@@ -3021,6 +3063,30 @@ String String::substr(int p_from, int p_chars) const {
 	return s;
 }
 
+// Looks for candidates with a vectorized search for the first character, then compares the rest.
+template <typename T>
+static int _find_sequence(const char32_t *p_src, int p_len, const T *p_key, int p_key_len, int p_from) {
+	const char32_t first = p_key[0];
+	const int last_start = p_len - p_key_len;
+	int i = p_from;
+	while (i <= last_start) {
+		const int64_t found = StringSIMD::find(p_src + i, last_start + 1 - i, first);
+		if (found < 0) {
+			return -1;
+		}
+		i += found;
+		int j = 1;
+		while (j < p_key_len && p_src[i + j] == (char32_t)p_key[j]) {
+			j++;
+		}
+		if (j == p_key_len) {
+			return i;
+		}
+		i++;
+	}
+	return -1;
+}
+
 int String::find(const String &p_str, int p_from) const {
 	const int str_len = p_str.length();
 	const int len = length();
@@ -3034,10 +3100,10 @@ int String::find(const String &p_str, int p_from) const {
 
 	if (p_str.length() == 1) {
 		// Optimize with single-char implementation.
-		return span().find(p_str[0], p_from);
+		return find_char(p_str[0], p_from);
 	}
 
-	return span().find_sequence(p_str.span(), p_from);
+	return _find_sequence(ptr(), len, p_str.ptr(), str_len, p_from);
 }
 
 int String::find(const char *p_str, int p_from) const {
@@ -3055,7 +3121,7 @@ int String::find(const char *p_str, int p_from) const {
 		return find_char(*p_str, p_from); // Optimize with single-char find.
 	}
 
-	return span().find_sequence(Span((const unsigned char *)p_str, str_len), p_from);
+	return _find_sequence(ptr(), len, (const unsigned char *)p_str, str_len, p_from);
 }
 
 int String::find_char(char32_t p_char, int p_from) const {
@@ -3065,7 +3131,8 @@ int String::find_char(char32_t p_char, int p_from) const {
 	if (p_from < 0 || p_from >= length()) {
 		return -1;
 	}
-	return span().find(p_char, p_from);
+	const int64_t found = StringSIMD::find(ptr() + p_from, length() - p_from, p_char);
+	return found < 0 ? -1 : p_from + found;
 }
 
 int String::findmk(const Vector<String> &p_keys, int p_from, int *r_key) const {
@@ -33,6 +33,7 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/os/condition_variable.h"
 #include "core/os/mutex.h"
+#include "core/os/thread.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/simple_type.h"
 #include "core/templates/tuple.h"
@@ -103,6 +104,64 @@ class CommandQueueMT {
 		_FORCE_INLINE_ auto &get() { return ::tuple_get<I>(args); }
 	};
 
+	/***** LOCK-FREE PRODUCERS *******/
+
+	// In lock-free mode, every producer thread appends commands to its own chain of
+	// segments without taking the mutex. Each command is stamped with a submission
+	// index from a shared counter, and the consumer merges the chains back in that
+	// order, so commands still run in the order they were pushed.
+
+	static const uint32_t LOCK_FREE_SEGMENT_SIZE = 16 * 1024;
+	static const uint32_t MAX_LOCK_FREE_PRODUCERS = 64;
+	static const uint32_t PRODUCER_CACHE_SIZE = 4;
+
+	struct CommandHeader {
+		uint64_t index = 0;
+		uint64_t size = 0;
+	};
+
+	struct Segment {
+		std::atomic<uint32_t> write_pos{ 0 };
+		std::atomic<Segment *> next{ nullptr };
+		alignas(uint64_t) uint8_t data[LOCK_FREE_SEGMENT_SIZE];
+	};
+
+	struct Producer {
+		// Only touched by the producer thread.
+		Thread::ID thread_id = Thread::UNASSIGNED_ID;
+		Segment *write_segment = nullptr;
+
+		char padding[Thread::CACHE_LINE_BYTES];
+
+		// Only touched by the consumer thread.
+		Segment *read_segment = nullptr;
+		uint32_t read_pos = 0;
+
+		// Fully consumed segment, handed back to the producer for reuse.
+		std::atomic<Segment *> spare{ nullptr };
+	};
+
+	// No member initializers, thread locals are zero-initialized anyway.
+	struct ProducerCacheEntry {
+		uint64_t queue_id;
+		Producer *producer;
+	};
+
+	inline static std::atomic<uint64_t> queue_id_counter{ 1 };
+	inline static thread_local ProducerCacheEntry producer_cache[PRODUCER_CACHE_SIZE];
+	inline static thread_local uint32_t producer_cache_next = 0;
+
+	bool lock_free = false;
+	uint64_t queue_id = 0;
+	std::atomic<uint32_t> producer_count{ 0 };
+	std::atomic<Producer *> producers[MAX_LOCK_FREE_PRODUCERS] = {};
+	// Used by threads registering after all the slots are taken, under the mutex.
+	Producer *shared_producer = nullptr;
+	std::atomic<uint64_t> submit_index{ 0 };
+	std::atomic<bool> consumer_active{ false };
+	uint64_t consume_index = 0;
+	uint64_t sync_done_index = 0;
+
 	/***** BASE *******/
 
 	static const uint32_t DEFAULT_COMMAND_MEM_SIZE_KB = 64;
@@ -115,7 +174,7 @@ class CommandQueueMT {
 	uint32_t sync_head = 0;
 	uint32_t sync_tail = 0;
 	uint32_t sync_awaiters = 0;
-	WorkerThreadPool::TaskID pump_task_id = WorkerThreadPool::INVALID_TASK_ID;
+	std::atomic<WorkerThreadPool::TaskID> pump_task_id{ WorkerThreadPool::INVALID_TASK_ID };
 	uint64_t flush_read_ptr = 0;
 	std::atomic<bool> pending{ false };
 
@@ -133,8 +192,247 @@ class CommandQueueMT {
 		pending.store(true);
 	}
 
+	static Producer *_create_producer(Thread::ID p_thread_id) {
+		Producer *producer = memnew(Producer);
+		producer->thread_id = p_thread_id;
+		producer->write_segment = memnew(Segment);
+		producer->read_segment = producer->write_segment;
+		return producer;
+	}
+
+	static void _free_producer(Producer *p_producer) {
+		Segment *segment = p_producer->read_segment;
+		while (segment) {
+			Segment *next = segment->next.load(std::memory_order_relaxed);
+			memdelete(segment);
+			segment = next;
+		}
+		Segment *spare = p_producer->spare.load(std::memory_order_relaxed);
+		if (spare) {
+			memdelete(spare);
+		}
+		memdelete(p_producer);
+	}
+
+	Producer *_register_producer() {
+		const Thread::ID thread_id = Thread::get_caller_id();
+		if (unlikely(thread_id == Thread::UNASSIGNED_ID)) {
+			// Not a thread we can tell apart from others.
+			return shared_producer;
+		}
+
+		Producer *producer = nullptr;
+
+		// The thread may already own a producer that fell out of its cache.
+		uint32_t count = MIN(producer_count.load(std::memory_order_acquire), MAX_LOCK_FREE_PRODUCERS);
+		for (uint32_t i = 0; i < count; i++) {
+			Producer *p = producers[i].load(std::memory_order_acquire);
+			if (p && p->thread_id == thread_id) {
+				producer = p;
+				break;
+			}
+		}
+
+		if (!producer) {
+			uint32_t slot = producer_count.fetch_add(1, std::memory_order_acq_rel);
+			if (likely(slot < MAX_LOCK_FREE_PRODUCERS)) {
+				producer = _create_producer(thread_id);
+				producers[slot].store(producer, std::memory_order_release);
+			} else {
+				producer = shared_producer;
+			}
+		}
+
+		ProducerCacheEntry &entry = producer_cache[producer_cache_next++ % PRODUCER_CACHE_SIZE];
+		entry.queue_id = queue_id;
+		entry.producer = producer;
+		return producer;
+	}
+
+	_FORCE_INLINE_ Producer *_get_producer() {
+		for (uint32_t i = 0; i < PRODUCER_CACHE_SIZE; i++) {
+			if (producer_cache[i].queue_id == queue_id) {
+				return producer_cache[i].producer;
+			}
+		}
+		return _register_producer();
+	}
+
+	Segment *_append_segment(Producer *p_producer) {
+		Segment *segment = p_producer->spare.exchange(nullptr, std::memory_order_acquire);
+		if (segment) {
+			segment->write_pos.store(0, std::memory_order_relaxed);
+			segment->next.store(nullptr, std::memory_order_relaxed);
+		} else {
+			segment = memnew(Segment);
+		}
+		p_producer->write_segment->next.store(segment, std::memory_order_release);
+		p_producer->write_segment = segment;
+		return segment;
+	}
+
+	template <typename T, typename... Args>
+	_FORCE_INLINE_ uint64_t _write_command(Producer *p_producer, Args &&...p_args) {
+		constexpr uint32_t alloc_size = sizeof(CommandHeader) + ((sizeof(T) + 8U - 1U) & ~(8U - 1U));
+		static_assert(alloc_size <= LOCK_FREE_SEGMENT_SIZE, "Type too large to fit in a command queue segment.");
+
+		Segment *segment = p_producer->write_segment;
+		uint32_t pos = segment->write_pos.load(std::memory_order_relaxed);
+		if (unlikely(pos + alloc_size > LOCK_FREE_SEGMENT_SIZE)) {
+			segment = _append_segment(p_producer);
+			pos = 0;
+		}
+
+		CommandHeader *header = reinterpret_cast<CommandHeader *>(&segment->data[pos]);
+		header->size = alloc_size;
+		memnew_placement(header + 1, T(std::forward<Args>(p_args)...));
+		// Take the index as late as possible, as the consumer has to wait for it to be published.
+		const uint64_t index = submit_index.fetch_add(1);
+		header->index = index;
+		segment->write_pos.store(pos + alloc_size, std::memory_order_release);
+		return index;
+	}
+
+	template <typename T, bool NeedsSync, typename... Args>
+	_FORCE_INLINE_ void _push_lock_free(Args &&...args) {
+		Producer *producer = _get_producer();
+		uint64_t index;
+		if (unlikely(producer == shared_producer)) {
+			MutexLock mlock(mutex);
+			index = _write_command<T>(producer, std::forward<Args>(args)...);
+		} else {
+			index = _write_command<T>(producer, std::forward<Args>(args)...);
+		}
+
+		// Only the push that makes the queue pending has to wake the consumer up, since it
+		// keeps draining until it catches up with the submission index.
+		if (!pending.load() && !pending.exchange(true)) {
+			WorkerThreadPool::TaskID task_id = pump_task_id.load(std::memory_order_relaxed);
+			if (task_id != WorkerThreadPool::INVALID_TASK_ID) {
+				WorkerThreadPool::get_singleton()->notify_yield_over(task_id);
+			}
+		}
+
+		if constexpr (NeedsSync) {
+			MutexLock mlock(mutex);
+			while (sync_done_index <= index) {
+				sync_cond_var.wait(mlock);
+			}
+		}
+	}
+
+	// Returns the next command of the producer, if it has been published already.
+	_FORCE_INLINE_ CommandHeader *_peek_command(Producer *p_producer) {
+		Segment *segment = p_producer->read_segment;
+		while (true) {
+			if (p_producer->read_pos < segment->write_pos.load(std::memory_order_acquire)) {
+				return reinterpret_cast<CommandHeader *>(&segment->data[p_producer->read_pos]);
+			}
+			Segment *next = segment->next.load(std::memory_order_acquire);
+			if (!next) {
+				return nullptr;
+			}
+			// The producer is done with this segment, but may have written to it before moving on.
+			if (p_producer->read_pos < segment->write_pos.load(std::memory_order_acquire)) {
+				continue;
+			}
+			p_producer->read_segment = next;
+			p_producer->read_pos = 0;
+			Segment *old_spare = p_producer->spare.exchange(segment, std::memory_order_acq_rel);
+			if (old_spare) {
+				memdelete(old_spare);
+			}
+			segment = next;
+		}
+	}
+
+	Producer *_find_producer_for_index(uint64_t p_index, CommandHeader *&r_header) {
+		uint32_t count = MIN(producer_count.load(std::memory_order_acquire), MAX_LOCK_FREE_PRODUCERS);
+		for (uint32_t i = 0; i <= count; i++) {
+			Producer *producer = i < count ? producers[i].load(std::memory_order_acquire) : shared_producer;
+			if (!producer) {
+				continue;
+			}
+			CommandHeader *header = _peek_command(producer);
+			if (header && header->index == p_index) {
+				r_header = header;
+				return producer;
+			}
+		}
+		return nullptr;
+	}
+
+	void _flush_lock_free() {
+		if (consumer_active.exchange(true)) {
+			// Another thread is flushing.
+			sync();
+			return;
+		}
+
+		flushing = true;
+		while (true) {
+			_consume_lock_free();
+
+			const uint64_t consumed = consume_index;
+			consumer_active.store(false);
+
+			// A command pushed after the last check of the submission index would be left behind,
+			// along with any thread waiting for it in sync() because this thread was flushing.
+			// If another thread took over flushing in the meantime, it will pick it up instead.
+			if (submit_index.load() == consumed || consumer_active.exchange(true)) {
+				break;
+			}
+		}
+		flushing = false;
+	}
+
+	void _consume_lock_free() {
+		pending.store(false);
+
+		Producer *producer = nullptr;
+		uint64_t end = submit_index.load();
+		while (consume_index < end) {
+			CommandHeader *header = producer ? _peek_command(producer) : nullptr;
+			if (!header || header->index != consume_index) {
+				// Consecutive commands usually come from the same producer, only search when switching.
+				producer = _find_producer_for_index(consume_index, header);
+				if (!producer) {
+					// The command has an index but is still being written.
+					Thread::yield();
+					continue;
+				}
+			}
+
+			CommandBase *cmd = reinterpret_cast<CommandBase *>(header + 1);
+			cmd->call();
+
+			if (unlikely(cmd->sync)) {
+				{
+					MutexLock lock(mutex);
+					sync_done_index = consume_index + 1;
+				}
+				sync_cond_var.notify_all();
+			}
+
+			cmd->~CommandBase();
+
+			producer->read_pos += header->size;
+			consume_index++;
+
+			if (consume_index == end) {
+				// Pick up anything pushed while flushing, like the locked mode does.
+				end = submit_index.load();
+			}
+		}
+	}
+
 	template <typename T, bool NeedsSync, typename... Args>
 	_FORCE_INLINE_ void _push_internal(Args &&...args) {
+		if (lock_free) {
+			_push_lock_free<T, NeedsSync>(std::forward<Args>(args)...);
+			return;
+		}
+
 		MutexLock mlock(mutex);
 		create_command<T>(std::forward<Args>(args)...);
 
@@ -163,6 +461,11 @@ class CommandQueueMT {
 			return;
 		}
 
+		if (lock_free) {
+			_flush_lock_free();
+			return;
+		}
+
 		flushing = true;
 
 		MutexLock lock(mutex);
@@ -275,7 +578,38 @@ public:
 		pump_task_id = p_task_id;
 	}
 
+	// Lets producer threads push without contending on the mutex.
+	// Must be set before the pump task is started and before any thread starts pushing commands,
+	// since the consumer reads the mode without locking.
+	void set_lock_free_producers(bool p_enable) {
+		MutexLock lock(mutex);
+		ERR_FAIL_COND_MSG(pump_task_id != WorkerThreadPool::INVALID_TASK_ID, "Can't change the producer mode of a command queue once its pump task is running.");
+		ERR_FAIL_COND_MSG(pending.load(), "Can't change the producer mode of a command queue with pending commands.");
+		lock_free = p_enable;
+		if (lock_free && !shared_producer) {
+			shared_producer = _create_producer(Thread::UNASSIGNED_ID);
+		}
+	}
+
+	bool is_using_lock_free_producers() const {
+		return lock_free;
+	}
+
 	CommandQueueMT() {
 		command_mem.reserve(DEFAULT_COMMAND_MEM_SIZE_KB * 1024);
+		queue_id = queue_id_counter.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	~CommandQueueMT() {
+		uint32_t count = MIN(producer_count.load(std::memory_order_acquire), MAX_LOCK_FREE_PRODUCERS);
+		for (uint32_t i = 0; i < count; i++) {
+			Producer *producer = producers[i].load(std::memory_order_acquire);
+			if (producer) {
+				_free_producer(producer);
+			}
+		}
+		if (shared_producer) {
+			_free_producer(shared_producer);
+		}
 	}
 };
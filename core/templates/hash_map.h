@@ -65,7 +65,8 @@ struct HashMapElement {
 template <typename TKey, typename TValue,
 		typename Hasher = HashMapHasherDefault,
 		typename Comparator = HashMapComparatorDefault<TKey>,
-		typename Allocator = DefaultTypedAllocator<HashMapElement<TKey, TValue>>>
+		typename Allocator = DefaultTypedAllocator<HashMapElement<TKey, TValue>>,
+		typename TableAllocator = DefaultAllocator>
 class HashMap : private Allocator {
 public:
 	static constexpr uint32_t MIN_CAPACITY_INDEX = 2; // Use a prime.
@@ -168,6 +169,22 @@ private:
 		}
 	}
 
+	_FORCE_INLINE_ void _alloc_table(uint32_t p_capacity) {
+		static_assert(EMPTY_HASH == 0, "Assuming EMPTY_HASH = 0 for zeroed hash allocation");
+		if constexpr (std::is_same_v<TableAllocator, DefaultAllocator>) {
+			_hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static_zeroed(sizeof(uint32_t) * p_capacity));
+		} else {
+			_hashes = reinterpret_cast<uint32_t *>(TableAllocator::alloc(sizeof(uint32_t) * p_capacity));
+			memset(_hashes, 0, sizeof(uint32_t) * p_capacity);
+		}
+		_elements = reinterpret_cast<HashMapElement<TKey, TValue> **>(TableAllocator::alloc(sizeof(HashMapElement<TKey, TValue> *) * p_capacity));
+	}
+
+	_FORCE_INLINE_ static void _free_table(HashMapElement<TKey, TValue> **p_elements, uint32_t *p_hashes) {
+		TableAllocator::free(p_elements);
+		TableAllocator::free(p_hashes);
+	}
+
 	void _resize_and_rehash(uint32_t p_new_capacity_idx) {
 		uint32_t old_capacity = hash_table_size_primes[_capacity_idx];
 
@@ -180,10 +197,7 @@ private:
 		uint32_t *old_hashes = _hashes;
 
 		_size = 0;
-		static_assert(EMPTY_HASH == 0, "Assuming EMPTY_HASH = 0 for alloc_static_zeroed call");
-
-		_hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static_zeroed(sizeof(uint32_t) * capacity));
-		_elements = reinterpret_cast<HashMapElement<TKey, TValue> **>(Memory::alloc_static(sizeof(HashMapElement<TKey, TValue> *) * capacity));
+		_alloc_table(capacity);
 
 		if (old_capacity == 0) {
 			// Nothing to do.
@@ -198,8 +212,7 @@ private:
 			_insert_element(old_hashes[i], old_elements[i]);
 		}
 
-		Memory::free_static(old_elements);
-		Memory::free_static(old_hashes);
+		_free_table(old_elements, old_hashes);
 	}
 
 	_FORCE_INLINE_ HashMapElement<TKey, TValue> *_insert(const TKey &p_key, const TValue &p_value, uint32_t p_hash, bool p_front_insert = false) {
@@ -207,9 +220,7 @@ private:
 		if (unlikely(_elements == nullptr)) {
 			// Allocate on demand to save memory.
 
-			static_assert(EMPTY_HASH == 0, "Assuming EMPTY_HASH = 0 for alloc_static_zeroed call");
-			_hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static_zeroed(sizeof(uint32_t) * capacity));
-			_elements = reinterpret_cast<HashMapElement<TKey, TValue> **>(Memory::alloc_static(sizeof(HashMapElement<TKey, TValue> *) * capacity));
+			_alloc_table(capacity);
 		}
 
 		if (_size + 1 > MAX_OCCUPANCY * capacity) {
@@ -638,8 +649,7 @@ public:
 			clear();
 		}
 		if (_elements != nullptr) {
-			Memory::free_static(_elements);
-			Memory::free_static(_hashes);
+			_free_table(_elements, _hashes);
 		}
 
 		_elements = p_other._elements;
@@ -694,8 +704,7 @@ public:
 		_clear_data();
 
 		if (_elements != nullptr) {
-			Memory::free_static(_elements);
-			Memory::free_static(_hashes);
+			_free_table(_elements, _hashes);
 		}
 	}
 };
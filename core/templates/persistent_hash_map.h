@@ -0,0 +1,447 @@
+/**************************************************************************/
+/*  persistent_hash_map.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
+
+#include <initializer_list>
+
+/**
+ * A hash map whose copies share their entries, in a hash array mapped trie.
+ * Each node indexes its entries and children by 5 bits of the key hashes, so
+ * modifying one copy only duplicates the few nodes on the path to the modified
+ * key. Taking a snapshot is O(1), and every version only costs memory for what
+ * changed.
+ *
+ * Lookups, insertions and removals visit at most 8 nodes. Unlike HashMap,
+ * iteration order follows the key hashes instead of the insertion order.
+ */
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class PersistentHashMap {
+	static constexpr uint32_t BITS = 5;
+	static constexpr uint32_t MASK = (1 << BITS) - 1;
+	// Below all hash bits, the entries that are left have colliding hashes and are kept in a plain list.
+	static constexpr uint32_t HASH_BITS = 32;
+	static constexpr uint32_t MAX_DEPTH = (HASH_BITS + BITS - 1) / BITS + 1;
+
+	struct Entry {
+		KeyValue<TKey, TValue> data;
+		uint32_t hash;
+	};
+
+	struct Node {
+		SafeRefCount refcount;
+		uint32_t entry_map = 0; // Hash slices that hold an entry.
+		uint32_t child_map = 0; // Hash slices that hold a child node.
+		uint32_t entry_count = 0;
+		uint32_t child_count = 0;
+		Entry *entries = nullptr; // In hash slice order, or in insertion order for colliding hashes.
+		Node **children = nullptr;
+
+		Node() { refcount.init(); }
+	};
+
+	Node *root = nullptr;
+	uint32_t count = 0;
+
+	static _FORCE_INLINE_ uint32_t _slice_bit(uint32_t p_hash, uint32_t p_shift) {
+		return 1u << ((p_hash >> p_shift) & MASK);
+	}
+
+	static _FORCE_INLINE_ uint32_t _position(uint32_t p_map, uint32_t p_bit) {
+		return count_set_bits(p_map & (p_bit - 1));
+	}
+
+	static _FORCE_INLINE_ bool _matches(const Entry &p_entry, const TKey &p_key, uint32_t p_hash) {
+		return p_entry.hash == p_hash && Comparator::compare(p_entry.data.key, p_key);
+	}
+
+	// Entry and child arrays are sized exactly, nodes are small and mostly copied rather than grown.
+	static void _insert_entry(Node *p_node, uint32_t p_pos, Entry &&p_entry) {
+		Entry *entries = (Entry *)Memory::alloc_static(sizeof(Entry) * (p_node->entry_count + 1));
+		for (uint32_t i = 0; i < p_pos; i++) {
+			memnew_placement(&entries[i], Entry(std::move(p_node->entries[i])));
+			p_node->entries[i].~Entry();
+		}
+		memnew_placement(&entries[p_pos], Entry(std::move(p_entry)));
+		for (uint32_t i = p_pos; i < p_node->entry_count; i++) {
+			memnew_placement(&entries[i + 1], Entry(std::move(p_node->entries[i])));
+			p_node->entries[i].~Entry();
+		}
+		if (p_node->entries) {
+			Memory::free_static(p_node->entries);
+		}
+		p_node->entries = entries;
+		p_node->entry_count++;
+	}
+
+	static void _remove_entry(Node *p_node, uint32_t p_pos) {
+		Entry *entries = p_node->entry_count > 1 ? (Entry *)Memory::alloc_static(sizeof(Entry) * (p_node->entry_count - 1)) : nullptr;
+		for (uint32_t i = 0; i < p_node->entry_count; i++) {
+			if (i != p_pos) {
+				memnew_placement(&entries[i < p_pos ? i : i - 1], Entry(std::move(p_node->entries[i])));
+			}
+			p_node->entries[i].~Entry();
+		}
+		Memory::free_static(p_node->entries);
+		p_node->entries = entries;
+		p_node->entry_count--;
+	}
+
+	static void _insert_child(Node *p_node, uint32_t p_pos, Node *p_child) {
+		p_node->children = (Node **)Memory::realloc_static(p_node->children, sizeof(Node *) * (p_node->child_count + 1));
+		memmove(&p_node->children[p_pos + 1], &p_node->children[p_pos], sizeof(Node *) * (p_node->child_count - p_pos));
+		p_node->children[p_pos] = p_child;
+		p_node->child_count++;
+	}
+
+	static void _remove_child(Node *p_node, uint32_t p_pos) {
+		p_node->child_count--;
+		if (p_node->child_count == 0) {
+			Memory::free_static(p_node->children);
+			p_node->children = nullptr;
+			return;
+		}
+		memmove(&p_node->children[p_pos], &p_node->children[p_pos + 1], sizeof(Node *) * (p_node->child_count - p_pos));
+	}
+
+	static void _unref(Node *p_node) {
+		if (!p_node || !p_node->refcount.unref()) {
+			return;
+		}
+		for (uint32_t i = 0; i < p_node->entry_count; i++) {
+			p_node->entries[i].~Entry();
+		}
+		if (p_node->entries) {
+			Memory::free_static(p_node->entries);
+		}
+		for (uint32_t i = 0; i < p_node->child_count; i++) {
+			_unref(p_node->children[i]);
+		}
+		if (p_node->children) {
+			Memory::free_static(p_node->children);
+		}
+		memdelete(p_node);
+	}
+
+	// Nodes referenced only once belong to this map alone and can be modified in place.
+	static Node *_unique(Node *p_node) {
+		if (p_node->refcount.get() == 1) {
+			return p_node;
+		}
+		Node *copy = memnew(Node);
+		copy->entry_map = p_node->entry_map;
+		copy->child_map = p_node->child_map;
+		copy->entry_count = p_node->entry_count;
+		copy->child_count = p_node->child_count;
+		if (p_node->entry_count) {
+			copy->entries = (Entry *)Memory::alloc_static(sizeof(Entry) * p_node->entry_count);
+			for (uint32_t i = 0; i < p_node->entry_count; i++) {
+				memnew_placement(&copy->entries[i], Entry(p_node->entries[i]));
+			}
+		}
+		if (p_node->child_count) {
+			copy->children = (Node **)Memory::alloc_static(sizeof(Node *) * p_node->child_count);
+			for (uint32_t i = 0; i < p_node->child_count; i++) {
+				copy->children[i] = p_node->children[i];
+				copy->children[i]->refcount.ref();
+			}
+		}
+		_unref(p_node);
+		return copy;
+	}
+
+	const Entry *_find(const TKey &p_key, uint32_t p_hash) const {
+		const Node *node = root;
+		for (uint32_t shift = 0; node; shift += BITS) {
+			if (shift >= HASH_BITS) {
+				for (uint32_t i = 0; i < node->entry_count; i++) {
+					if (_matches(node->entries[i], p_key, p_hash)) {
+						return &node->entries[i];
+					}
+				}
+				return nullptr;
+			}
+			const uint32_t bit = _slice_bit(p_hash, shift);
+			if (node->entry_map & bit) {
+				const Entry &entry = node->entries[_position(node->entry_map, bit)];
+				return _matches(entry, p_key, p_hash) ? &entry : nullptr;
+			}
+			if (!(node->child_map & bit)) {
+				return nullptr;
+			}
+			node = node->children[_position(node->child_map, bit)];
+		}
+		return nullptr;
+	}
+
+	// Returns the entry for `p_key` in `p_node`, which must be unique, adding it with a default value if needed.
+	static Entry *_insert(Node *p_node, uint32_t p_shift, const TKey &p_key, uint32_t p_hash, bool &r_inserted) {
+		if (p_shift >= HASH_BITS) {
+			for (uint32_t i = 0; i < p_node->entry_count; i++) {
+				if (_matches(p_node->entries[i], p_key, p_hash)) {
+					return &p_node->entries[i];
+				}
+			}
+			r_inserted = true;
+			_insert_entry(p_node, p_node->entry_count, Entry{ KeyValue<TKey, TValue>(p_key, TValue()), p_hash });
+			return &p_node->entries[p_node->entry_count - 1];
+		}
+
+		const uint32_t bit = _slice_bit(p_hash, p_shift);
+		if (p_node->child_map & bit) {
+			Node *&child = p_node->children[_position(p_node->child_map, bit)];
+			child = _unique(child);
+			return _insert(child, p_shift + BITS, p_key, p_hash, r_inserted);
+		}
+
+		const uint32_t entry_pos = _position(p_node->entry_map, bit);
+		if (!(p_node->entry_map & bit)) {
+			r_inserted = true;
+			p_node->entry_map |= bit;
+			_insert_entry(p_node, entry_pos, Entry{ KeyValue<TKey, TValue>(p_key, TValue()), p_hash });
+			return &p_node->entries[entry_pos];
+		}
+
+		Entry &existing = p_node->entries[entry_pos];
+		if (_matches(existing, p_key, p_hash)) {
+			return &existing;
+		}
+
+		// Both keys fall in the same slice, move them one level down.
+		Node *child = memnew(Node);
+		bool moved = false;
+		_insert(child, p_shift + BITS, existing.data.key, existing.hash, moved)->data.value = std::move(existing.data.value);
+		Entry *inserted = _insert(child, p_shift + BITS, p_key, p_hash, r_inserted);
+		_remove_entry(p_node, entry_pos);
+		p_node->entry_map &= ~bit;
+		p_node->child_map |= bit;
+		_insert_child(p_node, _position(p_node->child_map, bit), child);
+		return inserted;
+	}
+
+	// Erases `p_key` from `p_node`, which must be unique and hold the key.
+	static void _erase(Node *p_node, uint32_t p_shift, const TKey &p_key, uint32_t p_hash) {
+		if (p_shift >= HASH_BITS) {
+			for (uint32_t i = 0; i < p_node->entry_count; i++) {
+				if (_matches(p_node->entries[i], p_key, p_hash)) {
+					_remove_entry(p_node, i);
+					return;
+				}
+			}
+			return;
+		}
+
+		const uint32_t bit = _slice_bit(p_hash, p_shift);
+		if (p_node->entry_map & bit) {
+			_remove_entry(p_node, _position(p_node->entry_map, bit));
+			p_node->entry_map &= ~bit;
+			return;
+		}
+
+		const uint32_t child_pos = _position(p_node->child_map, bit);
+		Node *child = _unique(p_node->children[child_pos]);
+		p_node->children[child_pos] = child;
+		_erase(child, p_shift + BITS, p_key, p_hash);
+
+		// A child left with a single entry is merged back, so that lookups don't go deeper than needed.
+		if (child->child_count == 0 && child->entry_count <= 1) {
+			if (child->entry_count == 1) {
+				p_node->entry_map |= bit;
+				_insert_entry(p_node, _position(p_node->entry_map, bit), std::move(child->entries[0]));
+			}
+			_remove_child(p_node, child_pos);
+			p_node->child_map &= ~bit;
+			_unref(child);
+		}
+	}
+
+public:
+	class ConstIterator {
+		friend class PersistentHashMap;
+
+		struct Frame {
+			const Node *node = nullptr;
+			uint32_t index = 0; // Entries first, then children.
+		};
+
+		Frame stack[MAX_DEPTH];
+		uint32_t depth = 0;
+
+		// Moves to the first entry at or after the current position.
+		void _seek() {
+			while (depth > 0) {
+				Frame &frame = stack[depth - 1];
+				if (frame.index < frame.node->entry_count) {
+					return;
+				}
+				const uint32_t child = frame.index - frame.node->entry_count;
+				if (child < frame.node->child_count) {
+					frame.index++;
+					stack[depth++] = { frame.node->children[child], 0 };
+				} else {
+					depth--;
+				}
+			}
+		}
+
+		ConstIterator(const Node *p_root) {
+			if (p_root) {
+				stack[depth++] = { p_root, 0 };
+				_seek();
+			}
+		}
+
+	public:
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> &operator*() const {
+			const Frame &frame = stack[depth - 1];
+			return frame.node->entries[frame.index].data;
+		}
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> *operator->() const { return &operator*(); }
+		ConstIterator &operator++() {
+			stack[depth - 1].index++;
+			_seek();
+			return *this;
+		}
+
+		bool operator==(const ConstIterator &p_other) const {
+			if (depth != p_other.depth) {
+				return false;
+			}
+			return depth == 0 || (stack[depth - 1].node == p_other.stack[depth - 1].node && stack[depth - 1].index == p_other.stack[depth - 1].index);
+		}
+		bool operator!=(const ConstIterator &p_other) const { return !operator==(p_other); }
+
+		ConstIterator() = default;
+	};
+
+	_FORCE_INLINE_ ConstIterator begin() const { return ConstIterator(root); }
+	_FORCE_INLINE_ ConstIterator end() const { return ConstIterator(); }
+
+	_FORCE_INLINE_ uint32_t size() const { return count; }
+	_FORCE_INLINE_ bool is_empty() const { return count == 0; }
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		return _find(p_key, Hasher::hash(p_key)) != nullptr;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		const Entry *entry = _find(p_key, Hasher::hash(p_key));
+		return entry ? &entry->data.value : nullptr;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		const TValue *value = getptr(p_key);
+		CRASH_COND_MSG(!value, "PersistentHashMap key not found.");
+		return *value;
+	}
+
+	_FORCE_INLINE_ const TValue &operator[](const TKey &p_key) const { return get(p_key); }
+
+	void insert(const TKey &p_key, const TValue &p_value) {
+		ERR_FAIL_COND_MSG(count == UINT32_MAX, "PersistentHashMap is full.");
+		root = root ? _unique(root) : memnew(Node);
+		bool inserted = false;
+		_insert(root, 0, p_key, Hasher::hash(p_key), inserted)->data.value = p_value;
+		if (inserted) {
+			count++;
+		}
+	}
+
+	bool erase(const TKey &p_key) {
+		const uint32_t hash = Hasher::hash(p_key);
+		// Checked first, so that erasing a missing key doesn't copy any shared node.
+		if (!_find(p_key, hash)) {
+			return false;
+		}
+		count--;
+		if (count == 0) {
+			clear();
+			return true;
+		}
+		root = _unique(root);
+		_erase(root, 0, p_key, hash);
+		return true;
+	}
+
+	void clear() {
+		_unref(root);
+		root = nullptr;
+		count = 0;
+	}
+
+	// Whether both maps share all of their entries, so that they are equal without comparing them.
+	_FORCE_INLINE_ bool is_same_storage(const PersistentHashMap &p_other) const {
+		return root == p_other.root;
+	}
+
+	void operator=(const PersistentHashMap &p_from) {
+		if (this == &p_from) {
+			return;
+		}
+		if (p_from.root) {
+			p_from.root->refcount.ref();
+		}
+		clear();
+		root = p_from.root;
+		count = p_from.count;
+	}
+
+	void operator=(PersistentHashMap &&p_from) {
+		if (this == &p_from) {
+			return;
+		}
+		clear();
+		root = p_from.root;
+		count = p_from.count;
+		p_from.root = nullptr;
+		p_from.count = 0;
+	}
+
+	PersistentHashMap() {}
+	PersistentHashMap(const PersistentHashMap &p_from) { operator=(p_from); }
+	PersistentHashMap(PersistentHashMap &&p_from) { operator=(std::move(p_from)); }
+	PersistentHashMap(std::initializer_list<KeyValue<TKey, TValue>> p_init) {
+		for (const KeyValue<TKey, TValue> &E : p_init) {
+			insert(E.key, E.value);
+		}
+	}
+
+	~PersistentHashMap() {
+		clear();
+	}
+};
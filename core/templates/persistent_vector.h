@@ -0,0 +1,368 @@
+/**************************************************************************/
+/*  persistent_vector.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+#include "core/templates/safe_refcount.h"
+
+#include <initializer_list>
+
+/**
+ * A vector whose copies share their elements, like Vector, but in a tree of
+ * 32-element blocks instead of a single buffer. Modifying one copy only
+ * duplicates the blocks on the path to the modified element, so taking a
+ * snapshot is O(1) and every version only costs memory for what changed.
+ *
+ * Reading or writing an element is O(log32 n). Appending and removing the last
+ * element are amortized O(1), as the last block is kept outside of the tree.
+ */
+template <typename T>
+class PersistentVector {
+	static constexpr uint32_t BITS = 5;
+	static constexpr uint32_t WIDTH = 1 << BITS;
+	static constexpr uint32_t MASK = WIDTH - 1;
+
+	struct Node {
+		SafeRefCount refcount;
+
+		Node() { refcount.init(); }
+	};
+
+	struct Branch : Node {
+		Node *children[WIDTH] = {};
+	};
+
+	struct Leaf : Node {
+		T elements[WIDTH];
+	};
+
+	Branch *root = nullptr; // Holds the full blocks, `shift` bits above them.
+	Leaf *tail = nullptr; // The last block, which may not be full.
+	uint32_t count = 0;
+	uint32_t shift = BITS;
+
+	_FORCE_INLINE_ uint32_t _tail_offset() const {
+		return count < WIDTH ? 0 : ((count - 1) >> BITS) << BITS;
+	}
+
+	static void _unref(Node *p_node, uint32_t p_level) {
+		if (!p_node || !p_node->refcount.unref()) {
+			return;
+		}
+		if (p_level == 0) {
+			memdelete(static_cast<Leaf *>(p_node));
+			return;
+		}
+		Branch *branch = static_cast<Branch *>(p_node);
+		for (Node *child : branch->children) {
+			_unref(child, p_level - BITS);
+		}
+		memdelete(branch);
+	}
+
+	// Nodes referenced only once belong to this vector alone and can be modified in place.
+	static Leaf *_unique_leaf(Node *p_node) {
+		Leaf *leaf = static_cast<Leaf *>(p_node);
+		if (leaf->refcount.get() == 1) {
+			return leaf;
+		}
+		Leaf *copy = memnew(Leaf);
+		for (uint32_t i = 0; i < WIDTH; i++) {
+			copy->elements[i] = leaf->elements[i];
+		}
+		_unref(leaf, 0);
+		return copy;
+	}
+
+	static Branch *_unique_branch(Node *p_node, uint32_t p_level) {
+		Branch *branch = static_cast<Branch *>(p_node);
+		if (branch->refcount.get() == 1) {
+			return branch;
+		}
+		Branch *copy = memnew(Branch);
+		for (uint32_t i = 0; i < WIDTH; i++) {
+			copy->children[i] = branch->children[i];
+			if (copy->children[i]) {
+				copy->children[i]->refcount.ref();
+			}
+		}
+		_unref(branch, p_level);
+		return copy;
+	}
+
+	const Leaf *_leaf_for(uint32_t p_index) const {
+		if (p_index >= _tail_offset()) {
+			return tail;
+		}
+		const Node *node = root;
+		for (uint32_t level = shift; level > 0; level -= BITS) {
+			node = static_cast<const Branch *>(node)->children[(p_index >> level) & MASK];
+		}
+		return static_cast<const Leaf *>(node);
+	}
+
+	Leaf *_writable_leaf_for(uint32_t p_index) {
+		if (p_index >= _tail_offset()) {
+			tail = _unique_leaf(tail);
+			return tail;
+		}
+		root = _unique_branch(root, shift);
+		Branch *branch = root;
+		for (uint32_t level = shift; level > BITS; level -= BITS) {
+			Node *&child = branch->children[(p_index >> level) & MASK];
+			child = _unique_branch(child, level - BITS);
+			branch = static_cast<Branch *>(child);
+		}
+		Node *&leaf = branch->children[(p_index >> BITS) & MASK];
+		leaf = _unique_leaf(leaf);
+		return static_cast<Leaf *>(leaf);
+	}
+
+	// Returns a node `p_level` bits above `p_leaf`, which holds only that leaf.
+	static Node *_new_path(uint32_t p_level, Leaf *p_leaf) {
+		if (p_level == 0) {
+			return p_leaf;
+		}
+		Branch *branch = memnew(Branch);
+		branch->children[0] = _new_path(p_level - BITS, p_leaf);
+		return branch;
+	}
+
+	void _push_tail_into(Branch *p_branch, uint32_t p_level, uint32_t p_index) {
+		Node *&child = p_branch->children[(p_index >> p_level) & MASK];
+		if (p_level == BITS) {
+			child = tail;
+		} else if (child) {
+			child = _unique_branch(child, p_level - BITS);
+			_push_tail_into(static_cast<Branch *>(child), p_level - BITS, p_index);
+		} else {
+			child = _new_path(p_level - BITS, tail);
+		}
+	}
+
+	// Moves the full tail into the tree, leaving no tail.
+	void _push_tail() {
+		if (!root) {
+			root = memnew(Branch);
+		} else if ((count >> BITS) > (1u << shift)) {
+			// The tree is full, grow it by one level.
+			Branch *new_root = memnew(Branch);
+			new_root->children[0] = root;
+			new_root->children[1] = _new_path(shift, tail);
+			root = new_root;
+			shift += BITS;
+			tail = nullptr;
+			return;
+		} else {
+			root = _unique_branch(root, shift);
+		}
+		_push_tail_into(root, shift, count - WIDTH);
+		tail = nullptr;
+	}
+
+	// Removes the leaf holding `p_index`, the last one of the tree. Returns true if `p_branch` is left empty.
+	bool _pop_tail_from(Branch *p_branch, uint32_t p_level, uint32_t p_index) {
+		const uint32_t child_index = (p_index >> p_level) & MASK;
+		Node *&child = p_branch->children[child_index];
+		if (p_level > BITS) {
+			child = _unique_branch(child, p_level - BITS);
+			if (_pop_tail_from(static_cast<Branch *>(child), p_level - BITS, p_index)) {
+				_unref(child, p_level - BITS);
+				child = nullptr;
+			}
+		} else {
+			_unref(child, 0);
+			child = nullptr;
+		}
+		return child == nullptr && child_index == 0;
+	}
+
+public:
+	class ConstIterator {
+		friend class PersistentVector;
+
+		const PersistentVector *vector = nullptr;
+		const Leaf *leaf = nullptr;
+		uint32_t index = 0;
+
+		ConstIterator(const PersistentVector *p_vector, uint32_t p_index) :
+				vector(p_vector), index(p_index) {
+			if (index < vector->count) {
+				leaf = vector->_leaf_for(index);
+			}
+		}
+
+	public:
+		_FORCE_INLINE_ const T &operator*() const { return leaf->elements[index & MASK]; }
+		_FORCE_INLINE_ const T *operator->() const { return &leaf->elements[index & MASK]; }
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			index++;
+			if ((index & MASK) == 0 && index < vector->count) {
+				leaf = vector->_leaf_for(index);
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &p_other) const { return index == p_other.index; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &p_other) const { return index != p_other.index; }
+
+		ConstIterator() = default;
+	};
+
+	_FORCE_INLINE_ ConstIterator begin() const { return ConstIterator(this, 0); }
+	_FORCE_INLINE_ ConstIterator end() const { return ConstIterator(this, count); }
+
+	_FORCE_INLINE_ uint32_t size() const { return count; }
+	_FORCE_INLINE_ bool is_empty() const { return count == 0; }
+
+	_FORCE_INLINE_ const T &operator[](uint32_t p_index) const {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, count);
+		return _leaf_for(p_index)->elements[p_index & MASK];
+	}
+
+	_FORCE_INLINE_ const T &get(uint32_t p_index) const { return operator[](p_index); }
+
+	void set(uint32_t p_index, T p_value) {
+		ERR_FAIL_UNSIGNED_INDEX(p_index, count);
+		_writable_leaf_for(p_index)->elements[p_index & MASK] = std::move(p_value);
+	}
+
+	// Must take a copy instead of a reference (see GH-31736).
+	void push_back(T p_value) {
+		ERR_FAIL_COND_MSG(count == UINT32_MAX, "Vector is full.");
+		uint32_t tail_size = count - _tail_offset();
+		if (tail_size == WIDTH) {
+			_push_tail();
+			tail_size = 0;
+		}
+		tail = tail ? _unique_leaf(tail) : memnew(Leaf);
+		tail->elements[tail_size] = std::move(p_value);
+		count++;
+	}
+
+	void pop_back() {
+		ERR_FAIL_COND(count == 0);
+		if (count == 1) {
+			clear();
+			return;
+		}
+
+		const uint32_t tail_offset = _tail_offset();
+		if (count - tail_offset > 1) {
+			tail = _unique_leaf(tail);
+			tail->elements[count - 1 - tail_offset] = T();
+			count--;
+			return;
+		}
+
+		// The tail is left empty, the last leaf of the tree takes its place.
+		Leaf *new_tail = const_cast<Leaf *>(_leaf_for(count - 2));
+		new_tail->refcount.ref();
+		_unref(tail, 0);
+		tail = new_tail;
+
+		root = _unique_branch(root, shift);
+		_pop_tail_from(root, shift, count - 2);
+		count--;
+
+		if (!root->children[0]) {
+			_unref(root, shift);
+			root = nullptr;
+			shift = BITS;
+		} else if (shift > BITS && !root->children[1]) {
+			Branch *new_root = static_cast<Branch *>(root->children[0]);
+			new_root->refcount.ref();
+			_unref(root, shift);
+			root = new_root;
+			shift -= BITS;
+		}
+	}
+
+	void clear() {
+		_unref(root, shift);
+		_unref(tail, 0);
+		root = nullptr;
+		tail = nullptr;
+		count = 0;
+		shift = BITS;
+	}
+
+	// Whether both vectors share all of their elements, so that they are equal without comparing them.
+	_FORCE_INLINE_ bool is_same_storage(const PersistentVector &p_other) const {
+		return root == p_other.root && tail == p_other.tail && count == p_other.count;
+	}
+
+	void operator=(const PersistentVector &p_from) {
+		if (this == &p_from) {
+			return;
+		}
+		if (p_from.root) {
+			p_from.root->refcount.ref();
+		}
+		if (p_from.tail) {
+			p_from.tail->refcount.ref();
+		}
+		clear();
+		root = p_from.root;
+		tail = p_from.tail;
+		count = p_from.count;
+		shift = p_from.shift;
+	}
+
+	void operator=(PersistentVector &&p_from) {
+		if (this == &p_from) {
+			return;
+		}
+		clear();
+		root = p_from.root;
+		tail = p_from.tail;
+		count = p_from.count;
+		shift = p_from.shift;
+		p_from.root = nullptr;
+		p_from.tail = nullptr;
+		p_from.count = 0;
+		p_from.shift = BITS;
+	}
+
+	PersistentVector() {}
+	PersistentVector(const PersistentVector &p_from) { operator=(p_from); }
+	PersistentVector(PersistentVector &&p_from) { operator=(std::move(p_from)); }
+	PersistentVector(std::initializer_list<T> p_init) {
+		for (const T &element : p_init) {
+			push_back(element);
+		}
+	}
+
+	~PersistentVector() {
+		clear();
+	}
+};
@@ -32,9 +32,11 @@
 
 #include "core/os/memory.h"
 #include "core/os/mutex.h"
+#include "core/os/thread.h"
 #include "core/string/print_string.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/safe_refcount.h"
+#include "core/templates/span.h"
 #include "core/variant/variant.h"
 
 #include <cstdio>
@@ -116,21 +118,61 @@ class RID_Alloc : public RID_AllocBase {
 
 	mutable Mutex mutex;
 
-	_FORCE_INLINE_ RID _allocate_rid() {
+	// Thread-safe allocators keep a few small caches of free indices, picked by
+	// the calling thread, so most allocations and frees don't need to take the
+	// allocator-wide mutex. Indices move between a cache and the free list in batches.
+	// Elements are only claimed and released with either a cache mutex or the allocator
+	// mutex held, so iterating with all of them locked sees no element changing state.
+	// Cache mutexes are always locked before the allocator mutex.
+	static constexpr uint32_t FREE_CACHE_COUNT = 8;
+	static constexpr uint32_t FREE_CACHE_SIZE = 32;
+
+	struct FreeCache {
+		Mutex mutex; // Recursive, as the destructor of an element may free other elements.
+		uint32_t count = 0;
+		uint32_t indices[FREE_CACHE_SIZE];
+	};
+	FreeCache *free_caches = nullptr;
+	SafeNumeric<uint32_t> cached_count;
+
+	_FORCE_INLINE_ FreeCache &_get_free_cache() {
+		return free_caches[Thread::get_caller_id() % FREE_CACHE_COUNT];
+	}
+
+	// Locks every cache and the allocator mutex, for iteration over the elements.
+	void _lock_all() const {
 		if constexpr (THREAD_SAFE) {
+			for (uint32_t i = 0; i < FREE_CACHE_COUNT; i++) {
+				free_caches[i].mutex.lock();
+			}
 			mutex.lock();
 		}
+	}
+
+	void _unlock_all() const {
+		if constexpr (THREAD_SAFE) {
+			mutex.unlock();
+			for (uint32_t i = 0; i < FREE_CACHE_COUNT; i++) {
+				free_caches[i].mutex.unlock();
+			}
+		}
+	}
+
+	String _get_limit_error() const {
+		if (description != nullptr) {
+			return vformat("Element limit for RID of type '%s' reached.", String(description));
+		}
+		return "Element limit reached.";
+	}
 
+	// Takes an index from the free list, growing it if needed. Must be called with the mutex held.
+	// Returns UINT32_MAX if the element limit was reached.
+	uint32_t _pop_free_index() {
 		if (alloc_count == max_alloc) {
 			//allocate a new chunk
 			uint32_t chunk_count = alloc_count == 0 ? 0 : (max_alloc / elements_in_chunk);
 			if (THREAD_SAFE && chunk_count == chunk_limit) {
-				mutex.unlock();
-				if (description != nullptr) {
-					ERR_FAIL_V_MSG(RID(), vformat("Element limit for RID of type '%s' reached.", String(description)));
-				} else {
-					ERR_FAIL_V_MSG(RID(), "Element limit reached.");
-				}
+				return UINT32_MAX;
 			}
 
 			//grow chunks
@@ -160,25 +202,86 @@ class RID_Alloc : public RID_AllocBase {
 		}
 
 		uint32_t free_index = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
+		alloc_count++;
+		return free_index;
+	}
 
-		uint32_t free_chunk = free_index / elements_in_chunk;
-		uint32_t free_element = free_index % elements_in_chunk;
+	// Must be called with the mutex held.
+	_FORCE_INLINE_ void _push_free_index(uint32_t p_index) {
+		alloc_count--;
+		free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = p_index;
+	}
 
+	// Gives a fresh validator to a free index, leaving it uninitialized.
+	_FORCE_INLINE_ RID _claim_index(uint32_t p_index) {
 		uint32_t validator = 1 + (uint32_t)(_gen_id() % 0x7FFFFFFF);
 		uint64_t id = validator;
 		id <<= 32;
-		id |= free_index;
+		id |= p_index;
 
-		chunks[free_chunk][free_element].validator = validator;
-		chunks[free_chunk][free_element].validator |= 0x80000000; //mark uninitialized bit
+		chunks[p_index / elements_in_chunk][p_index % elements_in_chunk].validator = validator | 0x80000000; //mark uninitialized bit
 
-		alloc_count++;
+		return _make_from_id(id);
+	}
 
+	_FORCE_INLINE_ RID _allocate_rid() {
 		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
+			FreeCache &cache = _get_free_cache();
+			MutexLock cache_lock(cache.mutex);
+
+			if (cache.count == 0) {
+				MutexLock lock(mutex);
+				while (cache.count < FREE_CACHE_SIZE / 2) {
+					uint32_t index = _pop_free_index();
+					if (index == UINT32_MAX) {
+						break;
+					}
+					cache.indices[cache.count++] = index;
+				}
+				ERR_FAIL_COND_V_MSG(cache.count == 0, RID(), _get_limit_error());
+				cached_count.add(cache.count);
+			}
+
+			cached_count.decrement();
+			return _claim_index(cache.indices[--cache.count]);
+		} else {
+			return _claim_index(_pop_free_index());
 		}
+	}
 
-		return _make_from_id(id);
+	// Destroys the element behind p_rid, returning its index so it can be freed, or UINT32_MAX if p_rid is invalid.
+	// In thread-safe allocators, must be called with the caller's cache mutex held.
+	uint32_t _release_element(const RID &p_rid) {
+		uint64_t id = p_rid.get_id();
+		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
+		uint32_t ma;
+		if constexpr (THREAD_SAFE) { // Read atomically to avoid data race with the store in _pop_free_index().
+			ma = ((std::atomic<uint32_t> *)&max_alloc)->load(std::memory_order_relaxed);
+		} else {
+			ma = max_alloc;
+		}
+		ERR_FAIL_COND_V(idx >= ma, UINT32_MAX);
+
+		Chunk &c = chunks[idx / elements_in_chunk][idx % elements_in_chunk];
+		uint32_t validator = uint32_t(id >> 32);
+
+		if constexpr (THREAD_SAFE) {
+			// Threads freeing through different caches don't share a mutex, so invalidate
+			// first to make sure only one of several threads freeing the same RID destroys it.
+			uint32_t current = validator;
+			if (unlikely(!((std::atomic<uint32_t> *)&c.validator)->compare_exchange_strong(current, 0xFFFFFFFF, std::memory_order_relaxed))) {
+				ERR_FAIL_COND_V_MSG(current & 0x80000000, UINT32_MAX, "Attempted to free an uninitialized or invalid RID");
+				ERR_FAIL_V(UINT32_MAX);
+			}
+			c.data.~T();
+		} else {
+			ERR_FAIL_COND_V_MSG(c.validator & 0x80000000, UINT32_MAX, "Attempted to free an uninitialized or invalid RID");
+			ERR_FAIL_COND_V(c.validator != validator, UINT32_MAX);
+			c.data.~T();
+			c.validator = 0xFFFFFFFF; // go invalid
+		}
+
+		return idx;
 	}
 
 public:
@@ -198,6 +301,32 @@ public:
 		return _allocate_rid();
 	}
 
+	// Allocates and initializes p_count elements at once, taking the lock a single time.
+	LocalVector<RID> make_rids(uint32_t p_count) {
+		LocalVector<RID> rids;
+		rids.reserve(p_count);
+
+		if constexpr (THREAD_SAFE) {
+			mutex.lock();
+		}
+		for (uint32_t i = 0; i < p_count; i++) {
+			uint32_t index = _pop_free_index();
+			if (unlikely(index == UINT32_MAX)) {
+				ERR_PRINT(_get_limit_error());
+				break;
+			}
+			rids.push_back(_claim_index(index));
+		}
+		if constexpr (THREAD_SAFE) {
+			mutex.unlock();
+		}
+
+		for (const RID &rid : rids) {
+			initialize_rid(rid);
+		}
+		return rids;
+	}
+
 	_FORCE_INLINE_ T *get_or_null(const RID &p_rid, bool p_initialize = false) {
 		if (p_rid == RID()) {
 			return nullptr;
@@ -210,7 +339,7 @@ public:
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
 		uint32_t ma;
-		if constexpr (THREAD_SAFE) { // Read atomically to avoid data race with the store in _allocate_rid().
+		if constexpr (THREAD_SAFE) { // Read atomically to avoid data race with the store in _pop_free_index().
 			ma = ((std::atomic<uint32_t> *)&max_alloc)->load(std::memory_order_relaxed);
 		} else {
 			ma = max_alloc;
@@ -328,7 +457,13 @@ public:
 
 		uint32_t validator = uint32_t(id >> 32);
 
-		bool owned = (chunks[idx_chunk][idx_element].validator & 0x7FFFFFFF) == validator;
+		uint32_t current;
+		if constexpr (THREAD_SAFE) { // Read atomically, elements may be claimed or freed through a cache.
+			current = ((std::atomic<uint32_t> *)&chunks[idx_chunk][idx_element].validator)->load(std::memory_order_relaxed);
+		} else {
+			current = chunks[idx_chunk][idx_element].validator;
+		}
+		bool owned = (current & 0x7FFFFFFF) == validator;
 
 		if constexpr (THREAD_SAFE) {
 			mutex.unlock();
@@ -339,82 +474,109 @@ public:
 
 	_FORCE_INLINE_ void free(const RID &p_rid) {
 		if constexpr (THREAD_SAFE) {
-			mutex.lock();
-		}
+			FreeCache &cache = _get_free_cache();
+			MutexLock cache_lock(cache.mutex);
 
-		uint64_t id = p_rid.get_id();
-		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
+			// Keep the cache locked while the element is destroyed, so iteration never sees it half freed.
+			uint32_t idx = _release_element(p_rid);
+			if (unlikely(idx == UINT32_MAX)) {
+				return;
 			}
-			ERR_FAIL();
-		}
-
-		uint32_t idx_chunk = idx / elements_in_chunk;
-		uint32_t idx_element = idx % elements_in_chunk;
 
-		uint32_t validator = uint32_t(id >> 32);
-		if (unlikely(chunks[idx_chunk][idx_element].validator & 0x80000000)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
+			if (cache.count == FREE_CACHE_SIZE) {
+				MutexLock lock(mutex);
+				while (cache.count > FREE_CACHE_SIZE / 2) {
+					_push_free_index(cache.indices[--cache.count]);
+				}
+				cached_count.sub(FREE_CACHE_SIZE / 2);
 			}
-			ERR_FAIL_MSG("Attempted to free an uninitialized or invalid RID");
-		} else if (unlikely(chunks[idx_chunk][idx_element].validator != validator)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
+
+			cache.indices[cache.count++] = idx;
+			cached_count.increment();
+		} else {
+			uint32_t idx = _release_element(p_rid);
+			if (unlikely(idx == UINT32_MAX)) {
+				return;
 			}
-			ERR_FAIL();
+			_push_free_index(idx);
 		}
+	}
 
-		chunks[idx_chunk][idx_element].data.~T();
-		chunks[idx_chunk][idx_element].validator = 0xFFFFFFFF; // go invalid
-
-		alloc_count--;
-		free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = idx;
-
+	// Frees several elements at once, taking the lock a single time.
+	void free_rids(Span<RID> p_rids) {
+		if constexpr (THREAD_SAFE) {
+			// The cache is only locked to keep the same lock order as free().
+			_get_free_cache().mutex.lock();
+			mutex.lock();
+		}
+		for (const RID &rid : p_rids) {
+			uint32_t idx = _release_element(rid);
+			if (likely(idx != UINT32_MAX)) {
+				_push_free_index(idx);
+			}
+		}
 		if constexpr (THREAD_SAFE) {
 			mutex.unlock();
+			_get_free_cache().mutex.unlock();
 		}
 	}
 
 	_FORCE_INLINE_ uint32_t get_rid_count() const {
-		return alloc_count;
+		if constexpr (THREAD_SAFE) {
+			// Indices sitting in the free caches are still counted as allocated by the free list.
+			return alloc_count - cached_count.get();
+		} else {
+			return alloc_count;
+		}
 	}
 	LocalVector<RID> get_owned_list() const {
 		LocalVector<RID> owned;
-		if constexpr (THREAD_SAFE) {
-			mutex.lock();
-		}
+		_lock_all();
 		for (size_t i = 0; i < max_alloc; i++) {
 			uint64_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator;
 			if (validator != 0xFFFFFFFF) {
 				owned.push_back(_make_from_id((validator << 32) | i));
 			}
 		}
-		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
-		}
+		_unlock_all();
 		return owned;
 	}
 
 	//used for fast iteration in the elements or RIDs
-	void fill_owned_buffer(RID *p_rid_buffer) const {
-		if constexpr (THREAD_SAFE) {
-			mutex.lock();
-		}
+	// p_rid_buffer must hold at least p_max RIDs, usually get_rid_count(). Elements allocated
+	// after that count was taken are left out. Returns the number of RIDs written.
+	uint32_t fill_owned_buffer(RID *p_rid_buffer, uint32_t p_max = UINT32_MAX) const {
+		_lock_all();
 		uint32_t idx = 0;
-		for (size_t i = 0; i < max_alloc; i++) {
+		for (size_t i = 0; i < max_alloc && idx < p_max; i++) {
 			uint64_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator;
 			if (validator != 0xFFFFFFFF) {
 				p_rid_buffer[idx] = _make_from_id((validator << 32) | i);
 				idx++;
 			}
 		}
+		_unlock_all();
+		return idx;
+	}
 
-		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
+	// Calls p_callback(RID, T *) on every initialized element, walking chunks in memory order,
+	// which makes it the fastest way to update all elements. Elements must not be allocated
+	// or freed from the callback.
+	template <typename F>
+	void for_each(F &&p_callback) {
+		_lock_all();
+		uint32_t chunk_count = max_alloc / elements_in_chunk;
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			Chunk *chunk = chunks[i];
+			for (uint32_t j = 0; j < elements_in_chunk; j++) {
+				uint64_t validator = chunk[j].validator;
+				if (validator & 0x80000000) {
+					continue; // Free or uninitialized.
+				}
+				p_callback(_make_from_id((validator << 32) | (i * elements_in_chunk + j)), &chunk[j].data);
+			}
 		}
+		_unlock_all();
 	}
 
 	void set_description(const char *p_description) {
@@ -427,6 +589,7 @@ public:
 			chunk_limit = (p_maximum_number_of_elements / elements_in_chunk) + 1;
 			chunks = (Chunk **)memalloc(sizeof(Chunk *) * chunk_limit);
 			free_list_chunks = (uint32_t **)memalloc(sizeof(uint32_t *) * chunk_limit);
+			free_caches = memnew_arr(FreeCache, FREE_CACHE_COUNT);
 			SYNC_RELEASE;
 		}
 	}
@@ -436,9 +599,9 @@ public:
 			SYNC_ACQUIRE;
 		}
 
-		if (alloc_count) {
+		if (get_rid_count()) {
 			print_error(vformat("ERROR: %d RID allocations of type '%s' were leaked at exit.",
-					alloc_count, description ? description : typeid(T).name()));
+					get_rid_count(), description ? description : typeid(T).name()));
 
 			for (size_t i = 0; i < max_alloc; i++) {
 				uint32_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator;
@@ -461,6 +624,10 @@ public:
 			memfree(chunks);
 			memfree(free_list_chunks);
 		}
+
+		if (free_caches) {
+			memdelete_arr(free_caches);
+		}
 	}
 };
 
@@ -503,6 +670,10 @@ public:
 		alloc.free(p_rid);
 	}
 
+	_FORCE_INLINE_ void free_rids(Span<RID> p_rids) {
+		alloc.free_rids(p_rids);
+	}
+
 	_FORCE_INLINE_ uint32_t get_rid_count() const {
 		return alloc.get_rid_count();
 	}
@@ -511,8 +682,13 @@ public:
 		return alloc.get_owned_list();
 	}
 
-	void fill_owned_buffer(RID *p_rid_buffer) const {
-		alloc.fill_owned_buffer(p_rid_buffer);
+	uint32_t fill_owned_buffer(RID *p_rid_buffer, uint32_t p_max = UINT32_MAX) const {
+		return alloc.fill_owned_buffer(p_rid_buffer, p_max);
+	}
+
+	template <typename F>
+	void for_each(F &&p_callback) {
+		alloc.for_each([&p_callback](const RID &p_rid, T **p_ptr) { p_callback(p_rid, *p_ptr); });
 	}
 
 	void set_description(const char *p_description) {
@@ -539,6 +715,10 @@ public:
 		return alloc.allocate_rid();
 	}
 
+	_FORCE_INLINE_ LocalVector<RID> make_rids(uint32_t p_count) {
+		return alloc.make_rids(p_count);
+	}
+
 	_FORCE_INLINE_ void initialize_rid(RID p_rid) {
 		alloc.initialize_rid(p_rid);
 	}
@@ -559,6 +739,10 @@ public:
 		alloc.free(p_rid);
 	}
 
+	_FORCE_INLINE_ void free_rids(Span<RID> p_rids) {
+		alloc.free_rids(p_rids);
+	}
+
 	_FORCE_INLINE_ uint32_t get_rid_count() const {
 		return alloc.get_rid_count();
 	}
@@ -566,8 +750,13 @@ public:
 	_FORCE_INLINE_ LocalVector<RID> get_owned_list() const {
 		return alloc.get_owned_list();
 	}
-	void fill_owned_buffer(RID *p_rid_buffer) const {
-		alloc.fill_owned_buffer(p_rid_buffer);
+	uint32_t fill_owned_buffer(RID *p_rid_buffer, uint32_t p_max = UINT32_MAX) const {
+		return alloc.fill_owned_buffer(p_rid_buffer, p_max);
+	}
+
+	template <typename F>
+	void for_each(F &&p_callback) {
+		alloc.for_each(p_callback);
 	}
 
 	void set_description(const char *p_description) {
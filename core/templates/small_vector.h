@@ -0,0 +1,299 @@
+/**************************************************************************/
+/*  small_vector.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#pragma once
+
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+#include "core/templates/span.h"
+#include "core/templates/vector.h"
+
+#include <initializer_list>
+#include <type_traits>
+
+GODOT_GCC_WARNING_PUSH_AND_IGNORE("-Warray-bounds")
+
+/**
+ * A vector that keeps up to INLINE_CAPACITY elements in place, and only
+ * allocates on the heap once it grows past that.
+ * Useful for the many arrays that hold only a handful of elements most of the
+ * time, for which a Vector costs an allocation and a reference count each.
+ *
+ * Unlike Vector, copies are never shared, so prefer passing it by reference.
+ * Like with LocalVector, elements must be trivially relocatable.
+ */
+template <typename T, uint32_t INLINE_CAPACITY, typename U = uint32_t>
+class SmallVector {
+	static_assert(INLINE_CAPACITY > 0, "Use LocalVector if no inline storage is wanted.");
+
+	U count = 0;
+	U capacity = INLINE_CAPACITY;
+	union {
+		T *heap_data;
+		alignas(T) uint8_t inline_data[INLINE_CAPACITY * sizeof(T)];
+	};
+
+	_FORCE_INLINE_ bool _is_inline() const { return capacity == INLINE_CAPACITY; }
+
+	void _grow(U p_capacity) {
+		T *new_data = (T *)Memory::alloc_static(p_capacity * sizeof(T));
+		CRASH_COND_MSG(!new_data, "Out of memory");
+		memcpy((void *)new_data, (void *)ptr(), count * sizeof(T));
+		if (!_is_inline()) {
+			Memory::free_static(heap_data);
+		}
+		// Only overwrite the inline buffer once its elements were moved out.
+		heap_data = new_data;
+		capacity = p_capacity;
+	}
+
+	template <bool p_init>
+	void _resize(U p_size) {
+		if (p_size < count) {
+			if constexpr (!std::is_trivially_destructible_v<T>) {
+				T *data = ptr();
+				for (U i = p_size; i < count; i++) {
+					data[i].~T();
+				}
+			}
+			count = p_size;
+		} else if (p_size > count) {
+			reserve(p_size);
+			if constexpr (p_init) {
+				memnew_arr_placement(ptr() + count, p_size - count);
+			} else {
+				static_assert(std::is_trivially_destructible_v<T>, "T must be trivially destructible to resize uninitialized");
+			}
+			count = p_size;
+		}
+	}
+
+	void _copy_from(const T *p_data, U p_count) {
+		clear();
+		reserve(p_count);
+		T *data = ptr();
+		for (U i = 0; i < p_count; i++) {
+			memnew_placement(&data[i], T(p_data[i]));
+		}
+		count = p_count;
+	}
+
+	void _move_from(SmallVector &p_from) {
+		count = p_from.count;
+		capacity = p_from.capacity;
+		if (p_from._is_inline()) {
+			memcpy((void *)inline_data, (void *)p_from.inline_data, count * sizeof(T));
+		} else {
+			heap_data = p_from.heap_data;
+		}
+		p_from.count = 0;
+		p_from.capacity = INLINE_CAPACITY;
+	}
+
+public:
+	_FORCE_INLINE_ T *ptr() { return _is_inline() ? (T *)inline_data : heap_data; }
+	_FORCE_INLINE_ const T *ptr() const { return _is_inline() ? (const T *)inline_data : heap_data; }
+	_FORCE_INLINE_ U size() const { return count; }
+	_FORCE_INLINE_ bool is_empty() const { return count == 0; }
+	_FORCE_INLINE_ U get_capacity() const { return capacity; }
+	// Whether the elements are still stored in place, without any heap allocation.
+	_FORCE_INLINE_ bool is_inline() const { return _is_inline(); }
+
+	_FORCE_INLINE_ Span<T> span() const { return Span(ptr(), count); }
+	_FORCE_INLINE_ operator Span<T>() const { return span(); }
+
+	void reserve(U p_size) {
+		if (p_size > capacity) {
+			// Same 1.5x growth as LocalVector.
+			U new_capacity = MAX((U)2, capacity + ((1 + capacity) >> 1));
+			_grow(MAX(new_capacity, p_size));
+		}
+	}
+
+	// Must take a copy instead of a reference (see GH-31736).
+	_FORCE_INLINE_ void push_back(T p_elem) {
+		if (unlikely(count == capacity)) {
+			reserve(count + 1);
+		}
+		memnew_placement(&ptr()[count++], T(std::move(p_elem)));
+	}
+
+	void pop_back() {
+		ERR_FAIL_COND(count == 0);
+		count--;
+		ptr()[count].~T();
+	}
+
+	void remove_at(U p_index) {
+		ERR_FAIL_UNSIGNED_INDEX(p_index, count);
+		T *data = ptr();
+		count--;
+		for (U i = p_index; i < count; i++) {
+			data[i] = std::move(data[i + 1]);
+		}
+		data[count].~T();
+	}
+
+	void remove_at_unordered(U p_index) {
+		ERR_FAIL_UNSIGNED_INDEX(p_index, count);
+		T *data = ptr();
+		count--;
+		if (count > p_index) {
+			data[p_index] = std::move(data[count]);
+		}
+		data[count].~T();
+	}
+
+	bool erase(const T &p_val) {
+		int64_t idx = find(p_val);
+		if (idx >= 0) {
+			remove_at(idx);
+			return true;
+		}
+		return false;
+	}
+
+	void insert(U p_pos, T p_val) {
+		ERR_FAIL_UNSIGNED_INDEX(p_pos, count + 1);
+		if (p_pos == count) {
+			push_back(std::move(p_val));
+		} else {
+			resize(count + 1);
+			T *data = ptr();
+			for (U i = count - 1; i > p_pos; i--) {
+				data[i] = std::move(data[i - 1]);
+			}
+			data[p_pos] = std::move(p_val);
+		}
+	}
+
+	int64_t find(const T &p_val, int64_t p_from = 0) const {
+		if (p_from < 0) {
+			p_from = size() + p_from;
+		}
+		if (p_from < 0 || p_from >= size()) {
+			return -1;
+		}
+		return span().find(p_val, p_from);
+	}
+
+	bool has(const T &p_val) const {
+		return find(p_val) != -1;
+	}
+
+	/// Resize the vector.
+	/// Elements are initialized (or not) depending on what the default C++ behavior for T is.
+	void resize(U p_size) {
+		_resize<!std::is_trivially_constructible_v<T>>(p_size);
+	}
+
+	/// Resize and set all values to 0 / false / nullptr.
+	_FORCE_INLINE_ void resize_initialized(U p_size) { _resize<true>(p_size); }
+
+	/// Resize and keep memory uninitialized.
+	/// This is only available for trivially destructible types (otherwise, trivial resize might be UB).
+	_FORCE_INLINE_ void resize_uninitialized(U p_size) { _resize<false>(p_size); }
+
+	// Keeps the heap buffer, if any.
+	_FORCE_INLINE_ void clear() { resize(0); }
+	// Frees the heap buffer, going back to inline storage.
+	void reset() {
+		clear();
+		if (!_is_inline()) {
+			Memory::free_static(heap_data);
+			capacity = INLINE_CAPACITY;
+		}
+	}
+
+	_FORCE_INLINE_ const T &operator[](U p_index) const {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, count);
+		return ptr()[p_index];
+	}
+	_FORCE_INLINE_ T &operator[](U p_index) {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, count);
+		return ptr()[p_index];
+	}
+
+	_FORCE_INLINE_ T *begin() { return ptr(); }
+	_FORCE_INLINE_ T *end() { return ptr() + count; }
+	_FORCE_INLINE_ const T *begin() const { return ptr(); }
+	_FORCE_INLINE_ const T *end() const { return ptr() + count; }
+
+	bool operator==(const SmallVector &p_other) const { return span() == p_other.span(); }
+	bool operator!=(const SmallVector &p_other) const { return span() != p_other.span(); }
+
+	explicit operator Vector<T>() const {
+		Vector<T> ret;
+		ret.resize(count);
+		T *w = ret.ptrw();
+		if (w) {
+			copy_arr_placement(w, ptr(), count);
+		}
+		return ret;
+	}
+
+	_FORCE_INLINE_ SmallVector() {}
+	SmallVector(std::initializer_list<T> p_init) {
+		_copy_from(p_init.begin(), p_init.size());
+	}
+	explicit SmallVector(const Vector<T> &p_from) {
+		_copy_from(p_from.ptr(), p_from.size());
+	}
+	SmallVector(const SmallVector &p_from) {
+		_copy_from(p_from.ptr(), p_from.count);
+	}
+	SmallVector(SmallVector &&p_from) {
+		_move_from(p_from);
+	}
+
+	void operator=(const SmallVector &p_from) {
+		if (unlikely(this == &p_from)) {
+			return;
+		}
+		_copy_from(p_from.ptr(), p_from.count);
+	}
+	void operator=(const Vector<T> &p_from) {
+		_copy_from(p_from.ptr(), p_from.size());
+	}
+	void operator=(SmallVector &&p_from) {
+		if (unlikely(this == &p_from)) {
+			return;
+		}
+		reset();
+		_move_from(p_from);
+	}
+
+	~SmallVector() {
+		reset();
+	}
+};
+
+GODOT_GCC_WARNING_POP
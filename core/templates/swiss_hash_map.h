@@ -0,0 +1,806 @@
+/**************************************************************************/
+/*  swiss_hash_map.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/memory.h"
+#include "core/string/print_string.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+
+#include <initializer_list>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SWISS_HASH_MAP_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define SWISS_HASH_MAP_NEON
+#include <arm_neon.h>
+#endif
+
+class String;
+class StringName;
+class Variant;
+
+/**
+ * A "Swiss table" hash map, with the same API and element layout as AHashMap.
+ *
+ * Key/value pairs are stored contiguously in insertion order (erasing moves the
+ * last element into the hole, like AHashMap). The index is an open-addressing
+ * table of one control byte per slot, holding either the low 7 bits of the
+ * key's hash or an empty/deleted marker. Lookups compare a whole group of 16
+ * control bytes at once (SSE2 or NEON, with a scalar fallback), so the keys
+ * themselves are only compared on a 7-bit hash match, and probing stops at the
+ * first group that has an empty slot.
+ *
+ * This scales better than AHashMap for very large maps and high load factors,
+ * where Robin Hood probe sequences get long. For small maps, prefer AHashMap.
+ */
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class SwissHashMap {
+public:
+	// Must be a power of two, and at least GROUP_SIZE.
+	static constexpr uint32_t INITIAL_CAPACITY = 16;
+	static constexpr uint32_t GROUP_SIZE = 16;
+
+private:
+	static constexpr int8_t CTRL_EMPTY = -128; // 0b10000000
+	static constexpr int8_t CTRL_DELETED = -2; // 0b11111110
+
+	// A set of matching slots within a group.
+	struct GroupMask {
+#ifdef SWISS_HASH_MAP_NEON
+		static constexpr uint32_t SHIFT = 2; // 4 bits per slot.
+#else
+		static constexpr uint32_t SHIFT = 0;
+#endif
+		uint64_t mask;
+
+		_FORCE_INLINE_ explicit operator bool() const { return mask != 0; }
+		_FORCE_INLINE_ uint32_t lowest() const { return count_trailing_zeros(mask) >> SHIFT; }
+		_FORCE_INLINE_ void clear_lowest() { mask &= mask - 1; }
+	};
+
+	struct Group {
+#if defined(SWISS_HASH_MAP_SSE2)
+		__m128i ctrl;
+
+		_FORCE_INLINE_ explicit Group(const int8_t *p_ctrl) {
+			ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_ctrl));
+		}
+		_FORCE_INLINE_ GroupMask match(int8_t p_h2) const {
+			return GroupMask{ (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(p_h2), ctrl)) };
+		}
+		// Empty and deleted are the only control bytes with the high bit set.
+		_FORCE_INLINE_ GroupMask match_empty_or_deleted() const {
+			return GroupMask{ (uint64_t)(uint32_t)_mm_movemask_epi8(ctrl) };
+		}
+#elif defined(SWISS_HASH_MAP_NEON)
+		int8x16_t ctrl;
+
+		_FORCE_INLINE_ explicit Group(const int8_t *p_ctrl) {
+			ctrl = vld1q_s8(p_ctrl);
+		}
+		static _FORCE_INLINE_ GroupMask _to_mask(uint8x16_t p_cmp) {
+			// Narrow each byte to a nibble, then keep one bit per nibble.
+			const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(p_cmp), 4);
+			return GroupMask{ vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & 0x8888888888888888ULL };
+		}
+		_FORCE_INLINE_ GroupMask match(int8_t p_h2) const {
+			return _to_mask(vceqq_s8(vdupq_n_s8(p_h2), ctrl));
+		}
+		_FORCE_INLINE_ GroupMask match_empty_or_deleted() const {
+			return _to_mask(vcltq_s8(ctrl, vdupq_n_s8(0)));
+		}
+#else
+		const int8_t *ctrl;
+
+		_FORCE_INLINE_ explicit Group(const int8_t *p_ctrl) {
+			ctrl = p_ctrl;
+		}
+		_FORCE_INLINE_ GroupMask match(int8_t p_h2) const {
+			uint64_t mask = 0;
+			for (uint32_t i = 0; i < GROUP_SIZE; i++) {
+				mask |= (uint64_t)(ctrl[i] == p_h2) << i;
+			}
+			return GroupMask{ mask };
+		}
+		_FORCE_INLINE_ GroupMask match_empty_or_deleted() const {
+			uint64_t mask = 0;
+			for (uint32_t i = 0; i < GROUP_SIZE; i++) {
+				mask |= (uint64_t)(ctrl[i] < 0) << i;
+			}
+			return GroupMask{ mask };
+		}
+#endif
+		_FORCE_INLINE_ GroupMask match_empty() const {
+			return match(CTRL_EMPTY);
+		}
+	};
+
+	typedef KeyValue<TKey, TValue> MapKeyValue;
+	MapKeyValue *_elements = nullptr;
+	uint32_t *_hashes = nullptr; // Hash of each element, used when rehashing.
+	int8_t *_ctrl = nullptr; // One control byte per slot.
+	uint32_t *_slots = nullptr; // Element index of each slot.
+
+	// Due to optimization, this is `capacity - 1`. Use + 1 to get normal capacity.
+	uint32_t _capacity_mask = 0;
+	uint32_t _size = 0;
+	// Number of inserts left before a rehash is needed. Deleted slots are not reclaimed until then.
+	uint32_t _growth_left = 0;
+
+	_FORCE_INLINE_ static uint32_t _hash(const TKey &p_key) {
+		return Hasher::hash(p_key);
+	}
+
+	_FORCE_INLINE_ static int8_t _h2(uint32_t p_hash) {
+		return (int8_t)(p_hash & 0x7F);
+	}
+
+	// Maximum load factor is 7/8.
+	static _FORCE_INLINE_ uint32_t _get_max_elements(uint32_t p_capacity_mask) {
+		const uint32_t capacity = p_capacity_mask + 1;
+		return capacity - capacity / 8;
+	}
+
+	static _FORCE_INLINE_ uint32_t _get_capacity_mask_for(uint32_t p_elements) {
+		const uint64_t capacity = next_power_of_2(MAX((uint64_t)INITIAL_CAPACITY, (uint64_t)p_elements * 8 / 7 + 1));
+		return (uint32_t)capacity - 1;
+	}
+
+	// Walks the groups with triangular probing, which visits every group once when
+	// the group count is a power of two.
+	struct ProbeSeq {
+		uint32_t group;
+		uint32_t group_mask;
+		uint32_t step = 0;
+
+		_FORCE_INLINE_ ProbeSeq(uint32_t p_hash, uint32_t p_capacity_mask) {
+			group_mask = p_capacity_mask / GROUP_SIZE;
+			group = (p_hash >> 7) & group_mask;
+		}
+		_FORCE_INLINE_ uint32_t offset() const { return group * GROUP_SIZE; }
+		_FORCE_INLINE_ void next() {
+			step++;
+			group = (group + step) & group_mask;
+		}
+	};
+
+	bool _lookup_idx(const TKey &p_key, uint32_t &r_element_idx, uint32_t &r_slot_idx) const {
+		if (unlikely(_elements == nullptr)) {
+			return false; // Failed lookups, no _elements.
+		}
+		return _lookup_idx_with_hash(p_key, r_element_idx, r_slot_idx, _hash(p_key));
+	}
+
+	bool _lookup_idx_with_hash(const TKey &p_key, uint32_t &r_element_idx, uint32_t &r_slot_idx, uint32_t p_hash) const {
+		if (unlikely(_elements == nullptr)) {
+			return false; // Failed lookups, no _elements.
+		}
+
+		const int8_t h2 = _h2(p_hash);
+		ProbeSeq seq(p_hash, _capacity_mask);
+		while (true) {
+			const Group group(_ctrl + seq.offset());
+			for (GroupMask match = group.match(h2); match; match.clear_lowest()) {
+				const uint32_t slot_idx = seq.offset() + match.lowest();
+				const uint32_t element_idx = _slots[slot_idx];
+				if (Comparator::compare(_elements[element_idx].key, p_key)) {
+					r_element_idx = element_idx;
+					r_slot_idx = slot_idx;
+					return true;
+				}
+			}
+			if (group.match_empty()) {
+				return false;
+			}
+			seq.next();
+		}
+	}
+
+	// Finds the slot currently pointing at p_element_idx.
+	uint32_t _find_slot_of_element(uint32_t p_element_idx) const {
+		const uint32_t hash = _hashes[p_element_idx];
+		const int8_t h2 = _h2(hash);
+		ProbeSeq seq(hash, _capacity_mask);
+		while (true) {
+			const Group group(_ctrl + seq.offset());
+			for (GroupMask match = group.match(h2); match; match.clear_lowest()) {
+				const uint32_t slot_idx = seq.offset() + match.lowest();
+				if (_slots[slot_idx] == p_element_idx) {
+					return slot_idx;
+				}
+			}
+			DEV_ASSERT(!group.match_empty());
+			seq.next();
+		}
+	}
+
+	uint32_t _insert_slot(uint32_t p_hash, uint32_t p_element_idx) {
+		ProbeSeq seq(p_hash, _capacity_mask);
+		while (true) {
+			const GroupMask available = Group(_ctrl + seq.offset()).match_empty_or_deleted();
+			if (available) {
+				const uint32_t slot_idx = seq.offset() + available.lowest();
+				if (_ctrl[slot_idx] == CTRL_EMPTY) {
+					_growth_left--;
+				}
+				_ctrl[slot_idx] = _h2(p_hash);
+				_slots[slot_idx] = p_element_idx;
+				return slot_idx;
+			}
+			seq.next();
+		}
+	}
+
+	void _erase_slot(uint32_t p_slot_idx) {
+		// A probe sequence only ever continues past a group without empty slots,
+		// and groups never regain an empty slot once full, until rehashed. So if
+		// the group still has an empty slot, nothing probes past it.
+		const uint32_t group_offset = p_slot_idx & ~(GROUP_SIZE - 1);
+		if (Group(_ctrl + group_offset).match_empty()) {
+			_ctrl[p_slot_idx] = CTRL_EMPTY;
+			_growth_left++;
+		} else {
+			_ctrl[p_slot_idx] = CTRL_DELETED;
+		}
+	}
+
+	void _allocate_index(uint32_t p_capacity_mask) {
+		_capacity_mask = p_capacity_mask;
+		const uint32_t real_capacity = _capacity_mask + 1;
+		_ctrl = reinterpret_cast<int8_t *>(Memory::alloc_static(sizeof(int8_t) * real_capacity));
+		_slots = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * real_capacity));
+		memset(_ctrl, CTRL_EMPTY, real_capacity);
+		_growth_left = _get_max_elements(_capacity_mask);
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity_mask) {
+		Memory::free_static(_ctrl);
+		Memory::free_static(_slots);
+		_allocate_index(p_new_capacity_mask);
+
+		const uint32_t max_elements = _get_max_elements(_capacity_mask);
+		_elements = reinterpret_cast<MapKeyValue *>(Memory::realloc_static(_elements, sizeof(MapKeyValue) * max_elements));
+		_hashes = reinterpret_cast<uint32_t *>(Memory::realloc_static(_hashes, sizeof(uint32_t) * max_elements));
+
+		for (uint32_t i = 0; i < _size; i++) {
+			_insert_slot(_hashes[i], i);
+		}
+	}
+
+	int32_t _insert_element(const TKey &p_key, const TValue &p_value, uint32_t p_hash) {
+		if (unlikely(_elements == nullptr)) {
+			// Allocate on demand to save memory.
+			_allocate_index(_capacity_mask);
+			const uint32_t max_elements = _get_max_elements(_capacity_mask);
+			_elements = reinterpret_cast<MapKeyValue *>(Memory::alloc_static(sizeof(MapKeyValue) * max_elements));
+			_hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * max_elements));
+		}
+
+		if (unlikely(_growth_left == 0)) {
+			if (_size < _get_max_elements(_capacity_mask) / 2) {
+				// Mostly deleted slots, clean them up in place.
+				_resize_and_rehash(_capacity_mask);
+			} else {
+				_resize_and_rehash(_capacity_mask * 2 + 1);
+			}
+		}
+
+		memnew_placement(&_elements[_size], MapKeyValue(p_key, p_value));
+		_hashes[_size] = p_hash;
+
+		_insert_slot(p_hash, _size);
+		_size++;
+		return _size - 1;
+	}
+
+	void _init_from(const SwissHashMap &p_other) {
+		_capacity_mask = p_other._capacity_mask;
+		_size = p_other._size;
+		_growth_left = p_other._growth_left;
+
+		if (p_other._elements == nullptr) {
+			return;
+		}
+
+		const uint32_t real_capacity = _capacity_mask + 1;
+		const uint32_t max_elements = _get_max_elements(_capacity_mask);
+		_ctrl = reinterpret_cast<int8_t *>(Memory::alloc_static(sizeof(int8_t) * real_capacity));
+		_slots = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * real_capacity));
+		_elements = reinterpret_cast<MapKeyValue *>(Memory::alloc_static(sizeof(MapKeyValue) * max_elements));
+		_hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * max_elements));
+
+		if constexpr (std::is_trivially_copyable_v<TKey> && std::is_trivially_copyable_v<TValue>) {
+			void *destination = _elements;
+			const void *source = p_other._elements;
+			memcpy(destination, source, sizeof(MapKeyValue) * _size);
+		} else {
+			for (uint32_t i = 0; i < _size; i++) {
+				memnew_placement(&_elements[i], MapKeyValue(p_other._elements[i]));
+			}
+		}
+
+		memcpy(_hashes, p_other._hashes, sizeof(uint32_t) * _size);
+		memcpy(_ctrl, p_other._ctrl, sizeof(int8_t) * real_capacity);
+		memcpy(_slots, p_other._slots, sizeof(uint32_t) * real_capacity);
+	}
+
+public:
+	/* Standard Godot Container API */
+
+	_FORCE_INLINE_ uint32_t get_capacity() const { return _capacity_mask + 1; }
+	_FORCE_INLINE_ uint32_t size() const { return _size; }
+
+	_FORCE_INLINE_ bool is_empty() const {
+		return _size == 0;
+	}
+
+	void clear() {
+		if (_elements == nullptr || _size == 0) {
+			return;
+		}
+
+		memset(_ctrl, CTRL_EMPTY, _capacity_mask + 1);
+		_growth_left = _get_max_elements(_capacity_mask);
+		if constexpr (!(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>)) {
+			for (uint32_t i = 0; i < _size; i++) {
+				_elements[i].key.~TKey();
+				_elements[i].value.~TValue();
+			}
+		}
+
+		_size = 0;
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		uint32_t slot_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot_idx);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return _elements[element_idx].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		uint32_t slot_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot_idx);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return _elements[element_idx].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		uint32_t slot_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot_idx);
+
+		if (exists) {
+			return &_elements[element_idx].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		uint32_t slot_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot_idx);
+
+		if (exists) {
+			return &_elements[element_idx].value;
+		}
+		return nullptr;
+	}
+
+	bool has(const TKey &p_key) const {
+		uint32_t _idx = 0;
+		uint32_t slot_idx = 0;
+		return _lookup_idx(p_key, _idx, slot_idx);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t slot_idx = 0;
+		uint32_t element_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot_idx);
+
+		if (!exists) {
+			return false;
+		}
+
+		_erase_slot(slot_idx);
+		_elements[element_idx].key.~TKey();
+		_elements[element_idx].value.~TValue();
+		_size--;
+
+		if (element_idx < _size) {
+			memcpy((void *)&_elements[element_idx], (const void *)&_elements[_size], sizeof(MapKeyValue));
+			_hashes[element_idx] = _hashes[_size];
+			_slots[_find_slot_of_element(_size)] = element_idx;
+		}
+
+		return true;
+	}
+
+	// Replace the key of an entry in-place, without invalidating iterators or changing the entries position during iteration.
+	// p_old_key must exist in the map and p_new_key must not, unless it is equal to p_old_key.
+	bool replace_key(const TKey &p_old_key, const TKey &p_new_key) {
+		if (p_old_key == p_new_key) {
+			return true;
+		}
+		uint32_t slot_idx = 0;
+		uint32_t element_idx = 0;
+		ERR_FAIL_COND_V(_lookup_idx(p_new_key, element_idx, slot_idx), false);
+		ERR_FAIL_COND_V(!_lookup_idx(p_old_key, element_idx, slot_idx), false);
+		MapKeyValue &element = _elements[element_idx];
+		const_cast<TKey &>(element.key) = p_new_key;
+
+		_erase_slot(slot_idx);
+
+		const uint32_t hash = _hash(p_new_key);
+		_hashes[element_idx] = hash;
+		if (unlikely(_growth_left == 0)) {
+			// Rehashing reinserts every element, including this one.
+			_resize_and_rehash(_capacity_mask);
+		} else {
+			_insert_slot(hash, element_idx);
+		}
+
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	// If adding a known (possibly large) number of elements at once, must be larger than old capacity.
+	void reserve(uint32_t p_new_capacity) {
+		const uint32_t new_capacity_mask = _get_capacity_mask_for(p_new_capacity);
+		if (_elements == nullptr) {
+			_capacity_mask = MAX(_capacity_mask, new_capacity_mask);
+			return; // Unallocated yet.
+		}
+		if (new_capacity_mask <= _capacity_mask) {
+			if (p_new_capacity < size()) {
+				WARN_VERBOSE("reserve() called with a capacity smaller than the current size. This is likely a mistake.");
+			}
+			return;
+		}
+		_resize_and_rehash(new_capacity_mask);
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const MapKeyValue &operator*() const {
+			return *pair;
+		}
+		_FORCE_INLINE_ const MapKeyValue *operator->() const {
+			return pair;
+		}
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			pair++;
+			return *this;
+		}
+
+		_FORCE_INLINE_ ConstIterator &operator--() {
+			pair--;
+			if (pair < begin) {
+				pair = end;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return pair == b.pair; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return pair != b.pair; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return pair != end;
+		}
+
+		_FORCE_INLINE_ ConstIterator(MapKeyValue *p_key, MapKeyValue *p_begin, MapKeyValue *p_end) {
+			pair = p_key;
+			begin = p_begin;
+			end = p_end;
+		}
+		_FORCE_INLINE_ ConstIterator() {}
+		_FORCE_INLINE_ ConstIterator(const ConstIterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+		_FORCE_INLINE_ void operator=(const ConstIterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+
+	private:
+		MapKeyValue *pair = nullptr;
+		MapKeyValue *begin = nullptr;
+		MapKeyValue *end = nullptr;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ MapKeyValue &operator*() const {
+			return *pair;
+		}
+		_FORCE_INLINE_ MapKeyValue *operator->() const {
+			return pair;
+		}
+		_FORCE_INLINE_ Iterator &operator++() {
+			pair++;
+			return *this;
+		}
+		_FORCE_INLINE_ Iterator &operator--() {
+			pair--;
+			if (pair < begin) {
+				pair = end;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return pair == b.pair; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return pair != b.pair; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return pair != end;
+		}
+
+		_FORCE_INLINE_ Iterator(MapKeyValue *p_key, MapKeyValue *p_begin, MapKeyValue *p_end) {
+			pair = p_key;
+			begin = p_begin;
+			end = p_end;
+		}
+		_FORCE_INLINE_ Iterator() {}
+		_FORCE_INLINE_ Iterator(const Iterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+		_FORCE_INLINE_ void operator=(const Iterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+
+		operator ConstIterator() const {
+			return ConstIterator(pair, begin, end);
+		}
+
+	private:
+		MapKeyValue *pair = nullptr;
+		MapKeyValue *begin = nullptr;
+		MapKeyValue *end = nullptr;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(_elements, _elements, _elements + _size);
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(_elements + _size, _elements, _elements + _size);
+	}
+	_FORCE_INLINE_ Iterator last() {
+		if (unlikely(_size == 0)) {
+			return Iterator(nullptr, nullptr, nullptr);
+		}
+		return Iterator(_elements + _size - 1, _elements, _elements + _size);
+	}
+
+	Iterator find(const TKey &p_key) {
+		uint32_t slot_idx = 0;
+		uint32_t element_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot_idx);
+		if (!exists) {
+			return end();
+		}
+		return Iterator(_elements + element_idx, _elements, _elements + _size);
+	}
+
+	void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(_elements, _elements, _elements + _size);
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(_elements + _size, _elements, _elements + _size);
+	}
+	_FORCE_INLINE_ ConstIterator last() const {
+		if (unlikely(_size == 0)) {
+			return ConstIterator(nullptr, nullptr, nullptr);
+		}
+		return ConstIterator(_elements + _size - 1, _elements, _elements + _size);
+	}
+
+	ConstIterator find(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		uint32_t slot_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot_idx);
+		if (!exists) {
+			return end();
+		}
+		return ConstIterator(_elements + element_idx, _elements, _elements + _size);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		uint32_t slot_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot_idx);
+		CRASH_COND(!exists);
+		return _elements[element_idx].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t element_idx = 0;
+		uint32_t slot_idx = 0;
+		uint32_t hash = _hash(p_key);
+		bool exists = _lookup_idx_with_hash(p_key, element_idx, slot_idx, hash);
+
+		if (exists) {
+			return _elements[element_idx].value;
+		} else {
+			element_idx = _insert_element(p_key, TValue(), hash);
+			return _elements[element_idx].value;
+		}
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t element_idx = 0;
+		uint32_t slot_idx = 0;
+		uint32_t hash = _hash(p_key);
+		bool exists = _lookup_idx_with_hash(p_key, element_idx, slot_idx, hash);
+
+		if (!exists) {
+			element_idx = _insert_element(p_key, p_value, hash);
+		} else {
+			_elements[element_idx].value = p_value;
+		}
+		return Iterator(_elements + element_idx, _elements, _elements + _size);
+	}
+
+	// Inserts an element without checking if it already exists.
+	Iterator insert_new(const TKey &p_key, const TValue &p_value) {
+		DEV_ASSERT(!has(p_key));
+		uint32_t hash = _hash(p_key);
+		uint32_t element_idx = _insert_element(p_key, p_value, hash);
+		return Iterator(_elements + element_idx, _elements, _elements + _size);
+	}
+
+	/* Array methods. */
+
+	// Unsafe. Changing keys and going outside the bounds of an array can lead to undefined behavior.
+	KeyValue<TKey, TValue> *get_elements_ptr() {
+		return _elements;
+	}
+
+	// Returns the element index. If not found, returns -1.
+	int get_index(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		uint32_t slot_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot_idx);
+		if (!exists) {
+			return -1;
+		}
+		return element_idx;
+	}
+
+	KeyValue<TKey, TValue> &get_by_index(uint32_t p_index) {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, _size);
+		return _elements[p_index];
+	}
+
+	bool erase_by_index(uint32_t p_index) {
+		if (p_index >= size()) {
+			return false;
+		}
+		return erase(_elements[p_index].key);
+	}
+
+	/* Constructors */
+
+	SwissHashMap(SwissHashMap &&p_other) {
+		_elements = p_other._elements;
+		_hashes = p_other._hashes;
+		_ctrl = p_other._ctrl;
+		_slots = p_other._slots;
+		_capacity_mask = p_other._capacity_mask;
+		_size = p_other._size;
+		_growth_left = p_other._growth_left;
+
+		p_other._elements = nullptr;
+		p_other._hashes = nullptr;
+		p_other._ctrl = nullptr;
+		p_other._slots = nullptr;
+		p_other._capacity_mask = INITIAL_CAPACITY - 1;
+		p_other._size = 0;
+		p_other._growth_left = 0;
+	}
+
+	explicit SwissHashMap(const SwissHashMap &p_other) {
+		_init_from(p_other);
+	}
+
+	void operator=(const SwissHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+
+		reset();
+
+		_init_from(p_other);
+	}
+
+	SwissHashMap(uint32_t p_initial_capacity) {
+		_capacity_mask = _get_capacity_mask_for(p_initial_capacity);
+	}
+	SwissHashMap() :
+			_capacity_mask(INITIAL_CAPACITY - 1) {
+	}
+
+	SwissHashMap(std::initializer_list<KeyValue<TKey, TValue>> p_init) :
+			_capacity_mask(INITIAL_CAPACITY - 1) {
+		reserve(p_init.size());
+		for (const KeyValue<TKey, TValue> &E : p_init) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void reset() {
+		if (_elements != nullptr) {
+			if constexpr (!(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>)) {
+				for (uint32_t i = 0; i < _size; i++) {
+					_elements[i].key.~TKey();
+					_elements[i].value.~TValue();
+				}
+			}
+			Memory::free_static(_elements);
+			Memory::free_static(_hashes);
+			Memory::free_static(_ctrl);
+			Memory::free_static(_slots);
+			_elements = nullptr;
+			_hashes = nullptr;
+			_ctrl = nullptr;
+			_slots = nullptr;
+		}
+		_capacity_mask = INITIAL_CAPACITY - 1;
+		_size = 0;
+		_growth_left = 0;
+	}
+
+	~SwissHashMap() {
+		reset();
+	}
+};
@@ -0,0 +1,147 @@
+/**************************************************************************/
+/*  work_stealing_deque.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/thread.h"
+#include "core/typedefs.h"
+
+#include <atomic>
+#include <type_traits>
+
+// Chase-Lev work-stealing deque, using the memory orderings from
+// "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê et al., 2013).
+// The owner thread pushes and takes at the bottom (LIFO), while any other thread
+// can steal from the top (FIFO) without locking.
+// The capacity is fixed, so push() fails when the deque is full; callers are
+// expected to fall back to a shared queue in that case.
+template <typename T, uint32_t CAPACITY = 1024>
+class WorkStealingDeque {
+	static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "WorkStealingDeque capacity must be a power of 2.");
+	static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque only supports trivially copyable types.");
+
+	static constexpr int64_t MASK = CAPACITY - 1;
+
+	// Thieves contend on top, the owner mostly works on bottom; keep them apart.
+	union {
+		std::atomic<int64_t> top = 0;
+		char top_aligner[Thread::CACHE_LINE_BYTES];
+	};
+	union {
+		std::atomic<int64_t> bottom = 0;
+		char bottom_aligner[Thread::CACHE_LINE_BYTES];
+	};
+	std::atomic<T> buffer[CAPACITY];
+
+public:
+	// Owner thread only.
+	bool push(T p_value) {
+		int64_t b = bottom.load(std::memory_order_relaxed);
+		int64_t t = top.load(std::memory_order_acquire);
+		if (unlikely(b - t >= (int64_t)CAPACITY)) {
+			return false;
+		}
+		buffer[b & MASK].store(p_value, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	// Owner thread only.
+	bool take(T &r_value) {
+		// Top only grows, so this can't be a false negative. It spares the fence when idle.
+		if (bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed)) {
+			return false;
+		}
+
+		int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t t = top.load(std::memory_order_relaxed);
+
+		if (t > b) {
+			// Empty.
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		T value = buffer[b & MASK].load(std::memory_order_relaxed);
+		if (t == b) {
+			// Last element, race against thieves for it.
+			bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			bottom.store(b + 1, std::memory_order_relaxed);
+			if (!won) {
+				return false;
+			}
+		}
+		r_value = value;
+		return true;
+	}
+
+	// Any thread. Fails if the deque is empty or another thread got the element first.
+	bool steal(T &r_value) {
+		if (is_empty()) {
+			return false;
+		}
+
+		int64_t t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t b = bottom.load(std::memory_order_acquire);
+
+		if (t >= b) {
+			return false;
+		}
+
+		T value = buffer[t & MASK].load(std::memory_order_relaxed);
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			return false;
+		}
+		r_value = value;
+		return true;
+	}
+
+	// Only a hint when called from threads other than the owner.
+	_FORCE_INLINE_ bool is_empty() const {
+		return bottom.load(std::memory_order_acquire) <= top.load(std::memory_order_acquire);
+	}
+
+	_FORCE_INLINE_ uint32_t size() const {
+		int64_t s = bottom.load(std::memory_order_acquire) - top.load(std::memory_order_acquire);
+		return s > 0 ? (uint32_t)s : 0;
+	}
+
+	_FORCE_INLINE_ constexpr uint32_t get_capacity() const { return CAPACITY; }
+
+	WorkStealingDeque() {
+		for (uint32_t i = 0; i < CAPACITY; i++) {
+			buffer[i].store(T(), std::memory_order_relaxed);
+		}
+	}
+};
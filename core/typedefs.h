@@ -328,6 +328,43 @@ static inline uint64_t BSWAP64(uint64_t x) {
 }
 #endif
 
+// Index of the lowest set bit. The result is undefined if x is 0.
+#if defined(__GNUC__)
+_ALWAYS_INLINE_ uint32_t count_trailing_zeros(uint64_t x) {
+	return __builtin_ctzll(x);
+}
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+#include <intrin.h>
+_ALWAYS_INLINE_ uint32_t count_trailing_zeros(uint64_t x) {
+	unsigned long index;
+	_BitScanForward64(&index, x);
+	return index;
+}
+#else
+inline uint32_t count_trailing_zeros(uint64_t x) {
+	uint32_t n = 0;
+	while (!(x & 1)) {
+		x >>= 1;
+		n++;
+	}
+	return n;
+}
+#endif
+
+// Number of set bits.
+#if defined(__GNUC__)
+_ALWAYS_INLINE_ uint32_t count_set_bits(uint32_t x) {
+	return __builtin_popcount(x);
+}
+#else
+inline uint32_t count_set_bits(uint32_t x) {
+	x = x - ((x >> 1) & 0x55555555);
+	x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+	x = (x + (x >> 4)) & 0x0F0F0F0F;
+	return (x * 0x01010101) >> 24;
+}
+#endif
+
 // Generic comparator used in Map, List, etc.
 template <typename T>
 struct Comparator {
@@ -37,10 +37,86 @@ STATIC_ASSERT_INCOMPLETE_TYPE(class, String);
 #include "container_type_validate.h"
 #include "core/math/math_funcs.h"
 #include "core/object/script_language.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
 #include "core/templates/hashfuncs.h"
+#include "core/templates/sort_array.h"
 #include "core/templates/vector.h"
 #include "core/variant/callable.h"
 #include "core/variant/dictionary.h"
+#include "core/variant/variant_deep_walker.h"
+#include "core/variant/variant_internal.h"
+
+// Conversions for element types that typed arrays can store unboxed.
+struct ArrayPackedElement {
+	uint32_t size = 0;
+	void (*box)(const uint8_t *p_src, Variant &r_dst) = nullptr;
+	void (*unbox)(const Variant &p_src, uint8_t *p_dst) = nullptr;
+	void (*initialize)(uint8_t *p_dst) = nullptr;
+
+	static const ArrayPackedElement *get(Variant::Type p_type);
+};
+
+template <typename T>
+struct ArrayPackedElementImpl {
+	static void box(const uint8_t *p_src, Variant &r_dst) {
+		VariantTypeChanger<T>::change(&r_dst);
+		VariantInternalAccessor<T>::get(&r_dst) = *reinterpret_cast<const T *>(p_src);
+	}
+
+	static void unbox(const Variant &p_src, uint8_t *p_dst) {
+		*reinterpret_cast<T *>(p_dst) = VariantInternalAccessor<T>::get(&p_src);
+	}
+
+	static void initialize(uint8_t *p_dst) {
+		*reinterpret_cast<T *>(p_dst) = T();
+	}
+
+	static inline const ArrayPackedElement element = { sizeof(T), &box, &unbox, &initialize };
+};
+
+// Largest element size, used for temporary element buffers.
+static constexpr uint32_t ARRAY_PACKED_ELEMENT_MAX_SIZE = sizeof(Rect2);
+
+const ArrayPackedElement *ArrayPackedElement::get(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::BOOL:
+			return &ArrayPackedElementImpl<bool>::element;
+		case Variant::INT:
+			return &ArrayPackedElementImpl<int64_t>::element;
+		case Variant::FLOAT:
+			return &ArrayPackedElementImpl<double>::element;
+		case Variant::VECTOR2:
+			return &ArrayPackedElementImpl<Vector2>::element;
+		case Variant::VECTOR2I:
+			return &ArrayPackedElementImpl<Vector2i>::element;
+		case Variant::RECT2:
+			return &ArrayPackedElementImpl<Rect2>::element;
+		case Variant::RECT2I:
+			return &ArrayPackedElementImpl<Rect2i>::element;
+		case Variant::VECTOR3:
+			return &ArrayPackedElementImpl<Vector3>::element;
+		case Variant::VECTOR3I:
+			return &ArrayPackedElementImpl<Vector3i>::element;
+		case Variant::VECTOR4:
+			return &ArrayPackedElementImpl<Vector4>::element;
+		case Variant::VECTOR4I:
+			return &ArrayPackedElementImpl<Vector4i>::element;
+		case Variant::PLANE:
+			return &ArrayPackedElementImpl<Plane>::element;
+		case Variant::QUATERNION:
+			return &ArrayPackedElementImpl<Quaternion>::element;
+		case Variant::COLOR:
+			return &ArrayPackedElementImpl<Color>::element;
+		default:
+			return nullptr;
+	}
+}
+
+static BinaryMutex array_unpack_mutex;
+
+// How many elements `ArrayPrivate::box_element()` boxes one by one, at least, before boxing the whole array.
+static constexpr int ARRAY_BOXED_ELEMENTS_MIN = 16;
 
 struct ArrayPrivate {
 	SafeRefCount refcount;
@@ -48,11 +124,244 @@ struct ArrayPrivate {
 	Variant *read_only = nullptr; // If enabled, a pointer is used to a temporary value that is used to return read-only values.
 	ContainerTypeValidate typed;
 
+	// Typed arrays of the types in `ArrayPackedElement::get()` keep their elements unboxed in `packed_data`
+	// while `packed` is set, which takes a fraction of the memory of a Variant per element.
+	// Operations that hand out mutable Variant references or pointers box everything into `array` first, see `unpack()`.
+	// Const iterators and the const `operator[]` box elements one at a time instead.
+	const ArrayPackedElement *packed_element = nullptr;
+	SafeFlag packed;
+	int packed_count = 0;
+	Vector<uint8_t> packed_data;
+	// Elements boxed one at a time for readers that need a reference to them, see `box_element()`.
+	HashMap<int, Variant> boxed_elements;
+
+	void set_type(const ContainerTypeValidate &p_typed) {
+		typed = p_typed;
+		packed_element = ArrayPackedElement::get(typed.type);
+		if (packed_element && array.is_empty()) {
+			packed.set();
+		}
+	}
+
+	_FORCE_INLINE_ int size() const {
+		return packed.is_set() ? packed_count : array.size();
+	}
+
+	_FORCE_INLINE_ uint8_t *packed_ptrw(int p_idx) {
+		return packed_data.ptrw() + (size_t)p_idx * packed_element->size;
+	}
+
+	_FORCE_INLINE_ const uint8_t *packed_ptr(int p_idx) const {
+		return packed_data.ptr() + (size_t)p_idx * packed_element->size;
+	}
+
+	_FORCE_INLINE_ void box(int p_idx, Variant &r_value) const {
+		CRASH_BAD_INDEX(p_idx, packed_count);
+		// Numbers are by far the most common, so skip the indirect call for them.
+		if (typed.type == Variant::INT) {
+			VariantTypeChanger<int64_t>::change(&r_value);
+			*VariantInternal::get_int(&r_value) = reinterpret_cast<const int64_t *>(packed_data.ptr())[p_idx];
+		} else if (typed.type == Variant::FLOAT) {
+			VariantTypeChanger<double>::change(&r_value);
+			*VariantInternal::get_float(&r_value) = reinterpret_cast<const double *>(packed_data.ptr())[p_idx];
+		} else {
+			packed_element->box(packed_ptr(p_idx), r_value);
+		}
+	}
+
+	// Called by every modifying operation. Those can't run concurrently with reads, so this is
+	// where the packed data left behind by `unpack()` is released, and where an emptied array
+	// goes back to packed storage.
+	_FORCE_INLINE_ bool is_packed_for_write() {
+		if (unlikely(!boxed_elements.is_empty())) {
+			boxed_elements.clear();
+		}
+		if (packed.is_set()) {
+			return true;
+		}
+		if (unlikely(packed_element != nullptr)) {
+			packed_data.clear();
+			if (array.is_empty()) {
+				packed_count = 0;
+				packed.set();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Boxes the elements into `array` for good. Readers may call this concurrently, so the packed
+	// data stays valid for readers that already started on it until the next modification.
+	void unpack() {
+		if (likely(!packed.is_set())) {
+			return;
+		}
+		MutexLock lock(array_unpack_mutex);
+		_unpack_locked();
+	}
+
+	void _unpack_locked() {
+		if (!packed.is_set()) {
+			return;
+		}
+		array.resize(packed_count);
+		Variant *write = array.ptrw();
+		for (int i = 0; i < packed_count; i++) {
+			box(i, write[i]);
+		}
+		packed.clear();
+	}
+
+	// Boxes a single element for readers that need a reference to it, which stays valid until
+	// the next modification. Once many elements were asked for, the whole array is boxed instead,
+	// and nullptr is returned to read it from `array`.
+	const Variant *box_element(int p_idx) {
+		MutexLock lock(array_unpack_mutex);
+		if (!packed.is_set()) {
+			return nullptr;
+		}
+		CRASH_BAD_INDEX(p_idx, packed_count);
+		HashMap<int, Variant>::Iterator E = boxed_elements.find(p_idx);
+		if (E) {
+			return &E->value;
+		}
+		if (boxed_elements.size() >= (uint32_t)MAX(ARRAY_BOXED_ELEMENTS_MIN, packed_count / 8)) {
+			_unpack_locked();
+			return nullptr;
+		}
+		E = boxed_elements.insert(p_idx, Variant());
+		box(p_idx, E->value);
+		return &E->value;
+	}
+
+	Variant get_boxed(int p_idx) const {
+		Variant ret;
+		box(p_idx, ret);
+		return ret;
+	}
+
+	Vector<Variant> get_boxed() const {
+		if (!packed.is_set()) {
+			return array;
+		}
+		Vector<Variant> boxed;
+		boxed.resize(packed_count);
+		Variant *write = boxed.ptrw();
+		for (int i = 0; i < packed_count; i++) {
+			box(i, write[i]);
+		}
+		return boxed;
+	}
+
+	// Replaces the elements, which must already be validated for this array's type.
+	void set_elements(const Vector<Variant> &p_elements) {
+		boxed_elements.clear();
+		if (packed_element == nullptr) {
+			array = p_elements;
+			return;
+		}
+		array.clear();
+		packed_data.clear();
+		packed_count = 0;
+		packed.set();
+		packed_resize(p_elements.size());
+		for (int i = 0; i < packed_count; i++) {
+			packed_element->unbox(p_elements[i], packed_ptrw(i));
+		}
+	}
+
+	// Shares the elements of an array with the same element type.
+	void copy_elements(const ArrayPrivate &p_from) {
+		boxed_elements.clear();
+		if (packed_element != nullptr && packed_element == p_from.packed_element && p_from.packed.is_set()) {
+			array.clear();
+			packed_data = p_from.packed_data;
+			packed_count = p_from.packed_count;
+			packed.set();
+		} else {
+			array = p_from.get_boxed();
+			packed_data.clear();
+			packed.clear();
+		}
+	}
+
+	Error packed_resize(int p_new_size) {
+		ERR_FAIL_COND_V(p_new_size < 0, ERR_INVALID_PARAMETER);
+		Error err = packed_data.resize_uninitialized((int64_t)p_new_size * packed_element->size);
+		if (err) {
+			return err;
+		}
+		for (int i = packed_count; i < p_new_size; i++) {
+			packed_element->initialize(packed_ptrw(i));
+		}
+		packed_count = p_new_size;
+		return OK;
+	}
+
+	void packed_push_back(const Variant &p_value) {
+		packed_resize(packed_count + 1);
+		packed_element->unbox(p_value, packed_ptrw(packed_count - 1));
+	}
+
+	Error packed_insert(int p_pos, const Variant &p_value) {
+		Error err = packed_resize(packed_count + 1);
+		if (err) {
+			return err;
+		}
+		uint8_t *dst = packed_ptrw(p_pos);
+		memmove(dst + packed_element->size, dst, (size_t)(packed_count - 1 - p_pos) * packed_element->size);
+		packed_element->unbox(p_value, dst);
+		return OK;
+	}
+
+	void packed_remove_at(int p_pos) {
+		uint8_t *dst = packed_ptrw(p_pos);
+		memmove(dst, dst + packed_element->size, (size_t)(packed_count - 1 - p_pos) * packed_element->size);
+		packed_resize(packed_count - 1);
+	}
+
+	void packed_swap(int p_a, int p_b) {
+		uint8_t tmp[ARRAY_PACKED_ELEMENT_MAX_SIZE];
+		uint8_t *a = packed_ptrw(p_a);
+		uint8_t *b = packed_ptrw(p_b);
+		memcpy(tmp, a, packed_element->size);
+		memcpy(a, b, packed_element->size);
+		memcpy(b, tmp, packed_element->size);
+	}
+
 	ArrayPrivate() {}
 	ArrayPrivate(std::initializer_list<Variant> p_init) :
 			array(p_init) {}
 };
 
+// Reads elements by reference, boxing them one at a time when the array is packed.
+// The returned reference is only valid until the next read.
+class ArrayElementReader {
+	const ArrayPrivate *p = nullptr;
+	Variant boxed;
+
+public:
+	_FORCE_INLINE_ const Variant &operator[](int p_idx) {
+		if (!p->packed.is_set()) {
+			return p->array[p_idx];
+		}
+		p->box(p_idx, boxed);
+		return boxed;
+	}
+
+	// Same as StringLikeVariantComparator::compare() with an element of the array's type.
+	_FORCE_INLINE_ bool equals(int p_idx, const Variant &p_value) {
+		if (p->packed.is_set() && p->typed.type == Variant::INT) {
+			CRASH_BAD_INDEX(p_idx, p->packed_count);
+			return reinterpret_cast<const int64_t *>(p->packed_data.ptr())[p_idx] == *VariantInternal::get_int(&p_value);
+		}
+		return StringLikeVariantComparator::compare(operator[](p_idx), p_value);
+	}
+
+	ArrayElementReader(const ArrayPrivate *p_array) :
+			p(p_array) {}
+};
+
 void Array::_ref(const Array &p_from) const {
 	ArrayPrivate *_fp = p_from._p;
 
@@ -86,22 +395,37 @@ void Array::_unref() const {
 }
 
 Array::Iterator Array::begin() {
+	_p->unpack();
 	return Iterator(_p->array.ptrw(), _p->read_only);
 }
 
 Array::Iterator Array::end() {
+	_p->unpack();
 	return Iterator(_p->array.ptrw() + _p->array.size(), _p->read_only);
 }
 
 Array::ConstIterator Array::begin() const {
+	if (_p->packed.is_set()) {
+		return ConstIterator(_p, 0);
+	}
 	return ConstIterator(_p->array.ptr());
 }
 
 Array::ConstIterator Array::end() const {
-	return ConstIterator(_p->array.ptr() + _p->array.size());
+	if (_p->packed.is_set()) {
+		return ConstIterator(_p, _p->packed_count);
+	}
+	return ConstIterator(_p->array.ptr() + _p->array.size(), _p->array.size());
+}
+
+const Variant &Array::ConstIterator::_box() const {
+	Variant *element = reinterpret_cast<Variant *>(boxed);
+	packed->box(index, *element);
+	return *element;
 }
 
 Variant &Array::operator[](int p_idx) {
+	_p->unpack();
 	if (unlikely(_p->read_only)) {
 		*_p->read_only = _p->array[p_idx];
 		return *_p->read_only;
@@ -110,20 +434,30 @@ Variant &Array::operator[](int p_idx) {
 }
 
 const Variant &Array::operator[](int p_idx) const {
+	if (_p->packed.is_set()) {
+		const Variant *element = _p->box_element(p_idx);
+		if (element) {
+			return *element;
+		}
+	}
 	return _p->array[p_idx];
 }
 
 int Array::size() const {
-	return _p->array.size();
+	return _p->size();
 }
 
 bool Array::is_empty() const {
-	return _p->array.is_empty();
+	return _p->size() == 0;
 }
 
 void Array::clear() {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
 	_p->array.clear();
+	if (_p->is_packed_for_write()) {
+		_p->packed_data.clear();
+		_p->packed_count = 0;
+	}
 }
 
 bool Array::operator==(const Array &p_array) const {
@@ -139,10 +473,8 @@ bool Array::recursive_equal(const Array &p_array, int recursion_count) const {
 	if (_p == p_array._p) {
 		return true;
 	}
-	const Vector<Variant> &a1 = _p->array;
-	const Vector<Variant> &a2 = p_array._p->array;
-	const int size = a1.size();
-	if (size != a2.size()) {
+	const int size = _p->size();
+	if (size != p_array._p->size()) {
 		return false;
 	}
 
@@ -151,7 +483,12 @@ bool Array::recursive_equal(const Array &p_array, int recursion_count) const {
 		ERR_PRINT("Max recursion reached");
 		return true;
 	}
+	if (VariantDeepWalker::can_nest(_p->typed.type) && VariantDeepWalker::can_nest(p_array._p->typed.type)) {
+		return VariantDeepWalker::equal(*this, p_array, recursion_count);
+	}
 	recursion_count++;
+	ArrayElementReader a1(_p);
+	ArrayElementReader a2(p_array._p);
 	for (int i = 0; i < size; i++) {
 		if (!a1[i].hash_compare(a2[i], recursion_count, false)) {
 			return false;
@@ -167,10 +504,14 @@ bool Array::operator<(const Array &p_array) const {
 
 	int min_cmp = MIN(a_len, b_len);
 
+	ArrayElementReader a(_p);
+	ArrayElementReader b(p_array._p);
 	for (int i = 0; i < min_cmp; i++) {
-		if (operator[](i) < p_array[i]) {
+		const Variant &a_value = a[i];
+		const Variant &b_value = b[i];
+		if (a_value < b_value) {
 			return true;
-		} else if (p_array[i] < operator[](i)) {
+		} else if (b_value < a_value) {
 			return false;
 		}
 	}
@@ -198,11 +539,17 @@ uint32_t Array::recursive_hash(int recursion_count) const {
 		return 0;
 	}
 
+	if (VariantDeepWalker::can_nest(_p->typed.type)) {
+		return VariantDeepWalker::hash(*this, recursion_count);
+	}
+
 	uint32_t h = hash_murmur3_one_32(Variant::ARRAY);
 
 	recursion_count++;
-	for (int i = 0; i < _p->array.size(); i++) {
-		h = hash_murmur3_one_32(_p->array[i].recursive_hash(recursion_count), h);
+	ArrayElementReader reader(_p);
+	const int size = _p->size();
+	for (int i = 0; i < size; i++) {
+		h = hash_murmur3_one_32(reader[i].recursive_hash(recursion_count), h);
 	}
 	return hash_fmix32(h);
 }
@@ -222,12 +569,12 @@ void Array::assign(const Array &p_array) {
 		// from same to same or
 		// from anything to variants or
 		// from subclasses to base classes
-		_p->array = p_array._p->array;
+		_p->copy_elements(*p_array._p);
 		return;
 	}
 
-	const Variant *source = p_array._p->array.ptr();
-	int size = p_array._p->array.size();
+	ArrayElementReader source(p_array._p);
+	int size = p_array._p->size();
 
 	if ((source_typed.type == Variant::NIL && typed.type == Variant::OBJECT) || (source_typed.type == Variant::OBJECT && source_typed.can_reference(typed))) {
 		// from variants to objects or
@@ -238,7 +585,7 @@ void Array::assign(const Array &p_array) {
 				ERR_FAIL_MSG(vformat(R"(Unable to convert array index %d from "%s" to "%s".)", i, Variant::get_type_name(element.get_type()), Variant::get_type_name(typed.type)));
 			}
 		}
-		_p->array = p_array._p->array;
+		_p->copy_elements(*p_array._p);
 		return;
 	}
 	if (typed.type == Variant::OBJECT || source_typed.type == Variant::OBJECT) {
@@ -252,7 +599,7 @@ void Array::assign(const Array &p_array) {
 	if (source_typed.type == Variant::NIL && typed.type != Variant::OBJECT) {
 		// from variants to primitives
 		for (int i = 0; i < size; i++) {
-			const Variant *value = source + i;
+			const Variant *value = &source[i];
 			if (value->get_type() == typed.type) {
 				data[i] = *value;
 				continue;
@@ -267,7 +614,7 @@ void Array::assign(const Array &p_array) {
 	} else if (Variant::can_convert_strict(source_typed.type, typed.type)) {
 		// from primitives to different convertible primitives
 		for (int i = 0; i < size; i++) {
-			const Variant *value = source + i;
+			const Variant *value = &source[i];
 			Callable::CallError ce;
 			Variant::construct(typed.type, data[i], &value, 1, ce);
 			ERR_FAIL_COND_MSG(ce.error, vformat(R"(Unable to convert array index %d from "%s" to "%s".)", i, Variant::get_type_name(value->get_type()), Variant::get_type_name(typed.type)));
@@ -276,25 +623,50 @@ void Array::assign(const Array &p_array) {
 		ERR_FAIL_MSG(vformat(R"(Cannot assign contents of "Array[%s]" to "Array[%s]".)", Variant::get_type_name(source_typed.type), Variant::get_type_name(typed.type)));
 	}
 
-	_p->array = array;
+	_p->set_elements(array);
 }
 
 void Array::push_back(const Variant &p_value) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
 	Variant value = p_value;
 	ERR_FAIL_COND(!_p->typed.validate(value, "push_back"));
+	if (_p->is_packed_for_write()) {
+		_p->packed_push_back(value);
+		return;
+	}
 	_p->array.push_back(std::move(value));
 }
 
 void Array::append_array(const Array &p_array) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
 
+	if (_p->is_packed_for_write()) {
+		if (p_array._p->packed.is_set() && p_array._p->packed_element == _p->packed_element) {
+			_p->packed_data.append_array(p_array._p->packed_data);
+			_p->packed_count += p_array._p->packed_count;
+			return;
+		}
+
+		// Validate everything first, so a failure leaves the array untouched.
+		Vector<Variant> validated_array = p_array._p->get_boxed();
+		if (!_p->typed.can_reference(p_array._p->typed)) {
+			Variant *write = validated_array.ptrw();
+			for (int i = 0; i < validated_array.size(); ++i) {
+				ERR_FAIL_COND(!_p->typed.validate(write[i], "append_array"));
+			}
+		}
+		for (const Variant &value : validated_array) {
+			_p->packed_push_back(value);
+		}
+		return;
+	}
+
 	if (!is_typed() || _p->typed.can_reference(p_array._p->typed)) {
-		_p->array.append_array(p_array._p->array);
+		_p->array.append_array(p_array._p->get_boxed());
 		return;
 	}
 
-	Vector<Variant> validated_array = p_array._p->array;
+	Vector<Variant> validated_array = p_array._p->get_boxed();
 	Variant *write = validated_array.ptrw();
 	for (int i = 0; i < validated_array.size(); ++i) {
 		ERR_FAIL_COND(!_p->typed.validate(write[i], "append_array"));
@@ -305,6 +677,9 @@ void Array::append_array(const Array &p_array) {
 
 Error Array::resize(int p_new_size) {
 	ERR_FAIL_COND_V_MSG(_p->read_only, ERR_LOCKED, "Array is in read-only state.");
+	if (_p->is_packed_for_write()) {
+		return _p->packed_resize(p_new_size);
+	}
 	Variant::Type &variant_type = _p->typed.type;
 	int old_size = _p->array.size();
 	Error err = _p->array.resize_initialized(p_new_size);
@@ -319,6 +694,9 @@ Error Array::resize(int p_new_size) {
 
 Error Array::reserve(int p_new_size) {
 	ERR_FAIL_COND_V_MSG(_p->read_only, ERR_LOCKED, "Array is in read-only state.");
+	if (_p->is_packed_for_write()) {
+		return _p->packed_data.reserve((int64_t)p_new_size * _p->packed_element->size);
+	}
 	return _p->array.reserve(p_new_size);
 }
 
@@ -327,13 +705,17 @@ Error Array::insert(int p_pos, const Variant &p_value) {
 	Variant value = p_value;
 	ERR_FAIL_COND_V(!_p->typed.validate(value, "insert"), ERR_INVALID_PARAMETER);
 
+	const int size = _p->size();
 	if (p_pos < 0) {
 		// Relative offset from the end.
-		p_pos = _p->array.size() + p_pos;
+		p_pos = size + p_pos;
 	}
 
-	ERR_FAIL_INDEX_V_MSG(p_pos, _p->array.size() + 1, ERR_INVALID_PARAMETER, vformat("The calculated index %d is out of bounds (the array has %d elements). Leaving the array untouched.", p_pos, _p->array.size()));
+	ERR_FAIL_INDEX_V_MSG(p_pos, size + 1, ERR_INVALID_PARAMETER, vformat("The calculated index %d is out of bounds (the array has %d elements). Leaving the array untouched.", p_pos, size));
 
+	if (_p->is_packed_for_write()) {
+		return _p->packed_insert(p_pos, value);
+	}
 	return _p->array.insert(p_pos, std::move(value));
 }
 
@@ -341,6 +723,17 @@ void Array::fill(const Variant &p_value) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
 	Variant value = p_value;
 	ERR_FAIL_COND(!_p->typed.validate(value, "fill"));
+	if (_p->is_packed_for_write()) {
+		if (_p->packed_count > 0) {
+			const uint32_t element_size = _p->packed_element->size;
+			uint8_t *write = _p->packed_ptrw(0);
+			_p->packed_element->unbox(value, write);
+			for (int i = 1; i < _p->packed_count; i++) {
+				memcpy(write + (size_t)i * element_size, write, element_size);
+			}
+		}
+		return;
+	}
 	_p->array.fill(std::move(value));
 }
 
@@ -348,26 +741,36 @@ void Array::erase(const Variant &p_value) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
 	Variant value = p_value;
 	ERR_FAIL_COND(!_p->typed.validate(value, "erase"));
+	if (_p->is_packed_for_write()) {
+		ArrayElementReader reader(_p);
+		for (int i = 0; i < _p->packed_count; i++) {
+			if (reader[i] == value) {
+				_p->packed_remove_at(i);
+				return;
+			}
+		}
+		return;
+	}
 	_p->array.erase(value);
 }
 
 Variant Array::front() const {
-	ERR_FAIL_COND_V_MSG(_p->array.is_empty(), Variant(), "Can't take value from empty array.");
-	return operator[](0);
+	ERR_FAIL_COND_V_MSG(is_empty(), Variant(), "Can't take value from empty array.");
+	return get(0);
 }
 
 Variant Array::back() const {
-	ERR_FAIL_COND_V_MSG(_p->array.is_empty(), Variant(), "Can't take value from empty array.");
-	return operator[](_p->array.size() - 1);
+	ERR_FAIL_COND_V_MSG(is_empty(), Variant(), "Can't take value from empty array.");
+	return get(size() - 1);
 }
 
 Variant Array::pick_random() const {
-	ERR_FAIL_COND_V_MSG(_p->array.is_empty(), Variant(), "Can't take value from empty array.");
-	return operator[](Math::rand() % _p->array.size());
+	ERR_FAIL_COND_V_MSG(is_empty(), Variant(), "Can't take value from empty array.");
+	return get(Math::rand() % size());
 }
 
 int Array::find(const Variant &p_value, int p_from) const {
-	if (_p->array.is_empty()) {
+	if (is_empty()) {
 		return -1;
 	}
 	Variant value = p_value;
@@ -379,8 +782,9 @@ int Array::find(const Variant &p_value, int p_from) const {
 		return ret;
 	}
 
+	ArrayElementReader reader(_p);
 	for (int i = p_from; i < size(); i++) {
-		if (StringLikeVariantComparator::compare(_p->array[i], value)) {
+		if (reader.equals(i, value)) {
 			ret = i;
 			break;
 		}
@@ -398,8 +802,9 @@ int Array::find_custom(const Callable &p_callable, int p_from) const {
 
 	const Variant *argptrs[1];
 
+	ArrayElementReader reader(_p);
 	for (int i = p_from; i < size(); i++) {
-		const Variant &val = _p->array[i];
+		const Variant &val = reader[i];
 		argptrs[0] = &val;
 		Variant res;
 		Callable::CallError ce;
@@ -418,7 +823,8 @@ int Array::find_custom(const Callable &p_callable, int p_from) const {
 }
 
 int Array::rfind(const Variant &p_value, int p_from) const {
-	if (_p->array.is_empty()) {
+	const int size = _p->size();
+	if (size == 0) {
 		return -1;
 	}
 	Variant value = p_value;
@@ -426,15 +832,16 @@ int Array::rfind(const Variant &p_value, int p_from) const {
 
 	if (p_from < 0) {
 		// Relative offset from the end
-		p_from = _p->array.size() + p_from;
+		p_from = size + p_from;
 	}
-	if (p_from < 0 || p_from >= _p->array.size()) {
+	if (p_from < 0 || p_from >= size) {
 		// Limit to array boundaries
-		p_from = _p->array.size() - 1;
+		p_from = size - 1;
 	}
 
+	ArrayElementReader reader(_p);
 	for (int i = p_from; i >= 0; i--) {
-		if (StringLikeVariantComparator::compare(_p->array[i], value)) {
+		if (reader.equals(i, value)) {
 			return i;
 		}
 	}
@@ -443,23 +850,25 @@ int Array::rfind(const Variant &p_value, int p_from) const {
 }
 
 int Array::rfind_custom(const Callable &p_callable, int p_from) const {
-	if (_p->array.is_empty()) {
+	const int size = _p->size();
+	if (size == 0) {
 		return -1;
 	}
 
 	if (p_from < 0) {
 		// Relative offset from the end.
-		p_from = _p->array.size() + p_from;
+		p_from = size + p_from;
 	}
-	if (p_from < 0 || p_from >= _p->array.size()) {
+	if (p_from < 0 || p_from >= size) {
 		// Limit to array boundaries.
-		p_from = _p->array.size() - 1;
+		p_from = size - 1;
 	}
 
 	const Variant *argptrs[1];
 
+	ArrayElementReader reader(_p);
 	for (int i = p_from; i >= 0; i--) {
-		const Variant &val = _p->array[i];
+		const Variant &val = reader[i];
 		argptrs[0] = &val;
 		Variant res;
 		Callable::CallError ce;
@@ -480,13 +889,15 @@ int Array::rfind_custom(const Callable &p_callable, int p_from) const {
 int Array::count(const Variant &p_value) const {
 	Variant value = p_value;
 	ERR_FAIL_COND_V(!_p->typed.validate(value, "count"), 0);
-	if (_p->array.is_empty()) {
+	const int size = _p->size();
+	if (size == 0) {
 		return 0;
 	}
 
 	int amount = 0;
-	for (int i = 0; i < _p->array.size(); i++) {
-		if (StringLikeVariantComparator::compare(_p->array[i], value)) {
+	ArrayElementReader reader(_p);
+	for (int i = 0; i < size; i++) {
+		if (reader.equals(i, value)) {
 			amount++;
 		}
 	}
@@ -504,13 +915,18 @@ bool Array::has(const Variant &p_value) const {
 void Array::remove_at(int p_pos) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
 
+	const int size = _p->size();
 	if (p_pos < 0) {
 		// Relative offset from the end.
-		p_pos = _p->array.size() + p_pos;
+		p_pos = size + p_pos;
 	}
 
-	ERR_FAIL_INDEX_MSG(p_pos, _p->array.size(), vformat("The calculated index %d is out of bounds (the array has %d elements). Leaving the array untouched.", p_pos, _p->array.size()));
+	ERR_FAIL_INDEX_MSG(p_pos, size, vformat("The calculated index %d is out of bounds (the array has %d elements). Leaving the array untouched.", p_pos, size));
 
+	if (_p->is_packed_for_write()) {
+		_p->packed_remove_at(p_pos);
+		return;
+	}
 	_p->array.remove_at(p_pos);
 }
 
@@ -519,11 +935,19 @@ void Array::set(int p_idx, const Variant &p_value) {
 	Variant value = p_value;
 	ERR_FAIL_COND(!_p->typed.validate(value, "set"));
 
+	if (_p->is_packed_for_write()) {
+		CRASH_BAD_INDEX(p_idx, _p->packed_count);
+		_p->packed_element->unbox(value, _p->packed_ptrw(p_idx));
+		return;
+	}
 	_p->array.write[p_idx] = std::move(value);
 }
 
-const Variant &Array::get(int p_idx) const {
-	return operator[](p_idx);
+Variant Array::get(int p_idx) const {
+	if (_p->packed.is_set()) {
+		return _p->get_boxed(p_idx);
+	}
+	return _p->array[p_idx];
 }
 
 Array Array::duplicate(bool p_deep) const {
@@ -535,39 +959,33 @@ Array Array::duplicate_deep(ResourceDeepDuplicateMode p_deep_subresources_mode)
 }
 
 Array Array::recursive_duplicate(bool p_deep, ResourceDeepDuplicateMode p_deep_subresources_mode, int recursion_count) const {
+	if (p_deep && !VariantDeepWalker::is_plain_value(_p->typed.type)) {
+		// Copies the nested containers as well, without recursing.
+		Array copy = VariantDeepWalker::duplicate(*this, p_deep_subresources_mode, recursion_count);
+
+		// Variant::recursive_duplicate() may have created a remap cache by now.
+		if (recursion_count == 0) {
+			Resource::_teardown_duplicate_from_variant();
+		}
+		return copy;
+	}
+
 	Array new_arr;
-	new_arr._p->typed = _p->typed;
+	new_arr._p->set_type(_p->typed);
 
 	if (recursion_count > MAX_RECURSION) {
 		ERR_PRINT("Max recursion reached");
 		return new_arr;
 	}
 
-	if (p_deep) {
-		bool is_call_chain_end = recursion_count == 0;
-
-		recursion_count++;
-		int element_count = size();
-		new_arr.resize(element_count);
-		Variant *write = new_arr._p->array.ptrw();
-		for (int i = 0; i < element_count; i++) {
-			write[i] = get(i).recursive_duplicate(true, p_deep_subresources_mode, recursion_count);
-		}
-
-		// Variant::recursive_duplicate() may have created a remap cache by now.
-		if (is_call_chain_end) {
-			Resource::_teardown_duplicate_from_variant();
-		}
-	} else {
-		new_arr._p->array = _p->array;
-	}
-
+	// Plain values, including all packable element types, are deep copied by a shallow copy.
+	new_arr._p->copy_elements(*_p);
 	return new_arr;
 }
 
 Array Array::slice(int p_begin, int p_end, int p_step, bool p_deep) const {
 	Array result;
-	result._p->typed = _p->typed;
+	result._p->set_type(_p->typed);
 
 	ERR_FAIL_COND_V_MSG(p_step == 0, result, "Slice step cannot be zero.");
 
@@ -592,6 +1010,15 @@ Array Array::slice(int p_begin, int p_end, int p_step, bool p_deep) const {
 	int result_size = (end - begin) / p_step + (((end - begin) % p_step != 0) ? 1 : 0);
 	result.resize(result_size);
 
+	if (result._p->packed.is_set()) {
+		ArrayElementReader reader(_p);
+		for (int src_idx = begin, dest_idx = 0; dest_idx < result_size; ++dest_idx) {
+			result._p->packed_element->unbox(reader[src_idx], result._p->packed_ptrw(dest_idx));
+			src_idx += p_step;
+		}
+		return result;
+	}
+
 	Variant *write = result._p->array.ptrw();
 	for (int src_idx = begin, dest_idx = 0; dest_idx < result_size; ++dest_idx) {
 		write[dest_idx] = p_deep ? get(src_idx).duplicate(true) : get(src_idx);
@@ -603,14 +1030,16 @@ Array Array::slice(int p_begin, int p_end, int p_step, bool p_deep) const {
 
 Array Array::filter(const Callable &p_callable) const {
 	Array new_arr;
-	new_arr.resize(size());
-	new_arr._p->typed = _p->typed;
+	new_arr._p->set_type(_p->typed);
+	Vector<Variant> accepted;
+	accepted.resize(size());
 	int accepted_count = 0;
 
 	const Variant *argptrs[1];
-	Variant *write = new_arr._p->array.ptrw();
+	Variant *write = accepted.ptrw();
+	ArrayElementReader reader(_p);
 	for (int i = 0; i < size(); i++) {
-		argptrs[0] = &get(i);
+		argptrs[0] = &reader[i];
 
 		Variant result;
 		Callable::CallError ce;
@@ -620,12 +1049,13 @@ Array Array::filter(const Callable &p_callable) const {
 		}
 
 		if (result.operator bool()) {
-			write[accepted_count] = get(i);
+			write[accepted_count] = reader[i];
 			accepted_count++;
 		}
 	}
 
-	new_arr.resize(accepted_count);
+	accepted.resize(accepted_count);
+	new_arr._p->set_elements(accepted);
 
 	return new_arr;
 }
@@ -636,8 +1066,9 @@ Array Array::map(const Callable &p_callable) const {
 
 	const Variant *argptrs[1];
 	Variant *write = new_arr._p->array.ptrw();
+	ArrayElementReader reader(_p);
 	for (int i = 0; i < size(); i++) {
-		argptrs[0] = &get(i);
+		argptrs[0] = &reader[i];
 
 		Callable::CallError ce;
 		p_callable.callp(argptrs, 1, write[i], ce);
@@ -658,9 +1089,10 @@ Variant Array::reduce(const Callable &p_callable, const Variant &p_accum) const
 	}
 
 	const Variant *argptrs[2];
+	ArrayElementReader reader(_p);
 	for (int i = start; i < size(); i++) {
 		argptrs[0] = &ret;
-		argptrs[1] = &get(i);
+		argptrs[1] = &reader[i];
 
 		Variant result;
 		Callable::CallError ce;
@@ -676,8 +1108,9 @@ Variant Array::reduce(const Callable &p_callable, const Variant &p_accum) const
 
 bool Array::any(const Callable &p_callable) const {
 	const Variant *argptrs[1];
+	ArrayElementReader reader(_p);
 	for (int i = 0; i < size(); i++) {
-		argptrs[0] = &get(i);
+		argptrs[0] = &reader[i];
 
 		Variant result;
 		Callable::CallError ce;
@@ -698,8 +1131,9 @@ bool Array::any(const Callable &p_callable) const {
 
 bool Array::all(const Callable &p_callable) const {
 	const Variant *argptrs[1];
+	ArrayElementReader reader(_p);
 	for (int i = 0; i < size(); i++) {
-		argptrs[0] = &get(i);
+		argptrs[0] = &reader[i];
 
 		Variant result;
 		Callable::CallError ce;
@@ -730,22 +1164,54 @@ struct _ArrayVariantSort {
 	}
 };
 
+template <typename T>
+static void _sort_packed(ArrayPrivate *p_array) {
+	SortArray<T> sorter;
+	sorter.sort(reinterpret_cast<T *>(p_array->packed_data.ptrw()), p_array->packed_count);
+}
+
 void Array::sort() {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
+	if (_p->is_packed_for_write()) {
+		// Numbers compare the same unboxed, everything else goes through the Variant operators.
+		if (_p->typed.type == Variant::INT) {
+			_sort_packed<int64_t>(_p);
+		} else if (_p->typed.type == Variant::FLOAT) {
+			_sort_packed<double>(_p);
+		} else {
+			Vector<Variant> boxed = _p->get_boxed();
+			boxed.sort_custom<_ArrayVariantSort>();
+			_p->set_elements(boxed);
+		}
+		return;
+	}
 	_p->array.sort_custom<_ArrayVariantSort>();
 }
 
 void Array::sort_custom(const Callable &p_callable) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
+	if (_p->is_packed_for_write()) {
+		Vector<Variant> boxed = _p->get_boxed();
+		boxed.sort_custom<CallableComparator, true>(p_callable);
+		_p->set_elements(boxed);
+		return;
+	}
 	_p->array.sort_custom<CallableComparator, true>(p_callable);
 }
 
 void Array::shuffle() {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
-	const int n = _p->array.size();
+	const int n = _p->size();
 	if (n < 2) {
 		return;
 	}
+	if (_p->is_packed_for_write()) {
+		for (int i = n - 1; i >= 1; i--) {
+			const int j = Math::rand() % (i + 1);
+			_p->packed_swap(i, j);
+		}
+		return;
+	}
 	Variant *data = _p->array.ptrw();
 	for (int i = n - 1; i >= 1; i--) {
 		const int j = Math::rand() % (i + 1);
@@ -753,21 +1219,59 @@ void Array::shuffle() {
 	}
 }
 
+template <typename Comparator>
+static int _bisect(const ArrayPrivate *p_array, const Variant &p_value, bool p_before, Comparator p_compare) {
+	if (!p_array->packed.is_set()) {
+		return p_array->array.span().bisect(p_value, p_before, p_compare);
+	}
+
+	// Same as Span::bisect(), boxing the probed elements.
+	ArrayElementReader reader(p_array);
+	int lo = 0;
+	int hi = p_array->packed_count;
+	if (p_before) {
+		while (lo < hi) {
+			const int mid = (lo + hi) / 2;
+			if (p_compare(reader[mid], p_value)) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+	} else {
+		while (lo < hi) {
+			const int mid = (lo + hi) / 2;
+			if (p_compare(p_value, reader[mid])) {
+				hi = mid;
+			} else {
+				lo = mid + 1;
+			}
+		}
+	}
+	return lo;
+}
+
 int Array::bsearch(const Variant &p_value, bool p_before) const {
 	Variant value = p_value;
 	ERR_FAIL_COND_V(!_p->typed.validate(value, "binary search"), -1);
-	return _p->array.span().bisect<_ArrayVariantSort>(value, p_before);
+	return _bisect(_p, value, p_before, _ArrayVariantSort());
 }
 
 int Array::bsearch_custom(const Variant &p_value, const Callable &p_callable, bool p_before) const {
 	Variant value = p_value;
 	ERR_FAIL_COND_V(!_p->typed.validate(value, "custom binary search"), -1);
 
-	return _p->array.bsearch_custom<CallableComparator>(value, p_before, p_callable);
+	return _bisect(_p, value, p_before, CallableComparator{ p_callable });
 }
 
 void Array::reverse() {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
+	if (_p->is_packed_for_write()) {
+		for (int i = 0, j = _p->packed_count - 1; i < j; i++, j--) {
+			_p->packed_swap(i, j);
+		}
+		return;
+	}
 	_p->array.reverse();
 }
 
@@ -775,11 +1279,23 @@ void Array::push_front(const Variant &p_value) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
 	Variant value = p_value;
 	ERR_FAIL_COND(!_p->typed.validate(value, "push_front"));
+	if (_p->is_packed_for_write()) {
+		_p->packed_insert(0, value);
+		return;
+	}
 	_p->array.insert(0, std::move(value));
 }
 
 Variant Array::pop_back() {
 	ERR_FAIL_COND_V_MSG(_p->read_only, Variant(), "Array is in read-only state.");
+	if (_p->is_packed_for_write()) {
+		if (_p->packed_count == 0) {
+			return Variant();
+		}
+		const Variant ret = get(_p->packed_count - 1);
+		_p->packed_resize(_p->packed_count - 1);
+		return ret;
+	}
 	if (!_p->array.is_empty()) {
 		const int n = _p->array.size() - 1;
 		const Variant ret = _p->array.get(n);
@@ -791,6 +1307,14 @@ Variant Array::pop_back() {
 
 Variant Array::pop_front() {
 	ERR_FAIL_COND_V_MSG(_p->read_only, Variant(), "Array is in read-only state.");
+	if (_p->is_packed_for_write()) {
+		if (_p->packed_count == 0) {
+			return Variant();
+		}
+		const Variant ret = get(0);
+		_p->packed_remove_at(0);
+		return ret;
+	}
 	if (!_p->array.is_empty()) {
 		const Variant ret = _p->array.get(0);
 		_p->array.remove_at(0);
@@ -801,27 +1325,32 @@ Variant Array::pop_front() {
 
 Variant Array::pop_at(int p_pos) {
 	ERR_FAIL_COND_V_MSG(_p->read_only, Variant(), "Array is in read-only state.");
-	if (_p->array.is_empty()) {
+	const int size = _p->size();
+	if (size == 0) {
 		// Return `null` without printing an error to mimic `pop_back()` and `pop_front()` behavior.
 		return Variant();
 	}
 
 	if (p_pos < 0) {
 		// Relative offset from the end
-		p_pos = _p->array.size() + p_pos;
+		p_pos = size + p_pos;
 	}
 
 	ERR_FAIL_INDEX_V_MSG(
 			p_pos,
-			_p->array.size(),
+			size,
 			Variant(),
 			vformat(
 					"The calculated index %s is out of bounds (the array has %s elements). Leaving the array untouched and returning `null`.",
 					p_pos,
-					_p->array.size()));
+					size));
 
-	const Variant ret = _p->array.get(p_pos);
-	_p->array.remove_at(p_pos);
+	const Variant ret = get(p_pos);
+	if (_p->is_packed_for_write()) {
+		_p->packed_remove_at(p_pos);
+	} else {
+		_p->array.remove_at(p_pos);
+	}
 	return ret;
 }
 
@@ -833,9 +1362,11 @@ Variant Array::min() const {
 
 	int min_index = 0;
 	Variant is_less;
+	ArrayElementReader reader(_p);
+	ArrayElementReader min_reader(_p);
 	for (int i = 1; i < array_size; i++) {
 		bool valid;
-		Variant::evaluate(Variant::OP_LESS, _p->array[i], _p->array[min_index], is_less, valid);
+		Variant::evaluate(Variant::OP_LESS, reader[i], min_reader[min_index], is_less, valid);
 		if (!valid) {
 			return Variant(); //not a valid comparison
 		}
@@ -843,7 +1374,7 @@ Variant Array::min() const {
 			min_index = i;
 		}
 	}
-	return _p->array[min_index];
+	return get(min_index);
 }
 
 Variant Array::max() const {
@@ -854,9 +1385,11 @@ Variant Array::max() const {
 
 	int max_index = 0;
 	Variant is_greater;
+	ArrayElementReader reader(_p);
+	ArrayElementReader max_reader(_p);
 	for (int i = 1; i < array_size; i++) {
 		bool valid;
-		Variant::evaluate(Variant::OP_GREATER, _p->array[i], _p->array[max_index], is_greater, valid);
+		Variant::evaluate(Variant::OP_GREATER, reader[i], max_reader[max_index], is_greater, valid);
 		if (!valid) {
 			return Variant(); //not a valid comparison
 		}
@@ -864,7 +1397,7 @@ Variant Array::max() const {
 			max_index = i;
 		}
 	}
-	return _p->array[max_index];
+	return get(max_index);
 }
 
 const void *Array::id() const {
@@ -884,17 +1417,19 @@ void Array::set_typed(const ContainerType &p_element_type) {
 
 void Array::set_typed(uint32_t p_type, const StringName &p_class_name, const Variant &p_script) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
-	ERR_FAIL_COND_MSG(_p->array.size() > 0, "Type can only be set when array is empty.");
+	ERR_FAIL_COND_MSG(_p->size() > 0, "Type can only be set when array is empty.");
 	ERR_FAIL_COND_MSG(_p->refcount.get() > 1, "Type can only be set when array has no more than one user.");
 	ERR_FAIL_COND_MSG(_p->typed.type != Variant::NIL, "Type can only be set once.");
 	ERR_FAIL_COND_MSG(p_class_name != StringName() && p_type != Variant::OBJECT, "Class names can only be set for type OBJECT");
 	Ref<Script> script = p_script;
 	ERR_FAIL_COND_MSG(script.is_valid() && p_class_name == StringName(), "Script class can only be set together with base class name");
 
-	_p->typed.type = Variant::Type(p_type);
-	_p->typed.class_name = p_class_name;
-	_p->typed.script = script;
-	_p->typed.where = "TypedArray";
+	ContainerTypeValidate typed;
+	typed.type = Variant::Type(p_type);
+	typed.class_name = p_class_name;
+	typed.script = script;
+	typed.where = "TypedArray";
+	_p->set_type(typed);
 }
 
 bool Array::is_typed() const {
@@ -946,6 +1481,7 @@ bool Array::is_read_only() const {
 }
 
 Span<Variant> Array::span() const {
+	_p->unpack();
 	return _p->array.span();
 }
 
@@ -51,22 +51,35 @@ class Array {
 
 public:
 	struct ConstIterator {
-		_FORCE_INLINE_ const Variant &operator*() const { return *element_ptr; }
-		_FORCE_INLINE_ const Variant *operator->() const { return element_ptr; }
+		_FORCE_INLINE_ const Variant &operator*() const;
+		_FORCE_INLINE_ const Variant *operator->() const;
 
 		_FORCE_INLINE_ ConstIterator &operator++();
 		_FORCE_INLINE_ ConstIterator &operator--();
 
-		_FORCE_INLINE_ bool operator==(const ConstIterator &p_other) const { return element_ptr == p_other.element_ptr; }
-		_FORCE_INLINE_ bool operator!=(const ConstIterator &p_other) const { return element_ptr != p_other.element_ptr; }
+		// Another thread may box the array between begin() and end(), so packed iterators compare by index.
+		_FORCE_INLINE_ bool operator==(const ConstIterator &p_other) const { return (packed || p_other.packed) ? index == p_other.index : element_ptr == p_other.element_ptr; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &p_other) const { return !operator==(p_other); }
 
 		ConstIterator() = default;
 
-		_FORCE_INLINE_ ConstIterator(const Variant *p_element_ptr) :
-				element_ptr(p_element_ptr) {}
+		_FORCE_INLINE_ ConstIterator(const Variant *p_element_ptr, int p_index = 0) :
+				element_ptr(p_element_ptr), index(p_index) {}
+		_FORCE_INLINE_ ConstIterator(const ArrayPrivate *p_packed, int p_index) :
+				packed(p_packed), index(p_index) {}
+
+		// Big enough to hold any Variant, checked in variant.h.
+		static constexpr size_t BOXED_SIZE = 40;
 
 	private:
 		const Variant *element_ptr = nullptr;
+		// Packed typed arrays are iterated without boxing them, by boxing the current element
+		// into the iterator. References to it are only valid until the iterator moves.
+		const ArrayPrivate *packed = nullptr;
+		int index = 0;
+		alignas(8) mutable uint8_t boxed[BOXED_SIZE] = {};
+
+		const Variant &_box() const;
 	};
 	static_assert(std::is_trivially_copyable_v<ConstIterator>, "ConstIterator must be trivially copyable");
 
@@ -103,7 +116,7 @@ public:
 	const Variant &operator[](int p_idx) const;
 
 	void set(int p_idx, const Variant &p_value);
-	const Variant &get(int p_idx) const;
+	Variant get(int p_idx) const;
 
 	int size() const;
 	bool is_empty() const;
@@ -33,6 +33,7 @@
 #include "core/object/object.h"
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/templates/paged_allocator.h"
 #include "core/variant/callable_bind.h"
 #include "core/variant/variant_callable.h"
 
@@ -123,12 +124,7 @@ Error Callable::rpcp(int p_id, const Variant **p_arguments, int p_argcount, Call
 }
 
 Callable Callable::bindp(const Variant **p_arguments, int p_argcount) const {
-	Vector<Variant> args;
-	args.resize(p_argcount);
-	for (int i = 0; i < p_argcount; i++) {
-		args.write[i] = *p_arguments[i];
-	}
-	return Callable(memnew(CallableCustomBind(*this, args)));
+	return Callable(CallableCustomBind::create(*this, p_arguments, p_argcount));
 }
 
 Callable Callable::bindv(const Array &p_arguments) {
@@ -136,17 +132,16 @@ Callable Callable::bindv(const Array &p_arguments) {
 		return *this; // No point in creating a new callable if nothing is bound.
 	}
 
-	Vector<Variant> args;
-	args.resize(p_arguments.size());
+	const Variant **args = (const Variant **)alloca(sizeof(Variant *) * p_arguments.size());
 	for (int i = 0; i < p_arguments.size(); i++) {
-		args.write[i] = p_arguments[i];
+		args[i] = &p_arguments[i];
 	}
-	return Callable(memnew(CallableCustomBind(*this, args)));
+	return Callable(CallableCustomBind::create(*this, args, p_arguments.size()));
 }
 
 Callable Callable::unbind(int p_argcount) const {
 	ERR_FAIL_COND_V_MSG(p_argcount <= 0, Callable(*this), "Amount of unbind() arguments must be 1 or greater.");
-	return Callable(memnew(CallableCustomUnbind(*this, p_argcount)));
+	return Callable(CallableCustom::create<CallableCustomUnbind>(*this, p_argcount));
 }
 
 bool Callable::is_valid() const {
@@ -344,7 +339,7 @@ void Callable::operator=(const Callable &p_callable) {
 	}
 
 	if (cleanup_ref != nullptr && cleanup_ref->ref_count.unref()) {
-		memdelete(cleanup_ref);
+		CallableCustom::_free(cleanup_ref);
 	}
 	cleanup_ref = nullptr;
 }
@@ -439,7 +434,7 @@ Callable::Callable(const Callable &p_callable) {
 Callable::~Callable() {
 	if (is_custom()) {
 		if (custom->ref_count.unref()) {
-			memdelete(custom);
+			CallableCustom::_free(custom);
 			custom = nullptr;
 		}
 	}
@@ -482,6 +477,73 @@ int CallableCustom::get_unbound_arguments_count() const {
 	return 0;
 }
 
+// Pools for the small custom callables made with `CallableCustom::create()`, sized for binds of a
+// few arguments and method pointers. Larger ones fall back to the heap.
+union CallableCustomBucketSmall {
+	CallableCustomBucketSmall() {}
+	~CallableCustomBucketSmall() {}
+	uint64_t data[6];
+};
+
+union CallableCustomBucketMedium {
+	CallableCustomBucketMedium() {}
+	~CallableCustomBucketMedium() {}
+	uint64_t data[10];
+};
+
+union CallableCustomBucketLarge {
+	CallableCustomBucketLarge() {}
+	~CallableCustomBucketLarge() {}
+	uint64_t data[16];
+};
+
+enum {
+	CALLABLE_CUSTOM_POOL_NONE,
+	CALLABLE_CUSTOM_POOL_SMALL,
+	CALLABLE_CUSTOM_POOL_MEDIUM,
+	CALLABLE_CUSTOM_POOL_LARGE,
+};
+
+static PagedAllocator<CallableCustomBucketSmall, true, 256> callable_custom_bucket_small;
+static PagedAllocator<CallableCustomBucketMedium, true, 256> callable_custom_bucket_medium;
+static PagedAllocator<CallableCustomBucketLarge, true, 256> callable_custom_bucket_large;
+
+void *CallableCustom::_alloc(size_t p_size, uint8_t &r_pool) {
+	if (p_size <= sizeof(CallableCustomBucketSmall)) {
+		r_pool = CALLABLE_CUSTOM_POOL_SMALL;
+		return callable_custom_bucket_small.alloc();
+	} else if (p_size <= sizeof(CallableCustomBucketMedium)) {
+		r_pool = CALLABLE_CUSTOM_POOL_MEDIUM;
+		return callable_custom_bucket_medium.alloc();
+	} else if (p_size <= sizeof(CallableCustomBucketLarge)) {
+		r_pool = CALLABLE_CUSTOM_POOL_LARGE;
+		return callable_custom_bucket_large.alloc();
+	}
+	r_pool = CALLABLE_CUSTOM_POOL_NONE;
+	return Memory::alloc_static(p_size);
+}
+
+void CallableCustom::_free(CallableCustom *p_custom) {
+	const uint8_t pool = p_custom->pool;
+	if (pool == CALLABLE_CUSTOM_POOL_NONE) {
+		memdelete(p_custom);
+		return;
+	}
+
+	p_custom->~CallableCustom();
+	switch (pool) {
+		case CALLABLE_CUSTOM_POOL_SMALL: {
+			callable_custom_bucket_small.free(reinterpret_cast<CallableCustomBucketSmall *>(p_custom));
+		} break;
+		case CALLABLE_CUSTOM_POOL_MEDIUM: {
+			callable_custom_bucket_medium.free(reinterpret_cast<CallableCustomBucketMedium *>(p_custom));
+		} break;
+		case CALLABLE_CUSTOM_POOL_LARGE: {
+			callable_custom_bucket_large.free(reinterpret_cast<CallableCustomBucketLarge *>(p_custom));
+		} break;
+	}
+}
+
 CallableCustom::CallableCustom() {
 	ref_count.init();
 }
@@ -144,6 +144,10 @@ class CallableCustom {
 	friend class Callable;
 	SafeRefCount ref_count;
 	bool referenced = false;
+	uint8_t pool = 0; // Pool this was allocated from by `create()`, zero for the heap.
+
+	static void *_alloc(size_t p_size, uint8_t &r_pool);
+	static void _free(CallableCustom *p_custom);
 
 public:
 	typedef bool (*CompareEqualFunc)(const CallableCustom *p_a, const CallableCustom *p_b);
@@ -165,6 +169,23 @@ public:
 	virtual void get_bound_arguments(Vector<Variant> &r_arguments) const;
 	virtual int get_unbound_arguments_count() const;
 
+	// Allocates from a pool of small blocks when the type fits in one, instead of from the heap.
+	// Meant for the callables that are created and released all the time, like method pointers
+	// and binds. `p_extra_size` bytes after the object are left for the type to use.
+	template <typename T, typename... Args>
+	static T *create_with_extra_size(size_t p_extra_size, Args &&...p_args) {
+		uint8_t pool = 0;
+		void *mem = _alloc(sizeof(T) + p_extra_size, pool);
+		T *custom = memnew_placement(mem, T(std::forward<Args>(p_args)...));
+		static_cast<CallableCustom *>(custom)->pool = pool;
+		return custom;
+	}
+
+	template <typename T, typename... Args>
+	static T *create(Args &&...p_args) {
+		return create_with_extra_size<T>(0, std::forward<Args>(p_args)...);
+	}
+
 	CallableCustom();
 	virtual ~CallableCustom() {}
 };
@@ -47,7 +47,7 @@ bool CallableCustomBind::_equal_func(const CallableCustom *p_a, const CallableCu
 		return false;
 	}
 
-	if (a->binds.size() != b->binds.size()) {
+	if (a->bind_count != b->bind_count) {
 		return false;
 	}
 
@@ -64,7 +64,7 @@ bool CallableCustomBind::_less_func(const CallableCustom *p_a, const CallableCus
 		return false;
 	}
 
-	return a->binds.size() < b->binds.size();
+	return a->bind_count < b->bind_count;
 }
 
 CallableCustom::CompareEqualFunc CallableCustomBind::get_compare_equal_func() const {
@@ -94,13 +94,13 @@ const Callable *CallableCustomBind::get_base_comparator() const {
 int CallableCustomBind::get_argument_count(bool &r_is_valid) const {
 	int ret = callable.get_argument_count(&r_is_valid);
 	if (r_is_valid) {
-		return ret - binds.size();
+		return ret - bind_count;
 	}
 	return 0;
 }
 
 int CallableCustomBind::get_bound_arguments_count() const {
-	return callable.get_bound_arguments_count() + MAX(0, binds.size() - callable.get_unbound_arguments_count());
+	return callable.get_bound_arguments_count() + MAX(0, bind_count - callable.get_unbound_arguments_count());
 }
 
 void CallableCustomBind::get_bound_arguments(Vector<Variant> &r_arguments) const {
@@ -110,12 +110,18 @@ void CallableCustomBind::get_bound_arguments(Vector<Variant> &r_arguments) const
 
 	int sub_unbound_count = callable.get_unbound_arguments_count();
 
+	const Variant *binds = _get_binds();
+
 	if (sub_bound_count == 0 && sub_unbound_count == 0) {
-		r_arguments = binds;
+		r_arguments.resize(bind_count);
+		Variant *args = r_arguments.ptrw();
+		for (int i = 0; i < bind_count; i++) {
+			args[i] = binds[i];
+		}
 		return;
 	}
 
-	int added_count = MAX(0, binds.size() - sub_unbound_count);
+	int added_count = MAX(0, bind_count - sub_unbound_count);
 	int new_count = sub_bound_count + added_count;
 
 	if (added_count <= 0) {
@@ -135,36 +141,63 @@ void CallableCustomBind::get_bound_arguments(Vector<Variant> &r_arguments) const
 }
 
 int CallableCustomBind::get_unbound_arguments_count() const {
-	return MAX(0, callable.get_unbound_arguments_count() - binds.size());
+	return MAX(0, callable.get_unbound_arguments_count() - bind_count);
 }
 
 void CallableCustomBind::call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const {
-	const Variant **args = (const Variant **)alloca(sizeof(Variant *) * (binds.size() + p_argcount));
+	const Variant *binds = _get_binds();
+	const Variant **args = (const Variant **)alloca(sizeof(Variant *) * (bind_count + p_argcount));
 	for (int i = 0; i < p_argcount; i++) {
 		args[i] = (const Variant *)p_arguments[i];
 	}
-	for (int i = 0; i < binds.size(); i++) {
-		args[i + p_argcount] = (const Variant *)&binds[i];
+	for (int i = 0; i < bind_count; i++) {
+		args[i + p_argcount] = &binds[i];
 	}
 
-	callable.callp(args, p_argcount + binds.size(), r_return_value, r_call_error);
+	callable.callp(args, p_argcount + bind_count, r_return_value, r_call_error);
 }
 
 Error CallableCustomBind::rpc(int p_peer_id, const Variant **p_arguments, int p_argcount, Callable::CallError &r_call_error) const {
-	const Variant **args = (const Variant **)alloca(sizeof(Variant *) * (binds.size() + p_argcount));
+	const Variant *binds = _get_binds();
+	const Variant **args = (const Variant **)alloca(sizeof(Variant *) * (bind_count + p_argcount));
 	for (int i = 0; i < p_argcount; i++) {
 		args[i] = (const Variant *)p_arguments[i];
 	}
-	for (int i = 0; i < binds.size(); i++) {
-		args[i + p_argcount] = (const Variant *)&binds[i];
+	for (int i = 0; i < bind_count; i++) {
+		args[i + p_argcount] = &binds[i];
+	}
+
+	return callable.rpcp(p_peer_id, args, p_argcount + bind_count, r_call_error);
+}
+
+Vector<Variant> CallableCustomBind::get_binds() {
+	const Variant *binds = _get_binds();
+	Vector<Variant> ret;
+	ret.resize(bind_count);
+	for (int i = 0; i < bind_count; i++) {
+		ret.write[i] = binds[i];
 	}
+	return ret;
+}
 
-	return callable.rpcp(p_peer_id, args, p_argcount + binds.size(), r_call_error);
+CallableCustomBind *CallableCustomBind::create(const Callable &p_callable, const Variant **p_binds, int p_bind_count) {
+	return CallableCustom::create_with_extra_size<CallableCustomBind>(sizeof(Variant) * p_bind_count, p_callable, p_binds, p_bind_count);
 }
 
-CallableCustomBind::CallableCustomBind(const Callable &p_callable, const Vector<Variant> &p_binds) {
+CallableCustomBind::CallableCustomBind(const Callable &p_callable, const Variant **p_binds, int p_bind_count) {
 	callable = p_callable;
-	binds = p_binds;
+	bind_count = p_bind_count;
+	Variant *binds = const_cast<Variant *>(_get_binds());
+	for (int i = 0; i < bind_count; i++) {
+		memnew_placement(&binds[i], Variant(*p_binds[i]));
+	}
+}
+
+CallableCustomBind::~CallableCustomBind() {
+	const Variant *binds = _get_binds();
+	for (int i = 0; i < bind_count; i++) {
+		binds[i].~Variant();
+	}
 }
 
 //////////////////////////////////
@@ -34,12 +34,19 @@
 #include "core/variant/variant.h"
 
 class CallableCustomBind : public CallableCustom {
+	friend class CallableCustom;
+
 	Callable callable;
-	Vector<Variant> binds;
+	int bind_count = 0;
+
+	// The bound arguments are stored right after the object, in the same allocation.
+	_FORCE_INLINE_ const Variant *_get_binds() const { return reinterpret_cast<const Variant *>(this + 1); }
 
 	static bool _equal_func(const CallableCustom *p_a, const CallableCustom *p_b);
 	static bool _less_func(const CallableCustom *p_a, const CallableCustom *p_b);
 
+	CallableCustomBind(const Callable &p_callable, const Variant **p_binds, int p_bind_count);
+
 public:
 	//for every type that inherits, these must always be the same for this type
 	virtual uint32_t hash() const override;
@@ -57,9 +64,10 @@ public:
 	virtual void get_bound_arguments(Vector<Variant> &r_arguments) const override;
 	virtual int get_unbound_arguments_count() const override;
 	Callable get_callable() { return callable; }
-	Vector<Variant> get_binds() { return binds; }
+	Vector<Variant> get_binds();
 
-	CallableCustomBind(const Callable &p_callable, const Vector<Variant> &p_binds);
+	static CallableCustomBind *create(const Callable &p_callable, const Variant **p_binds, int p_bind_count);
+	virtual ~CallableCustomBind();
 };
 
 class CallableCustomUnbind : public CallableCustom {
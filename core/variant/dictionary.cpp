@@ -36,8 +36,10 @@ STATIC_ASSERT_INCOMPLETE_TYPE(class, String);
 
 #include "core/templates/hash_map.h"
 #include "core/templates/safe_refcount.h"
+#include "core/templates/sort_list.h"
 #include "core/variant/container_type_validate.h"
 #include "core/variant/variant.h"
+#include "core/variant/variant_deep_walker.h"
 // required in this order by VariantInternal, do not remove this comment.
 #include "core/object/class_db.h"
 #include "core/object/object.h"
@@ -47,52 +49,399 @@ STATIC_ASSERT_INCOMPLETE_TYPE(class, String);
 struct DictionaryPrivate {
 	SafeRefCount refcount;
 	Variant *read_only = nullptr; // If enabled, a pointer is used to a temporary value that is used to return read-only values.
-	HashMap<Variant, Variant, HashMapHasherDefault, StringLikeVariantComparator> variant_map;
+	// Entries in insertion order, in chunks that are never reallocated, so entries never move.
+	// Chunks past the tail are spare and have no entries yet.
+	struct Chunk {
+		Dictionary::Entry *entries = nullptr;
+		uint32_t capacity = 0;
+	};
+	LocalVector<Chunk> chunks;
+	uint32_t tail_chunk = 0; // Chunk the last entry was appended to.
+	uint32_t tail_used = 0; // Entries used in the tail chunk, including erased ones.
+	uint32_t used = 0; // Entries used in all chunks, including erased ones.
+	uint32_t count = 0;
+	uint32_t release_used = 0; // Value of `used` at which chunks with only erased entries are looked for again.
+	// Open-addressing index of the live entries, only built once a linear scan is no longer cheaper.
+	uint32_t *index_hashes = nullptr;
+	Dictionary::Entry **index_entries = nullptr;
+	uint32_t index_capacity = 0;
 	ContainerTypeValidate typed_key;
 	ContainerTypeValidate typed_value;
 	Variant *typed_fallback = nullptr; // Allows a typed dictionary to return dummy values when attempting an invalid access.
+
+	using EntryData = KeyValue<Variant, Variant>;
+
+	static constexpr uint32_t FIRST_CHUNK_SIZE = 4;
+	// Limits the space a chunk kept alive by a single entry can waste.
+	static constexpr uint32_t MAX_CHUNK_SIZE = 1024;
+	static constexpr uint32_t SMALL_MAP_SIZE = 8; // Dictionaries up to this size are searched linearly.
+	static constexpr uint32_t MAX_INDEX_LOAD_PERCENT = 75;
+
+	_FORCE_INLINE_ static uint32_t hash_key(const Variant &p_key) {
+		const uint32_t hash = HashMapHasherDefault::hash(p_key);
+		return hash == 0 ? 1 : hash; // Zero marks erased entries.
+	}
+
+	_FORCE_INLINE_ static uint32_t get_index_capacity(uint32_t p_count) {
+		return next_power_of_2(p_count * 100 / MAX_INDEX_LOAD_PERCENT + 1);
+	}
+
+	_FORCE_INLINE_ Dictionary::Entry *chunk_end(uint32_t p_chunk) const {
+		return chunks[p_chunk].entries + (p_chunk == tail_chunk ? tail_used : chunks[p_chunk].capacity);
+	}
+
+	Dictionary::Entry *find(const Variant &p_key, uint32_t p_hash) const {
+		if (index_capacity) {
+			const uint32_t mask = index_capacity - 1;
+			for (uint32_t slot = p_hash & mask; index_hashes[slot] != 0; slot = (slot + 1) & mask) {
+				if (index_hashes[slot] == p_hash && StringLikeVariantComparator::compare(index_entries[slot]->data.key, p_key)) {
+					return index_entries[slot];
+				}
+			}
+			return nullptr;
+		}
+
+		if (used == 0) {
+			return nullptr;
+		}
+		for (uint32_t i = 0; i <= tail_chunk; i++) {
+			for (Dictionary::Entry *E = chunks[i].entries, *end = chunk_end(i); E != end; E++) {
+				if (E->hash == p_hash && StringLikeVariantComparator::compare(E->data.key, p_key)) {
+					return E;
+				}
+			}
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ Dictionary::Entry *find(const Variant &p_key) const {
+		return find(p_key, hash_key(p_key));
+	}
+
+	// Only valid if the entry was found in this dictionary.
+	uint32_t find_chunk(const Dictionary::Entry *p_entry) const {
+		for (uint32_t i = 0; i < tail_chunk; i++) {
+			if (p_entry >= chunks[i].entries && p_entry < chunks[i].entries + chunks[i].capacity) {
+				return i;
+			}
+		}
+		return tail_chunk;
+	}
+
+	const Dictionary::Entry *get_entry_at(int p_index) const {
+		if (p_index < 0 || (uint32_t)p_index >= count) {
+			return nullptr;
+		}
+		uint32_t index = p_index;
+		if (used == count) {
+			// No erased entries, so positions map directly to chunks.
+			uint32_t chunk = 0;
+			while (index >= chunks[chunk].capacity) {
+				index -= chunks[chunk].capacity;
+				chunk++;
+			}
+			return chunks[chunk].entries + index;
+		}
+		for (uint32_t i = 0; i <= tail_chunk; i++) {
+			for (const Dictionary::Entry *E = chunks[i].entries, *end = chunk_end(i); E != end; E++) {
+				if (E->hash != 0 && index-- == 0) {
+					return E;
+				}
+			}
+		}
+		return nullptr;
+	}
+
+	void index_insert(Dictionary::Entry *p_entry) {
+		const uint32_t mask = index_capacity - 1;
+		uint32_t slot = p_entry->hash & mask;
+		while (index_hashes[slot] != 0) {
+			slot = (slot + 1) & mask;
+		}
+		index_hashes[slot] = p_entry->hash;
+		index_entries[slot] = p_entry;
+	}
+
+	void index_remove(const Dictionary::Entry *p_entry) {
+		const uint32_t mask = index_capacity - 1;
+		uint32_t hole = p_entry->hash & mask;
+		while (index_entries[hole] != p_entry || index_hashes[hole] == 0) {
+			hole = (hole + 1) & mask;
+		}
+		// Backward shift deletion, so lookups never need tombstones.
+		for (uint32_t slot = (hole + 1) & mask; index_hashes[slot] != 0; slot = (slot + 1) & mask) {
+			const uint32_t home = index_hashes[slot] & mask;
+			if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+				index_hashes[hole] = index_hashes[slot];
+				index_entries[hole] = index_entries[slot];
+				hole = slot;
+			}
+		}
+		index_hashes[hole] = 0;
+	}
+
+	void rebuild_index(uint32_t p_capacity) {
+		if (p_capacity != index_capacity) {
+			if (index_hashes) {
+				Memory::free_static(index_hashes);
+				Memory::free_static(index_entries);
+			}
+			index_capacity = p_capacity;
+			index_hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static_zeroed(sizeof(uint32_t) * index_capacity));
+			index_entries = reinterpret_cast<Dictionary::Entry **>(Memory::alloc_static(sizeof(Dictionary::Entry *) * index_capacity));
+		} else {
+			memset(index_hashes, 0, sizeof(uint32_t) * index_capacity);
+		}
+
+		if (used == 0) {
+			return;
+		}
+		for (uint32_t i = 0; i <= tail_chunk; i++) {
+			for (Dictionary::Entry *E = chunks[i].entries, *end = chunk_end(i); E != end; E++) {
+				if (E->hash != 0) {
+					index_insert(E);
+				}
+			}
+		}
+	}
+
+	static Chunk alloc_chunk(uint32_t p_capacity) {
+		Chunk chunk;
+		chunk.entries = reinterpret_cast<Dictionary::Entry *>(Memory::alloc_static(sizeof(Dictionary::Entry) * p_capacity));
+		chunk.capacity = p_capacity;
+		return chunk;
+	}
+
+	// Gives back the chunks before the tail whose entries were all erased. Live entries are never
+	// moved, so a chunk is only reclaimed once all of its entries are gone, like the front of a queue.
+	void release_erased_chunks() {
+		for (uint32_t i = 0; i < tail_chunk;) {
+			const Chunk chunk = chunks[i];
+			bool all_erased = true;
+			for (const Dictionary::Entry *E = chunk.entries, *end = chunk.entries + chunk.capacity; E != end && all_erased; E++) {
+				all_erased = E->hash == 0;
+			}
+			if (!all_erased) {
+				i++;
+				continue;
+			}
+			chunks.remove_at(i);
+			tail_chunk--;
+			used -= chunk.capacity;
+			if (chunks.size() == tail_chunk + 1) {
+				chunks.push_back(chunk); // Keep one spare chunk, so a queue reuses its storage.
+			} else {
+				Memory::free_static(chunk.entries);
+			}
+		}
+		release_used = used + MAX(used / 2, FIRST_CHUNK_SIZE);
+	}
+
+	// The key must not be in the dictionary yet.
+	Dictionary::Entry *append(const Variant &p_key, uint32_t p_hash) {
+		if (chunks.is_empty()) {
+			chunks.push_back(alloc_chunk(FIRST_CHUNK_SIZE));
+		} else if (tail_used == chunks[tail_chunk].capacity) {
+			if (used >= release_used && used - count > MAX(SMALL_MAP_SIZE, count)) {
+				// Mostly erased entries, see if whole chunks can be reused instead of growing.
+				release_erased_chunks();
+			}
+			tail_chunk++;
+			tail_used = 0;
+			if (tail_chunk == chunks.size()) {
+				chunks.push_back(alloc_chunk(CLAMP(next_power_of_2(count), FIRST_CHUNK_SIZE, MAX_CHUNK_SIZE)));
+			}
+		}
+
+		Dictionary::Entry *E = chunks[tail_chunk].entries + tail_used;
+		memnew_placement(&E->data, EntryData(p_key, Variant()));
+		E->hash = p_hash;
+		tail_used++;
+		used++;
+		count++;
+
+		if (index_capacity) {
+			if (count > index_capacity * MAX_INDEX_LOAD_PERCENT / 100) {
+				rebuild_index(index_capacity * 2);
+			} else {
+				index_insert(E);
+			}
+		} else if (count > SMALL_MAP_SIZE) {
+			rebuild_index(get_index_capacity(count));
+		}
+		return E;
+	}
+
+	Variant &get_or_insert(const Variant &p_key) {
+		const uint32_t hash = hash_key(p_key);
+		Dictionary::Entry *E = find(p_key, hash);
+		if (!E) {
+			E = append(p_key, hash);
+		}
+		return E->data.value;
+	}
+
+	bool erase(const Variant &p_key) {
+		Dictionary::Entry *E = find(p_key);
+		if (!E) {
+			return false;
+		}
+		if (index_capacity) {
+			index_remove(E);
+		}
+		E->data.~EntryData();
+		E->hash = 0;
+		count--;
+
+		// Give back trailing erased entries right away, so using the dictionary as a stack leaves no holes.
+		while (used > 0 && chunks[tail_chunk].entries[tail_used - 1].hash == 0) {
+			used--;
+			tail_used--;
+			if (tail_used == 0 && tail_chunk > 0) {
+				tail_chunk--;
+				tail_used = chunks[tail_chunk].capacity;
+			}
+		}
+		return true;
+	}
+
+	void reserve(uint32_t p_capacity) {
+		uint32_t capacity = 0;
+		for (const Chunk &chunk : chunks) {
+			capacity += chunk.capacity;
+		}
+		if (capacity < p_capacity) {
+			chunks.push_back(alloc_chunk(MAX(p_capacity - capacity, FIRST_CHUNK_SIZE)));
+		}
+		if (p_capacity > SMALL_MAP_SIZE && get_index_capacity(p_capacity) > index_capacity) {
+			rebuild_index(get_index_capacity(p_capacity));
+		}
+	}
+
+	void clear() {
+		for (uint32_t i = 0; used > 0 && i <= tail_chunk; i++) {
+			for (Dictionary::Entry *E = chunks[i].entries, *end = chunk_end(i); E != end; E++) {
+				if (E->hash != 0) {
+					E->data.~EntryData();
+				}
+			}
+		}
+		tail_chunk = 0;
+		tail_used = 0;
+		used = 0;
+		count = 0;
+		release_used = 0;
+		if (index_capacity) {
+			memset(index_hashes, 0, sizeof(uint32_t) * index_capacity);
+		}
+	}
+
+	void copy_from(const DictionaryPrivate &p_from) {
+		if (&p_from == this) {
+			return;
+		}
+		clear();
+		reserve(p_from.count);
+		for (uint32_t i = 0; p_from.used > 0 && i <= p_from.tail_chunk; i++) {
+			for (const Dictionary::Entry *E = p_from.chunks[i].entries, *end = p_from.chunk_end(i); E != end; E++) {
+				if (E->hash != 0) {
+					append(E->data.key, E->hash)->data.value = E->data.value;
+				}
+			}
+		}
+	}
+
+	~DictionaryPrivate() {
+		clear();
+		for (const Chunk &chunk : chunks) {
+			Memory::free_static(chunk.entries);
+		}
+		if (index_hashes) {
+			Memory::free_static(index_hashes);
+			Memory::free_static(index_entries);
+		}
+	}
 };
 
+void Dictionary::ConstIterator::_skip_holes() {
+	while (true) {
+		if (entry == chunk_end) {
+			// Chunks before this one may have been released since the iterator got here.
+			if (chunk >= dictionary->chunks.size() || dictionary->chunks[chunk].entries != chunk_begin) {
+				chunk = UINT32_MAX;
+				for (uint32_t i = 0; i < dictionary->chunks.size(); i++) {
+					if (dictionary->chunks[i].entries == chunk_begin) {
+						chunk = i;
+						break;
+					}
+				}
+			}
+			// Entries may have been appended to this chunk since the iterator got here.
+			const Entry *end = chunk <= dictionary->tail_chunk ? dictionary->chunk_end(chunk) : entry;
+			if (entry < end) {
+				chunk_end = end;
+			} else if (chunk < dictionary->tail_chunk) {
+				chunk++;
+				chunk_begin = dictionary->chunks[chunk].entries;
+				entry = chunk_begin;
+				chunk_end = dictionary->chunk_end(chunk);
+			} else {
+				entry = nullptr;
+				chunk_end = nullptr;
+				return;
+			}
+			continue;
+		}
+		if (entry->hash != 0) {
+			return;
+		}
+		entry++;
+	}
+}
+
 Dictionary::ConstIterator Dictionary::begin() const {
-	return _p->variant_map.begin();
+	ConstIterator it;
+	if (_p->count == 0) {
+		return it;
+	}
+	it.dictionary = _p;
+	it.chunk_begin = _p->chunks[0].entries;
+	it.entry = it.chunk_begin;
+	it.chunk_end = _p->chunk_end(0);
+	if (it.entry->hash == 0) {
+		it._skip_holes();
+	}
+	return it;
 }
 
 Dictionary::ConstIterator Dictionary::end() const {
-	return _p->variant_map.end();
+	return ConstIterator();
 }
 
 LocalVector<Variant> Dictionary::get_key_list() const {
 	LocalVector<Variant> keys;
 
-	keys.reserve(_p->variant_map.size());
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+	keys.reserve(_p->count);
+	for (const KeyValue<Variant, Variant> &E : *this) {
 		keys.push_back(E.key);
 	}
 	return keys;
 }
 
 Variant Dictionary::get_key_at_index(int p_index) const {
-	int index = 0;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-		if (index == p_index) {
-			return E.key;
-		}
-		index++;
+	const Entry *E = _p->get_entry_at(p_index);
+	if (!E) {
+		return Variant();
 	}
-
-	return Variant();
+	return E->data.key;
 }
 
 Variant Dictionary::get_value_at_index(int p_index) const {
-	int index = 0;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-		if (index == p_index) {
-			return E.value;
-		}
-		index++;
+	const Entry *E = _p->get_entry_at(p_index);
+	if (!E) {
+		return Variant();
 	}
-
-	return Variant();
+	return E->data.value;
 }
 
 // WARNING: This operator does not validate the value type. For scripting/extensions this is
@@ -106,19 +455,21 @@ Variant &Dictionary::operator[](const Variant &p_key) {
 		VariantInternal::initialize(_p->typed_fallback, _p->typed_value.type);
 		return *_p->typed_fallback;
 	} else if (unlikely(_p->read_only)) {
-		if (likely(_p->variant_map.has(key))) {
-			*_p->read_only = _p->variant_map[key];
+		const Entry *E = _p->find(key);
+		if (likely(E)) {
+			*_p->read_only = E->data.value;
 		} else {
 			VariantInternal::initialize(_p->read_only, _p->typed_value.type);
 		}
 		return *_p->read_only;
 	} else {
-		const uint32_t old_size = _p->variant_map.size();
-		Variant &value = _p->variant_map[key];
-		if (_p->variant_map.size() > old_size) {
-			VariantInternal::initialize(&value, _p->typed_value.type);
+		const uint32_t hash = DictionaryPrivate::hash_key(key);
+		Entry *E = _p->find(key, hash);
+		if (!E) {
+			E = _p->append(key, hash);
+			VariantInternal::initialize(&E->data.value, _p->typed_value.type);
 		}
-		return value;
+		return E->data.value;
 	}
 }
 
@@ -132,9 +483,9 @@ const Variant &Dictionary::operator[](const Variant &p_key) const {
 		return *_p->typed_fallback;
 	} else {
 		static Variant empty;
-		const Variant *value = _p->variant_map.getptr(key);
-		ERR_FAIL_COND_V_MSG(!value, empty, vformat(R"(Bug: Dictionary::operator[] used when there was no value for the given key "%s". Please report.)", key));
-		return *value;
+		const Entry *E = _p->find(key);
+		ERR_FAIL_COND_V_MSG(!E, empty, vformat(R"(Bug: Dictionary::operator[] used when there was no value for the given key "%s". Please report.)", key));
+		return E->data.value;
 	}
 }
 
@@ -143,11 +494,11 @@ const Variant *Dictionary::getptr(const Variant &p_key) const {
 	if (unlikely(!_p->typed_key.validate(key, "getptr"))) {
 		return nullptr;
 	}
-	HashMap<Variant, Variant, HashMapHasherDefault, StringLikeVariantComparator>::ConstIterator E(_p->variant_map.find(key));
+	const Entry *E = _p->find(key);
 	if (!E) {
 		return nullptr;
 	}
-	return &E->value;
+	return &E->data.value;
 }
 
 // WARNING: This method does not validate the value type.
@@ -156,27 +507,27 @@ Variant *Dictionary::getptr(const Variant &p_key) {
 	if (unlikely(!_p->typed_key.validate(key, "getptr"))) {
 		return nullptr;
 	}
-	HashMap<Variant, Variant, HashMapHasherDefault, StringLikeVariantComparator>::Iterator E(_p->variant_map.find(key));
+	Entry *E = _p->find(key);
 	if (!E) {
 		return nullptr;
 	}
 	if (unlikely(_p->read_only != nullptr)) {
-		*_p->read_only = E->value;
+		*_p->read_only = E->data.value;
 		return _p->read_only;
 	} else {
-		return &E->value;
+		return &E->data.value;
 	}
 }
 
 Variant Dictionary::get_valid(const Variant &p_key) const {
 	Variant key = p_key;
 	ERR_FAIL_COND_V(!_p->typed_key.validate(key, "get_valid"), Variant());
-	HashMap<Variant, Variant, HashMapHasherDefault, StringLikeVariantComparator>::ConstIterator E(_p->variant_map.find(key));
+	const Entry *E = _p->find(key);
 
 	if (!E) {
 		return Variant();
 	}
-	return E->value;
+	return E->data.value;
 }
 
 Variant Dictionary::get(const Variant &p_key, const Variant &p_default) const {
@@ -209,29 +560,29 @@ bool Dictionary::set(const Variant &p_key, const Variant &p_value) {
 	ERR_FAIL_COND_V(!_p->typed_key.validate(key, "set"), false);
 	Variant value = p_value;
 	ERR_FAIL_COND_V(!_p->typed_value.validate(value, "set"), false);
-	_p->variant_map[key] = value;
+	_p->get_or_insert(key) = value;
 	return true;
 }
 
 int Dictionary::size() const {
-	return _p->variant_map.size();
+	return _p->count;
 }
 
 bool Dictionary::is_empty() const {
-	return !_p->variant_map.size();
+	return _p->count == 0;
 }
 
 bool Dictionary::has(const Variant &p_key) const {
 	Variant key = p_key;
 	ERR_FAIL_COND_V(!_p->typed_key.validate(key, "use 'has'"), false);
-	return _p->variant_map.has(key);
+	return _p->find(key) != nullptr;
 }
 
 bool Dictionary::has_all(const Array &p_keys) const {
 	for (int i = 0; i < p_keys.size(); i++) {
 		Variant key = p_keys[i];
 		ERR_FAIL_COND_V(!_p->typed_key.validate(key, "use 'has_all'"), false);
-		if (!_p->variant_map.has(key)) {
+		if (!_p->find(key)) {
 			return false;
 		}
 	}
@@ -241,7 +592,7 @@ bool Dictionary::has_all(const Array &p_keys) const {
 Variant Dictionary::find_key(const Variant &p_value) const {
 	Variant value = p_value;
 	ERR_FAIL_COND_V(!_p->typed_value.validate(value, "find_key"), Variant());
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+	for (const KeyValue<Variant, Variant> &E : *this) {
 		if (E.value == value) {
 			return E.key;
 		}
@@ -253,7 +604,7 @@ bool Dictionary::erase(const Variant &p_key) {
 	Variant key = p_key;
 	ERR_FAIL_COND_V(!_p->typed_key.validate(key, "erase"), false);
 	ERR_FAIL_COND_V_MSG(_p->read_only, false, "Dictionary is in read-only state.");
-	return _p->variant_map.erase(key);
+	return _p->erase(key);
 }
 
 bool Dictionary::operator==(const Dictionary &p_dictionary) const {
@@ -269,7 +620,7 @@ bool Dictionary::recursive_equal(const Dictionary &p_dictionary, int recursion_c
 	if (_p == p_dictionary._p) {
 		return true;
 	}
-	if (_p->variant_map.size() != p_dictionary._p->variant_map.size()) {
+	if (_p->count != p_dictionary._p->count) {
 		return false;
 	}
 
@@ -278,14 +629,12 @@ bool Dictionary::recursive_equal(const Dictionary &p_dictionary, int recursion_c
 		ERR_PRINT("Max recursion reached");
 		return true;
 	}
-	recursion_count++;
-	for (const KeyValue<Variant, Variant> &this_E : _p->variant_map) {
-		HashMap<Variant, Variant, HashMapHasherDefault, StringLikeVariantComparator>::ConstIterator other_E(p_dictionary._p->variant_map.find(this_E.key));
-		if (!other_E || !this_E.value.hash_compare(other_E->value, recursion_count, false)) {
-			return false;
-		}
-	}
-	return true;
+	return VariantDeepWalker::equal(*this, p_dictionary, recursion_count);
+}
+
+const Variant *Dictionary::_find_value(const Variant &p_key) const {
+	const Entry *E = _p->find(p_key);
+	return E ? &E->data.value : nullptr;
 }
 
 void Dictionary::_ref(const Dictionary &p_from) const {
@@ -308,19 +657,19 @@ void Dictionary::_ref(const Dictionary &p_from) const {
 void Dictionary::reserve(int p_new_capacity) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Dictionary is in read-only state.");
 	ERR_FAIL_COND_MSG(p_new_capacity < 0, "New capacity must be non-negative.");
-	_p->variant_map.reserve(p_new_capacity);
+	_p->reserve(p_new_capacity);
 }
 
 void Dictionary::clear() {
 	ERR_FAIL_COND_MSG(_p->read_only, "Dictionary is in read-only state.");
-	_p->variant_map.clear();
+	_p->clear();
 }
 
 struct _DictionaryVariantSort {
-	_FORCE_INLINE_ bool operator()(const KeyValue<Variant, Variant> &p_l, const KeyValue<Variant, Variant> &p_r) const {
+	_FORCE_INLINE_ bool operator()(const Dictionary::Entry *p_l, const Dictionary::Entry *p_r) const {
 		bool valid = false;
 		Variant res;
-		Variant::evaluate(Variant::OP_LESS, p_l.key, p_r.key, res, valid);
+		Variant::evaluate(Variant::OP_LESS, p_l->data.key, p_r->data.key, res, valid);
 		if (!valid) {
 			res = false;
 		}
@@ -330,12 +679,41 @@ struct _DictionaryVariantSort {
 
 void Dictionary::sort() {
 	ERR_FAIL_COND_MSG(_p->read_only, "Dictionary is in read-only state.");
-	_p->variant_map.sort_custom<_DictionaryVariantSort>();
+	if (_p->count < 2) {
+		return;
+	}
+
+	// Sort a list of the entries, which keeps the sort stable like it was with linked entries.
+	struct SortElement {
+		const Entry *entry = nullptr;
+		SortElement *prev = nullptr;
+		SortElement *next = nullptr;
+	};
+	LocalVector<SortElement> elements;
+	elements.resize(_p->count);
+	uint32_t i = 0;
+	for (ConstIterator it = begin(); it; ++it) {
+		elements[i].entry = it.entry;
+		elements[i].prev = i > 0 ? &elements[i - 1] : nullptr;
+		elements[i].next = i + 1 < _p->count ? &elements[i + 1] : nullptr;
+		i++;
+	}
+	SortElement *head = &elements[0];
+	SortElement *tail = &elements[_p->count - 1];
+	SortList<SortElement, const Entry *, &SortElement::entry, &SortElement::prev, &SortElement::next, _DictionaryVariantSort> sorter;
+	sorter.sort(head, tail);
+
+	DictionaryPrivate sorted;
+	sorted.reserve(_p->count);
+	for (const SortElement *E = head; E; E = E->next) {
+		sorted.append(E->entry->data.key, E->entry->hash)->data.value = E->entry->data.value;
+	}
+	_p->copy_from(sorted);
 }
 
 void Dictionary::merge(const Dictionary &p_dictionary, bool p_overwrite) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Dictionary is in read-only state.");
-	for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+	for (const KeyValue<Variant, Variant> &E : p_dictionary) {
 		Variant key = E.key;
 		Variant value = E.value;
 		ERR_FAIL_COND(!_p->typed_key.validate(key, "merge"));
@@ -376,15 +754,7 @@ uint32_t Dictionary::recursive_hash(int recursion_count) const {
 		return 0;
 	}
 
-	uint32_t h = hash_murmur3_one_32(Variant::DICTIONARY);
-
-	recursion_count++;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-		h = hash_murmur3_one_32(E.key.recursive_hash(recursion_count), h);
-		h = hash_murmur3_one_32(E.value.recursive_hash(recursion_count), h);
-	}
-
-	return hash_fmix32(h);
+	return VariantDeepWalker::hash(*this, recursion_count);
 }
 
 Array Dictionary::keys() const {
@@ -392,14 +762,14 @@ Array Dictionary::keys() const {
 	if (is_typed_key()) {
 		varr.set_typed(get_typed_key_builtin(), get_typed_key_class_name(), get_typed_key_script());
 	}
-	if (_p->variant_map.is_empty()) {
+	if (_p->count == 0) {
 		return varr;
 	}
 
 	varr.resize(size());
 
 	int i = 0;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+	for (const KeyValue<Variant, Variant> &E : *this) {
 		varr[i] = E.key;
 		i++;
 	}
@@ -412,14 +782,14 @@ Array Dictionary::values() const {
 	if (is_typed_value()) {
 		varr.set_typed(get_typed_value_builtin(), get_typed_value_class_name(), get_typed_value_script());
 	}
-	if (_p->variant_map.is_empty()) {
+	if (_p->count == 0) {
 		return varr;
 	}
 
 	varr.resize(size());
 
 	int i = 0;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+	for (const KeyValue<Variant, Variant> &E : *this) {
 		varr[i] = E.value;
 		i++;
 	}
@@ -439,12 +809,11 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 		// From same to same or,
 		// from anything to variants or,
 		// from subclasses to base classes.
-		_p->variant_map = p_dictionary._p->variant_map;
+		_p->copy_from(*p_dictionary._p);
 		return;
 	}
 
-	int size = p_dictionary._p->variant_map.size();
-	HashMap<Variant, Variant, HashMapHasherDefault, StringLikeVariantComparator> variant_map = HashMap<Variant, Variant, HashMapHasherDefault, StringLikeVariantComparator>(size);
+	int size = p_dictionary._p->count;
 
 	Vector<Variant> key_array;
 	key_array.resize(size);
@@ -459,7 +828,7 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 		// from anything to variants or,
 		// from subclasses to base classes.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+		for (const KeyValue<Variant, Variant> &E : p_dictionary) {
 			const Variant *key = &E.key;
 			key_data[i++] = *key;
 		}
@@ -467,7 +836,7 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 		// From variants to objects or,
 		// from base classes to subclasses.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+		for (const KeyValue<Variant, Variant> &E : p_dictionary) {
 			const Variant *key = &E.key;
 			if (key->get_type() != Variant::NIL && (key->get_type() != Variant::OBJECT || !typed_key.validate_object(*key, "assign"))) {
 				ERR_FAIL_MSG(vformat(R"(Unable to convert key from "%s" to "%s".)", Variant::get_type_name(key->get_type()), Variant::get_type_name(typed_key.type)));
@@ -480,7 +849,7 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 	} else if (typed_key_source.type == Variant::NIL && typed_key.type != Variant::OBJECT) {
 		// From variants to primitives.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+		for (const KeyValue<Variant, Variant> &E : p_dictionary) {
 			const Variant *key = &E.key;
 			if (key->get_type() == typed_key.type) {
 				key_data[i++] = *key;
@@ -496,7 +865,7 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 	} else if (Variant::can_convert_strict(typed_key_source.type, typed_key.type)) {
 		// From primitives to different convertible primitives.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+		for (const KeyValue<Variant, Variant> &E : p_dictionary) {
 			const Variant *key = &E.key;
 			Callable::CallError ce;
 			Variant::construct(typed_key.type, key_data[i++], &key, 1, ce);
@@ -512,7 +881,7 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 		// from anything to variants or,
 		// from subclasses to base classes.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+		for (const KeyValue<Variant, Variant> &E : p_dictionary) {
 			const Variant *value = &E.value;
 			value_data[i++] = *value;
 		}
@@ -520,7 +889,7 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 		// From variants to objects or,
 		// from base classes to subclasses.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+		for (const KeyValue<Variant, Variant> &E : p_dictionary) {
 			const Variant *value = &E.value;
 			if (value->get_type() != Variant::NIL && (value->get_type() != Variant::OBJECT || !typed_value.validate_object(*value, "assign"))) {
 				ERR_FAIL_MSG(vformat(R"(Unable to convert value at key "%s" from "%s" to "%s".)", key_data[i], Variant::get_type_name(value->get_type()), Variant::get_type_name(typed_value.type)));
@@ -533,7 +902,7 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 	} else if (typed_value_source.type == Variant::NIL && typed_value.type != Variant::OBJECT) {
 		// From variants to primitives.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+		for (const KeyValue<Variant, Variant> &E : p_dictionary) {
 			const Variant *value = &E.value;
 			if (value->get_type() == typed_value.type) {
 				value_data[i++] = *value;
@@ -549,7 +918,7 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 	} else if (Variant::can_convert_strict(typed_value_source.type, typed_value.type)) {
 		// From primitives to different convertible primitives.
 		int i = 0;
-		for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+		for (const KeyValue<Variant, Variant> &E : p_dictionary) {
 			const Variant *value = &E.value;
 			Callable::CallError ce;
 			Variant::construct(typed_value.type, value_data[i++], &value, 1, ce);
@@ -560,33 +929,40 @@ void Dictionary::assign(const Dictionary &p_dictionary) {
 				Variant::get_type_name(typed_key.type), Variant::get_type_name(typed_value.type)));
 	}
 
+	_p->clear();
+	_p->reserve(size);
 	for (int i = 0; i < size; i++) {
-		variant_map.insert(key_data[i], value_data[i]);
+		_p->get_or_insert(key_data[i]) = value_data[i];
 	}
-
-	_p->variant_map = variant_map;
 }
 
 const Variant *Dictionary::next(const Variant *p_key) const {
 	if (p_key == nullptr) {
 		// caller wants to get the first element
-		if (_p->variant_map.begin()) {
-			return &_p->variant_map.begin()->key;
+		ConstIterator it = begin();
+		if (it) {
+			return &it->key;
 		}
 		return nullptr;
 	}
 	Variant key = *p_key;
 	ERR_FAIL_COND_V(!_p->typed_key.validate(key, "next"), nullptr);
-	HashMap<Variant, Variant, HashMapHasherDefault, StringLikeVariantComparator>::Iterator E = _p->variant_map.find(key);
+	const Entry *E = _p->find(key);
 
 	if (!E) {
 		return nullptr;
 	}
 
-	++E;
+	ConstIterator it;
+	it.dictionary = _p;
+	it.chunk = _p->find_chunk(E);
+	it.chunk_begin = _p->chunks[it.chunk].entries;
+	it.entry = E;
+	it.chunk_end = _p->chunk_end(it.chunk);
+	++it;
 
-	if (E) {
-		return &E->key;
+	if (it) {
+		return &it->key;
 	}
 
 	return nullptr;
@@ -610,6 +986,17 @@ bool Dictionary::is_read_only() const {
 }
 
 Dictionary Dictionary::recursive_duplicate(bool p_deep, ResourceDeepDuplicateMode p_deep_subresources_mode, int recursion_count) const {
+	if (p_deep) {
+		// Copies the nested containers as well, without recursing.
+		Dictionary copy = VariantDeepWalker::duplicate(*this, p_deep_subresources_mode, recursion_count);
+
+		// Variant::recursive_duplicate() may have created a remap cache by now.
+		if (recursion_count == 0) {
+			Resource::_teardown_duplicate_from_variant();
+		}
+		return copy;
+	}
+
 	Dictionary n;
 	n._p->typed_key = _p->typed_key;
 	n._p->typed_value = _p->typed_value;
@@ -619,23 +1006,9 @@ Dictionary Dictionary::recursive_duplicate(bool p_deep, ResourceDeepDuplicateMod
 		return n;
 	}
 
-	n.reserve(_p->variant_map.size());
-	if (p_deep) {
-		bool is_call_chain_end = recursion_count == 0;
-
-		recursion_count++;
-		for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-			n[E.key.recursive_duplicate(true, p_deep_subresources_mode, recursion_count)] = E.value.recursive_duplicate(true, p_deep_subresources_mode, recursion_count);
-		}
-
-		// Variant::recursive_duplicate() may have created a remap cache by now.
-		if (is_call_chain_end) {
-			Resource::_teardown_duplicate_from_variant();
-		}
-	} else {
-		for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-			n[E.key] = E.value;
-		}
+	n.reserve(_p->count);
+	for (const KeyValue<Variant, Variant> &E : *this) {
+		n[E.key] = E.value;
 	}
 
 	return n;
@@ -647,7 +1020,7 @@ void Dictionary::set_typed(const ContainerType &p_key_type, const ContainerType
 
 void Dictionary::set_typed(uint32_t p_key_type, const StringName &p_key_class_name, const Variant &p_key_script, uint32_t p_value_type, const StringName &p_value_class_name, const Variant &p_value_script) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Dictionary is in read-only state.");
-	ERR_FAIL_COND_MSG(_p->variant_map.size() > 0, "Type can only be set when dictionary is empty.");
+	ERR_FAIL_COND_MSG(_p->count > 0, "Type can only be set when dictionary is empty.");
 	ERR_FAIL_COND_MSG(_p->refcount.get() > 1, "Type can only be set when dictionary has no more than one user.");
 	ERR_FAIL_COND_MSG(_p->typed_key.type != Variant::NIL || _p->typed_value.type != Variant::NIL, "Type can only be set once.");
 	ERR_FAIL_COND_MSG((p_key_class_name != StringName() && p_key_type != Variant::OBJECT) || (p_value_class_name != StringName() && p_value_type != Variant::OBJECT), "Class names can only be set for type OBJECT.");
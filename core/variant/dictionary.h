@@ -49,8 +49,36 @@ class Dictionary {
 	void _ref(const Dictionary &p_from) const;
 	void _unref() const;
 
+	friend class VariantDeepWalker;
+	const Variant *_find_value(const Variant &p_key) const;
+
 public:
-	using ConstIterator = HashMap<Variant, Variant, HashMapHasherDefault, StringLikeVariantComparator>::ConstIterator;
+	// Entries are kept in insertion order in chunks that are never reallocated, and are never moved,
+	// so references to keys and values stay valid when other keys are inserted or erased.
+	struct Entry;
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const KeyValue<Variant, Variant> &operator*() const;
+		_FORCE_INLINE_ const KeyValue<Variant, Variant> *operator->() const;
+		_FORCE_INLINE_ ConstIterator &operator++();
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &p_other) const { return entry == p_other.entry; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &p_other) const { return entry != p_other.entry; }
+		_FORCE_INLINE_ explicit operator bool() const { return entry != nullptr; }
+
+		ConstIterator() = default;
+
+	private:
+		friend class Dictionary;
+
+		const Entry *entry = nullptr;
+		const Entry *chunk_begin = nullptr;
+		const Entry *chunk_end = nullptr;
+		const DictionaryPrivate *dictionary = nullptr;
+		uint32_t chunk = 0;
+
+		void _skip_holes();
+	};
 
 	ConstIterator begin() const;
 	ConstIterator end() const;
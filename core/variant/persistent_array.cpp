@@ -0,0 +1,102 @@
+/**************************************************************************/
+/*  persistent_array.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "persistent_array.h"
+
+#include "core/object/class_db.h"
+
+Ref<PersistentArray> PersistentArray::_create(PersistentVector<Variant> &&p_elements) {
+	Ref<PersistentArray> array;
+	array.instantiate();
+	array->elements = std::move(p_elements);
+	return array;
+}
+
+Ref<PersistentArray> PersistentArray::from_array(const Array &p_array) {
+	PersistentVector<Variant> elements;
+	for (const Variant &element : p_array) {
+		elements.push_back(element);
+	}
+	return _create(std::move(elements));
+}
+
+Array PersistentArray::to_array() const {
+	Array array;
+	array.resize(elements.size());
+	int i = 0;
+	for (const Variant &element : elements) {
+		array.set(i++, element);
+	}
+	return array;
+}
+
+Variant PersistentArray::get_element(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, (int)elements.size(), Variant());
+	return elements[p_index];
+}
+
+Variant PersistentArray::back() const {
+	ERR_FAIL_COND_V_MSG(elements.is_empty(), Variant(), "Can't take value from empty array.");
+	return elements[elements.size() - 1];
+}
+
+Ref<PersistentArray> PersistentArray::with_element(int p_index, const Variant &p_value) const {
+	ERR_FAIL_INDEX_V(p_index, (int)elements.size(), Ref<PersistentArray>());
+	PersistentVector<Variant> new_elements = elements;
+	new_elements.set(p_index, p_value);
+	return _create(std::move(new_elements));
+}
+
+Ref<PersistentArray> PersistentArray::appended(const Variant &p_value) const {
+	PersistentVector<Variant> new_elements = elements;
+	new_elements.push_back(p_value);
+	return _create(std::move(new_elements));
+}
+
+Ref<PersistentArray> PersistentArray::without_last() const {
+	ERR_FAIL_COND_V_MSG(elements.is_empty(), Ref<PersistentArray>(), "Can't remove value from empty array.");
+	PersistentVector<Variant> new_elements = elements;
+	new_elements.pop_back();
+	return _create(std::move(new_elements));
+}
+
+void PersistentArray::_bind_methods() {
+	ClassDB::bind_static_method("PersistentArray", D_METHOD("from_array", "array"), &PersistentArray::from_array);
+	ClassDB::bind_method(D_METHOD("to_array"), &PersistentArray::to_array);
+
+	ClassDB::bind_method(D_METHOD("size"), &PersistentArray::size);
+	ClassDB::bind_method(D_METHOD("is_empty"), &PersistentArray::is_empty);
+	ClassDB::bind_method(D_METHOD("get_element", "index"), &PersistentArray::get_element);
+	ClassDB::bind_method(D_METHOD("back"), &PersistentArray::back);
+
+	ClassDB::bind_method(D_METHOD("with_element", "index", "value"), &PersistentArray::with_element);
+	ClassDB::bind_method(D_METHOD("appended", "value"), &PersistentArray::appended);
+	ClassDB::bind_method(D_METHOD("without_last"), &PersistentArray::without_last);
+}
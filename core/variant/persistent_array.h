@@ -0,0 +1,62 @@
+/**************************************************************************/
+/*  persistent_array.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/ref_counted.h"
+#include "core/templates/persistent_vector.h"
+
+// An array that can't be modified. Methods that would modify it return a new
+// PersistentArray instead, which shares all unchanged elements with this one.
+class PersistentArray : public RefCounted {
+	GDCLASS(PersistentArray, RefCounted);
+
+	PersistentVector<Variant> elements;
+
+	static Ref<PersistentArray> _create(PersistentVector<Variant> &&p_elements);
+
+protected:
+	static void _bind_methods();
+
+public:
+	static Ref<PersistentArray> from_array(const Array &p_array);
+	Array to_array() const;
+
+	int size() const { return elements.size(); }
+	bool is_empty() const { return elements.is_empty(); }
+	Variant get_element(int p_index) const;
+	Variant back() const;
+
+	Ref<PersistentArray> with_element(int p_index, const Variant &p_value) const;
+	Ref<PersistentArray> appended(const Variant &p_value) const;
+	Ref<PersistentArray> without_last() const;
+
+	const PersistentVector<Variant> &get_elements() const { return elements; }
+};
@@ -0,0 +1,113 @@
+/**************************************************************************/
+/*  persistent_dictionary.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "persistent_dictionary.h"
+
+#include "core/object/class_db.h"
+
+Ref<PersistentDictionary> PersistentDictionary::_create(Map &&p_entries) {
+	Ref<PersistentDictionary> dictionary;
+	dictionary.instantiate();
+	dictionary->entries = std::move(p_entries);
+	return dictionary;
+}
+
+Ref<PersistentDictionary> PersistentDictionary::from_dictionary(const Dictionary &p_dictionary) {
+	Map entries;
+	for (const KeyValue<Variant, Variant> &E : p_dictionary) {
+		entries.insert(E.key, E.value);
+	}
+	return _create(std::move(entries));
+}
+
+Dictionary PersistentDictionary::to_dictionary() const {
+	Dictionary dictionary;
+	dictionary.reserve(entries.size());
+	for (const KeyValue<Variant, Variant> &E : entries) {
+		dictionary[E.key] = E.value;
+	}
+	return dictionary;
+}
+
+Variant PersistentDictionary::get_value(const Variant &p_key, const Variant &p_default) const {
+	const Variant *value = entries.getptr(p_key);
+	return value ? *value : p_default;
+}
+
+Array PersistentDictionary::keys() const {
+	Array keys;
+	keys.resize(entries.size());
+	int i = 0;
+	for (const KeyValue<Variant, Variant> &E : entries) {
+		keys.set(i++, E.key);
+	}
+	return keys;
+}
+
+Array PersistentDictionary::values() const {
+	Array values;
+	values.resize(entries.size());
+	int i = 0;
+	for (const KeyValue<Variant, Variant> &E : entries) {
+		values.set(i++, E.value);
+	}
+	return values;
+}
+
+Ref<PersistentDictionary> PersistentDictionary::with_value(const Variant &p_key, const Variant &p_value) const {
+	Map new_entries = entries;
+	new_entries.insert(p_key, p_value);
+	return _create(std::move(new_entries));
+}
+
+Ref<PersistentDictionary> PersistentDictionary::without(const Variant &p_key) const {
+	if (!entries.has(p_key)) {
+		// Nothing changes, so this dictionary can be shared as is.
+		return Ref<PersistentDictionary>(const_cast<PersistentDictionary *>(this));
+	}
+	Map new_entries = entries;
+	new_entries.erase(p_key);
+	return _create(std::move(new_entries));
+}
+
+void PersistentDictionary::_bind_methods() {
+	ClassDB::bind_static_method("PersistentDictionary", D_METHOD("from_dictionary", "dictionary"), &PersistentDictionary::from_dictionary);
+	ClassDB::bind_method(D_METHOD("to_dictionary"), &PersistentDictionary::to_dictionary);
+
+	ClassDB::bind_method(D_METHOD("size"), &PersistentDictionary::size);
+	ClassDB::bind_method(D_METHOD("is_empty"), &PersistentDictionary::is_empty);
+	ClassDB::bind_method(D_METHOD("has", "key"), &PersistentDictionary::has);
+	ClassDB::bind_method(D_METHOD("get_value", "key", "default"), &PersistentDictionary::get_value, DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("keys"), &PersistentDictionary::keys);
+	ClassDB::bind_method(D_METHOD("values"), &PersistentDictionary::values);
+
+	ClassDB::bind_method(D_METHOD("with_value", "key", "value"), &PersistentDictionary::with_value);
+	ClassDB::bind_method(D_METHOD("without", "key"), &PersistentDictionary::without);
+}
@@ -0,0 +1,67 @@
+/**************************************************************************/
+/*  persistent_dictionary.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/ref_counted.h"
+#include "core/templates/persistent_hash_map.h"
+
+// A dictionary that can't be modified. Methods that would modify it return a new
+// PersistentDictionary instead, which shares all unchanged entries with this one.
+class PersistentDictionary : public RefCounted {
+	GDCLASS(PersistentDictionary, RefCounted);
+
+public:
+	typedef PersistentHashMap<Variant, Variant, HashMapHasherDefault, StringLikeVariantComparator> Map;
+
+private:
+	Map entries;
+
+	static Ref<PersistentDictionary> _create(Map &&p_entries);
+
+protected:
+	static void _bind_methods();
+
+public:
+	static Ref<PersistentDictionary> from_dictionary(const Dictionary &p_dictionary);
+	Dictionary to_dictionary() const;
+
+	int size() const { return entries.size(); }
+	bool is_empty() const { return entries.is_empty(); }
+	bool has(const Variant &p_key) const { return entries.has(p_key); }
+	Variant get_value(const Variant &p_key, const Variant &p_default = Variant()) const;
+	Array keys() const;
+	Array values() const;
+
+	Ref<PersistentDictionary> with_value(const Variant &p_key, const Variant &p_value) const;
+	Ref<PersistentDictionary> without(const Variant &p_key) const;
+
+	const Map &get_entries() const { return entries; }
+};
@@ -1594,7 +1594,7 @@ String stringify_vector(const T &vec, int recursion_count) {
 			str += ", ";
 		}
 
-		str += stringify_variant_clean(vec[i], recursion_count);
+		str += stringify_variant_clean(vec.get(i), recursion_count);
 	}
 	str += "]";
 	return str;
@@ -985,13 +985,53 @@ Array::Iterator &Array::Iterator::operator--() {
 	return *this;
 }
 
+static_assert(sizeof(Variant) <= Array::ConstIterator::BOXED_SIZE, "Array::ConstIterator can't hold a Variant.");
+
+const Variant &Array::ConstIterator::operator*() const {
+	if (unlikely(packed)) {
+		return _box();
+	}
+	return *element_ptr;
+}
+
+const Variant *Array::ConstIterator::operator->() const {
+	return &operator*();
+}
+
 Array::ConstIterator &Array::ConstIterator::operator++() {
-	element_ptr++;
+	if (likely(!packed)) {
+		element_ptr++;
+	}
+	index++;
 	return *this;
 }
 
 Array::ConstIterator &Array::ConstIterator::operator--() {
-	element_ptr--;
+	if (likely(!packed)) {
+		element_ptr--;
+	}
+	index--;
+	return *this;
+}
+
+struct Dictionary::Entry {
+	KeyValue<Variant, Variant> data;
+	uint32_t hash; // Zero for erased entries, whose data is already destroyed.
+};
+
+const KeyValue<Variant, Variant> &Dictionary::ConstIterator::operator*() const {
+	return entry->data;
+}
+
+const KeyValue<Variant, Variant> *Dictionary::ConstIterator::operator->() const {
+	return &entry->data;
+}
+
+Dictionary::ConstIterator &Dictionary::ConstIterator::operator++() {
+	entry++;
+	if (unlikely(entry == chunk_end || entry->hash == 0)) {
+		_skip_holes();
+	}
 	return *this;
 }
 
@@ -34,6 +34,7 @@
 #include "core/debugger/engine_debugger.h"
 #include "core/io/compression.h"
 #include "core/io/marshalls.h"
+#include "core/math/bulk_math.h"
 #include "core/object/class_db.h"
 #include "core/os/os.h"
 #include "core/templates/a_hash_map.h"
@@ -1167,6 +1168,72 @@ struct _VariantCall {
 		return ret;
 	}
 
+	// Packed arrays of floats and float vectors are handed to BulkMath as flat arrays of scalars.
+	template <typename T>
+	using PackedScalar = std::conditional_t<std::is_same_v<T, float> || std::is_same_v<T, Color>, float, real_t>;
+
+	template <typename T>
+	static Vector<T> func_Packed_multiply_add(Vector<T> *p_instance, const T &p_multiplier, const T &p_addend) {
+		using S = PackedScalar<T>;
+		constexpr int components = sizeof(T) / sizeof(S);
+		Vector<T> ret;
+		ret.resize_uninitialized(p_instance->size());
+		BulkMath::multiply_add(reinterpret_cast<const S *>(p_instance->ptr()), reinterpret_cast<S *>(ret.ptrw()), p_instance->size() * components, components, reinterpret_cast<const S *>(&p_multiplier), reinterpret_cast<const S *>(&p_addend));
+		return ret;
+	}
+
+	template <typename T>
+	static Vector<T> func_Packed_clamp(Vector<T> *p_instance, const T &p_min, const T &p_max) {
+		using S = PackedScalar<T>;
+		constexpr int components = sizeof(T) / sizeof(S);
+		Vector<T> ret;
+		ret.resize_uninitialized(p_instance->size());
+		BulkMath::clamp(reinterpret_cast<const S *>(p_instance->ptr()), reinterpret_cast<S *>(ret.ptrw()), p_instance->size() * components, components, reinterpret_cast<const S *>(&p_min), reinterpret_cast<const S *>(&p_max));
+		return ret;
+	}
+
+	template <typename T>
+	static Vector<T> func_Packed_lerp(Vector<T> *p_instance, const Vector<T> &p_to, double p_weight) {
+		using S = PackedScalar<T>;
+		constexpr int components = sizeof(T) / sizeof(S);
+		ERR_FAIL_COND_V_MSG(p_to.size() != p_instance->size(), Vector<T>(), "Arrays must have the same size to be interpolated.");
+		Vector<T> ret;
+		ret.resize_uninitialized(p_instance->size());
+		BulkMath::lerp(reinterpret_cast<const S *>(p_instance->ptr()), reinterpret_cast<const S *>(p_to.ptr()), reinterpret_cast<S *>(ret.ptrw()), p_instance->size() * components, S(p_weight));
+		return ret;
+	}
+
+	template <typename T>
+	static T func_Packed_sum(Vector<T> *p_instance) {
+		using S = PackedScalar<T>;
+		constexpr int components = sizeof(T) / sizeof(S);
+		T ret;
+		BulkMath::sum(reinterpret_cast<const S *>(p_instance->ptr()), p_instance->size() * components, components, reinterpret_cast<S *>(&ret));
+		return ret;
+	}
+
+	template <typename T>
+	static T func_Packed_min(Vector<T> *p_instance) {
+		using S = PackedScalar<T>;
+		constexpr int components = sizeof(T) / sizeof(S);
+		T ret = T();
+		if (!p_instance->is_empty()) {
+			BulkMath::min(reinterpret_cast<const S *>(p_instance->ptr()), p_instance->size() * components, components, reinterpret_cast<S *>(&ret));
+		}
+		return ret;
+	}
+
+	template <typename T>
+	static T func_Packed_max(Vector<T> *p_instance) {
+		using S = PackedScalar<T>;
+		constexpr int components = sizeof(T) / sizeof(S);
+		T ret = T();
+		if (!p_instance->is_empty()) {
+			BulkMath::max(reinterpret_cast<const S *>(p_instance->ptr()), p_instance->size() * components, components, reinterpret_cast<S *>(&ret));
+		}
+		return ret;
+	}
+
 	static void func_Callable_call(Variant *v, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
 		Callable *callable = &VariantInternalAccessor<Callable>::get(v);
 		callable->callp(p_args, p_argcount, r_ret, r_error);
@@ -2909,6 +2976,12 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedFloat32Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedFloat32Array, count, sarray("value"), varray());
 	bind_method(PackedFloat32Array, erase, sarray("value"), varray());
+	bind_function(PackedFloat32Array, multiply_add, _VariantCall::func_Packed_multiply_add<float>, sarray("multiplier", "addend"), varray());
+	bind_function(PackedFloat32Array, clamp, _VariantCall::func_Packed_clamp<float>, sarray("min", "max"), varray());
+	bind_function(PackedFloat32Array, lerp, _VariantCall::func_Packed_lerp<float>, sarray("to", "weight"), varray());
+	bind_function(PackedFloat32Array, sum, _VariantCall::func_Packed_sum<float>, sarray(), varray());
+	bind_function(PackedFloat32Array, min, _VariantCall::func_Packed_min<float>, sarray(), varray());
+	bind_function(PackedFloat32Array, max, _VariantCall::func_Packed_max<float>, sarray(), varray());
 
 	/* Float64 Array */
 
@@ -2993,6 +3066,12 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedVector2Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedVector2Array, count, sarray("value"), varray());
 	bind_method(PackedVector2Array, erase, sarray("value"), varray());
+	bind_function(PackedVector2Array, multiply_add, _VariantCall::func_Packed_multiply_add<Vector2>, sarray("multiplier", "addend"), varray());
+	bind_function(PackedVector2Array, clamp, _VariantCall::func_Packed_clamp<Vector2>, sarray("min", "max"), varray());
+	bind_function(PackedVector2Array, lerp, _VariantCall::func_Packed_lerp<Vector2>, sarray("to", "weight"), varray());
+	bind_function(PackedVector2Array, sum, _VariantCall::func_Packed_sum<Vector2>, sarray(), varray());
+	bind_function(PackedVector2Array, min, _VariantCall::func_Packed_min<Vector2>, sarray(), varray());
+	bind_function(PackedVector2Array, max, _VariantCall::func_Packed_max<Vector2>, sarray(), varray());
 
 	/* Vector3 Array */
 
@@ -3021,6 +3100,12 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedVector3Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedVector3Array, count, sarray("value"), varray());
 	bind_method(PackedVector3Array, erase, sarray("value"), varray());
+	bind_function(PackedVector3Array, multiply_add, _VariantCall::func_Packed_multiply_add<Vector3>, sarray("multiplier", "addend"), varray());
+	bind_function(PackedVector3Array, clamp, _VariantCall::func_Packed_clamp<Vector3>, sarray("min", "max"), varray());
+	bind_function(PackedVector3Array, lerp, _VariantCall::func_Packed_lerp<Vector3>, sarray("to", "weight"), varray());
+	bind_function(PackedVector3Array, sum, _VariantCall::func_Packed_sum<Vector3>, sarray(), varray());
+	bind_function(PackedVector3Array, min, _VariantCall::func_Packed_min<Vector3>, sarray(), varray());
+	bind_function(PackedVector3Array, max, _VariantCall::func_Packed_max<Vector3>, sarray(), varray());
 
 	/* Color Array */
 
@@ -3049,6 +3134,12 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedColorArray, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedColorArray, count, sarray("value"), varray());
 	bind_method(PackedColorArray, erase, sarray("value"), varray());
+	bind_function(PackedColorArray, multiply_add, _VariantCall::func_Packed_multiply_add<Color>, sarray("multiplier", "addend"), varray());
+	bind_function(PackedColorArray, clamp, _VariantCall::func_Packed_clamp<Color>, sarray("min", "max"), varray());
+	bind_function(PackedColorArray, lerp, _VariantCall::func_Packed_lerp<Color>, sarray("to", "weight"), varray());
+	bind_function(PackedColorArray, sum, _VariantCall::func_Packed_sum<Color>, sarray(), varray());
+	bind_function(PackedColorArray, min, _VariantCall::func_Packed_min<Color>, sarray(), varray());
+	bind_function(PackedColorArray, max, _VariantCall::func_Packed_max<Color>, sarray(), varray());
 
 	/* Vector4 Array */
 
@@ -656,7 +656,7 @@ public:
 		int size = src_arr.size();
 		dst_arr.resize(size);
 		for (int i = 0; i < size; i++) {
-			dst_arr.write[i] = src_arr[i];
+			dst_arr.write[i] = src_arr.get(i);
 		}
 	}
 
@@ -668,7 +668,7 @@ public:
 		int size = src_arr.size();
 		dst_arr.resize(size);
 		for (int i = 0; i < size; i++) {
-			dst_arr.write[i] = src_arr[i];
+			dst_arr.write[i] = src_arr.get(i);
 		}
 	}
 	static void ptr_construct(void *base, const void **p_args) {
@@ -678,7 +678,7 @@ public:
 		int size = src_arr.size();
 		dst_arr.resize(size);
 		for (int i = 0; i < size; i++) {
-			dst_arr.write[i] = src_arr[i];
+			dst_arr.write[i] = src_arr.get(i);
 		}
 
 		PtrConstruct<T>::construct(dst_arr, base);
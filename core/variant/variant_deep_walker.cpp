@@ -0,0 +1,382 @@
+/**************************************************************************/
+/*  variant_deep_walker.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "variant_deep_walker.h"
+
+#include "core/templates/hashfuncs.h"
+#include "core/templates/small_vector.h"
+#include "core/variant/variant_internal.h"
+
+// Most graphs are only a few levels deep, so the stacks rarely leave their inline storage.
+static constexpr uint32_t WALK_STACK_INLINE_DEPTH = 32;
+
+// Frames refer to the source containers through the Variants holding them. Those live in the
+// parent containers, which are not modified during a walk, so the pointers stay valid.
+
+struct DuplicateFrame {
+	const Variant *source = nullptr;
+	Variant copy; // Shares the container that is being filled with the value handed to the parent.
+	const Variant *elements = nullptr; // Source elements, if the source is an Array.
+	Dictionary::ConstIterator next; // Next source entry, if the source is a Dictionary.
+	int index = 0;
+	int size = 0;
+	int depth = 0;
+};
+
+typedef SmallVector<DuplicateFrame, WALK_STACK_INLINE_DEPTH> DuplicateStack;
+
+// Returns the copy of `p_value`. If it's a container with elements that need a deep copy too,
+// the copy starts out shallow and a frame is pushed to replace those elements.
+static Variant _duplicate_begin(const Variant &p_value, ResourceDeepDuplicateMode p_deep_subresources_mode, int p_depth, DuplicateStack &r_stack) {
+	switch (p_value.get_type()) {
+		case Variant::ARRAY: {
+			const Array &array = *VariantInternal::get_array(&p_value);
+			if (p_depth > MAX_RECURSION) {
+				ERR_PRINT("Max recursion reached");
+				Array copy;
+				if (array.is_typed()) {
+					copy.set_typed(array.get_typed_builtin(), array.get_typed_class_name(), array.get_typed_script());
+				}
+				return copy;
+			}
+
+			// The shallow copy is already typed and sized, and shares the plain elements with the source.
+			Variant copy = array.duplicate(false);
+			if (!array.is_empty() && !VariantDeepWalker::is_plain_value(array.get_typed_builtin())) {
+				DuplicateFrame frame;
+				frame.source = &p_value;
+				frame.copy = copy;
+				frame.elements = array.span().ptr();
+				frame.size = array.size();
+				frame.depth = p_depth;
+				r_stack.push_back(frame);
+			}
+			return copy;
+		}
+		case Variant::DICTIONARY: {
+			const Dictionary &dictionary = *VariantInternal::get_dictionary(&p_value);
+			Dictionary copy;
+			if (dictionary.is_typed()) {
+				copy.set_typed(dictionary.get_typed_key_builtin(), dictionary.get_typed_key_class_name(), dictionary.get_typed_key_script(),
+						dictionary.get_typed_value_builtin(), dictionary.get_typed_value_class_name(), dictionary.get_typed_value_script());
+			}
+			if (p_depth > MAX_RECURSION) {
+				ERR_PRINT("Max recursion reached");
+				return copy;
+			}
+
+			if (!dictionary.is_empty()) {
+				copy.reserve(dictionary.size());
+				DuplicateFrame frame;
+				frame.source = &p_value;
+				frame.copy = copy;
+				frame.next = dictionary.begin();
+				frame.depth = p_depth;
+				r_stack.push_back(frame);
+			}
+			return copy;
+		}
+		default: {
+			if (VariantDeepWalker::is_plain_value(p_value.get_type())) {
+				return p_value;
+			}
+			// Objects and packed arrays don't nest any further here, resources are duplicated on their own.
+			return p_value.recursive_duplicate(true, p_deep_subresources_mode, p_depth);
+		}
+	}
+}
+
+Variant VariantDeepWalker::_duplicate(const Variant &p_variant, ResourceDeepDuplicateMode p_deep_subresources_mode, int p_recursion_count) {
+	DuplicateStack stack;
+	Variant result = _duplicate_begin(p_variant, p_deep_subresources_mode, p_recursion_count, stack);
+
+	while (!stack.is_empty()) {
+		// Pushing a frame may move the stack, so nothing in the frame may be used after `_duplicate_begin()`.
+		DuplicateFrame &frame = stack[stack.size() - 1];
+		const int depth = frame.depth + 1;
+
+		if (frame.elements) {
+			if (frame.index == frame.size) {
+				stack.pop_back();
+				continue;
+			}
+			const int index = frame.index++;
+			const Variant &element = frame.elements[index];
+			if (is_plain_value(element.get_type()) || element.get_type() == Variant::NIL) {
+				continue; // Already shared by the shallow copy.
+			}
+			Variant &copy = (*VariantInternal::get_array(&frame.copy))[index];
+			copy = _duplicate_begin(element, p_deep_subresources_mode, depth, stack);
+		} else {
+			if (!frame.next) {
+				stack.pop_back();
+				continue;
+			}
+			const KeyValue<Variant, Variant> &entry = *frame.next;
+			++frame.next;
+			Dictionary &copy = *VariantInternal::get_dictionary(&frame.copy);
+			// Keys must be complete before they are hashed, which only nested containers used as keys need a separate walk for.
+			Variant &value = is_plain_value(entry.key.get_type()) ? copy[entry.key] : copy[_duplicate(entry.key, p_deep_subresources_mode, depth)];
+			if (is_plain_value(entry.value.get_type())) {
+				value = entry.value;
+			} else {
+				value = _duplicate_begin(entry.value, p_deep_subresources_mode, depth, stack);
+			}
+		}
+	}
+
+	return result;
+}
+
+struct HashFrame {
+	const Variant *source = nullptr;
+	const Variant *elements = nullptr;
+	Dictionary::ConstIterator next;
+	int index = 0;
+	int size = 0;
+	int depth = 0;
+	uint32_t hash = 0;
+	bool value_next = false; // Whether the key of `next` was hashed already.
+};
+
+typedef SmallVector<HashFrame, WALK_STACK_INLINE_DEPTH> HashStack;
+
+// Returns true if a frame was pushed to hash the elements of `p_value`, otherwise sets `r_hash`.
+static bool _hash_begin(const Variant &p_value, int p_depth, HashStack &r_stack, uint32_t &r_hash) {
+	const Variant::Type type = p_value.get_type();
+	if (type != Variant::ARRAY && type != Variant::DICTIONARY) {
+		r_hash = p_value.recursive_hash(p_depth);
+		return false;
+	}
+	if (p_depth > MAX_RECURSION) {
+		ERR_PRINT("Max recursion reached");
+		r_hash = 0;
+		return false;
+	}
+
+	HashFrame frame;
+	frame.source = &p_value;
+	frame.depth = p_depth;
+	frame.hash = hash_murmur3_one_32(type);
+	if (type == Variant::ARRAY) {
+		const Array &array = *VariantInternal::get_array(&p_value);
+		if (!VariantDeepWalker::can_nest(array.get_typed_builtin())) {
+			r_hash = array.recursive_hash(p_depth);
+			return false;
+		}
+		frame.elements = array.span().ptr();
+		frame.size = array.size();
+	} else {
+		frame.next = VariantInternal::get_dictionary(&p_value)->begin();
+	}
+	r_stack.push_back(frame);
+	return true;
+}
+
+uint32_t VariantDeepWalker::_hash(const Variant &p_variant, int p_recursion_count) {
+	HashStack stack;
+	uint32_t hash = 0;
+	if (!_hash_begin(p_variant, p_recursion_count, stack, hash)) {
+		return hash;
+	}
+
+	while (true) {
+		HashFrame &frame = stack[stack.size() - 1];
+		const Variant *value = nullptr;
+		if (frame.elements) {
+			if (frame.index < frame.size) {
+				value = &frame.elements[frame.index++];
+			}
+		} else if (frame.next) {
+			if (frame.value_next) {
+				value = &frame.next->value;
+				++frame.next;
+			} else {
+				value = &frame.next->key;
+			}
+			frame.value_next = !frame.value_next;
+		}
+
+		if (value) {
+			if (!_hash_begin(*value, frame.depth + 1, stack, hash)) {
+				frame.hash = hash_murmur3_one_32(hash, frame.hash);
+			}
+			continue;
+		}
+
+		// All elements are hashed, fold the result into the parent.
+		hash = hash_fmix32(frame.hash);
+		stack.pop_back();
+		if (stack.is_empty()) {
+			return hash;
+		}
+		HashFrame &parent = stack[stack.size() - 1];
+		parent.hash = hash_murmur3_one_32(hash, parent.hash);
+	}
+}
+
+struct EqualFrame {
+	const Variant *a = nullptr;
+	const Variant *b = nullptr;
+	const Variant *elements_a = nullptr;
+	const Variant *elements_b = nullptr;
+	Dictionary::ConstIterator next; // Next entry of `a`, if comparing Dictionaries.
+	int index = 0;
+	int size = 0;
+	int depth = 0;
+};
+
+typedef SmallVector<EqualFrame, WALK_STACK_INLINE_DEPTH> EqualStack;
+
+// Compares two Variants of the same type at the recursion depth `Array::recursive_equal()` or
+// `Dictionary::recursive_equal()` would see them. Returns true if a frame was pushed to compare
+// their elements, otherwise sets `r_equal`.
+static bool _equal_begin(const Variant &p_a, const Variant &p_b, int p_depth, EqualStack &r_stack, bool &r_equal) {
+	EqualFrame frame;
+	if (p_a.get_type() == Variant::ARRAY) {
+		const Array &a = *VariantInternal::get_array(&p_a);
+		const Array &b = *VariantInternal::get_array(&p_b);
+		if (a.is_same_instance(b)) {
+			r_equal = true;
+			return false;
+		}
+		if (a.size() != b.size()) {
+			r_equal = false;
+			return false;
+		}
+		if (p_depth > MAX_RECURSION) {
+			ERR_PRINT("Max recursion reached");
+			r_equal = true;
+			return false;
+		}
+		if (!VariantDeepWalker::can_nest(a.get_typed_builtin()) || !VariantDeepWalker::can_nest(b.get_typed_builtin())) {
+			// Elements that can't be containers on either side are compared directly.
+			r_equal = a.recursive_equal(b, p_depth);
+			return false;
+		}
+		frame.elements_a = a.span().ptr();
+		frame.elements_b = b.span().ptr();
+		frame.size = a.size();
+	} else {
+		const Dictionary &a = *VariantInternal::get_dictionary(&p_a);
+		const Dictionary &b = *VariantInternal::get_dictionary(&p_b);
+		if (a.is_same_instance(b)) {
+			r_equal = true;
+			return false;
+		}
+		if (a.size() != b.size()) {
+			r_equal = false;
+			return false;
+		}
+		if (p_depth > MAX_RECURSION) {
+			ERR_PRINT("Max recursion reached");
+			r_equal = true;
+			return false;
+		}
+		frame.next = a.begin();
+	}
+
+	frame.a = &p_a;
+	frame.b = &p_b;
+	frame.depth = p_depth;
+	r_stack.push_back(frame);
+	return true;
+}
+
+bool VariantDeepWalker::_equal(const Variant &p_a, const Variant &p_b, int p_recursion_count) {
+	EqualStack stack;
+	bool equal = true;
+	if (!_equal_begin(p_a, p_b, p_recursion_count, stack, equal)) {
+		return equal;
+	}
+
+	while (!stack.is_empty()) {
+		EqualFrame &frame = stack[stack.size() - 1];
+		const Variant *a = nullptr;
+		const Variant *b = nullptr;
+		if (frame.elements_a) {
+			if (frame.index < frame.size) {
+				a = &frame.elements_a[frame.index];
+				b = &frame.elements_b[frame.index];
+				frame.index++;
+			}
+		} else if (frame.next) {
+			const KeyValue<Variant, Variant> &entry = *frame.next;
+			++frame.next;
+			a = &entry.value;
+			b = VariantInternal::get_dictionary(frame.b)->_find_value(entry.key);
+			if (!b) {
+				return false;
+			}
+		}
+
+		if (!a) {
+			stack.pop_back();
+			continue;
+		}
+		if (a->get_type() != b->get_type()) {
+			return false;
+		}
+		// Same depths as going through `Variant::hash_compare()`, which adds one level on its own.
+		if (a->get_type() == Variant::ARRAY || a->get_type() == Variant::DICTIONARY) {
+			if (!_equal_begin(*a, *b, frame.depth + 2, stack, equal) && !equal) {
+				return false;
+			}
+		} else if (!a->hash_compare(*b, frame.depth + 1, false)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+Array VariantDeepWalker::duplicate(const Array &p_array, ResourceDeepDuplicateMode p_deep_subresources_mode, int p_recursion_count) {
+	return _duplicate(p_array, p_deep_subresources_mode, p_recursion_count);
+}
+
+Dictionary VariantDeepWalker::duplicate(const Dictionary &p_dictionary, ResourceDeepDuplicateMode p_deep_subresources_mode, int p_recursion_count) {
+	return _duplicate(p_dictionary, p_deep_subresources_mode, p_recursion_count);
+}
+
+uint32_t VariantDeepWalker::hash(const Array &p_array, int p_recursion_count) {
+	return _hash(p_array, p_recursion_count);
+}
+
+uint32_t VariantDeepWalker::hash(const Dictionary &p_dictionary, int p_recursion_count) {
+	return _hash(p_dictionary, p_recursion_count);
+}
+
+bool VariantDeepWalker::equal(const Array &p_a, const Array &p_b, int p_recursion_count) {
+	return _equal(p_a, p_b, p_recursion_count);
+}
+
+bool VariantDeepWalker::equal(const Dictionary &p_a, const Dictionary &p_b, int p_recursion_count) {
+	return _equal(p_a, p_b, p_recursion_count);
+}
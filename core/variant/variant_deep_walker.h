@@ -0,0 +1,63 @@
+/**************************************************************************/
+/*  variant_deep_walker.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/variant/variant.h"
+
+// Deep duplication, hashing and comparison of nested Arrays and Dictionaries.
+// The nesting is walked with an explicit stack instead of recursing once per container,
+// so large graphs don't exhaust the native stack and containers holding only plain values
+// are handled in bulk.
+class VariantDeepWalker {
+	static Variant _duplicate(const Variant &p_variant, ResourceDeepDuplicateMode p_deep_subresources_mode, int p_recursion_count);
+	static uint32_t _hash(const Variant &p_variant, int p_recursion_count);
+	static bool _equal(const Variant &p_a, const Variant &p_b, int p_recursion_count);
+
+public:
+	// Whether the elements of a container typed as `p_type` may be Arrays or Dictionaries.
+	static _FORCE_INLINE_ bool can_nest(uint32_t p_type) {
+		return p_type == Variant::NIL || p_type == Variant::ARRAY || p_type == Variant::DICTIONARY;
+	}
+
+	// Whether a deep copy of a value of type `p_type` is the same as a plain copy.
+	static _FORCE_INLINE_ bool is_plain_value(uint32_t p_type) {
+		return p_type != Variant::NIL && p_type != Variant::OBJECT && p_type != Variant::DICTIONARY && p_type < Variant::ARRAY;
+	}
+
+	static Array duplicate(const Array &p_array, ResourceDeepDuplicateMode p_deep_subresources_mode, int p_recursion_count);
+	static Dictionary duplicate(const Dictionary &p_dictionary, ResourceDeepDuplicateMode p_deep_subresources_mode, int p_recursion_count);
+
+	static uint32_t hash(const Array &p_array, int p_recursion_count);
+	static uint32_t hash(const Dictionary &p_dictionary, int p_recursion_count);
+
+	static bool equal(const Array &p_a, const Array &p_b, int p_recursion_count);
+	static bool equal(const Dictionary &p_a, const Dictionary &p_b, int p_recursion_count);
+};
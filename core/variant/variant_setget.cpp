@@ -664,7 +664,7 @@ struct VariantIndexedSetGet_Array {
 			*oob = true;
 			return;
 		}
-		*value = (VariantInternalAccessor<Array>::get(base))[index];
+		*value = VariantInternalAccessor<Array>::get(base).get(index);
 		*oob = false;
 	}
 	static void ptr_get(const void *base, int64_t index, void *member) {
@@ -674,7 +674,7 @@ struct VariantIndexedSetGet_Array {
 			index += v.size();
 		}
 		OOB_TEST(index, v.size());
-		PtrToArg<Variant>::encode(v[index], member);
+		PtrToArg<Variant>::encode(v.get(index), member);
 	}
 	static void set(Variant *base, int64_t index, const Variant *value, bool *valid, bool *oob) {
 		if (VariantInternalAccessor<Array>::get(base).is_read_only()) {
@@ -36,6 +36,9 @@
 #include "core/string/print_string.h"
 
 #include <fcntl.h>
+#if !defined(WEB_ENABLED)
+#include <sys/mman.h>
+#endif
 #include <sys/stat.h>
 #include <sys/types.h>
 #if !defined(__FreeBSD__) && !defined(__OpenBSD__) && !defined(__NetBSD__) && !defined(WEB_ENABLED)
@@ -204,6 +207,16 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+#if !defined(WEB_ENABLED)
+	if (mapped_data) {
+		munmap(mapped_data, mapped_length);
+	}
+#endif
+	mapped_data = nullptr;
+	mapped_length = 0;
+	mapped_pos = 0;
+	mapped_eof = false;
+
 	fclose(f);
 	f = nullptr;
 
@@ -258,6 +271,13 @@ String FileAccessUnix::get_real_path() const {
 void FileAccessUnix::seek(uint64_t p_position) {
 	ERR_FAIL_NULL_MSG(f, "File must be opened before use.");
 
+	if (mapped_data) {
+		mapped_pos = p_position;
+		mapped_eof = false;
+		last_error = OK;
+		return;
+	}
+
 	if (fseeko(f, p_position, SEEK_SET)) {
 		check_errors();
 	}
@@ -266,6 +286,16 @@ void FileAccessUnix::seek(uint64_t p_position) {
 void FileAccessUnix::seek_end(int64_t p_position) {
 	ERR_FAIL_NULL_MSG(f, "File must be opened before use.");
 
+	if (mapped_data) {
+		if (p_position < 0 && (uint64_t)-p_position > mapped_length) {
+			return; // Seeking before the start of the file is ignored, like with `fseeko()`.
+		}
+		mapped_pos = mapped_length + p_position;
+		mapped_eof = false;
+		last_error = OK;
+		return;
+	}
+
 	if (fseeko(f, p_position, SEEK_END)) {
 		check_errors();
 	}
@@ -274,6 +304,10 @@ void FileAccessUnix::seek_end(int64_t p_position) {
 uint64_t FileAccessUnix::get_position() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
 
+	if (mapped_data) {
+		return mapped_pos;
+	}
+
 	int64_t pos = ftello(f);
 	if (pos < 0) {
 		check_errors();
@@ -285,6 +319,10 @@ uint64_t FileAccessUnix::get_position() const {
 uint64_t FileAccessUnix::get_length() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
 
+	if (mapped_data) {
+		return mapped_length;
+	}
+
 	int64_t pos = ftello(f);
 	ERR_FAIL_COND_V(pos < 0, 0);
 	ERR_FAIL_COND_V(fseeko(f, 0, SEEK_END), 0);
@@ -296,6 +334,9 @@ uint64_t FileAccessUnix::get_length() const {
 }
 
 bool FileAccessUnix::eof_reached() const {
+	if (mapped_data) {
+		return mapped_eof;
+	}
 	return feof(f);
 }
 
@@ -303,12 +344,67 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	ERR_FAIL_NULL_V_MSG(f, -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
+	if (mapped_data) {
+		uint64_t read = p_length;
+		if (mapped_pos >= mapped_length) {
+			read = 0;
+		} else if (p_length > mapped_length - mapped_pos) {
+			read = mapped_length - mapped_pos;
+		}
+		if (read > 0) {
+			memcpy(p_dst, mapped_data + mapped_pos, read);
+			mapped_pos += read;
+		}
+		// Like `fread()`, only trying to read past the end sets the EOF flag.
+		mapped_eof = read < p_length;
+		last_error = mapped_eof ? ERR_FILE_EOF : OK;
+		return read;
+	}
+
 	uint64_t read = fread(p_dst, 1, p_length, f);
 	check_errors();
 
 	return read;
 }
 
+Error FileAccessUnix::map() {
+	ERR_FAIL_NULL_V_MSG(f, ERR_FILE_CANT_READ, "File must be opened before use.");
+
+	if (mapped_data) {
+		return OK;
+	}
+
+#if defined(WEB_ENABLED)
+	return ERR_UNAVAILABLE;
+#else
+	// Only regular, non-empty files opened for reading are mapped.
+	if (flags != READ) {
+		return ERR_UNAVAILABLE;
+	}
+
+	struct stat st = {};
+	if (fstat(fileno(f), &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0 || (uint64_t)st.st_size > (uint64_t)SIZE_MAX) {
+		return ERR_UNAVAILABLE;
+	}
+
+	const int64_t pos = ftello(f);
+	if (pos < 0) {
+		return ERR_FILE_CANT_READ;
+	}
+
+	void *data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+	if (data == MAP_FAILED) {
+		return ERR_UNAVAILABLE;
+	}
+
+	mapped_data = (uint8_t *)data;
+	mapped_length = st.st_size;
+	mapped_pos = pos;
+	mapped_eof = feof(f);
+	return OK;
+#endif
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -43,6 +43,13 @@ class FileAccessUnix : public FileAccess {
 	int flags = 0;
 	void check_errors(bool p_write = false) const;
 	mutable Error last_error = OK;
+
+	// Set when reads are served from a read-only memory mapping (see `map()`).
+	uint8_t *mapped_data = nullptr;
+	uint64_t mapped_length = 0;
+	mutable uint64_t mapped_pos = 0;
+	mutable bool mapped_eof = false;
+
 	String save_path;
 	String path;
 	String path_src;
@@ -71,6 +78,8 @@ public:
 	virtual bool eof_reached() const override; ///< reading passed EOF
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual Error map() override;
+	virtual Span<uint8_t> get_mapped_span() const override { return Span<uint8_t>(mapped_data, mapped_length); }
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -49,6 +49,7 @@
 #include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
 #include "core/object/script_language.h"
+#include "core/os/frame_arena.h"
 #include "core/os/os.h"
 #include "core/os/time.h"
 #include "core/profiling/profiling.h"
@@ -2197,6 +2198,13 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 	GLOBAL_DEF("debug/settings/stdout/print_gpu_profile", false);
 	GLOBAL_DEF("debug/settings/stdout/verbose_stdout", false);
 	GLOBAL_DEF("debug/settings/physics_interpolation/enable_warnings", true);
+	Memory::set_allocation_sampling_interval(GLOBAL_DEF(PropertyInfo(Variant::INT, "debug/settings/memory/allocation_sampling_interval", PROPERTY_HINT_RANGE, "0,16777216,1,or_greater,suffix:B"), 0));
+	if (GLOBAL_DEF("debug/settings/memory/tag_monitors", false)) {
+		Memory::set_tag_tracking_enabled(true);
+		performance->add_memory_tag_monitors();
+	} else if (Memory::get_allocation_sampling_interval()) {
+		Memory::set_tag_tracking_enabled(true);
+	}
 	if (!OS::get_singleton()->_verbose_stdout) { // Not manually overridden.
 		OS::get_singleton()->_verbose_stdout = GLOBAL_GET("debug/settings/stdout/verbose_stdout");
 	}
@@ -4988,6 +4996,7 @@ bool Main::iteration() {
 
 	frames++;
 	Engine::get_singleton()->_process_frames++;
+	FrameArena::advance_frame();
 
 	if (frame > 1000000) {
 		// Wait a few seconds before printing FPS, as FPS reporting just after the engine has started is inaccurate.
@@ -5095,6 +5104,27 @@ void Main::cleanup(bool p_force) {
 	if (input) {
 		input->flush_frame_parsed_events();
 	}
+
+	if (Memory::get_allocation_sampling_interval()) {
+		Memory::AllocationSiteSample samples[20];
+		uint32_t sample_count = Memory::get_allocation_site_samples(samples, std_size(samples));
+		print_line("Sites with the most sampled allocations:");
+		for (uint32_t i = 0; i < sample_count; i++) {
+			const Memory::AllocationSite *site = samples[i].site;
+			String size = String::humanize_size(samples[i].bytes);
+			String caller;
+			for (const void *address : samples[i].callers) {
+				if (address) {
+					caller += (caller.is_empty() ? "" : " < ") + vformat("0x%x", (uint64_t)(uintptr_t)address);
+				}
+			}
+			if (site->line) {
+				print_line(vformat("  %s (%s) %s:%d, %s, called from %s", size, Memory::get_tag_name(site->tag), site->file, site->line, site->function, caller));
+			} else {
+				print_line(vformat("  %s (%s) called from %s", size, Memory::get_tag_name(site->tag), caller));
+			}
+		}
+	}
 #endif
 
 	GDExtensionManager::get_singleton()->shutdown();
@@ -160,6 +160,24 @@ int Performance::_get_orphan_node_count() const {
 #endif
 }
 
+#ifdef DEBUG_ENABLED
+uint64_t Performance::_get_tag_mem_usage(int p_tag, bool p_max) const {
+	Memory::AllocationTag tag = (Memory::AllocationTag)p_tag;
+	return p_max ? Memory::get_tag_mem_max_usage(tag) : Memory::get_tag_mem_usage(tag);
+}
+#endif
+
+void Performance::add_memory_tag_monitors() {
+#ifdef DEBUG_ENABLED
+	// Static memory per allocation tag, only tracked in debug builds.
+	for (int i = 0; i < Memory::TAG_MAX; i++) {
+		String tag_name = Memory::get_tag_name((Memory::AllocationTag)i);
+		add_custom_monitor("memory_tags/" + tag_name, callable_mp(this, &Performance::_get_tag_mem_usage), varray(i, false), MONITOR_TYPE_MEMORY);
+		add_custom_monitor("memory_tags/" + tag_name + "_max", callable_mp(this, &Performance::_get_tag_mem_usage), varray(i, true), MONITOR_TYPE_MEMORY);
+	}
+#endif
+}
+
 String Performance::get_monitor_name(Monitor p_monitor) const {
 	ERR_FAIL_INDEX_V(p_monitor, MONITOR_MAX, String());
 	static const char *names[MONITOR_MAX] = {
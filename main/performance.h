@@ -52,6 +52,9 @@ class Performance : public Object {
 
 	int _get_node_count() const;
 	int _get_orphan_node_count() const;
+#ifdef DEBUG_ENABLED
+	uint64_t _get_tag_mem_usage(int p_tag, bool p_max) const;
+#endif
 
 	double _process_time;
 	double _physics_process_time;
@@ -149,6 +152,9 @@ public:
 
 	uint64_t get_monitor_modification_time();
 
+	// Adds the "memory_tags/*" custom monitors. Does nothing in release builds.
+	void add_memory_tag_monitors();
+
 	static Performance *get_singleton() { return singleton; }
 
 	Performance();
@@ -149,6 +149,8 @@ void GDScript::_super_implicit_constructor(GDScript *p_script, GDScriptInstance
 }
 
 GDScriptInstance *GDScript::_create_instance(const Variant **p_args, int p_argcount, Object *p_owner, Callable::CallError &r_error) {
+	MEMORY_TAG_SCOPE(SCRIPT);
+
 	/* STEP 1, CREATE */
 
 	GDScriptInstance *instance = memnew(GDScriptInstance);
@@ -737,6 +739,8 @@ void GDScript::_restore_old_static_data() {
 #endif
 
 Error GDScript::reload(bool p_keep_state) {
+	MEMORY_TAG_SCOPE(SCRIPT);
+
 	if (reloading) {
 		return OK;
 	}
@@ -215,6 +215,7 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 			function->global_names.write[E.value] = E.key;
 		}
 		function->_global_names_count = function->global_names.size();
+		function->call_caches.resize(function->global_names.size());
 
 	} else {
 		function->_global_names_ptr = nullptr;
@@ -36,6 +36,7 @@
 #include "core/object/script_language.h"
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
@@ -481,6 +482,7 @@ private:
 	Vector<Variant> constants;
 	HashMap<StringName, Variant> constant_map;
 	Vector<StringName> global_names;
+	LocalVector<MethodCallCache> call_caches; // Indexed like global_names, for untyped calls to each name.
 	Vector<Variant::ValidatedOperatorEvaluator> operator_funcs;
 	Vector<Variant::ValidatedSetter> setters;
 	Vector<Variant::ValidatedGetter> getters;
@@ -1288,6 +1288,7 @@ void GodotPhysicsServer2D::init() {
 }
 
 void GodotPhysicsServer2D::step(real_t p_step) {
+	MEMORY_TAG_SCOPE(PHYSICS);
 	if (!active) {
 		return;
 	}
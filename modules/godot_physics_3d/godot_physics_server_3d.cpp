@@ -1672,6 +1672,7 @@ void GodotPhysicsServer3D::init() {
 }
 
 void GodotPhysicsServer3D::step(real_t p_step) {
+	MEMORY_TAG_SCOPE(PHYSICS);
 	if (!active) {
 		return;
 	}
@@ -40,6 +40,9 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+#define SETUP_CONSTRAINTS_GRAIN 16
+#define ISLAND_BATCH_COUNT 4
+#define ISLAND_BATCH_MIN_CONSTRAINT_COUNT 256
 
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -112,9 +115,10 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 	}
 }
 
-void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
-	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
-	constraint->setup(delta);
+void GodotStep3D::_setup_constraints(uint32_t p_from, uint32_t p_to, uint32_t p_participant, void *p_userdata) {
+	for (uint32_t constraint_index = p_from; constraint_index < p_to; ++constraint_index) {
+		all_constraints[constraint_index]->setup(delta);
+	}
 }
 
 void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const {
@@ -158,6 +162,88 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	}
 }
 
+void GodotStep3D::_build_island_batches(uint32_t p_island_count) {
+	island_batches.clear();
+
+	uint32_t total_constraint_count = all_constraints.size();
+	if (p_island_count < 2 || total_constraint_count < ISLAND_BATCH_MIN_CONSTRAINT_COUNT) {
+		return; // Not worth the extra tasks.
+	}
+
+	// Islands are pushed to `all_constraints` in order, so each batch covers a contiguous range of it.
+	uint32_t batch_constraint_count = total_constraint_count / ISLAND_BATCH_COUNT;
+	IslandBatch batch;
+	for (uint32_t island_index = 0; island_index < p_island_count; ++island_index) {
+		batch.island_end = island_index + 1;
+		batch.constraint_end += constraint_islands[island_index].size();
+		if (batch.constraint_end - batch.constraint_begin >= batch_constraint_count) {
+			island_batches.push_back(batch);
+			batch.island_begin = batch.island_end;
+			batch.constraint_begin = batch.constraint_end;
+		}
+	}
+	if (batch.island_end > batch.island_begin) {
+		island_batches.push_back(batch);
+	}
+}
+
+void GodotStep3D::_setup_island_batch(uint32_t p_chunk_index, uint32_t p_batch_index) {
+	const IslandBatch &batch = island_batches[p_batch_index];
+	uint32_t from = batch.constraint_begin + p_chunk_index * SETUP_CONSTRAINTS_GRAIN;
+	_setup_constraints(from, MIN(from + SETUP_CONSTRAINTS_GRAIN, batch.constraint_end), 0);
+}
+
+void GodotStep3D::_pre_solve_island_batch(uint32_t p_batch_index) {
+	const IslandBatch &batch = island_batches[p_batch_index];
+	for (uint32_t island_index = batch.island_begin; island_index < batch.island_end; ++island_index) {
+		_pre_solve_island(constraint_islands[island_index]);
+	}
+}
+
+void GodotStep3D::_solve_island_batch(uint32_t p_index, uint32_t p_batch_index) {
+	_solve_island(island_batches[p_batch_index].island_begin + p_index);
+}
+
+void GodotStep3D::_process_island_batches() {
+	// Each batch is set up in parallel, then pre-solved on a single task chained to the pre-solve of the
+	// previous batch, then solved in parallel. Pre-solving still never runs concurrently, but it overlaps
+	// the setup of later batches and the solving of earlier ones.
+	// This is safe because islands never share a body that's written to: static bodies only connect islands
+	// and are never moved by constraints, and shared state like area queries is only touched when pre-solving.
+	WorkerThreadPool *wtp = WorkerThreadPool::get_singleton();
+	uint32_t batch_count = island_batches.size();
+	uint32_t max_tasks = MAX(1, wtp->get_thread_count());
+
+	island_batch_tasks.resize(batch_count * 3);
+	WorkerThreadPool::TaskID *setup_tasks = island_batch_tasks.ptr();
+	WorkerThreadPool::TaskID *pre_solve_tasks = setup_tasks + batch_count;
+	WorkerThreadPool::TaskID *solve_tasks = pre_solve_tasks + batch_count;
+
+	for (uint32_t batch_index = 0; batch_index < batch_count; ++batch_index) {
+		const IslandBatch &batch = island_batches[batch_index];
+
+		uint32_t chunk_count = Math::division_round_up(batch.constraint_end - batch.constraint_begin, (uint32_t)SETUP_CONSTRAINTS_GRAIN);
+		setup_tasks[batch_index] = wtp->add_template_group_task(this, &GodotStep3D::_setup_island_batch, batch_index, chunk_count, MIN(chunk_count, max_tasks), true, SNAME("Physics3DConstraintSetup"));
+
+		WorkerThreadPool::TaskID pre_solve_dependencies[2] = { setup_tasks[batch_index], batch_index > 0 ? pre_solve_tasks[batch_index - 1] : WorkerThreadPool::INVALID_TASK_ID };
+		pre_solve_tasks[batch_index] = wtp->add_template_task_with_dependencies(this, &GodotStep3D::_pre_solve_island_batch, batch_index, Span<WorkerThreadPool::TaskID>(pre_solve_dependencies, batch_index > 0 ? 2 : 1), true, SNAME("Physics3DConstraintPreSolveIslands"));
+
+		// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
+		// their content is not reliable after these calls and shouldn't be used anymore.
+		uint32_t island_count = batch.island_end - batch.island_begin;
+		solve_tasks[batch_index] = wtp->add_template_group_task_with_dependencies(this, &GodotStep3D::_solve_island_batch, batch_index, island_count, Span<WorkerThreadPool::TaskID>(&pre_solve_tasks[batch_index], 1), MIN(island_count, max_tasks), true, SNAME("Physics3DConstraintSolveIslands"));
+	}
+
+	// Everything else has finished by the time the solving does, so the rest of the waits only release the tasks.
+	for (uint32_t batch_index = 0; batch_index < batch_count; ++batch_index) {
+		wtp->wait_for_group_task_completion(solve_tasks[batch_index]);
+	}
+	for (uint32_t batch_index = 0; batch_index < batch_count; ++batch_index) {
+		wtp->wait_for_task_completion(pre_solve_tasks[batch_index]);
+		wtp->wait_for_group_task_completion(setup_tasks[batch_index]);
+	}
+}
+
 void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
 	bool can_sleep = true;
 
@@ -341,36 +427,51 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		profile_begtime = profile_endtime;
 	}
 
-	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
+	_build_island_batches(island_count);
 
-	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	if (island_batches.size() > 1) {
+		/* SETUP, PRE-SOLVE AND SOLVE CONSTRAINT ISLANDS IN BATCHES */
 
-	{ //profile
-		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS, profile_endtime - profile_begtime);
-		profile_begtime = profile_endtime;
-	}
+		_process_island_batches();
 
-	/* PRE-SOLVE CONSTRAINT ISLANDS */
+		{ //profile
+			// The phases overlap, so they're all accounted for as solving time.
+			profile_endtime = OS::get_singleton()->get_ticks_usec();
+			p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS, 0);
+			p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
+			profile_begtime = profile_endtime;
+		}
+	} else {
+		/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
-	// WARNING: This doesn't run on threads, because it involves thread-unsafe processing.
-	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
-		_pre_solve_island(constraint_islands[island_index]);
-	}
+		uint32_t total_constraint_count = all_constraints.size();
+		WorkerThreadPool::get_singleton()->parallel_for(this, &GodotStep3D::_setup_constraints, nullptr, 0, total_constraint_count, SETUP_CONSTRAINTS_GRAIN, true, SNAME("Physics3DConstraintSetup"));
 
-	/* SOLVE CONSTRAINT ISLANDS */
+		{ //profile
+			profile_endtime = OS::get_singleton()->get_ticks_usec();
+			p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS, profile_endtime - profile_begtime);
+			profile_begtime = profile_endtime;
+		}
 
-	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
-	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		/* PRE-SOLVE CONSTRAINT ISLANDS */
 
-	{ //profile
-		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
-		profile_begtime = profile_endtime;
+		// WARNING: This doesn't run on threads, because it involves thread-unsafe processing.
+		for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+			_pre_solve_island(constraint_islands[island_index]);
+		}
+
+		/* SOLVE CONSTRAINT ISLANDS */
+
+		// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
+		// their content is not reliable after these calls and shouldn't be used anymore.
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		{ //profile
+			profile_endtime = OS::get_singleton()->get_ticks_usec();
+			p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
+			profile_begtime = profile_endtime;
+		}
 	}
 
 	/* INTEGRATE VELOCITIES */
@@ -32,6 +32,7 @@
 
 #include "godot_space_3d.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/local_vector.h"
 
 class GodotStep3D {
@@ -44,11 +45,27 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
 
+	// A range of consecutive constraint islands, along with their range in `all_constraints`.
+	struct IslandBatch {
+		uint32_t island_begin = 0;
+		uint32_t island_end = 0;
+		uint32_t constraint_begin = 0;
+		uint32_t constraint_end = 0;
+	};
+
+	LocalVector<IslandBatch> island_batches;
+	LocalVector<WorkerThreadPool::TaskID> island_batch_tasks;
+
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
-	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
+	void _setup_constraints(uint32_t p_from, uint32_t p_to, uint32_t p_participant, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _build_island_batches(uint32_t p_island_count);
+	void _setup_island_batch(uint32_t p_chunk_index, uint32_t p_batch_index);
+	void _pre_solve_island_batch(uint32_t p_batch_index);
+	void _solve_island_batch(uint32_t p_index, uint32_t p_batch_index);
+	void _process_island_batches();
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
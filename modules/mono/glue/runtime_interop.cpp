@@ -1613,7 +1613,8 @@ int64_t godotsharp_packed_color_array_size(const PackedColorArray *p_self) {
 }
 
 int64_t godotsharp_array_size(const Array *p_self) {
-	return p_self->size();
+	// Managed code reads the elements directly after getting the size, so they must be boxed.
+	return p_self->span().size();
 }
 
 // The order in this array must match the declaration order of
@@ -110,22 +110,102 @@ void TextEdit::Text::set_inline_object_parser(const Callable &p_parser) {
 	invalidate_all();
 }
 
+uint32_t TextEdit::Text::_find_chunk(int p_line) const {
+	if (last_chunk < chunks.size()) {
+		const LineChunk *chunk = chunks[last_chunk];
+		if (p_line >= chunk->first_line && p_line < chunk->first_line + (int)chunk->lines.size()) {
+			return last_chunk;
+		}
+	}
+
+	uint32_t low = 0;
+	uint32_t high = chunks.size() - 1;
+	while (low < high) {
+		const uint32_t middle = (low + high + 1) / 2;
+		if (chunks[middle]->first_line <= p_line) {
+			low = middle;
+		} else {
+			high = middle - 1;
+		}
+	}
+	last_chunk = low;
+	return low;
+}
+
+TextEdit::Text::Line *TextEdit::Text::_get_line(int p_line) const {
+	const LineChunk *chunk = chunks[_find_chunk(p_line)];
+	return chunk->lines[p_line - chunk->first_line];
+}
+
+TextEdit::Text::Line *TextEdit::Text::_get_shaped_line(int p_line) const {
+	Line *line = _get_line(p_line);
+	if (line->shaping_dirty) {
+		_shape_line(p_line, true);
+	}
+	return line;
+}
+
+void TextEdit::Text::_split_chunk(uint32_t p_chunk) {
+	LineChunk *chunk = chunks[p_chunk];
+	const uint32_t chunk_size = chunk->lines.size();
+	if (chunk_size <= (uint32_t)LINE_CHUNK_SIZE) {
+		return;
+	}
+
+	// Leave room for later insertions in each new chunk.
+	const uint32_t split_size = LINE_CHUNK_SIZE / 2;
+	const uint32_t new_chunk_count = (chunk_size - 1) / split_size;
+
+	LocalVector<LineChunk *> new_chunks;
+	new_chunks.reserve(chunks.size() + new_chunk_count);
+	for (uint32_t i = 0; i <= p_chunk; i++) {
+		new_chunks.push_back(chunks[i]);
+	}
+	for (uint32_t from = split_size; from < chunk_size; from += split_size) {
+		LineChunk *new_chunk = memnew(LineChunk);
+		const uint32_t to = MIN(from + split_size, chunk_size);
+		new_chunk->lines.resize(to - from);
+		memcpy(new_chunk->lines.ptr(), chunk->lines.ptr() + from, (to - from) * sizeof(Line *));
+		new_chunks.push_back(new_chunk);
+	}
+	for (uint32_t i = p_chunk + 1; i < chunks.size(); i++) {
+		new_chunks.push_back(chunks[i]);
+	}
+	chunk->lines.resize(split_size);
+	chunks = new_chunks;
+}
+
+void TextEdit::Text::_update_chunk_lines(uint32_t p_from_chunk) {
+	int first_line = 0;
+	if (p_from_chunk > 0 && p_from_chunk <= chunks.size()) {
+		const LineChunk *previous = chunks[p_from_chunk - 1];
+		first_line = previous->first_line + previous->lines.size();
+	}
+	for (uint32_t i = p_from_chunk; i < chunks.size(); i++) {
+		chunks[i]->first_line = first_line;
+		first_line += chunks[i]->lines.size();
+	}
+}
+
 int TextEdit::Text::get_line_width(int p_line, int p_wrap_index) const {
-	ERR_FAIL_INDEX_V(p_line, text.size(), 0);
+	ERR_FAIL_INDEX_V(p_line, line_total, 0);
+	const Line *line = _get_shaped_line(p_line);
 	if (p_wrap_index != -1) {
-		return text[p_line].data_buf->get_line_width(p_wrap_index);
+		return line->data_buf->get_line_width(p_wrap_index);
 	}
-	return text[p_line].data_buf->get_size().x;
+	return line->data_buf->get_size().x;
 }
 
 int TextEdit::Text::get_max_width() const {
 	if (max_line_width_dirty) {
 		int new_max_line_width = 0;
-		for (const Line &l : text) {
-			if (l.hidden) {
-				continue;
+		for (const LineChunk *chunk : chunks) {
+			for (const Line *l : chunk->lines) {
+				if (l->hidden) {
+					continue;
+				}
+				new_max_line_width = MAX(new_max_line_width, l->width);
 			}
-			new_max_line_width = MAX(new_max_line_width, l.width);
 		}
 		max_line_width = new_max_line_width;
 	}
@@ -136,11 +216,13 @@ int TextEdit::Text::get_max_width() const {
 int TextEdit::Text::get_line_height() const {
 	if (max_line_height_dirty) {
 		int new_max_line_height = 0;
-		for (const Line &l : text) {
-			if (l.hidden) {
-				continue;
+		for (const LineChunk *chunk : chunks) {
+			for (const Line *l : chunk->lines) {
+				if (l->hidden) {
+					continue;
+				}
+				new_max_line_height = MAX(new_max_line_height, l->height);
 			}
-			new_max_line_height = MAX(new_max_line_height, l.height);
 		}
 		max_line_height = new_max_line_height;
 	}
@@ -165,16 +247,16 @@ BitField<TextServer::LineBreakFlag> TextEdit::Text::get_brk_flags() const {
 }
 
 int TextEdit::Text::get_line_wrap_amount(int p_line) const {
-	ERR_FAIL_INDEX_V(p_line, text.size(), 0);
+	ERR_FAIL_INDEX_V(p_line, line_total, 0);
 
-	return text[p_line].line_count - 1;
+	return _get_line(p_line)->line_count - 1;
 }
 
 Vector<Vector2i> TextEdit::Text::get_line_wrap_ranges(int p_line) const {
 	Vector<Vector2i> ret;
-	ERR_FAIL_INDEX_V(p_line, text.size(), ret);
+	ERR_FAIL_INDEX_V(p_line, line_total, ret);
 
-	Ref<TextParagraph> data_buf = text[p_line].data_buf;
+	Ref<TextParagraph> data_buf = _get_shaped_line(p_line)->data_buf;
 	int line_count = data_buf->get_line_count();
 	for (int i = 0; i < line_count; i++) {
 		ret.push_back(data_buf->get_line_range(i));
@@ -183,13 +265,13 @@ Vector<Vector2i> TextEdit::Text::get_line_wrap_ranges(int p_line) const {
 }
 
 const Ref<TextParagraph> TextEdit::Text::get_line_data(int p_line) const {
-	ERR_FAIL_INDEX_V(p_line, text.size(), Ref<TextParagraph>());
-	return text[p_line].data_buf;
+	ERR_FAIL_INDEX_V(p_line, line_total, Ref<TextParagraph>());
+	return _get_shaped_line(p_line)->data_buf;
 }
 
 float TextEdit::Text::get_indent_offset(int p_line, bool p_rtl) const {
-	ERR_FAIL_INDEX_V(p_line, text.size(), 0);
-	Line &text_line = text.write[p_line];
+	ERR_FAIL_INDEX_V(p_line, line_total, 0);
+	Line &text_line = *_get_shaped_line(p_line);
 	if (text_line.indent_ofs < 0.0) {
 		int char_count = 0;
 		int line_length = text_line.data.size();
@@ -219,31 +301,32 @@ float TextEdit::Text::get_indent_offset(int p_line, bool p_rtl) const {
 
 _FORCE_INLINE_ const String &TextEdit::Text::operator[](int p_line) const {
 	static const String empty;
-	ERR_FAIL_INDEX_V(p_line, text.size(), empty);
-	return text[p_line].data;
+	ERR_FAIL_INDEX_V(p_line, line_total, empty);
+	return _get_line(p_line)->data;
 }
 
 _FORCE_INLINE_ const String &TextEdit::Text::get_text_with_ime(int p_line) const {
-	if (!text[p_line].ime_data.is_empty()) {
-		return text[p_line].ime_data;
+	const Line *line = _get_line(p_line);
+	if (!line->ime_data.is_empty()) {
+		return line->ime_data;
 	} else {
-		return text[p_line].data;
+		return line->data;
 	}
 }
 
 const Vector<RID> TextEdit::Text::get_accessibility_elements(int p_line) {
-	ERR_FAIL_INDEX_V(p_line, text.size(), Vector<RID>());
+	ERR_FAIL_INDEX_V(p_line, line_total, Vector<RID>());
 
-	return text[p_line].accessibility_text_root_element;
+	return _get_line(p_line)->accessibility_text_root_element;
 }
 
 void TextEdit::Text::update_accessibility(int p_line, RID p_root) {
-	ERR_FAIL_INDEX(p_line, text.size());
+	ERR_FAIL_INDEX(p_line, line_total);
 
-	Line &l = text.write[p_line];
+	Line &l = *_get_shaped_line(p_line);
 	if (l.accessibility_text_root_element.is_empty()) {
 		for (int i = 0; i < l.data_buf->get_line_count(); i++) {
-			bool is_last_line = (p_line == text.size() - 1) && (i == l.data_buf->get_line_count() - 1);
+			bool is_last_line = (p_line == line_total - 1) && (i == l.data_buf->get_line_count() - 1);
 			RID rid = DisplayServer::get_singleton()->accessibility_create_sub_text_edit_elements(p_root, l.data_buf->get_line_rid(i), max_line_height, p_line, is_last_line);
 			l.accessibility_text_root_element.push_back(rid);
 		}
@@ -262,9 +345,9 @@ inline bool is_inline_info_valid(const Variant &p_info) {
 }
 
 void TextEdit::Text::invalidate_cache(int p_line, bool p_text_changed) {
-	ERR_FAIL_INDEX(p_line, text.size());
+	ERR_FAIL_INDEX(p_line, line_total);
 
-	Line &l = text.write[p_line];
+	Line &l = *_get_line(p_line);
 	for (const RID rid : l.accessibility_text_root_element) {
 		if (rid.is_valid()) {
 			DisplayServer::get_singleton()->accessibility_free_element(rid);
@@ -272,11 +355,43 @@ void TextEdit::Text::invalidate_cache(int p_line, bool p_text_changed) {
 	}
 	l.accessibility_text_root_element.clear();
 
+	if (p_text_changed) {
+		l.shaping_dirty = true;
+	}
+
 	if (font.is_null()) {
 		return; // Not in tree?
 	}
 
-	Line &text_line = text.write[p_line];
+	if (_is_shaping_deferred()) {
+		// Shaped on first access, estimate the width from the column count until then.
+		l.shaping_dirty = true;
+		l.indent_ofs = -1.0;
+
+		const String &text_with_ime = (!l.ime_data.is_empty()) ? l.ime_data : l.data;
+		const char32_t *chars = text_with_ime.ptr();
+		int column_count = 0;
+		for (int i = 0; i < text_with_ime.length(); i++) {
+			column_count += (chars[i] == '\t') ? MAX(1, tab_size) : 1;
+		}
+		_update_line_metrics(l, 1, font_height, Math::ceil(column_count * font_space_width));
+		return;
+	}
+
+	_shape_line(p_line, p_text_changed || l.shaping_dirty);
+}
+
+void TextEdit::Text::_shape_line(int p_line, bool p_text_changed) const {
+	Line &text_line = *_get_line(p_line);
+	if (text_line.data_buf.is_null()) {
+		text_line.data_buf.instantiate();
+	}
+
+	if (font.is_null()) {
+		return; // Not in tree?
+	}
+	text_line.shaping_dirty = false;
+
 	if (p_text_changed) {
 		text_line.data_buf->clear();
 	}
@@ -352,50 +467,57 @@ void TextEdit::Text::invalidate_cache(int p_line, bool p_text_changed) {
 		text_line.data_buf->tab_align(tabs);
 	}
 
+	const int line_count = text_line.data_buf->get_line_count();
+	int height = font_height;
+	for (int i = 0; i < line_count; i++) {
+		height = MAX(height, text_line.data_buf->get_line_size(i).y);
+	}
+	_update_line_metrics(text_line, line_count, height, text_line.data_buf->get_size().x);
+}
+
+void TextEdit::Text::_update_line_metrics(Line &r_line, int p_line_count, int p_height, int p_width) const {
 	// Update wrap amount.
-	const int old_line_count = text_line.line_count;
-	text_line.line_count = text_line.data_buf->get_line_count();
-	if (!text_line.hidden && text_line.line_count != old_line_count) {
-		total_visible_line_count += text_line.line_count - old_line_count;
+	const int old_line_count = r_line.line_count;
+	r_line.line_count = p_line_count;
+	if (!r_line.hidden && r_line.line_count != old_line_count) {
+		total_visible_line_count += r_line.line_count - old_line_count;
 	}
 
 	// Update height.
-	const int old_height = text_line.height;
-	text_line.height = font_height;
-	for (int i = 0; i < text_line.line_count; i++) {
-		text_line.height = MAX(text_line.height, text_line.data_buf->get_line_size(i).y);
-	}
+	const int old_height = r_line.height;
+	r_line.height = p_height;
 
 	// If this line has shrunk, this may no longer be the tallest line.
-	if (!text_line.hidden) {
-		if (old_height == max_line_height && text_line.height < old_height) {
+	if (!r_line.hidden) {
+		if (old_height == max_line_height && r_line.height < old_height) {
 			max_line_height_dirty = true;
 		} else {
-			max_line_height = MAX(text_line.height, max_line_height);
+			max_line_height = MAX(r_line.height, max_line_height);
 		}
 	}
 
 	// Update width.
-	const int old_width = text_line.width;
-	text_line.width = get_line_width(p_line);
+	const int old_width = r_line.width;
+	r_line.width = p_width;
 
-	if (!text_line.hidden) {
+	if (!r_line.hidden) {
 		// If this line has shrunk, this may no longer be the longest line.
-		if (old_width == max_line_width && text_line.width < old_width) {
+		if (old_width == max_line_width && r_line.width < old_width) {
 			max_line_width_dirty = true;
 		} else {
-			max_line_width = MAX(text_line.width, max_line_width);
+			max_line_width = MAX(r_line.width, max_line_width);
 		}
 	}
 }
 
 void TextEdit::Text::invalidate_all_lines() {
-	for (int i = 0; i < text.size(); i++) {
+	for (int i = 0; i < line_total; i++) {
 		if (tab_size_dirty) {
-			if (tab_size > 0) {
+			Line *line = _get_line(i);
+			if (tab_size > 0 && !line->shaping_dirty) {
 				Vector<float> tabs;
 				tabs.push_back(MAX(1, (font->get_char_size(' ', font_size).width + font->get_spacing(TextServer::SPACING_SPACE)) * tab_size));
-				text[i].data_buf->tab_align(tabs);
+				line->data_buf->tab_align(tabs);
 			}
 		}
 		invalidate_cache(i, false);
@@ -413,9 +535,10 @@ void TextEdit::Text::invalidate_font() {
 
 	if (font.is_valid() && font_size > 0) {
 		font_height = font->get_height(font_size);
+		font_space_width = font->get_char_size(' ', font_size).width + font->get_spacing(TextServer::SPACING_SPACE);
 	}
 
-	for (int i = 0; i < text.size(); i++) {
+	for (int i = 0; i < line_total; i++) {
 		invalidate_cache(i, false);
 	}
 	is_dirty = false;
@@ -431,24 +554,35 @@ void TextEdit::Text::invalidate_all() {
 
 	if (font.is_valid() && font_size > 0) {
 		font_height = font->get_height(font_size);
+		font_space_width = font->get_char_size(' ', font_size).width + font->get_spacing(TextServer::SPACING_SPACE);
 	}
 
-	for (int i = 0; i < text.size(); i++) {
+	for (int i = 0; i < line_total; i++) {
 		invalidate_cache(i, true);
 	}
 	is_dirty = false;
 }
 
 void TextEdit::Text::clear() {
-	text.clear();
+	for (LineChunk *chunk : chunks) {
+		for (Line *line : chunk->lines) {
+			memdelete(line);
+		}
+		memdelete(chunk);
+	}
+	chunks.clear();
+	last_chunk = 0;
 
 	max_line_width_dirty = true;
 	max_line_height_dirty = true;
 	total_visible_line_count = 0;
 
-	Line line;
-	line.gutters.resize(gutter_count);
-	text.insert(0, line);
+	LineChunk *chunk = memnew(LineChunk);
+	Line *line = memnew(Line);
+	line->gutters.resize(gutter_count);
+	chunk->lines.push_back(line);
+	chunks.push_back(chunk);
+	line_total = 1;
 	invalidate_cache(0, true);
 }
 
@@ -457,27 +591,29 @@ int TextEdit::Text::get_total_visible_line_count() const {
 }
 
 void TextEdit::Text::set(int p_line, const String &p_text, const Array &p_bidi_override) {
-	ERR_FAIL_INDEX(p_line, text.size());
+	ERR_FAIL_INDEX(p_line, line_total);
 
-	text.write[p_line].data = p_text;
-	text.write[p_line].ime_data = String();
-	text.write[p_line].bidi_override = p_bidi_override;
-	text.write[p_line].ime_bidi_override.clear();
+	Line &text_line = *_get_line(p_line);
+	text_line.data = p_text;
+	text_line.ime_data = String();
+	text_line.bidi_override = p_bidi_override;
+	text_line.ime_bidi_override.clear();
 	invalidate_cache(p_line, true);
 }
 
 void TextEdit::Text::set_ime(int p_line, const String &p_text, const Array &p_bidi_override) {
-	ERR_FAIL_INDEX(p_line, text.size());
+	ERR_FAIL_INDEX(p_line, line_total);
 
-	text.write[p_line].ime_data = p_text;
-	text.write[p_line].ime_bidi_override = p_bidi_override;
+	Line &text_line = *_get_line(p_line);
+	text_line.ime_data = p_text;
+	text_line.ime_bidi_override = p_bidi_override;
 	invalidate_cache(p_line, true);
 }
 
 void TextEdit::Text::set_hidden(int p_line, bool p_hidden) {
-	ERR_FAIL_INDEX(p_line, text.size());
+	ERR_FAIL_INDEX(p_line, line_total);
 
-	Line &text_line = text.write[p_line];
+	Line &text_line = *_get_line(p_line);
 	if (text_line.hidden == p_hidden) {
 		return;
 	}
@@ -498,34 +634,43 @@ void TextEdit::Text::set_hidden(int p_line, bool p_hidden) {
 }
 
 bool TextEdit::Text::is_hidden(int p_line) const {
-	ERR_FAIL_INDEX_V(p_line, text.size(), true);
-	return text[p_line].hidden;
+	ERR_FAIL_INDEX_V(p_line, line_total, true);
+	return _get_line(p_line)->hidden;
 }
 
 void TextEdit::Text::insert(int p_at, const Vector<String> &p_text, const Vector<Array> &p_bidi_override) {
-	ERR_FAIL_INDEX(p_at, text.size() + 1);
+	ERR_FAIL_INDEX(p_at, line_total);
+	ERR_FAIL_COND(p_text.is_empty());
+
+	set(p_at, p_text[0], p_bidi_override[0]);
 
 	int new_line_count = p_text.size() - 1;
-	if (new_line_count > 0) {
-		text.resize(text.size() + new_line_count);
-		for (int i = (text.size() - 1); i > p_at; i--) {
-			if ((i - new_line_count) <= 0) {
-				break;
-			}
-			text.write[i] = text[i - new_line_count];
-		}
+	if (new_line_count <= 0) {
+		return;
 	}
 
-	for (int i = 0; i < p_text.size(); i++) {
-		if (i == 0) {
-			set(p_at + i, p_text[i], p_bidi_override[i]);
-			continue;
-		}
-		Line line;
-		line.gutters.resize(gutter_count);
-		line.data = p_text[i];
-		line.bidi_override = p_bidi_override[i];
-		text.write[p_at + i] = line;
+	// New lines go after p_at, in the chunk that holds it.
+	const uint32_t chunk_index = _find_chunk(p_at);
+	LineChunk *chunk = chunks[chunk_index];
+	const uint32_t offset = p_at - chunk->first_line + 1;
+	const uint32_t old_size = chunk->lines.size();
+	chunk->lines.resize(old_size + new_line_count);
+	Line **lines = chunk->lines.ptr();
+	memmove(lines + offset + new_line_count, lines + offset, (old_size - offset) * sizeof(Line *));
+
+	for (int i = 1; i < p_text.size(); i++) {
+		Line *line = memnew(Line);
+		line->gutters.resize(gutter_count);
+		line->data = p_text[i];
+		line->bidi_override = p_bidi_override[i];
+		lines[offset + i - 1] = line;
+	}
+	line_total += new_line_count;
+
+	_split_chunk(chunk_index);
+	_update_chunk_lines(chunk_index + 1);
+
+	for (int i = 1; i < p_text.size(); i++) {
 		invalidate_cache(p_at + i, true);
 	}
 }
@@ -536,7 +681,7 @@ void TextEdit::Text::remove_range(int p_from_line, int p_to_line) {
 	}
 
 	for (int i = p_from_line + 1; i <= p_to_line; i++) {
-		const Line &text_line = text[i];
+		const Line &text_line = *_get_line(i);
 		if (text_line.hidden) {
 			continue;
 		}
@@ -550,42 +695,100 @@ void TextEdit::Text::remove_range(int p_from_line, int p_to_line) {
 		total_visible_line_count -= text_line.line_count;
 	}
 
-	int diff = p_to_line - p_from_line;
-	for (int i = p_to_line + 1; i < text.size(); i++) {
-		text.write[i - diff] = text[i];
+	// The chunk holding p_from_line keeps at least that line, following chunks may be emptied.
+	const uint32_t from_chunk = _find_chunk(p_from_line);
+	const int remove_begin = p_from_line + 1;
+	const int remove_end = p_to_line + 1;
+	uint32_t chunk_index = from_chunk;
+	uint32_t kept_chunk_index = from_chunk;
+	for (; chunk_index < chunks.size(); chunk_index++) {
+		LineChunk *chunk = chunks[chunk_index];
+		if (chunk->first_line >= remove_end) {
+			break;
+		}
+
+		const int chunk_size = chunk->lines.size();
+		const int begin = MAX(remove_begin, chunk->first_line) - chunk->first_line;
+		const int end = MIN(remove_end, chunk->first_line + chunk_size) - chunk->first_line;
+		if (begin < end) {
+			Line **lines = chunk->lines.ptr();
+			for (int i = begin; i < end; i++) {
+				memdelete(lines[i]);
+			}
+			memmove(lines + begin, lines + end, (chunk_size - end) * sizeof(Line *));
+			chunk->lines.resize(chunk_size - (end - begin));
+		}
+
+		if (chunk->lines.is_empty()) {
+			memdelete(chunk);
+		} else {
+			chunks[kept_chunk_index++] = chunk;
+		}
+	}
+	if (kept_chunk_index < chunk_index) {
+		LineChunk **chunk_ptrs = chunks.ptr();
+		memmove(chunk_ptrs + kept_chunk_index, chunk_ptrs + chunk_index, (chunks.size() - chunk_index) * sizeof(LineChunk *));
+		chunks.resize(chunks.size() - (chunk_index - kept_chunk_index));
+	}
+
+	// Merge with the next chunk when both fit in one, so removals don't leave many small chunks.
+	if (from_chunk + 1 < chunks.size() && chunks[from_chunk]->lines.size() + chunks[from_chunk + 1]->lines.size() <= (uint32_t)LINE_CHUNK_SIZE) {
+		LineChunk *next = chunks[from_chunk + 1];
+		for (Line *line : next->lines) {
+			chunks[from_chunk]->lines.push_back(line);
+		}
+		memdelete(next);
+		chunks.remove_at(from_chunk + 1);
 	}
-	text.resize(text.size() - diff);
+
+	line_total -= p_to_line - p_from_line;
+	last_chunk = from_chunk;
+	_update_chunk_lines(from_chunk + 1);
 
 	ERR_FAIL_COND(total_visible_line_count < 0); // BUG
 }
 
+TextEdit::Text::~Text() {
+	for (LineChunk *chunk : chunks) {
+		for (Line *line : chunk->lines) {
+			memdelete(line);
+		}
+		memdelete(chunk);
+	}
+}
+
 void TextEdit::Text::add_gutter(int p_at) {
-	for (int i = 0; i < text.size(); i++) {
-		if (p_at < 0 || p_at > gutter_count) {
-			text.write[i].gutters.push_back(Gutter());
-		} else {
-			text.write[i].gutters.insert(p_at, Gutter());
+	for (LineChunk *chunk : chunks) {
+		for (Line *line : chunk->lines) {
+			if (p_at < 0 || p_at > gutter_count) {
+				line->gutters.push_back(Gutter());
+			} else {
+				line->gutters.insert(p_at, Gutter());
+			}
 		}
 	}
 	gutter_count++;
 }
 
 void TextEdit::Text::remove_gutter(int p_gutter) {
-	ERR_FAIL_INDEX(p_gutter, text.size());
+	ERR_FAIL_INDEX(p_gutter, line_total);
 
-	for (int i = 0; i < text.size(); i++) {
-		text.write[i].gutters.remove_at(p_gutter);
+	for (LineChunk *chunk : chunks) {
+		for (Line *line : chunk->lines) {
+			line->gutters.remove_at(p_gutter);
+		}
 	}
 	gutter_count--;
 }
 
 void TextEdit::Text::move_gutters(int p_from_line, int p_to_line) {
-	ERR_FAIL_INDEX(p_from_line, text.size());
-	ERR_FAIL_INDEX(p_to_line, text.size());
+	ERR_FAIL_INDEX(p_from_line, line_total);
+	ERR_FAIL_INDEX(p_to_line, line_total);
 
-	text.write[p_to_line].gutters = text[p_from_line].gutters;
-	text.write[p_from_line].gutters.clear();
-	text.write[p_from_line].gutters.resize(gutter_count);
+	Line *from_line = _get_line(p_from_line);
+	_get_line(p_to_line)->gutters = from_line->gutters;
+	from_line->gutters.clear();
+	from_line->gutters.resize(gutter_count);
 }
 
 void TextEdit::Text::set_use_default_word_separators(bool p_enabled) {
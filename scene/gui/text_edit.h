@@ -151,7 +151,8 @@ private:
 
 			String data;
 			Array bidi_override;
-			Ref<TextParagraph> data_buf;
+			Ref<TextParagraph> data_buf; // Created when the line is first shaped.
+			bool shaping_dirty = true;
 			Vector<RID> accessibility_text_root_element;
 
 			String ime_data;
@@ -163,20 +164,35 @@ private:
 			int height = 0;
 			int width = 0;
 			float indent_ofs = -1.0;
-
-			Line() {
-				data_buf.instantiate();
-			}
 		};
 
 	private:
+		// Lines are stored by pointer in chunks of bounded size, so inserting or removing lines
+		// only moves the pointers of one chunk. Each chunk knows the index of its first line,
+		// which is updated for the following chunks after an edit.
+		struct LineChunk {
+			int first_line = 0;
+			LocalVector<Line *> lines;
+		};
+
+		static constexpr int LINE_CHUNK_SIZE = 512;
+
+		// While wrapping is disabled, lines of documents longer than this are only shaped when
+		// first accessed (drawn, measured or navigated). Until then, their width is estimated
+		// from their column count.
+		static constexpr int DEFERRED_SHAPING_LINE_COUNT = 4096;
+
 		bool is_dirty = false;
 		bool tab_size_dirty = false;
 
-		mutable Vector<Line> text;
+		LocalVector<LineChunk *> chunks;
+		int line_total = 0;
+		mutable uint32_t last_chunk = 0;
+
 		Ref<Font> font;
 		int font_size = -1;
 		int font_height = 0;
+		float font_space_width = 0.0;
 
 		String language;
 		TextServer::Direction direction = TextServer::DIRECTION_AUTO;
@@ -198,6 +214,16 @@ private:
 		int gutter_count = 0;
 		bool indent_wrapped_lines = false;
 
+		uint32_t _find_chunk(int p_line) const;
+		Line *_get_line(int p_line) const;
+		Line *_get_shaped_line(int p_line) const;
+		void _split_chunk(uint32_t p_chunk);
+		void _update_chunk_lines(uint32_t p_from_chunk);
+
+		bool _is_shaping_deferred() const { return width <= 0 && line_total > DEFERRED_SHAPING_LINE_COUNT; }
+		void _shape_line(int p_line, bool p_text_changed) const;
+		void _update_line_metrics(Line &r_line, int p_line_count, int p_height, int p_width) const;
+
 	public:
 		void set_tab_size(int p_tab_size);
 		int get_tab_size() const;
@@ -235,8 +261,10 @@ private:
 		const Vector<RID> get_accessibility_elements(int p_line);
 		void update_accessibility(int p_line, RID p_root);
 		void clear_accessibility() {
-			for (int i = 0; i < text.size(); i++) {
-				text.write[i].accessibility_text_root_element.clear();
+			for (LineChunk *chunk : chunks) {
+				for (Line *line : chunk->lines) {
+					line->accessibility_text_root_element.clear();
+				}
 			}
 		}
 
@@ -250,7 +278,7 @@ private:
 		bool is_hidden(int p_line) const;
 		void insert(int p_at, const Vector<String> &p_text, const Vector<Array> &p_bidi_override);
 		void remove_range(int p_from_line, int p_to_line);
-		int size() const { return text.size(); }
+		int size() const { return line_total; }
 		void clear();
 
 		void invalidate_cache(int p_line, bool p_text_changed = false);
@@ -266,24 +294,29 @@ private:
 		void remove_gutter(int p_gutter);
 		void move_gutters(int p_from_line, int p_to_line);
 
-		void set_line_gutter_metadata(int p_line, int p_gutter, const Variant &p_metadata) { text.write[p_line].gutters.write[p_gutter].metadata = p_metadata; }
-		const Variant &get_line_gutter_metadata(int p_line, int p_gutter) const { return text[p_line].gutters[p_gutter].metadata; }
+		void set_line_gutter_metadata(int p_line, int p_gutter, const Variant &p_metadata) { _get_line(p_line)->gutters.write[p_gutter].metadata = p_metadata; }
+		const Variant &get_line_gutter_metadata(int p_line, int p_gutter) const { return _get_line(p_line)->gutters[p_gutter].metadata; }
 
-		void set_line_gutter_text(int p_line, int p_gutter, const String &p_text) { text.write[p_line].gutters.write[p_gutter].text = p_text; }
-		const String &get_line_gutter_text(int p_line, int p_gutter) const { return text[p_line].gutters[p_gutter].text; }
+		void set_line_gutter_text(int p_line, int p_gutter, const String &p_text) { _get_line(p_line)->gutters.write[p_gutter].text = p_text; }
+		const String &get_line_gutter_text(int p_line, int p_gutter) const { return _get_line(p_line)->gutters[p_gutter].text; }
 
-		void set_line_gutter_icon(int p_line, int p_gutter, const Ref<Texture2D> &p_icon) { text.write[p_line].gutters.write[p_gutter].icon = p_icon; }
-		const Ref<Texture2D> &get_line_gutter_icon(int p_line, int p_gutter) const { return text[p_line].gutters[p_gutter].icon; }
+		void set_line_gutter_icon(int p_line, int p_gutter, const Ref<Texture2D> &p_icon) { _get_line(p_line)->gutters.write[p_gutter].icon = p_icon; }
+		const Ref<Texture2D> &get_line_gutter_icon(int p_line, int p_gutter) const { return _get_line(p_line)->gutters[p_gutter].icon; }
 
-		void set_line_gutter_item_color(int p_line, int p_gutter, const Color &p_color) { text.write[p_line].gutters.write[p_gutter].color = p_color; }
-		const Color &get_line_gutter_item_color(int p_line, int p_gutter) const { return text[p_line].gutters[p_gutter].color; }
+		void set_line_gutter_item_color(int p_line, int p_gutter, const Color &p_color) { _get_line(p_line)->gutters.write[p_gutter].color = p_color; }
+		const Color &get_line_gutter_item_color(int p_line, int p_gutter) const { return _get_line(p_line)->gutters[p_gutter].color; }
 
-		void set_line_gutter_clickable(int p_line, int p_gutter, bool p_clickable) { text.write[p_line].gutters.write[p_gutter].clickable = p_clickable; }
-		bool is_line_gutter_clickable(int p_line, int p_gutter) const { return text[p_line].gutters[p_gutter].clickable; }
+		void set_line_gutter_clickable(int p_line, int p_gutter, bool p_clickable) { _get_line(p_line)->gutters.write[p_gutter].clickable = p_clickable; }
+		bool is_line_gutter_clickable(int p_line, int p_gutter) const { return _get_line(p_line)->gutters[p_gutter].clickable; }
 
 		/* Line style. */
-		void set_line_background_color(int p_line, const Color &p_color) { text.write[p_line].background_color = p_color; }
-		const Color get_line_background_color(int p_line) const { return text[p_line].background_color; }
+		void set_line_background_color(int p_line, const Color &p_color) { _get_line(p_line)->background_color = p_color; }
+		const Color get_line_background_color(int p_line) const { return _get_line(p_line)->background_color; }
+
+		Text() {}
+		Text(const Text &) = delete;
+		Text &operator=(const Text &) = delete;
+		~Text();
 	};
 
 	/* Text */
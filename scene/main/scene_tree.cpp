@@ -626,6 +626,7 @@ void SceneTree::iteration_prepare() {
 }
 
 bool SceneTree::physics_process(double p_time) {
+	MEMORY_TAG_SCOPE(SCENE);
 	current_frame++;
 
 	flush_transform_notifications();
@@ -675,6 +676,7 @@ void SceneTree::iteration_end() {
 }
 
 bool SceneTree::process(double p_time) {
+	MEMORY_TAG_SCOPE(SCENE);
 	// First pass of scene tree fixed timestep interpolation.
 	if (get_scene_tree_fti().is_enabled()) {
 		// Special, we need to ensure RenderingServer is up to date
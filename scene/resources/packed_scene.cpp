@@ -1719,7 +1719,7 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 			}
 			nd.groups.resize(r[idx++]);
 			for (int j = 0; j < nd.groups.size(); j++) {
-				nd.groups.write[j] = r[idx++];
+				nd.groups[j] = r[idx++];
 			}
 		}
 	}
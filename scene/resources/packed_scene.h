@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/io/resource.h"
+#include "core/templates/small_vector.h"
 #include "scene/main/node.h"
 
 class SceneState : public RefCounted {
@@ -67,7 +68,7 @@ class SceneState : public RefCounted {
 		};
 
 		Vector<Property> properties;
-		Vector<int> groups;
+		SmallVector<int, 2> groups; // Most nodes are in one or two groups at most, so this usually doesn't allocate.
 	};
 
 	struct DeferredNodePathProperties {
@@ -259,6 +259,7 @@ AudioDriver *AudioDriverManager::get_driver(int p_driver) {
 //////////////////////////////////////////////
 
 void AudioServer::_driver_process(int p_frames, int32_t *p_buffer) {
+	MEMORY_TAG_SCOPE(AUDIO);
 	mix_count++;
 	int todo = p_frames;
 
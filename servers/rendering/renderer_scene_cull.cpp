@@ -2805,13 +2805,15 @@ bool RendererSceneCull::_visibility_parent_check(const CullData &p_cull_data, co
 	return ((parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK) == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE) || (parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN);
 }
 
-void RendererSceneCull::_scene_cull_threaded(uint32_t p_thread, CullData *cull_data) {
-	uint32_t cull_total = cull_data->scenario->instance_data.size();
-	uint32_t total_threads = WorkerThreadPool::get_singleton()->get_thread_count();
-	uint32_t cull_from = p_thread * cull_total / total_threads;
-	uint32_t cull_to = (p_thread + 1 == total_threads) ? cull_total : ((p_thread + 1) * cull_total / total_threads);
-
-	_scene_cull(*cull_data, scene_cull_result_threads[p_thread], cull_from, cull_to);
+void RendererSceneCull::_scene_cull_threaded(uint32_t p_from, uint32_t p_to, uint32_t p_participant, CullData *cull_data) {
+	// Each partition covers a fixed instance range and owns its result buffer,
+	// so the output does not depend on which thread ends up culling it.
+	uint64_t total = cull_data->cull_to - cull_data->cull_from;
+	for (uint32_t i = p_from; i < p_to; i++) {
+		uint64_t from = cull_data->cull_from + i * total / cull_data->partition_count;
+		uint64_t to = cull_data->cull_from + (i + 1) * total / cull_data->partition_count;
+		_scene_cull(*cull_data, scene_cull_result_partitions[i], from, to);
+	}
 }
 
 void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cull_result, uint64_t p_from, uint64_t p_to) {
@@ -3334,15 +3336,30 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 
 		if (cull_to > thread_cull_threshold) {
 			//multiple threads
-			for (InstanceCullResult &thread : scene_cull_result_threads) {
-				thread.clear();
+			uint32_t max_partitions = WorkerThreadPool::get_singleton()->get_parallel_for_participant_count() * SCENE_CULL_PARTITIONS_PER_PARTICIPANT;
+			uint32_t partition_count = MIN(max_partitions, (uint32_t)((cull_to - cull_from + SCENE_CULL_GRAIN - 1) / SCENE_CULL_GRAIN));
+			if (scene_cull_result_partitions.size() < partition_count) {
+				// The pool may have grown since init, e.g. to run the pump task of a server.
+				uint32_t prev_size = scene_cull_result_partitions.size();
+				scene_cull_result_partitions.resize(partition_count);
+				for (uint32_t i = prev_size; i < partition_count; i++) {
+					scene_cull_result_partitions[i].init(&rid_cull_page_pool, &geometry_instance_cull_page_pool, &instance_cull_page_pool);
+				}
 			}
 
-			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_scene_cull_threaded, &cull_data, scene_cull_result_threads.size(), -1, true, SNAME("RenderCullInstances"));
-			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			for (uint32_t i = 0; i < partition_count; i++) {
+				scene_cull_result_partitions[i].clear();
+			}
+
+			cull_data.cull_from = cull_from;
+			cull_data.cull_to = cull_to;
+			cull_data.partition_count = partition_count;
+
+			WorkerThreadPool::get_singleton()->parallel_for(this, &RendererSceneCull::_scene_cull_threaded, &cull_data, 0, partition_count, 1, true, SNAME("RenderCullInstances"));
 
-			for (InstanceCullResult &thread : scene_cull_result_threads) {
-				scene_cull_result.append_from(thread);
+			// Merge in partition order, so results keep the same order as a single threaded cull.
+			for (uint32_t i = 0; i < partition_count; i++) {
+				scene_cull_result.append_from(scene_cull_result_partitions[i]);
 			}
 
 		} else {
@@ -4236,7 +4253,7 @@ void RendererSceneCull::update() {
 
 	uint32_t rid_count = scenario_owner.get_rid_count();
 	RID *rids = (RID *)alloca(sizeof(RID) * rid_count);
-	scenario_owner.fill_owned_buffer(rids);
+	rid_count = scenario_owner.fill_owned_buffer(rids, rid_count);
 	for (uint32_t i = 0; i < rid_count; i++) {
 		Scenario *s = scenario_owner.get_or_null(rids[i]);
 		s->indexers[Scenario::INDEXER_GEOMETRY].optimize_incremental(indexer_update_iterations);
@@ -4371,9 +4388,9 @@ RendererSceneCull::RendererSceneCull() {
 	}
 
 	scene_cull_result.init(&rid_cull_page_pool, &geometry_instance_cull_page_pool, &instance_cull_page_pool);
-	scene_cull_result_threads.resize(WorkerThreadPool::get_singleton()->get_thread_count());
-	for (InstanceCullResult &thread : scene_cull_result_threads) {
-		thread.init(&rid_cull_page_pool, &geometry_instance_cull_page_pool, &instance_cull_page_pool);
+	scene_cull_result_partitions.resize(WorkerThreadPool::get_singleton()->get_parallel_for_participant_count() * SCENE_CULL_PARTITIONS_PER_PARTICIPANT);
+	for (InstanceCullResult &partition : scene_cull_result_partitions) {
+		partition.init(&rid_cull_page_pool, &geometry_instance_cull_page_pool, &instance_cull_page_pool);
 	}
 
 	indexer_update_iterations = GLOBAL_GET("rendering/limits/spatial_indexer/update_iterations_per_frame");
@@ -4402,10 +4419,10 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 
 	scene_cull_result.reset();
-	for (InstanceCullResult &thread : scene_cull_result_threads) {
-		thread.reset();
+	for (InstanceCullResult &partition : scene_cull_result_partitions) {
+		partition.reset();
 	}
-	scene_cull_result_threads.clear();
+	scene_cull_result_partitions.clear();
 
 	if (dummy_occlusion_culling) {
 		memdelete(dummy_occlusion_culling);
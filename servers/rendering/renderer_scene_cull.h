@@ -56,7 +56,9 @@ public:
 		SDFGI_MAX_CASCADES = 8,
 		SDFGI_MAX_REGIONS_PER_CASCADE = 3,
 		MAX_INSTANCE_PAIRS = 32,
-		MAX_UPDATE_SHADOWS = 512
+		MAX_UPDATE_SHADOWS = 512,
+		SCENE_CULL_GRAIN = 64, // Minimum amount of instances culled at once by a thread.
+		SCENE_CULL_PARTITIONS_PER_PARTICIPANT = 4, // Lets idle threads steal work from slow ones.
 	};
 
 	uint64_t render_pass;
@@ -1000,7 +1002,7 @@ public:
 	};
 
 	InstanceCullResult scene_cull_result;
-	LocalVector<InstanceCullResult> scene_cull_result_threads;
+	LocalVector<InstanceCullResult> scene_cull_result_partitions;
 
 	RendererSceneRender::RenderShadowData render_shadow_data[MAX_UPDATE_SHADOWS];
 	uint32_t max_shadows_used = 0;
@@ -1144,9 +1146,12 @@ public:
 		const RendererSceneOcclusionCull::HZBuffer *occlusion_buffer;
 		const Projection *camera_matrix;
 		uint64_t visibility_viewport_mask;
+		uint64_t cull_from = 0;
+		uint64_t cull_to = 0;
+		uint32_t partition_count = 0;
 	};
 
-	void _scene_cull_threaded(uint32_t p_thread, CullData *cull_data);
+	void _scene_cull_threaded(uint32_t p_from, uint32_t p_to, uint32_t p_participant, CullData *cull_data);
 	void _scene_cull(CullData &cull_data, InstanceCullResult &cull_result, uint64_t p_from, uint64_t p_to);
 	static void _scene_particles_set_view_axis(RID p_particles, const Vector3 &p_axis, const Vector3 &p_up_axis);
 	_FORCE_INLINE_ bool _visibility_parent_check(const CullData &p_cull_data, const InstanceData &p_instance_data);
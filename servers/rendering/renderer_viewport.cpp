@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/math/transform_interpolator.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/os/frame_arena.h"
 #include "core/profiling/profiling.h"
 #include "renderer_canvas_cull.h"
 #include "renderer_scene_cull.h"
@@ -757,7 +758,8 @@ void RendererViewport::draw_viewports(bool p_swap_buffers) {
 		sorted_active_viewports_dirty = false;
 	}
 
-	HashMap<DisplayServer::WindowID, Vector<BlitToScreen>> blit_to_screen_list;
+	// Only needed until the end of this function, so it doesn't need the general allocator.
+	FrameHashMap<DisplayServer::WindowID, FrameLocalVector<BlitToScreen>> blit_to_screen_list;
 	//draw viewports
 	RENDER_TIMESTAMP("> Render Viewports");
 
@@ -875,12 +877,9 @@ void RendererViewport::draw_viewports(bool p_swap_buffers) {
 							RSG::rasterizer->gl_end_frame(p_swap_buffers);
 						}
 					} else if (blits.size() > 0) {
-						if (!blit_to_screen_list.has(vp->viewport_to_screen)) {
-							blit_to_screen_list[vp->viewport_to_screen] = Vector<BlitToScreen>();
-						}
-
+						FrameLocalVector<BlitToScreen> &screen_blits = blit_to_screen_list[vp->viewport_to_screen];
 						for (int b = 0; b < blits.size(); b++) {
-							blit_to_screen_list[vp->viewport_to_screen].push_back(blits[b]);
+							screen_blits.push_back(blits[b]);
 						}
 					}
 				}
@@ -908,11 +907,7 @@ void RendererViewport::draw_viewports(bool p_swap_buffers) {
 					RSG::rasterizer->blit_render_targets_to_screen(vp->viewport_to_screen, &blit, 1);
 					RSG::rasterizer->gl_end_frame(p_swap_buffers);
 				} else {
-					Vector<BlitToScreen> *blits = blit_to_screen_list.getptr(vp->viewport_to_screen);
-					if (blits == nullptr) {
-						blits = &blit_to_screen_list.insert(vp->viewport_to_screen, Vector<BlitToScreen>())->value;
-					}
-					blits->push_back(blit);
+					blit_to_screen_list[vp->viewport_to_screen].push_back(blit);
 				}
 			}
 		}
@@ -943,7 +938,7 @@ void RendererViewport::draw_viewports(bool p_swap_buffers) {
 
 	GodotProfileZoneGrouped(_profile_zone, "rasterizer->blit_render_targets_to_screen");
 	if (p_swap_buffers && !blit_to_screen_list.is_empty()) {
-		for (const KeyValue<int, Vector<BlitToScreen>> &E : blit_to_screen_list) {
+		for (const KeyValue<DisplayServer::WindowID, FrameLocalVector<BlitToScreen>> &E : blit_to_screen_list) {
 			RSG::rasterizer->blit_render_targets_to_screen(E.key, E.value.ptr(), E.value.size());
 		}
 	}
@@ -1593,7 +1588,7 @@ RID RendererViewport::viewport_find_from_screen_attachment(DisplayServer::Window
 	RID *rids = nullptr;
 	uint32_t rid_count = viewport_owner.get_rid_count();
 	rids = (RID *)alloca(sizeof(RID) * rid_count);
-	viewport_owner.fill_owned_buffer(rids);
+	rid_count = viewport_owner.fill_owned_buffer(rids, rid_count);
 	for (uint32_t i = 0; i < rid_count; i++) {
 		Viewport *viewport = viewport_owner.get_or_null(rids[i]);
 		if (viewport->viewport_to_screen == p_id) {
@@ -30,6 +30,7 @@
 
 #include "rendering_server_default.h"
 
+#include "core/config/project_settings.h"
 #include "core/os/os.h"
 #include "core/profiling/profiling.h"
 #include "renderer_canvas_cull.h"
@@ -67,6 +68,7 @@ void RenderingServerDefault::request_frame_drawn_callback(const Callable &p_call
 }
 
 void RenderingServerDefault::_draw(bool p_swap_buffers, double frame_step) {
+	MEMORY_TAG_SCOPE(RENDERING);
 	GodotProfileZoneGroupedFirst(_profile_zone, "rasterizer->begin_frame");
 	RSG::rasterizer->begin_frame(frame_step);
 
@@ -270,6 +272,7 @@ void RenderingServerDefault::init() {
 	if (create_thread) {
 		print_verbose("RenderingServerWrapMT: Starting render thread");
 		DisplayServer::get_singleton()->release_rendering_thread();
+		command_queue.set_lock_free_producers(GLOBAL_GET("threading/servers/lock_free_command_queue"));
 		WorkerThreadPool::TaskID tid = WorkerThreadPool::get_singleton()->add_task(callable_mp(this, &RenderingServerDefault::_thread_loop), true, "Rendering Server pump task", true);
 		command_queue.set_pump_task_id(tid);
 		command_queue.push(this, &RenderingServerDefault::_assign_mt_ids, tid);
@@ -406,6 +409,7 @@ void RenderingServerDefault::_thread_exit() {
 }
 
 void RenderingServerDefault::_thread_loop() {
+	MEMORY_TAG_SCOPE(RENDERING);
 	DisplayServer::get_singleton()->gl_window_make_current(DisplayServer::MAIN_WINDOW_ID); // Move GL to this thread.
 
 	while (!exit) {
@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/io/file_access.h"
+#include "core/os/os.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
@@ -248,6 +249,102 @@ TEST_CASE("[FileAccess] Get/Store floating point half precision values") {
 	}
 }
 
+TEST_CASE("[FileAccess] Compressed multi-block reads") {
+	const String file_path = TestUtils::get_temp_path("compressed_multi_block.bin");
+	// Spans several read-ahead windows, and ends with a partial block.
+	const int size = 3 * 1024 * 1024 + 123;
+	Vector<uint8_t> data;
+	data.resize(size);
+	uint8_t *w = data.ptrw();
+	for (int i = 0; i < size; i++) {
+		w[i] = uint8_t((i * 7) ^ (i >> 11));
+	}
+
+	{
+		Ref<FileAccess> fw = FileAccess::open_compressed(file_path, FileAccess::WRITE, FileAccess::COMPRESSION_ZSTD);
+		REQUIRE(fw.is_valid());
+		fw->store_buffer(data);
+	}
+
+	Ref<FileAccess> f = FileAccess::open_compressed(file_path, FileAccess::READ, FileAccess::COMPRESSION_ZSTD);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == (uint64_t)size);
+
+	SUBCASE("Sequential reads") {
+		Vector<uint8_t> read_back;
+		while (read_back.size() < size) {
+			// Odd-sized reads straddle block and read-ahead window boundaries.
+			const Vector<uint8_t> chunk = f->get_buffer(10007);
+			REQUIRE(chunk.size() > 0);
+			read_back.append_array(chunk);
+		}
+		CHECK(read_back == data);
+		CHECK(f->get_buffer(1).is_empty());
+		CHECK(f->eof_reached());
+	}
+
+	SUBCASE("Random access") {
+		const int positions[] = { size - 10, 5, 2 * 1024 * 1024 + 4095, 1024 * 1024, 4096, size - 1 };
+		for (const int position : positions) {
+			f->seek(position);
+			CHECK(f->get_position() == (uint64_t)position);
+			CHECK(f->get_8() == data[position]);
+		}
+
+		// Sequential reading resumes correctly after a seek.
+		f->seek(1024 * 1024 - 3);
+		const Vector<uint8_t> chunk = f->get_buffer(1024 * 1024);
+		CHECK(chunk == data.slice(1024 * 1024 - 3, 2 * 1024 * 1024 - 3));
+	}
+
+	f->close();
+	DirAccess::remove_file_or_error(file_path);
+}
+
+TEST_CASE_BENCHMARK("[FileAccess][Benchmark] Compressed read throughput") {
+	const String file_path = TestUtils::get_temp_path("compressed_read_benchmark.bin");
+	const String file_path_compressed = TestUtils::get_temp_path("compressed_read_benchmark.zst");
+	const int size = 256 * 1024 * 1024;
+	Vector<uint8_t> data;
+	data.resize(size);
+	uint8_t *w = data.ptrw();
+	for (int i = 0; i < size; i++) {
+		w[i] = uint8_t((i * 7) ^ (i >> 11) ^ (i >> 17));
+	}
+
+	{
+		Ref<FileAccess> fw = FileAccess::open(file_path, FileAccess::WRITE);
+		REQUIRE(fw.is_valid());
+		fw->store_buffer(data);
+	}
+	{
+		Ref<FileAccess> fw = FileAccess::open_compressed(file_path_compressed, FileAccess::WRITE, FileAccess::COMPRESSION_ZSTD);
+		REQUIRE(fw.is_valid());
+		fw->store_buffer(data);
+	}
+
+	Vector<uint8_t> read_back;
+	read_back.resize(size);
+	const double megabytes = double(size) / (1024 * 1024);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	f->get_buffer(read_back.ptrw(), size);
+	print_line(vformat("Uncompressed: %.1f MB/s.", megabytes / (double(OS::get_singleton()->get_ticks_usec() - begin) / 1000000.0)));
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	f = FileAccess::open_compressed(file_path_compressed, FileAccess::READ, FileAccess::COMPRESSION_ZSTD);
+	REQUIRE(f.is_valid());
+	f->get_buffer(read_back.ptrw(), size);
+	print_line(vformat("Compressed (zstd, parallel read-ahead): %.1f MB/s.", megabytes / (double(OS::get_singleton()->get_ticks_usec() - begin) / 1000000.0)));
+	CHECK(read_back == data);
+
+	f.unref();
+	DirAccess::remove_file_or_error(file_path);
+	DirAccess::remove_file_or_error(file_path_compressed);
+}
+
 TEST_CASE("[FileAccess] Cursor positioning") {
 	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("line_endings_lf.test.txt"), FileAccess::READ);
 	REQUIRE(f.is_valid());
@@ -295,4 +392,79 @@ TEST_CASE("[FileAccess] Cursor positioning") {
 	}
 }
 
+TEST_CASE("[FileAccess] Memory mapped reads") {
+	const String file_path = TestUtils::get_data_path("line_endings_lf.test.txt");
+	Ref<FileAccess> f_stdio = FileAccess::open(file_path, FileAccess::READ);
+	REQUIRE(f_stdio.is_valid());
+	const Vector<uint8_t> contents = f_stdio->get_buffer(f_stdio->get_length());
+
+	Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	f->seek(3);
+	// Files are only mapped on request.
+	CHECK(f->get_mapped_span().is_empty());
+	if (f->map() != OK) {
+		MESSAGE("Memory mapping is not supported by this platform's FileAccess, skipping.");
+		return;
+	}
+
+	const Span<uint8_t> mapped = f->get_mapped_span();
+	CHECK(mapped == contents.span());
+	// Mapping again keeps the existing mapping.
+	CHECK(f->map() == OK);
+	CHECK(f->get_mapped_span().ptr() == mapped.ptr());
+	CHECK(f->get_length() == (uint64_t)contents.size());
+	// Mapping preserves the cursor.
+	CHECK(f->get_position() == 3);
+	CHECK(f->get_8() == contents[3]);
+
+	f->seek_end(-2);
+	uint8_t tail[4] = {};
+	CHECK(f->get_buffer(tail, 4) == 2);
+	CHECK(tail[0] == contents[contents.size() - 2]);
+	CHECK(tail[1] == contents[contents.size() - 1]);
+	CHECK(f->eof_reached());
+	CHECK(f->get_error() == ERR_FILE_EOF);
+
+	f->seek(0);
+	CHECK_FALSE(f->eof_reached());
+	CHECK(f->get_buffer(contents.size()) == contents);
+	CHECK_FALSE(f->eof_reached());
+
+	f->seek_end(-(int64_t)contents.size() - 10); // Seeking to a position below 0 is ignored.
+	CHECK(f->get_position() == (uint64_t)contents.size());
+
+	f->close();
+	CHECK(f->get_mapped_span().is_empty());
+}
+
+TEST_CASE_BENCHMARK("[FileAccess][Benchmark] Memory mapped reads") {
+	const String file_path = TestUtils::get_temp_path("mapped_read_benchmark.bin");
+	const int values = 16 * 1024 * 1024;
+	{
+		Ref<FileAccess> fw = FileAccess::open(file_path, FileAccess::WRITE);
+		REQUIRE(fw.is_valid());
+		for (int i = 0; i < values; i++) {
+			fw->store_32(i);
+		}
+	}
+
+	for (int mapped = 0; mapped < 2; mapped++) {
+		Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		if (mapped) {
+			f->map();
+		}
+		uint64_t sum = 0;
+		for (int i = 0; i < values; i++) {
+			sum += f->get_32();
+		}
+		print_line(vformat("%s: read %d values in %d usec.", mapped ? "mmap" : "stdio", values, OS::get_singleton()->get_ticks_usec() - begin));
+		CHECK(sum == uint64_t(values) * (values - 1) / 2);
+	}
+
+	DirAccess::remove_file_or_error(file_path);
+}
+
 } // namespace TestFileAccess
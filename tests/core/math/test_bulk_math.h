@@ -0,0 +1,258 @@
+/**************************************************************************/
+/*  test_bulk_math.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/bulk_math.h"
+#include "core/math/random_number_generator.h"
+#include "core/math/transform_2d.h"
+#include "core/math/transform_3d.h"
+#include "core/os/os.h"
+#include "core/variant/variant.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBulkMath {
+
+// Enough elements to cover the vector loops and every possible scalar tail.
+constexpr int ELEMENT_COUNT = 53;
+
+template <typename T>
+Vector<T> random_floats(RandomNumberGenerator &p_rng, int p_count) {
+	Vector<T> ret;
+	ret.resize(p_count);
+	for (T &value : ret) {
+		value = p_rng.randf_range(-100, 100);
+	}
+	return ret;
+}
+
+TEST_CASE("[BulkMath] Element-wise operations match the scalar ones") {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(42);
+
+	const Vector<float> src = random_floats<float>(**rng, ELEMENT_COUNT * 4);
+	const Vector<float> to = random_floats<float>(**rng, ELEMENT_COUNT * 4);
+	const float multiplier[4] = { 2.0f, -0.5f, 0.0f, 3.25f };
+	const float addend[4] = { 1.0f, 7.5f, -3.0f, 0.0f };
+	const float min[4] = { -50.0f, 0.0f, -10.0f, 20.0f };
+	const float max[4] = { 50.0f, 100.0f, 10.0f, -20.0f }; // Inverted range on the last component.
+
+	for (int components = 1; components <= 4; components++) {
+		for (int count = 0; count <= ELEMENT_COUNT * components; count += components) {
+			Vector<float> dst;
+			dst.resize(count);
+
+			BulkMath::multiply_add(src.ptr(), dst.ptrw(), count, components, multiplier, addend);
+			for (int i = 0; i < count; i++) {
+				CHECK_EQ(dst[i], src[i] * multiplier[i % components] + addend[i % components]);
+			}
+
+			BulkMath::clamp(src.ptr(), dst.ptrw(), count, components, min, max);
+			for (int i = 0; i < count; i++) {
+				CHECK_EQ(dst[i], CLAMP(src[i], min[i % components], max[i % components]));
+			}
+
+			BulkMath::lerp(src.ptr(), to.ptr(), dst.ptrw(), count, 0.3f);
+			for (int i = 0; i < count; i++) {
+				CHECK_EQ(dst[i], Math::lerp(src[i], to[i], 0.3f));
+			}
+		}
+	}
+}
+
+TEST_CASE("[BulkMath] Reductions match the scalar ones") {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(7);
+
+	const Vector<float> src = random_floats<float>(**rng, ELEMENT_COUNT * 4);
+
+	for (int components = 1; components <= 4; components++) {
+		for (int count = components; count <= ELEMENT_COUNT * components; count += components) {
+			double expected_sum[4] = {};
+			float expected_min[4] = { INFINITY, INFINITY, INFINITY, INFINITY };
+			float expected_max[4] = { -INFINITY, -INFINITY, -INFINITY, -INFINITY };
+			for (int i = 0; i < count; i++) {
+				const int c = i % components;
+				expected_sum[c] += src[i];
+				expected_min[c] = MIN(expected_min[c], src[i]);
+				expected_max[c] = MAX(expected_max[c], src[i]);
+			}
+
+			float result[4];
+			BulkMath::sum(src.ptr(), count, components, result);
+			for (int c = 0; c < components; c++) {
+				// Lanes are added in a different order, so rounding may differ slightly.
+				CHECK(result[c] == doctest::Approx(expected_sum[c]).epsilon(0.0001));
+			}
+			BulkMath::min(src.ptr(), count, components, result);
+			for (int c = 0; c < components; c++) {
+				CHECK_EQ(result[c], expected_min[c]);
+			}
+			BulkMath::max(src.ptr(), count, components, result);
+			for (int c = 0; c < components; c++) {
+				CHECK_EQ(result[c], expected_max[c]);
+			}
+		}
+	}
+}
+
+TEST_CASE("[BulkMath] Array transforms match transforming each vector") {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(1234);
+
+	const Vector<real_t> values = random_floats<real_t>(**rng, ELEMENT_COUNT * 3);
+	const Transform3D transform_3d = Transform3D(Basis(Vector3(0.3, -1.2, 0.5).normalized(), 0.8).scaled(Vector3(1.5, 0.5, 2.0)), Vector3(10, -4, 2.5));
+	const Transform2D transform_2d = Transform2D(0.7, Size2(2.0, -0.5), 0.2, Vector2(-3, 8));
+
+	for (int count = 0; count <= ELEMENT_COUNT; count++) {
+		Vector<Vector3> points_3d;
+		Vector<Vector2> points_2d;
+		for (int i = 0; i < count; i++) {
+			points_3d.push_back(Vector3(values[i * 3], values[i * 3 + 1], values[i * 3 + 2]));
+			points_2d.push_back(Vector2(values[i * 3], values[i * 3 + 1]));
+		}
+
+		const Vector<Vector3> xformed_3d = transform_3d.xform(points_3d);
+		const Vector<Vector3> xformed_inv_3d = transform_3d.xform_inv(points_3d);
+		const Vector<Vector2> xformed_2d = transform_2d.xform(points_2d);
+		const Vector<Vector2> xformed_inv_2d = transform_2d.xform_inv(points_2d);
+		REQUIRE_EQ(xformed_3d.size(), count);
+		REQUIRE_EQ(xformed_inv_3d.size(), count);
+		REQUIRE_EQ(xformed_2d.size(), count);
+		REQUIRE_EQ(xformed_inv_2d.size(), count);
+		for (int i = 0; i < count; i++) {
+			CHECK(xformed_3d[i].is_equal_approx(transform_3d.xform(points_3d[i])));
+			CHECK(xformed_inv_3d[i].is_equal_approx(transform_3d.xform_inv(points_3d[i])));
+			CHECK(xformed_2d[i].is_equal_approx(transform_2d.xform(points_2d[i])));
+			CHECK(xformed_inv_2d[i].is_equal_approx(transform_2d.xform_inv(points_2d[i])));
+		}
+	}
+
+	// Transforming in place.
+	Vector<Vector3> points;
+	points.resize(ELEMENT_COUNT);
+	memcpy(points.ptrw(), values.ptr(), ELEMENT_COUNT * sizeof(Vector3));
+	const Vector<Vector3> expected = transform_3d.xform(points);
+	BulkMath::xform(transform_3d, points.ptr(), points.ptrw(), points.size());
+	CHECK(points == expected);
+}
+
+TEST_CASE("[BulkMath] Packed array methods") {
+	const PackedVector3Array vectors = { Vector3(1, -2, 3), Vector3(-4, 5, 0.5), Vector3(7, 8, -9) };
+	Variant array = vectors;
+	Variant ret = array.call("sum");
+	CHECK_EQ(ret, Variant(Vector3(4, 11, -5.5)));
+	ret = array.call("min");
+	CHECK_EQ(ret, Variant(Vector3(-4, -2, -9)));
+	ret = array.call("max");
+	CHECK_EQ(ret, Variant(Vector3(7, 8, 3)));
+
+	ret = array.call("multiply_add", Vector3(2, 1, 0), Vector3(1, 1, 1));
+	CHECK_EQ(ret, Variant(PackedVector3Array({ Vector3(3, -1, 1), Vector3(-7, 6, 1), Vector3(15, 9, 1) })));
+	ret = array.call("clamp", Vector3(0, 0, 0), Vector3(5, 5, 5));
+	CHECK_EQ(ret, Variant(PackedVector3Array({ Vector3(1, 0, 3), Vector3(0, 5, 0.5), Vector3(5, 5, 0) })));
+	ret = array.call("lerp", PackedVector3Array({ Vector3(), Vector3(), Vector3() }), 0.5);
+	CHECK_EQ(ret, Variant(PackedVector3Array({ Vector3(0.5, -1, 1.5), Vector3(-2, 2.5, 0.25), Vector3(3.5, 4, -4.5) })));
+
+	const PackedFloat32Array floats = { 0.5, -1.5, 4.0, 2.0, 8.0 };
+	CHECK_EQ(Variant(floats).call("sum"), Variant(13.0));
+	CHECK_EQ(Variant(floats).call("min"), Variant(-1.5));
+	CHECK_EQ(Variant(floats).call("max"), Variant(8.0));
+
+	const PackedColorArray colors = { Color(0.5, 0.25, 1, 1), Color(0.25, 0.5, 0, 0.5) };
+	CHECK_EQ(Variant(colors).call("sum"), Variant(Color(0.75, 0.75, 1, 1.5)));
+	CHECK_EQ(Variant(colors).call("multiply_add", Color(2, 2, 2, 1), Color(0, 0, 0, 0)), Variant(PackedColorArray({ Color(1, 0.5, 2, 1), Color(0.5, 1, 0, 0.5) })));
+
+	// Empty arrays.
+	CHECK_EQ(Variant(PackedVector2Array()).call("sum"), Variant(Vector2()));
+	CHECK_EQ(Variant(PackedVector2Array()).call("min"), Variant(Vector2()));
+	CHECK_EQ(Variant(PackedFloat32Array()).call("max"), Variant(0.0));
+
+	ERR_PRINT_OFF;
+	ret = array.call("lerp", PackedVector3Array({ Vector3() }), 0.5);
+	ERR_PRINT_ON;
+	CHECK_EQ(ret, Variant(PackedVector3Array()));
+}
+
+TEST_CASE_BENCHMARK("[BulkMath][Benchmark] Packed array math") {
+	const int element_count = 1000000;
+	const int iterations = 10;
+
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	const Vector<real_t> values = random_floats<real_t>(**rng, element_count * 3);
+	Vector<Vector3> points;
+	points.resize(element_count);
+	memcpy(points.ptrw(), values.ptr(), element_count * sizeof(Vector3));
+	const Transform3D transform = Transform3D(Basis(Vector3(0, 1, 0), 0.5), Vector3(1, 2, 3));
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		Vector<Vector3> ret;
+		ret.resize(element_count);
+		Vector3 *w = ret.ptrw();
+		for (int j = 0; j < element_count; j++) {
+			w[j] = transform.xform(points[j]);
+		}
+	}
+	const uint64_t xform_scalar = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		const Vector<Vector3> ret = transform.xform(points);
+	}
+	const uint64_t xform_bulk = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	Vector3 sum_scalar;
+	for (int i = 0; i < iterations; i++) {
+		sum_scalar = Vector3();
+		for (int j = 0; j < element_count; j++) {
+			sum_scalar += points[j];
+		}
+	}
+	const uint64_t sum_scalar_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	Vector3 sum_bulk;
+	for (int i = 0; i < iterations; i++) {
+		BulkMath::sum(&points[0].x, element_count * 3, 3, &sum_bulk.x);
+	}
+	const uint64_t sum_bulk_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	print_line(vformat("Transform3D * PackedVector3Array: %.2f ns/element per vector, %.2f ns/element bulk", xform_scalar * 1000.0 / (element_count * iterations), xform_bulk * 1000.0 / (element_count * iterations)));
+	print_line(vformat("PackedVector3Array.sum(): %.2f ns/element per vector (%s), %.2f ns/element bulk (%s)", sum_scalar_time * 1000.0 / (element_count * iterations), sum_scalar, sum_bulk_time * 1000.0 / (element_count * iterations), sum_bulk));
+}
+
+} // namespace TestBulkMath
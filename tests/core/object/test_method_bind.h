@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/object/class_db.h"
+#include "core/os/os.h"
 
 #include "tests/test_macros.h"
 
@@ -171,4 +172,122 @@ TEST_CASE("[MethodBind] check all method binds") {
 
 	memdelete(mbt);
 }
+
+// A bind that only implements the virtual ptrcall(), like extension binds do.
+class UnspecializedMethodBind : public MethodBind {
+public:
+	mutable int ptrcalls = 0;
+
+	static PtrCallFunc get_dispatch_func() { return &_ptrcall_dispatch; }
+
+	virtual Variant::Type _gen_argument_type(int p_arg) const override { return Variant::INT; }
+	virtual PropertyInfo _gen_argument_type_info(int p_arg) const override { return PropertyInfo(Variant::INT, String()); }
+#ifdef DEBUG_ENABLED
+	virtual GodotTypeInfo::Metadata get_argument_meta(int p_arg) const override { return GodotTypeInfo::METADATA_NONE; }
+#endif // DEBUG_ENABLED
+
+	virtual Variant call(Object *p_object, const Variant **p_args, int p_arg_count, Callable::CallError &r_error) const override { return Variant(); }
+	virtual void validated_call(Object *p_object, const Variant **p_args, Variant *r_ret) const override {}
+
+	virtual void ptrcall(Object *p_object, const void **p_args, void *r_ret) const override {
+		ptrcalls++;
+		*(int64_t *)r_ret = *(const int64_t *)p_args[0] * 2;
+	}
+};
+
+TEST_CASE("[MethodBind] Resolved ptrcall functions") {
+	MethodBindTester *mbt = memnew(MethodBindTester);
+	for (int i = 0; i < MethodBindTester::TEST_MAX; i++) {
+		mbt->test_valid[i] = false;
+	}
+
+	int64_t arg = 42;
+	const void *args[1] = { &arg };
+	int64_t ret = 0;
+
+	MethodBind *method = ClassDB::get_method(MethodBindTester::get_class_static(), "test_method_args");
+	REQUIRE(method);
+	mbt->test_num = 42;
+	method->get_ptrcall_func()(method, mbt, args, nullptr);
+	CHECK(mbt->test_valid[MethodBindTester::TEST_METHOD_ARGS]);
+
+	method = ClassDB::get_method(MethodBindTester::get_class_static(), "test_methodc");
+	REQUIRE(method);
+	method->get_ptrcall_func()(method, mbt, nullptr, nullptr);
+	CHECK(mbt->test_valid[MethodBindTester::TEST_METHODC]);
+
+	method = ClassDB::get_method(MethodBindTester::get_class_static(), "test_methodr_args");
+	REQUIRE(method);
+	method->get_ptrcall_func()(method, mbt, args, &ret);
+	CHECK(mbt->test_valid[MethodBindTester::TEST_METHODR_ARGS]);
+	CHECK_EQ(ret, 42);
+
+	arg = 7;
+	method = ClassDB::get_method(MethodBindTester::get_class_static(), "test_methodrc_args");
+	REQUIRE(method);
+	method->get_ptrcall_func()(method, mbt, args, &ret);
+	CHECK(mbt->test_valid[MethodBindTester::TEST_METHODRC_ARGS]);
+	CHECK_EQ(ret, 7);
+
+	// Binds that aren't specialized resolve to a function that calls ptrcall().
+	UnspecializedMethodBind unspecialized;
+	CHECK(unspecialized.get_ptrcall_func() == UnspecializedMethodBind::get_dispatch_func());
+	arg = 21;
+	int64_t virtual_ret = 0;
+	unspecialized.ptrcall(mbt, args, &virtual_ret);
+	unspecialized.get_ptrcall_func()(&unspecialized, mbt, args, &ret);
+	CHECK_EQ(unspecialized.ptrcalls, 2);
+	CHECK_EQ(ret, virtual_ret);
+	CHECK_EQ(ret, 42);
+
+	// Vararg binds can't be specialized either.
+	method = ClassDB::get_method(Object::get_class_static(), "emit_signal");
+	REQUIRE(method);
+	CHECK(method->is_vararg());
+	CHECK(method->get_ptrcall_func() == UnspecializedMethodBind::get_dispatch_func());
+
+	memdelete(mbt);
+}
+
+TEST_CASE_BENCHMARK("[MethodBind][Benchmark] ptrcall") {
+	const int iterations = 10000000;
+
+	MethodBindTester *mbt = memnew(MethodBindTester);
+	MethodBind *method = ClassDB::get_method(MethodBindTester::get_class_static(), "test_methodrc_args");
+	REQUIRE(method);
+
+	int64_t arg = 0;
+	const void *args[1] = { &arg };
+	int64_t ret = 0;
+	int64_t sum = 0;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations / 10; i++) {
+		Variant v = mbt->call(SNAME("test_methodrc_args"), i);
+		sum += (int64_t)v;
+	}
+	const uint64_t variant_call = (OS::get_singleton()->get_ticks_usec() - begin) * 10;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		arg = i;
+		method->ptrcall(mbt, args, &ret);
+		sum += ret;
+	}
+	const uint64_t virtual_ptrcall = OS::get_singleton()->get_ticks_usec() - begin;
+
+	const MethodBind::PtrCallFunc ptrcall_func = method->get_ptrcall_func();
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		arg = i;
+		ptrcall_func(method, mbt, args, &ret);
+		sum += ret;
+	}
+	const uint64_t direct_ptrcall = OS::get_singleton()->get_ticks_usec() - begin;
+
+	print_line(vformat("Object::call(): %.2f ns, ptrcall(): %.2f ns, resolved ptrcall function: %.2f ns (%d)",
+			variant_call * 1000.0 / iterations, virtual_ptrcall * 1000.0 / iterations, direct_ptrcall * 1000.0 / iterations, sum));
+
+	memdelete(mbt);
+}
 } // namespace TestMethodBind
@@ -32,7 +32,10 @@
 
 #include "core/object/class_db.h"
 #include "core/object/object.h"
+#include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
 
 #include "tests/test_macros.h"
 
@@ -702,4 +705,288 @@ TEST_CASE("[Object] RequiredResult") {
 	CHECK_EQ(ref, var);
 }
 
+static Variant cached_call(MethodCallCache &p_cache, Object *p_object, const StringName &p_method) {
+	MethodCallCache::Scope scope(p_cache);
+	Callable::CallError ce;
+	Variant ret = p_object->callp(p_method, nullptr, 0, ce);
+	CHECK_EQ(ce.error, Callable::CallError::CALL_OK);
+	return ret;
+}
+
+TEST_CASE("[Object] Method call cache") {
+	Object *object = memnew(Object);
+	Ref<RefCounted> ref_counted;
+	ref_counted.instantiate();
+
+	MethodCallCache cache;
+	CHECK_FALSE(cache.is_updated());
+	CHECK_EQ(cached_call(cache, object, "get_class"), Variant("Object"));
+	CHECK(cache.is_updated());
+	CHECK_EQ(cached_call(cache, ref_counted.ptr(), "get_class"), Variant("RefCounted"));
+
+	// A copy starts with the same entries, so calls that hit don't update it.
+	MethodCallCache copy = cache;
+	CHECK_FALSE(copy.is_updated());
+	CHECK_EQ(cached_call(copy, object, "get_class"), Variant("Object"));
+	CHECK_EQ(cached_call(copy, ref_counted.ptr(), "get_class"), Variant("RefCounted"));
+	CHECK_FALSE(copy.is_updated());
+
+	// Another method is resolved, evicting an entry.
+	CHECK_EQ(cached_call(copy, object, "get_instance_id"), Variant(object->get_instance_id()));
+	CHECK(copy.is_updated());
+
+	MethodCallCache invalidated = cache;
+	MethodCallCache::invalidate_all();
+	CHECK_EQ(cached_call(invalidated, object, "get_class"), Variant("Object"));
+	CHECK(invalidated.is_updated());
+
+	// Connections keep a cache for the method they call.
+	object->add_user_signal(MethodInfo("cache_test", PropertyInfo(Variant::STRING_NAME, "name"), PropertyInfo(Variant::INT, "value")));
+	object->connect("cache_test", Callable(object, "set_meta"));
+	for (int i = 0; i < 3; i++) {
+		object->emit_signal("cache_test", "cache_test_meta", i);
+		CHECK_EQ(object->get_meta("cache_test_meta"), Variant(i));
+	}
+
+	memdelete(object);
+}
+
+class SignalCounter : public Object {
+	GDCLASS(SignalCounter, Object);
+
+public:
+	int count = 0;
+	Object *emitter = nullptr;
+	Callable connect_on_emit;
+	Callable disconnect_on_emit;
+
+	void on_signal() {
+		count++;
+		if (connect_on_emit.is_valid()) {
+			emitter->connect("changed", connect_on_emit);
+			connect_on_emit = Callable();
+		}
+		if (disconnect_on_emit.is_valid()) {
+			emitter->disconnect("changed", disconnect_on_emit);
+			disconnect_on_emit = Callable();
+		}
+	}
+};
+
+TEST_CASE("[Object] Signal connections changed during emission") {
+	Object emitter;
+	emitter.add_user_signal(MethodInfo("changed"));
+	SignalCounter first;
+	SignalCounter second;
+	SignalCounter third;
+	SignalCounter one_shot;
+	first.emitter = &emitter;
+
+	emitter.connect("changed", callable_mp(&first, &SignalCounter::on_signal));
+	emitter.connect("changed", callable_mp(&second, &SignalCounter::on_signal));
+	emitter.connect("changed", callable_mp(&one_shot, &SignalCounter::on_signal), Object::CONNECT_ONE_SHOT);
+
+	// Connections made or removed by a callback take effect on the next emission.
+	first.connect_on_emit = callable_mp(&third, &SignalCounter::on_signal);
+	first.disconnect_on_emit = callable_mp(&second, &SignalCounter::on_signal);
+	emitter.emit_signal("changed");
+	CHECK_EQ(first.count, 1);
+	CHECK_EQ(second.count, 1);
+	CHECK_EQ(third.count, 0);
+	CHECK_EQ(one_shot.count, 1);
+	CHECK_FALSE(emitter.is_connected("changed", callable_mp(&second, &SignalCounter::on_signal)));
+	CHECK_FALSE(emitter.is_connected("changed", callable_mp(&one_shot, &SignalCounter::on_signal)));
+
+	emitter.emit_signal("changed");
+	emitter.emit_signal("changed");
+	CHECK_EQ(first.count, 3);
+	CHECK_EQ(second.count, 1);
+	CHECK_EQ(third.count, 2);
+	CHECK_EQ(one_shot.count, 1);
+
+	emitter.disconnect("changed", callable_mp(&first, &SignalCounter::on_signal));
+	emitter.emit_signal("changed");
+	CHECK_EQ(first.count, 3);
+	CHECK_EQ(third.count, 3);
+
+	// A user signal keeps its table entry without connections.
+	emitter.disconnect("changed", callable_mp(&third, &SignalCounter::on_signal));
+	CHECK(emitter.has_signal("changed"));
+	CHECK_FALSE(emitter.has_connections("changed"));
+	CHECK_EQ(emitter.emit_signal("changed"), OK);
+}
+
+struct ObjectDBStressState {
+	LocalVector<Object *> live_objects;
+	LocalVector<ObjectID> live_ids;
+	LocalVector<ObjectID> freed_ids;
+	int lookups = 0;
+	SafeFlag stop;
+	SafeNumeric<uint32_t> churned;
+	SafeNumeric<uint32_t> wrong_lookups;
+
+	static void churn(void *p_userdata) {
+		ObjectDBStressState *state = static_cast<ObjectDBStressState *>(p_userdata);
+		LocalVector<Object *> objects;
+		while (!state->stop.is_set()) {
+			for (int i = 0; i < 64; i++) {
+				objects.push_back(memnew(Object));
+			}
+			// Free in a different order than created, so slots are reused out of order.
+			for (uint32_t i = 0; i < objects.size(); i += 2) {
+				memdelete(objects[i]);
+			}
+			for (uint32_t i = 1; i < objects.size(); i += 2) {
+				memdelete(objects[i]);
+			}
+			state->churned.add(objects.size());
+			objects.clear();
+		}
+	}
+
+	static void lookup(void *p_userdata) {
+		ObjectDBStressState *state = static_cast<ObjectDBStressState *>(p_userdata);
+		uint32_t wrong = 0;
+		for (int i = 0; i < state->lookups; i++) {
+			const uint32_t index = i % state->live_ids.size();
+			wrong += ObjectDB::get_instance(state->live_ids[index]) != state->live_objects[index];
+			wrong += ObjectDB::get_instance(state->freed_ids[index]) != nullptr;
+		}
+		state->wrong_lookups.add(wrong);
+	}
+};
+
+static void run_objectdb_stress(ObjectDBStressState &r_state, int p_object_count, int p_lookup_threads, bool p_churn) {
+	for (int i = 0; i < p_object_count; i++) {
+		Object *object = memnew(Object);
+		r_state.live_objects.push_back(object);
+		r_state.live_ids.push_back(object->get_instance_id());
+		Object *freed = memnew(Object);
+		r_state.freed_ids.push_back(freed->get_instance_id());
+		memdelete(freed);
+	}
+
+	Thread churn_thread;
+	if (p_churn) {
+		churn_thread.start(&ObjectDBStressState::churn, &r_state);
+	}
+	LocalVector<Thread> lookup_threads;
+	lookup_threads.resize(p_lookup_threads);
+	for (Thread &thread : lookup_threads) {
+		thread.start(&ObjectDBStressState::lookup, &r_state);
+	}
+	for (Thread &thread : lookup_threads) {
+		thread.wait_to_finish();
+	}
+	r_state.stop.set();
+	if (p_churn) {
+		churn_thread.wait_to_finish();
+	}
+
+	for (Object *object : r_state.live_objects) {
+		memdelete(object);
+	}
+}
+
+TEST_CASE("[Object] ObjectDB lookups while other threads create and free objects") {
+	ObjectDBStressState state;
+	state.lookups = 200000;
+	run_objectdb_stress(state, 1000, 3, true);
+
+	CHECK_EQ(state.wrong_lookups.get(), 0u);
+	for (const ObjectID &id : state.live_ids) {
+		CHECK(ObjectDB::get_instance(id) == nullptr);
+	}
+	CHECK(ObjectDB::get_instance(ObjectID()) == nullptr);
+}
+
+TEST_CASE_BENCHMARK("[Object][Benchmark] ObjectDB lookups") {
+	const int lookups = 5000000;
+	const int thread_counts[] = { 1, 4 };
+
+	for (int thread_count : thread_counts) {
+		for (int churn = 0; churn < 2; churn++) {
+			ObjectDBStressState state;
+			state.lookups = lookups;
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			run_objectdb_stress(state, 10000, thread_count, churn);
+			const uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+
+			CHECK_EQ(state.wrong_lookups.get(), 0u);
+			print_line(vformat("%d lookup threads%s: %.1f M lookups/s, %d objects created and freed meanwhile",
+					thread_count, churn ? " with churn" : "", lookups * 2.0 * thread_count / elapsed, state.churned.get()));
+		}
+	}
+}
+
+TEST_CASE_BENCHMARK("[Object][Benchmark] Dynamic dispatch") {
+	const int iterations = 1000000;
+	Object *object = memnew(Object);
+	const StringName method = "get_instance_id";
+	Callable::CallError ce;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		object->callp(method, nullptr, 0, ce);
+	}
+	uint64_t uncached = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MethodCallCache cache;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		MethodCallCache::Scope scope(cache);
+		object->callp(method, nullptr, 0, ce);
+	}
+	uint64_t cached = OS::get_singleton()->get_ticks_usec() - begin;
+
+	Callable callable(object, method);
+	Variant ret;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		callable.callp(nullptr, 0, ret, ce);
+	}
+	uint64_t callable_call = OS::get_singleton()->get_ticks_usec() - begin;
+
+	object->add_user_signal(MethodInfo("benchmark"));
+	object->connect("benchmark", callable);
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		object->emit_signalp("benchmark", nullptr, 0);
+	}
+	uint64_t emit = OS::get_singleton()->get_ticks_usec() - begin;
+
+	print_line(vformat("callp %.1f ns, callp with cache %.1f ns, Callable::callp %.1f ns, emit_signal with one connection %.1f ns",
+			uncached * 1000.0 / iterations, cached * 1000.0 / iterations, callable_call * 1000.0 / iterations, emit * 1000.0 / iterations));
+	memdelete(object);
+}
+
+TEST_CASE_BENCHMARK("[Object][Benchmark] Signal emission") {
+	const int iterations = 200000;
+	const int connection_counts[] = { 0, 1, 8, 64 };
+	Object emitter;
+	emitter.add_user_signal(MethodInfo("benchmark"));
+	LocalVector<SignalCounter *> counters;
+
+	for (int connection_count : connection_counts) {
+		while ((int)counters.size() < connection_count) {
+			SignalCounter *counter = memnew(SignalCounter);
+			emitter.connect("benchmark", callable_mp(counter, &SignalCounter::on_signal));
+			counters.push_back(counter);
+		}
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < iterations; i++) {
+			emitter.emit_signalp("benchmark", nullptr, 0);
+		}
+		uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+		print_line(vformat("%d connections: %.0f emits/s", connection_count, iterations * 1000000.0 / elapsed));
+	}
+
+	CHECK_EQ(counters[0]->count, iterations * 3);
+	CHECK_EQ(counters[63]->count, iterations);
+	for (SignalCounter *counter : counters) {
+		memdelete(counter);
+	}
+}
+
 } // namespace TestObject
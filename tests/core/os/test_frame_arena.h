@@ -0,0 +1,166 @@
+/**************************************************************************/
+/*  test_frame_arena.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/frame_arena.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFrameArena {
+
+TEST_CASE("[FrameArena] Allocations are aligned and rewound when freed.") {
+	uint8_t *a = (uint8_t *)FrameArena::alloc(3);
+	uint8_t *b = (uint8_t *)FrameArena::alloc(17);
+	CHECK(((uintptr_t)a % Memory::MAX_ALIGN) == 0);
+	CHECK(((uintptr_t)b % Memory::MAX_ALIGN) == 0);
+	CHECK(b > a);
+
+	// Freeing the most recent allocation gives its space back.
+	FrameArena::free(b);
+	uint8_t *c = (uint8_t *)FrameArena::alloc(17);
+	CHECK(c == b);
+
+	FrameArena::free(c);
+	FrameArena::free(a);
+
+	// With no live allocations, the arena starts over.
+	uint8_t *d = (uint8_t *)FrameArena::alloc(1);
+	CHECK(d == a);
+	FrameArena::free(d);
+}
+
+TEST_CASE("[FrameArena] Realloc grows the last allocation in place.") {
+	uint32_t *a = (uint32_t *)FrameArena::alloc(sizeof(uint32_t) * 4);
+	for (uint32_t i = 0; i < 4; i++) {
+		a[i] = i;
+	}
+	uint32_t *b = (uint32_t *)FrameArena::realloc(a, sizeof(uint32_t) * 4, sizeof(uint32_t) * 64);
+	CHECK(a == b);
+
+	uint32_t *c = (uint32_t *)FrameArena::alloc(8);
+	uint32_t *d = (uint32_t *)FrameArena::realloc(b, sizeof(uint32_t) * 64, sizeof(uint32_t) * 128);
+	CHECK(d != b);
+	for (uint32_t i = 0; i < 4; i++) {
+		CHECK(d[i] == i);
+	}
+
+	FrameArena::free(c);
+	FrameArena::free(d);
+}
+
+TEST_CASE("[FrameArena] Blocks are merged and high-water marks tracked.") {
+	const size_t block_size = FrameArena::get_block_size();
+	const uint64_t high_water_mark = FrameArena::get_thread_stats().high_water_mark;
+
+	// Force the arena over several blocks.
+	void *a = FrameArena::alloc(block_size / 2 + 1);
+	void *b = FrameArena::alloc(block_size / 2 + 1);
+	void *c = FrameArena::alloc(block_size * 2);
+	CHECK(FrameArena::get_thread_stats().capacity > block_size * 2);
+	CHECK(FrameArena::get_thread_stats().high_water_mark >= MAX(high_water_mark, (uint64_t)block_size * 3));
+
+	FrameArena::free(c);
+	FrameArena::free(b);
+	FrameArena::free(a);
+
+	// The same amount now fits in the single merged block.
+	const uint64_t capacity = FrameArena::get_thread_stats().capacity;
+	a = FrameArena::alloc(block_size / 2 + 1);
+	b = FrameArena::alloc(block_size / 2 + 1);
+	c = FrameArena::alloc(block_size * 2);
+	CHECK(FrameArena::get_thread_stats().capacity == capacity);
+	FrameArena::free(c);
+	FrameArena::free(b);
+	FrameArena::free(a);
+
+	FrameArena::advance_frame();
+	a = FrameArena::alloc(1);
+	CHECK(FrameArena::get_thread_stats().frame_high_water_mark >= block_size * 3);
+	FrameArena::free(a);
+}
+
+TEST_CASE("[FrameArena] The calling thread's arena is reset at frame boundaries.") {
+	// Start from a single block.
+	FrameArena::free(FrameArena::alloc(1));
+
+	void *a = FrameArena::alloc(16);
+	void *b = FrameArena::alloc(16);
+	FrameArena::free(a);
+
+	// `b` is still allocated, but must not outlive the frame.
+	ERR_PRINT_OFF;
+	FrameArena::advance_frame();
+	ERR_PRINT_ON;
+
+	void *c = FrameArena::alloc(16);
+	CHECK(c == a);
+	FrameArena::free(c);
+	CHECK(FrameArena::alloc(16) == a);
+	FrameArena::free(a);
+	(void)b;
+}
+
+TEST_CASE("[FrameArena] Containers.") {
+	{
+		FrameLocalVector<int> vector;
+		for (int i = 0; i < 1000; i++) {
+			vector.push_back(i);
+		}
+		CHECK(vector.size() == 1000);
+		CHECK(vector[999] == 999);
+
+		FrameHashMap<int, int> map;
+		for (int i = 0; i < 1000; i++) {
+			map.insert(i, i * 2);
+		}
+		CHECK(map.size() == 1000);
+		CHECK(map[500] == 1000);
+		map.erase(500);
+		CHECK_FALSE(map.has(500));
+	}
+
+	{
+		// Bucket arrays come from the arena as well, not only the elements.
+		FrameHashMap<int, int> map;
+		map.reserve(100000);
+		CHECK(FrameArena::get_thread_stats().capacity >= 100000 * (sizeof(uint32_t) + sizeof(void *)));
+	}
+
+	// Everything was freed, so the arena is reset.
+	void *a = FrameArena::alloc(1);
+	void *b = FrameArena::alloc(1);
+	FrameArena::free(b);
+	FrameArena::free(a);
+	CHECK(FrameArena::alloc(1) == a);
+	FrameArena::free(a);
+}
+
+} // namespace TestFrameArena
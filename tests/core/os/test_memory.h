@@ -0,0 +1,180 @@
+/**************************************************************************/
+/*  test_memory.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/memory.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMemory {
+
+#ifdef DEBUG_ENABLED
+static void *tagged_alloc(size_t p_bytes) {
+	MEMORY_TAG_SCOPE(PHYSICS);
+	return memalloc(p_bytes);
+}
+
+static void tagged_alloc_twice(void **r_first, void **r_second, size_t p_bytes) {
+	MEMORY_TAG_SCOPE(SCENE);
+	*r_first = memalloc(p_bytes);
+	*r_second = memalloc(p_bytes);
+}
+
+TEST_CASE("[Memory] Allocation tags") {
+	Memory::set_tag_tracking_enabled(true);
+	const uint64_t usage = Memory::get_tag_mem_usage(Memory::TAG_PHYSICS);
+
+	void *mem = tagged_alloc(1000);
+	CHECK_EQ(Memory::get_tag_mem_usage(Memory::TAG_PHYSICS), usage + 1000);
+	CHECK(Memory::get_tag_mem_max_usage(Memory::TAG_PHYSICS) >= usage + 1000);
+
+	// Reallocating and freeing outside of the scope keeps the original tag.
+	mem = memrealloc(mem, 3000);
+	CHECK_EQ(Memory::get_tag_mem_usage(Memory::TAG_PHYSICS), usage + 3000);
+	mem = memrealloc(mem, 500);
+	CHECK_EQ(Memory::get_tag_mem_usage(Memory::TAG_PHYSICS), usage + 500);
+	memfree(mem);
+	CHECK_EQ(Memory::get_tag_mem_usage(Memory::TAG_PHYSICS), usage);
+
+	{
+		MEMORY_TAG_SCOPE(PHYSICS);
+		{
+			// The innermost scope wins.
+			MEMORY_TAG_SCOPE(AUDIO);
+			const uint64_t audio_usage = Memory::get_tag_mem_usage(Memory::TAG_AUDIO);
+			mem = memalloc(100);
+			CHECK_EQ(Memory::get_tag_mem_usage(Memory::TAG_AUDIO), audio_usage + 100);
+			memfree(mem);
+		}
+		mem = memalloc(100);
+		CHECK_EQ(Memory::get_tag_mem_usage(Memory::TAG_PHYSICS), usage + 100);
+		memfree(mem);
+	}
+	Memory::set_tag_tracking_enabled(false);
+}
+
+TEST_CASE("[Memory] Allocation tags are only tracked while enabled") {
+	const uint64_t usage = Memory::get_tag_mem_usage(Memory::TAG_PHYSICS);
+
+	void *untracked = tagged_alloc(1000);
+	CHECK_EQ(Memory::get_tag_mem_usage(Memory::TAG_PHYSICS), usage);
+
+	Memory::set_tag_tracking_enabled(true);
+	void *tracked = tagged_alloc(1000);
+	CHECK_EQ(Memory::get_tag_mem_usage(Memory::TAG_PHYSICS), usage + 1000);
+
+	// Memory allocated while disabled is never charged, even once enabled.
+	untracked = memrealloc(untracked, 2000);
+	memfree(untracked);
+	CHECK_EQ(Memory::get_tag_mem_usage(Memory::TAG_PHYSICS), usage + 1000);
+
+	// Memory allocated while enabled is still released once disabled.
+	Memory::set_tag_tracking_enabled(false);
+	memfree(tracked);
+	CHECK_EQ(Memory::get_tag_mem_usage(Memory::TAG_PHYSICS), usage);
+}
+
+TEST_CASE("[Memory] Allocation sampling") {
+	const uint32_t interval = 1024;
+	Memory::clear_allocation_site_samples();
+	Memory::set_tag_tracking_enabled(true);
+	Memory::set_allocation_sampling_interval(interval);
+
+	void *mem[64];
+	for (int i = 0; i < 64; i++) {
+		mem[i] = tagged_alloc(interval);
+	}
+	Memory::set_allocation_sampling_interval(0);
+	Memory::set_tag_tracking_enabled(false);
+	for (int i = 0; i < 64; i++) {
+		memfree(mem[i]);
+	}
+
+	Memory::AllocationSiteSample samples[16];
+	uint32_t count = Memory::get_allocation_site_samples(samples, 16);
+	bool found = false;
+	for (uint32_t i = 0; i < count; i++) {
+		if (samples[i].site->tag == Memory::TAG_PHYSICS && String(samples[i].site->function) == "tagged_alloc") {
+			found = true;
+			// Every allocation is as big as the interval, so each one is sampled.
+			CHECK_EQ(samples[i].samples, 64u);
+			CHECK_EQ(samples[i].bytes, 64u * interval);
+		}
+		if (i > 0) {
+			CHECK(samples[i - 1].bytes >= samples[i].bytes);
+		}
+	}
+	CHECK(found);
+	Memory::clear_allocation_site_samples();
+}
+
+TEST_CASE("[Memory] Allocation sampling per caller") {
+	const uint32_t interval = 1024;
+	Memory::clear_allocation_site_samples();
+	Memory::set_tag_tracking_enabled(true);
+	Memory::set_allocation_sampling_interval(interval);
+
+	void *mem[32];
+	for (int i = 0; i < 32; i += 2) {
+		tagged_alloc_twice(&mem[i], &mem[i + 1], interval);
+	}
+	Memory::set_allocation_sampling_interval(0);
+	Memory::set_tag_tracking_enabled(false);
+	for (int i = 0; i < 32; i++) {
+		memfree(mem[i]);
+	}
+
+	Memory::AllocationSiteSample samples[64];
+	uint32_t count = Memory::get_allocation_site_samples(samples, 64);
+	LocalVector<const Memory::AllocationSiteSample *> found;
+	for (uint32_t i = 0; i < count; i++) {
+		if (samples[i].site->tag == Memory::TAG_SCENE && String(samples[i].site->function) == "tagged_alloc_twice") {
+			// Both allocations are in the same scope, but are made from different places.
+			CHECK_EQ(samples[i].samples, 16u);
+			found.push_back(&samples[i]);
+		}
+	}
+#if defined(__GNUC__) || defined(_MSC_VER)
+	REQUIRE_EQ(found.size(), 2u);
+	CHECK(found[0]->callers[0] != nullptr);
+	CHECK(found[0]->callers[0] != found[1]->callers[0]);
+#if defined(_MSC_VER) || !defined(WEB_ENABLED)
+	// The rest of the stack is the same for both.
+	CHECK(found[0]->callers[1] != nullptr);
+	CHECK_EQ(found[0]->callers[1], found[1]->callers[1]);
+#endif
+#endif
+	Memory::clear_allocation_site_samples();
+}
+#endif // DEBUG_ENABLED
+
+} // namespace TestMemory
@@ -0,0 +1,137 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#pragma once
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/string/string_name.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Creation from String") {
+	const StringName a = String("string_name_test");
+	const StringName b = String("string_name_test");
+	const StringName c = "string_name_test";
+	CHECK_EQ(a, b);
+	CHECK_EQ(a, c);
+	CHECK_EQ(a.data_unique_pointer(), c.data_unique_pointer());
+	CHECK_EQ(String(a), "string_name_test");
+	CHECK_NE(a, StringName("string_name_other"));
+	CHECK(StringName(String()).is_empty());
+}
+
+struct ConcurrentNames {
+	static const uint32_t NAME_COUNT = 512;
+	static const uint32_t THREAD_COUNT = 8;
+
+	Vector<String> strings;
+	StringName names[THREAD_COUNT][NAME_COUNT];
+
+	void create(uint32_t p_index, void *p_userdata) {
+		for (int pass = 0; pass < 16; pass++) {
+			for (uint32_t i = 0; i < NAME_COUNT; i++) {
+				// Temporaries are created and released while other threads look up the same names.
+				StringName temp = strings[i];
+				names[p_index][i] = temp;
+			}
+		}
+	}
+};
+
+TEST_CASE("[StringName] Concurrent creation") {
+	ConcurrentNames *data = memnew(ConcurrentNames);
+	for (uint32_t i = 0; i < ConcurrentNames::NAME_COUNT; i++) {
+		data->strings.push_back(vformat("concurrent_name_%d", i));
+	}
+
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(data, &ConcurrentNames::create, nullptr, ConcurrentNames::THREAD_COUNT, ConcurrentNames::THREAD_COUNT, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	bool all_equal = true;
+	for (uint32_t i = 0; i < ConcurrentNames::NAME_COUNT; i++) {
+		const StringName expected = data->strings[i];
+		for (uint32_t j = 0; j < ConcurrentNames::THREAD_COUNT; j++) {
+			all_equal = all_equal && data->names[j][i] == expected;
+		}
+	}
+	CHECK(all_equal);
+	memdelete(data);
+}
+
+struct NameBenchmark {
+	Vector<String> strings;
+	SafeNumeric<uint64_t> checksum;
+
+	void from_string(uint32_t p_index, void *p_userdata) {
+		uint64_t sum = 0;
+		for (int i = 0; i < strings.size(); i++) {
+			StringName name = strings[(i + p_index * 97) % strings.size()];
+			sum += name.hash();
+		}
+		checksum.add(sum);
+	}
+
+	void sname(uint32_t p_index, void *p_userdata) {
+		uint64_t sum = 0;
+		for (int i = 0; i < strings.size(); i++) {
+			sum += SNAME("benchmark_sname").hash();
+		}
+		checksum.add(sum);
+	}
+};
+
+TEST_CASE_BENCHMARK("[StringName][Benchmark] Multi-threaded creation") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	NameBenchmark bench;
+	for (int i = 0; i < 200000; i++) {
+		bench.strings.push_back(vformat("benchmark_name_%d", i % 20000));
+	}
+
+	for (uint32_t threads : { 1u, (uint32_t)pool->get_thread_count() }) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		WorkerThreadPool::GroupID group = pool->add_template_group_task(&bench, &NameBenchmark::from_string, nullptr, threads, threads, true);
+		pool->wait_for_group_task_completion(group);
+		uint64_t from_string = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		group = pool->add_template_group_task(&bench, &NameBenchmark::sname, nullptr, threads, threads, true);
+		pool->wait_for_group_task_completion(group);
+		uint64_t sname = OS::get_singleton()->get_ticks_usec() - begin;
+
+		const double ops = double(bench.strings.size()) * threads;
+		print_line(vformat("%d threads: StringName(String) %.1f ns/op, SNAME %.1f ns/op", threads, from_string * 1000.0 / ops, sname * 1000.0 / ops));
+	}
+}
+
+} // namespace TestStringName
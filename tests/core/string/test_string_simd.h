@@ -0,0 +1,163 @@
+/**************************************************************************/
+/*  test_string_simd.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/os.h"
+#include "core/string/string_simd.h"
+#include "core/string/ustring.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringSIMD {
+
+// Mixes long ASCII runs with multi-byte characters at every offset within a vector block.
+static String make_mixed_text(int p_length) {
+	const char32_t non_ascii[] = { U'é', U'Ж', U'語', U'😀', U'Ä' };
+	String text;
+	text.resize_uninitialized(p_length + 1);
+	char32_t *w = text.ptrw();
+	for (int i = 0; i < p_length; i++) {
+		if (i % 23 == 0 || i % 37 == 5) {
+			w[i] = non_ascii[i % 5];
+		} else {
+			w[i] = 'A' + (i * 7) % 58;
+		}
+	}
+	w[p_length] = 0;
+	return text;
+}
+
+TEST_CASE("[StringSIMD] Kernels") {
+	const String text = make_mixed_text(200);
+	const char32_t *chars = text.ptr();
+
+	CHECK_EQ(StringSIMD::ascii_prefix_length(chars, text.length()), 0);
+	CHECK_EQ(StringSIMD::ascii_prefix_length(chars + 1, text.length() - 1), 4);
+	CHECK_EQ(StringSIMD::find(chars, text.length(), U'😀'), 23);
+	CHECK_EQ(StringSIMD::find(chars, text.length(), U'?'), -1);
+
+	const uint8_t bytes[] = "Hello, world! This is more than sixteen bytes.\xC3\xA9";
+	CHECK_EQ(StringSIMD::ascii_prefix_length(bytes, sizeof(bytes)), 46);
+
+	char32_t wide[46];
+	StringSIMD::widen(bytes, wide, 46);
+	uint8_t narrow[46];
+	StringSIMD::narrow(wide, narrow, 46);
+	CHECK_EQ(memcmp(bytes, narrow, 46), 0);
+	CHECK_EQ(wide[45], U'.');
+}
+
+TEST_CASE("[StringSIMD] String operations on mixed text") {
+	for (int length : { 1, 7, 15, 16, 17, 64, 300 }) {
+		const String text = make_mixed_text(length);
+
+		// UTF-8 round trip, and the character length map.
+		Vector<uint8_t> length_map;
+		const CharString utf8 = text.utf8(&length_map);
+		CHECK_EQ(String::utf8(utf8.get_data(), utf8.length()), text);
+		int total = 0;
+		for (int i = 0; i < length_map.size(); i++) {
+			total += length_map[i];
+		}
+		CHECK_EQ(total, utf8.length());
+
+		// Case conversion agrees with the per character functions.
+		const String lower = text.to_lower();
+		const String upper = text.to_upper();
+		bool case_matches = lower.length() == length && upper.length() == length;
+		for (int i = 0; i < length; i++) {
+			case_matches = case_matches && lower[i] == String::char_lowercase(text[i]) && upper[i] == String::char_uppercase(text[i]);
+		}
+		CHECK(case_matches);
+
+		// The hash agrees with the one of the raw characters.
+		CHECK_EQ(text.hash(), String::hash(text.ptr(), length));
+		CHECK_EQ(text.hash(), String::hash(text.ptr()));
+	}
+
+	const String text = make_mixed_text(500);
+	const String key = text.substr(300, 9);
+	CHECK_EQ(text.find(key), 300);
+	CHECK_EQ(text.find(key, 301), -1);
+	CHECK_EQ(text.find("HOV"), 1);
+	CHECK_EQ(text.find_char(U'語'), 42);
+	CHECK_EQ(text.replace(key, "").length(), 491);
+	CHECK_EQ(text.split(key).size(), 2);
+}
+
+TEST_CASE_BENCHMARK("[StringSIMD][Benchmark] String throughput") {
+	const int length = 4 * 1024 * 1024;
+	const int iterations = 10;
+	const String text = make_mixed_text(length);
+	const CharString utf8 = text.utf8();
+	const double megabytes = double(length) * iterations / (1024 * 1024);
+
+	auto report = [megabytes](const char *p_name, uint64_t p_usec) {
+		print_line(vformat("%s: %.1f MB/s of characters.", p_name, megabytes / (double(p_usec) / 1000000.0)));
+	};
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		String decoded;
+		decoded.append_utf8(utf8.get_data(), utf8.length());
+	}
+	report("UTF-8 decoding", OS::get_singleton()->get_ticks_usec() - begin);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		const CharString encoded = text.utf8();
+	}
+	report("UTF-8 encoding", OS::get_singleton()->get_ticks_usec() - begin);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	int found = 0;
+	for (int i = 0; i < iterations; i++) {
+		found += text.find("not in the text");
+	}
+	report("Substring search", OS::get_singleton()->get_ticks_usec() - begin);
+	CHECK_EQ(found, -iterations);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		const String lower = text.to_lower();
+	}
+	report("Lower case", OS::get_singleton()->get_ticks_usec() - begin);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	uint32_t hash = 0;
+	for (int i = 0; i < iterations; i++) {
+		hash ^= text.hash();
+	}
+	report("Hashing", OS::get_singleton()->get_ticks_usec() - begin);
+	CHECK_EQ(hash, 0u);
+}
+
+} // namespace TestStringSIMD
@@ -518,4 +518,163 @@ TEST_CASE("[CommandQueue] Test Parameter Passing Semantics") {
 
 	sts.destroy_threads();
 }
+
+class LockFreeQueueState {
+public:
+	static const uint32_t MAX_PRODUCERS = 16;
+
+	CommandQueueMT command_queue;
+	SafeFlag exit_consumer;
+	Thread consumer_thread;
+	Thread producer_threads[MAX_PRODUCERS];
+	uint32_t producer_count = 0;
+	uint32_t commands_per_producer = 0;
+	SafeNumeric<uint32_t> next_producer;
+	bool use_sync = false;
+	bool flush_from_producers = false;
+
+	// Only touched by the thread flushing the queue.
+	uint32_t last_seq[MAX_PRODUCERS] = {};
+	uint32_t order_errors = 0;
+	uint32_t executed = 0;
+
+	void record(uint32_t p_producer, uint32_t p_seq) {
+		if (p_seq != last_seq[p_producer] + 1) {
+			order_errors++;
+		}
+		last_seq[p_producer] = p_seq;
+		executed++;
+	}
+
+	uint32_t record_ret(uint32_t p_producer, uint32_t p_seq) {
+		record(p_producer, p_seq);
+		return p_seq;
+	}
+
+	static void consumer_loop(void *p_userdata) {
+		LockFreeQueueState *state = static_cast<LockFreeQueueState *>(p_userdata);
+		while (!state->exit_consumer.is_set()) {
+			state->command_queue.flush_all();
+			Thread::yield();
+		}
+		state->command_queue.flush_all();
+	}
+
+	static void producer_loop(void *p_userdata) {
+		LockFreeQueueState *state = static_cast<LockFreeQueueState *>(p_userdata);
+		uint32_t producer = state->next_producer.postincrement();
+		for (uint32_t i = 1; i <= state->commands_per_producer; i++) {
+			if (state->use_sync && (i % 64) == 0) {
+				uint32_t ret = 0;
+				state->command_queue.push_and_ret(state, &LockFreeQueueState::record_ret, &ret, producer, i);
+				if (ret != i) {
+					// Reported through the consumer-side counters, which are checked after joining.
+					state->command_queue.push(state, &LockFreeQueueState::record, producer, 0u);
+				}
+			} else {
+				state->command_queue.push(state, &LockFreeQueueState::record, producer, i);
+			}
+			if (state->flush_from_producers && (i % 128) == 0) {
+				// Either flushes, or waits for the thread that is flushing to get to this point.
+				state->command_queue.flush_all();
+			}
+		}
+	}
+
+	void run(uint32_t p_producer_count, uint32_t p_commands_per_producer) {
+		producer_count = p_producer_count;
+		commands_per_producer = p_commands_per_producer;
+		consumer_thread.start(&LockFreeQueueState::consumer_loop, this);
+		for (uint32_t i = 0; i < producer_count; i++) {
+			producer_threads[i].start(&LockFreeQueueState::producer_loop, this);
+		}
+		for (uint32_t i = 0; i < producer_count; i++) {
+			producer_threads[i].wait_to_finish();
+		}
+		exit_consumer.set();
+		consumer_thread.wait_to_finish();
+	}
+};
+
+TEST_CASE("[CommandQueue] Lock-free producers keep submission order") {
+	CommandQueueMT command_queue;
+	command_queue.set_lock_free_producers(true);
+	CHECK(command_queue.is_using_lock_free_producers());
+
+	LocalVector<int> values;
+	struct Recorder {
+		LocalVector<int> *values = nullptr;
+		void record(int p_value) {
+			values->push_back(p_value);
+		}
+	} recorder;
+	recorder.values = &values;
+
+	// Enough commands to span several segments.
+	for (int i = 0; i < 10000; i++) {
+		command_queue.push(&recorder, &Recorder::record, i);
+	}
+	command_queue.flush_if_pending();
+
+	REQUIRE(values.size() == 10000);
+	bool in_order = true;
+	for (int i = 0; i < 10000; i++) {
+		in_order = in_order && values[i] == i;
+	}
+	CHECK_MESSAGE(in_order, "Commands should run in the order they were pushed.");
+
+	values.clear();
+	command_queue.push(&recorder, &Recorder::record, 1);
+	command_queue.flush_all();
+	command_queue.flush_if_pending();
+	CHECK(values.size() == 1);
+}
+
+TEST_CASE("[CommandQueue] Lock-free producers from multiple threads") {
+	SUBCASE("Push") {
+		LockFreeQueueState state;
+		state.command_queue.set_lock_free_producers(true);
+		state.run(8, 20000);
+
+		CHECK(state.executed == 8 * 20000);
+		CHECK_MESSAGE(state.order_errors == 0, "Commands of each producer should run in the order they were pushed.");
+	}
+
+	SUBCASE("Push with sync and return values") {
+		LockFreeQueueState state;
+		state.command_queue.set_lock_free_producers(true);
+		state.use_sync = true;
+		state.run(4, 4096);
+
+		CHECK(state.executed == 4 * 4096);
+		CHECK_MESSAGE(state.order_errors == 0, "Commands of each producer should run in the order they were pushed.");
+	}
+
+	SUBCASE("Push while other threads flush") {
+		LockFreeQueueState state;
+		state.command_queue.set_lock_free_producers(true);
+		state.flush_from_producers = true;
+		state.run(4, 16384);
+
+		CHECK(state.executed == 4 * 16384);
+		CHECK_MESSAGE(state.order_errors == 0, "Commands of each producer should run in the order they were pushed.");
+	}
+}
+
+TEST_CASE_BENCHMARK("[CommandQueue][Benchmark] Producer throughput") {
+	const uint32_t commands = 1 << 20;
+	for (uint32_t producers = 1; producers <= LockFreeQueueState::MAX_PRODUCERS; producers *= 2) {
+		for (int lock_free = 0; lock_free < 2; lock_free++) {
+			LockFreeQueueState state;
+			state.command_queue.set_lock_free_producers(lock_free);
+
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			state.run(producers, commands / producers);
+			uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, 1u);
+
+			CHECK(state.executed == commands);
+			print_line(vformat("%2d producers, %s: %.2f M commands/s", producers, lock_free ? "lock-free" : "locked   ", double(commands) / double(elapsed)));
+		}
+	}
+}
 } // namespace TestCommandQueue
@@ -0,0 +1,155 @@
+/**************************************************************************/
+/*  test_persistent_hash_map.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/hash_map.h"
+#include "core/templates/persistent_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPersistentHashMap {
+
+TEST_CASE("[PersistentHashMap] Insert, get and erase") {
+	PersistentHashMap<int, int> map;
+	CHECK(map.is_empty());
+	CHECK_EQ(map.begin(), map.end());
+
+	const int count = 10000;
+	for (int i = 0; i < count; i++) {
+		map.insert(i, i * 2);
+	}
+	CHECK_EQ(map.size(), (uint32_t)count);
+	map.insert(5, 50);
+	CHECK_EQ(map.size(), (uint32_t)count);
+	CHECK_EQ(map[5], 50);
+
+	bool all_found = true;
+	for (int i = 0; i < count; i++) {
+		all_found = all_found && map.has(i) && (i == 5 || map[i] == i * 2);
+	}
+	CHECK(all_found);
+	CHECK_FALSE(map.has(count));
+	CHECK_EQ(map.getptr(-1), nullptr);
+
+	CHECK(map.erase(5));
+	CHECK_FALSE(map.erase(5));
+	CHECK_FALSE(map.has(5));
+	CHECK_EQ(map.size(), (uint32_t)count - 1);
+
+	for (int i = 0; i < count; i += 2) {
+		map.erase(i);
+	}
+	CHECK_EQ(map.size(), (uint32_t)count / 2);
+	for (int i = 1; i < count; i += 2) {
+		all_found = all_found && map[i] == i * 2;
+	}
+	CHECK(all_found);
+}
+
+TEST_CASE("[PersistentHashMap] Iteration") {
+	PersistentHashMap<int, int> map;
+	HashMap<int, int> expected;
+	for (int i = 0; i < 3000; i++) {
+		map.insert(i * 7, i);
+		expected.insert(i * 7, i);
+	}
+
+	uint32_t visited = 0;
+	bool all_match = true;
+	for (const KeyValue<int, int> &E : map) {
+		const int *value = expected.getptr(E.key);
+		all_match = all_match && value && *value == E.value;
+		visited++;
+	}
+	CHECK(all_match);
+	CHECK_EQ(visited, map.size());
+}
+
+TEST_CASE("[PersistentHashMap] Copies are not affected by changes") {
+	PersistentHashMap<String, int> map;
+	for (int i = 0; i < 500; i++) {
+		map.insert(itos(i), i);
+	}
+
+	PersistentHashMap<String, int> snapshot = map;
+	CHECK(snapshot.is_same_storage(map));
+
+	map.insert("0", -1);
+	map.insert("new", 1);
+	map.erase("1");
+	CHECK_FALSE(snapshot.is_same_storage(map));
+	CHECK_EQ(map["0"], -1);
+	CHECK(map.has("new"));
+	CHECK_FALSE(map.has("1"));
+
+	CHECK_EQ(snapshot.size(), 500u);
+	CHECK_EQ(snapshot["0"], 0);
+	CHECK_FALSE(snapshot.has("new"));
+	CHECK_EQ(snapshot["1"], 1);
+
+	// Erasing a missing key keeps sharing everything.
+	PersistentHashMap<String, int> copy = snapshot;
+	CHECK_FALSE(copy.erase("missing"));
+	CHECK(copy.is_same_storage(snapshot));
+}
+
+struct CollidingHasher {
+	static uint32_t hash(int p_key) { return p_key % 3; }
+};
+
+TEST_CASE("[PersistentHashMap] Colliding hashes") {
+	PersistentHashMap<int, int, CollidingHasher> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(i, i);
+	}
+	PersistentHashMap<int, int, CollidingHasher> snapshot = map;
+	for (int i = 0; i < 100; i += 3) {
+		map.erase(i);
+	}
+
+	CHECK_EQ(map.size(), 66u);
+	CHECK_EQ(snapshot.size(), 100u);
+	bool all_match = true;
+	for (int i = 0; i < 100; i++) {
+		all_match = all_match && map.has(i) == (i % 3 != 0) && snapshot[i] == i;
+	}
+	CHECK(all_match);
+
+	uint32_t visited = 0;
+	for (const KeyValue<int, int> &E : map) {
+		all_match = all_match && E.key % 3 != 0;
+		visited++;
+	}
+	CHECK(all_match);
+	CHECK_EQ(visited, 66u);
+}
+
+} // namespace TestPersistentHashMap
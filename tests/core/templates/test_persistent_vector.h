@@ -0,0 +1,145 @@
+/**************************************************************************/
+/*  test_persistent_vector.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/persistent_vector.h"
+#include "core/templates/vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPersistentVector {
+
+TEST_CASE("[PersistentVector] Push back, get and pop back") {
+	PersistentVector<int> vector;
+	CHECK(vector.is_empty());
+
+	// Enough elements for a tree three levels deep.
+	const int count = 40000;
+	for (int i = 0; i < count; i++) {
+		vector.push_back(i);
+	}
+	CHECK_EQ(vector.size(), (uint32_t)count);
+	bool all_equal = true;
+	for (int i = 0; i < count; i++) {
+		all_equal = all_equal && vector[i] == i;
+	}
+	CHECK(all_equal);
+
+	int expected = 0;
+	for (int element : vector) {
+		all_equal = all_equal && element == expected++;
+	}
+	CHECK(all_equal);
+	CHECK_EQ(expected, count);
+
+	for (int i = count - 1; i >= 0; i--) {
+		all_equal = all_equal && vector[vector.size() - 1] == i;
+		vector.pop_back();
+	}
+	CHECK(all_equal);
+	CHECK(vector.is_empty());
+	CHECK_EQ(vector.begin(), vector.end());
+}
+
+TEST_CASE("[PersistentVector] Copies are not affected by changes") {
+	PersistentVector<int> vector;
+	for (int i = 0; i < 1000; i++) {
+		vector.push_back(i);
+	}
+
+	PersistentVector<int> snapshot = vector;
+	CHECK(snapshot.is_same_storage(vector));
+
+	vector.set(10, -10);
+	vector.set(999, -999);
+	vector.push_back(1000);
+	CHECK_FALSE(snapshot.is_same_storage(vector));
+	CHECK_EQ(vector[10], -10);
+	CHECK_EQ(vector[999], -999);
+	CHECK_EQ(vector.size(), 1001u);
+	CHECK_EQ(snapshot[10], 10);
+	CHECK_EQ(snapshot[999], 999);
+	CHECK_EQ(snapshot.size(), 1000u);
+
+	// Shrinking past shared blocks must not affect the snapshot either.
+	for (int i = 0; i < 600; i++) {
+		vector.pop_back();
+	}
+	vector.set(0, -1);
+	CHECK_EQ(vector.size(), 401u);
+	CHECK_EQ(vector[0], -1);
+	CHECK_EQ(snapshot[0], 0);
+	for (int i = 0; i < 1000; i++) {
+		if (snapshot[i] != i) {
+			FAIL("Snapshot changed at ", i);
+		}
+	}
+}
+
+TEST_CASE("[PersistentVector] Many versions") {
+	Vector<PersistentVector<int>> versions;
+	PersistentVector<int> vector;
+	for (int i = 0; i < 100; i++) {
+		for (int j = 0; j < 50; j++) {
+			vector.push_back(i);
+		}
+		vector.set(i, -i);
+		versions.push_back(vector);
+	}
+
+	for (int i = 0; i < 100; i++) {
+		const PersistentVector<int> &version = versions[i];
+		CHECK_EQ(version.size(), (uint32_t)(i + 1) * 50);
+		CHECK_EQ(version[i], -i);
+		CHECK_EQ(version[version.size() - 1], i);
+		if (i + 1 < 100) {
+			CHECK_EQ(version[i + 1], 0);
+		}
+	}
+}
+
+TEST_CASE("[PersistentVector] Strings") {
+	PersistentVector<String> vector = { "a", "b", "c" };
+	PersistentVector<String> copy = vector;
+	copy.set(1, "x");
+	copy.pop_back();
+	CHECK_EQ(vector.size(), 3u);
+	CHECK_EQ(vector[1], "b");
+	CHECK_EQ(vector[2], "c");
+	CHECK_EQ(copy.size(), 2u);
+	CHECK_EQ(copy[1], "x");
+
+	vector.clear();
+	CHECK(vector.is_empty());
+	CHECK_EQ(copy[0], "a");
+}
+
+} // namespace TestPersistentVector
@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
 #include "core/os/thread.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
@@ -115,6 +117,79 @@ TEST_CASE("[RID] 'get_local_index'") {
 	CHECK(RID::from_uint64(4'294'967'297).get_local_index() == 1);
 }
 
+template <bool THREAD_SAFE>
+static void test_batch_and_iteration() {
+	// Small chunks, so elements span several of them.
+	RID_Owner<int, THREAD_SAFE> owner(sizeof(int) * 16);
+
+	LocalVector<RID> rids = owner.make_rids(100);
+	REQUIRE_EQ(rids.size(), 100u);
+	CHECK_EQ(owner.get_rid_count(), 100u);
+	for (uint32_t i = 0; i < rids.size(); i++) {
+		int *value = owner.get_or_null(rids[i]);
+		REQUIRE(value);
+		*value = i;
+	}
+
+	// Free the even elements, some one by one and the others in a batch.
+	LocalVector<RID> batch;
+	for (uint32_t i = 0; i < rids.size(); i += 2) {
+		if (i % 4 == 0) {
+			owner.free(rids[i]);
+		} else {
+			batch.push_back(rids[i]);
+		}
+	}
+	owner.free_rids(batch);
+	CHECK_EQ(owner.get_rid_count(), 50u);
+	CHECK_FALSE(owner.owns(rids[0]));
+	CHECK_FALSE(owner.owns(rids[2]));
+	CHECK(owner.owns(rids[1]));
+
+	ERR_PRINT_OFF;
+	owner.free(rids[0]);
+	owner.free_rids(batch);
+	ERR_PRINT_ON;
+	CHECK_EQ(owner.get_rid_count(), 50u);
+
+	uint32_t visited = 0;
+	int sum = 0;
+	bool in_order = true;
+	bool valid = true;
+	uint32_t last_index = 0;
+	owner.for_each([&](const RID &p_rid, int *p_value) {
+		in_order = in_order && (visited == 0 || p_rid.get_local_index() > last_index);
+		valid = valid && owner.get_or_null(p_rid) == p_value;
+		last_index = p_rid.get_local_index();
+		sum += *p_value;
+		visited++;
+	});
+	CHECK_EQ(visited, 50u);
+	CHECK_EQ(sum, 2500);
+	CHECK(in_order);
+	CHECK(valid);
+
+	// Freed slots are reused.
+	RID rid = owner.make_rid(7);
+	CHECK_EQ(*owner.get_or_null(rid), 7);
+	CHECK_LT(rid.get_local_index(), 100u);
+	CHECK_EQ(owner.get_rid_count(), 51u);
+
+	LocalVector<RID> remaining = owner.get_owned_list();
+	CHECK_EQ(remaining.size(), 51u);
+	owner.free_rids(remaining);
+	CHECK_EQ(owner.get_rid_count(), 0u);
+}
+
+TEST_CASE("[RID_Owner] Batch allocation and iteration") {
+	SUBCASE("Not thread safe") {
+		test_batch_and_iteration<false>();
+	}
+	SUBCASE("Thread safe") {
+		test_batch_and_iteration<true>();
+	}
+}
+
 #ifdef THREADS_ENABLED
 // This case would let sanitizers realize data races.
 // Additionally, on purely weakly ordered architectures, it would detect synchronization issues
@@ -251,6 +326,112 @@ TEST_CASE("[RID_Owner] Thread safety") {
 		tester.test();
 	}
 }
+
+struct RID_ChurnTester {
+	static const uint32_t TASKS = 8;
+	static const uint32_t LIVE = 256;
+
+	RID_Owner<uint64_t, true> rid_owner;
+	SafeNumeric<uint32_t> errors;
+
+	void churn(uint32_t p_index, void *p_userdata) {
+		RID rids[LIVE];
+		for (int pass = 0; pass < 64; pass++) {
+			for (uint32_t i = 0; i < LIVE; i++) {
+				rids[i] = rid_owner.make_rid(((uint64_t)p_index << 32) | i);
+			}
+			for (uint32_t i = 0; i < LIVE; i++) {
+				uint64_t *value = rid_owner.get_or_null(rids[i]);
+				if (!value || *value != (((uint64_t)p_index << 32) | i)) {
+					errors.increment();
+				}
+				rid_owner.free(rids[i]);
+			}
+		}
+	}
+};
+
+TEST_CASE("[RID_Owner] Concurrent allocation and free") {
+	RID_ChurnTester *tester = memnew(RID_ChurnTester);
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(tester, &RID_ChurnTester::churn, nullptr, RID_ChurnTester::TASKS, RID_ChurnTester::TASKS, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	CHECK_EQ(tester->errors.get(), 0u);
+	CHECK_EQ(tester->rid_owner.get_rid_count(), 0u);
+	memdelete(tester);
+}
+
+TEST_CASE("[RID_Owner] Iteration concurrent with allocation and free") {
+	RID_ChurnTester *tester = memnew(RID_ChurnTester);
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(tester, &RID_ChurnTester::churn, nullptr, RID_ChurnTester::TASKS, RID_ChurnTester::TASKS, true);
+
+	// Elements must never be seen half freed, and the buffer must never overflow.
+	uint32_t invalid = 0;
+	uint32_t overflows = 0;
+	RID buffer[16];
+	while (!WorkerThreadPool::get_singleton()->is_group_task_completed(group)) {
+		tester->rid_owner.for_each([&](const RID &p_rid, uint64_t *p_value) {
+			if (tester->rid_owner.get_or_null(p_rid) != p_value || (*p_value >> 32) >= RID_ChurnTester::TASKS) {
+				invalid++;
+			}
+		});
+		if (tester->rid_owner.fill_owned_buffer(buffer, std_size(buffer)) > std_size(buffer)) {
+			overflows++;
+		}
+	}
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	CHECK_EQ(invalid, 0u);
+	CHECK_EQ(overflows, 0u);
+	CHECK_EQ(tester->errors.get(), 0u);
+	CHECK_EQ(tester->rid_owner.fill_owned_buffer(buffer, std_size(buffer)), 0u);
+	memdelete(tester);
+}
 #endif // THREADS_ENABLED
 
+TEST_CASE_BENCHMARK("[RID_Owner][Benchmark] Allocation and free") {
+	const uint32_t count = 100000;
+	const int passes = 20;
+	RID_Owner<uint64_t, true> rid_owner;
+	LocalVector<RID> rids;
+	rids.resize(count);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int pass = 0; pass < passes; pass++) {
+		for (uint32_t i = 0; i < count; i++) {
+			rids[i] = rid_owner.make_rid();
+		}
+		for (uint32_t i = 0; i < count; i++) {
+			rid_owner.free(rids[i]);
+		}
+	}
+	uint64_t single = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int pass = 0; pass < passes; pass++) {
+		rids = rid_owner.make_rids(count);
+		rid_owner.free_rids(rids);
+	}
+	uint64_t batch = OS::get_singleton()->get_ticks_usec() - begin;
+
+	uint64_t sum = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	rids = rid_owner.make_rids(count);
+	for (int pass = 0; pass < passes; pass++) {
+		for (uint32_t i = 0; i < count; i++) {
+			sum += *rid_owner.get_or_null(rids[i]);
+		}
+	}
+	uint64_t lookup = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int pass = 0; pass < passes; pass++) {
+		rid_owner.for_each([&sum](const RID &p_rid, uint64_t *p_value) { sum += *p_value; });
+	}
+	uint64_t iteration = OS::get_singleton()->get_ticks_usec() - begin;
+	rid_owner.free_rids(rids);
+
+	const double ops = double(count) * passes;
+	print_line(vformat("make_rid/free %.1f ns/op, make_rids/free_rids %.1f ns/op, get_or_null %.1f ns/op, for_each %.1f ns/op (%d)", single * 1000.0 / ops, batch * 1000.0 / ops, lookup * 1000.0 / ops, iteration * 1000.0 / ops, sum));
+}
+
 } // namespace TestRID
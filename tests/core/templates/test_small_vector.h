@@ -0,0 +1,184 @@
+/**************************************************************************/
+/*  test_small_vector.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#pragma once
+
+#include "core/os/os.h"
+#include "core/string/string_name.h"
+#include "core/templates/small_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSmallVector {
+
+TEST_CASE("[SmallVector] Inline storage") {
+	SmallVector<int, 4> vector;
+	CHECK(vector.is_empty());
+	CHECK(vector.is_inline());
+	CHECK_EQ(vector.get_capacity(), 4u);
+
+	for (int i = 0; i < 4; i++) {
+		vector.push_back(i);
+	}
+	CHECK(vector.is_inline());
+	CHECK_EQ(vector.size(), 4u);
+
+	vector.push_back(4);
+	CHECK_FALSE(vector.is_inline());
+	CHECK_EQ(vector.size(), 5u);
+	for (int i = 0; i < 5; i++) {
+		CHECK_EQ(vector[i], i);
+	}
+
+	// Clearing keeps the heap buffer around, resetting goes back to inline storage.
+	vector.clear();
+	CHECK_FALSE(vector.is_inline());
+	vector.reset();
+	CHECK(vector.is_inline());
+	CHECK(vector.is_empty());
+}
+
+TEST_CASE("[SmallVector] Insert and remove") {
+	SmallVector<int, 2> vector = { 0, 2 };
+	vector.insert(1, 1);
+	vector.insert(0, -1);
+	vector.insert(4, 3);
+	CHECK_EQ(vector.size(), 5u);
+	for (int i = 0; i < 5; i++) {
+		CHECK_EQ(vector[i], i - 1);
+	}
+
+	vector.remove_at(0);
+	CHECK_EQ(vector[0], 0);
+	CHECK(vector.erase(2));
+	CHECK_FALSE(vector.erase(2));
+	CHECK_EQ(vector.find(3), 2);
+	CHECK(vector.has(1));
+	vector.remove_at_unordered(0);
+	CHECK_EQ(vector[0], 3);
+	vector.pop_back();
+	CHECK_EQ(vector.size(), 1u);
+}
+
+TEST_CASE("[SmallVector] Copy and move") {
+	SUBCASE("Inline") {
+		SmallVector<StringName, 2> vector = { "a", "b" };
+		SmallVector<StringName, 2> copy = vector;
+		CHECK(copy == vector);
+		copy.push_back("c");
+		CHECK_EQ(vector.size(), 2u);
+
+		SmallVector<StringName, 2> moved = std::move(vector);
+		CHECK(moved.is_inline());
+		CHECK_EQ(moved[1], StringName("b"));
+		CHECK(vector.is_empty());
+	}
+
+	SUBCASE("Heap") {
+		SmallVector<StringName, 2> vector = { "a", "b", "c" };
+		CHECK_FALSE(vector.is_inline());
+		const StringName *data = vector.ptr();
+		SmallVector<StringName, 2> moved;
+		moved = std::move(vector);
+		// The heap buffer is handed over.
+		CHECK_EQ(moved.ptr(), data);
+		CHECK(vector.is_inline());
+		CHECK(vector.is_empty());
+
+		SmallVector<StringName, 2> copy;
+		copy = moved;
+		CHECK(copy == moved);
+		CHECK_NE(copy.ptr(), moved.ptr());
+	}
+
+	SUBCASE("Vector") {
+		Vector<int> source = { 1, 2, 3 };
+		SmallVector<int, 4> vector(source);
+		CHECK(vector.is_inline());
+		CHECK_EQ(Vector<int>(vector), source);
+	}
+}
+
+TEST_CASE("[SmallVector] Resize") {
+	SmallVector<String, 3> vector;
+	vector.resize(2);
+	vector[1] = "hello";
+	CHECK(vector.is_inline());
+	vector.resize(10);
+	CHECK_FALSE(vector.is_inline());
+	CHECK_EQ(vector[1], "hello");
+	CHECK(vector[9].is_empty());
+	vector.resize(1);
+	CHECK_EQ(vector.size(), 1u);
+
+	SmallVector<int, 3> ints;
+	ints.resize_initialized(5);
+	for (int value : ints) {
+		CHECK_EQ(value, 0);
+	}
+}
+
+template <typename V>
+static void fill_small_vectors(LocalVector<V> &r_vectors, uint32_t p_count) {
+	r_vectors.resize(p_count);
+	for (uint32_t i = 0; i < p_count; i++) {
+		// Mostly tiny, like the indices of a polygon or the names of a node path.
+		for (uint32_t j = 0; j < 1 + i % 4; j++) {
+			r_vectors[i].push_back(i + j);
+		}
+	}
+}
+
+TEST_CASE_BENCHMARK("[SmallVector][Benchmark] Tiny arrays") {
+	const uint32_t count = 200000;
+
+	uint64_t memory = Memory::get_mem_usage();
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	{
+		LocalVector<Vector<int32_t>> vectors;
+		fill_small_vectors(vectors, count);
+		memory = Memory::get_mem_usage() - memory;
+		begin = OS::get_singleton()->get_ticks_usec() - begin;
+	}
+	print_line(vformat("Vector: %d arrays of 1-4 elements, %d ms, %d bytes of heap.", count, begin / 1000, memory));
+
+	memory = Memory::get_mem_usage();
+	begin = OS::get_singleton()->get_ticks_usec();
+	{
+		LocalVector<SmallVector<int32_t, 4>> vectors;
+		fill_small_vectors(vectors, count);
+		memory = Memory::get_mem_usage() - memory;
+		begin = OS::get_singleton()->get_ticks_usec() - begin;
+	}
+	print_line(vformat("SmallVector: %d arrays of 1-4 elements, %d ms, %d bytes of heap.", count, begin / 1000, memory));
+}
+
+} // namespace TestSmallVector
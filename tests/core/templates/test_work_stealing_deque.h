@@ -0,0 +1,143 @@
+/**************************************************************************/
+/*  test_work_stealing_deque.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_deque.h"
+
+#include "tests/test_macros.h"
+
+namespace TestWorkStealingDeque {
+
+TEST_CASE("[WorkStealingDeque] Owner takes LIFO, thieves steal FIFO") {
+	WorkStealingDeque<int, 16> deque;
+	CHECK(deque.is_empty());
+
+	for (int i = 1; i <= 4; i++) {
+		CHECK(deque.push(i));
+	}
+	CHECK(deque.size() == 4);
+
+	int value = 0;
+	CHECK(deque.take(value));
+	CHECK(value == 4);
+	CHECK(deque.steal(value));
+	CHECK(value == 1);
+	CHECK(deque.take(value));
+	CHECK(value == 3);
+	CHECK(deque.steal(value));
+	CHECK(value == 2);
+
+	CHECK(deque.is_empty());
+	CHECK_FALSE(deque.take(value));
+	CHECK_FALSE(deque.steal(value));
+}
+
+TEST_CASE("[WorkStealingDeque] Push fails when full") {
+	WorkStealingDeque<int, 4> deque;
+	for (int i = 0; i < 4; i++) {
+		CHECK(deque.push(i));
+	}
+	CHECK_FALSE(deque.push(4));
+
+	// Wrapping around after making room.
+	int value = 0;
+	CHECK(deque.steal(value));
+	CHECK(value == 0);
+	CHECK(deque.push(4));
+	CHECK(deque.size() == 4);
+
+	for (int i = 1; i <= 4; i++) {
+		CHECK(deque.steal(value));
+		CHECK(value == i);
+	}
+	CHECK(deque.is_empty());
+}
+
+struct StealTestState {
+	static const int ITEMS = 200000;
+
+	WorkStealingDeque<int, 256> deque;
+	LocalVector<SafeNumeric<uint32_t>> consumed;
+	SafeFlag owner_done;
+
+	static void thief(void *p_userdata) {
+		StealTestState *state = static_cast<StealTestState *>(p_userdata);
+		int value = 0;
+		while (!state->owner_done.is_set() || !state->deque.is_empty()) {
+			if (state->deque.steal(value)) {
+				state->consumed[value].increment();
+			}
+		}
+	}
+};
+
+TEST_CASE("[WorkStealingDeque] Concurrent take and steal") {
+	StealTestState state;
+	state.consumed.resize(StealTestState::ITEMS);
+
+	const int thief_count = 3;
+	Thread thieves[thief_count];
+	for (int i = 0; i < thief_count; i++) {
+		thieves[i].start(&StealTestState::thief, &state);
+	}
+
+	int value = 0;
+	for (int i = 0; i < StealTestState::ITEMS; i++) {
+		while (!state.deque.push(i)) {
+			if (state.deque.take(value)) {
+				state.consumed[value].increment();
+			}
+		}
+		// Take every now and then, so the owner races the thieves for the last elements.
+		if ((i % 3) == 0 && state.deque.take(value)) {
+			state.consumed[value].increment();
+		}
+	}
+	while (state.deque.take(value)) {
+		state.consumed[value].increment();
+	}
+	state.owner_done.set();
+
+	for (int i = 0; i < thief_count; i++) {
+		thieves[i].wait_to_finish();
+	}
+
+	bool all_consumed_once = true;
+	for (int i = 0; i < StealTestState::ITEMS; i++) {
+		all_consumed_once = all_consumed_once && state.consumed[i].get() == 1;
+	}
+	CHECK_MESSAGE(all_consumed_once, "Every element should be consumed exactly once.");
+}
+
+} // namespace TestWorkStealingDeque
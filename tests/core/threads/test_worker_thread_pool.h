@@ -172,4 +172,391 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static void static_fan_out_task(void *p_arg) {
+	int depth = (int)(intptr_t)p_arg;
+	counter[0].increment();
+	if (depth == 0) {
+		return;
+	}
+	// Posted from a pool thread, so these go to its work-stealing queue.
+	WorkerThreadPool::TaskID left = WorkerThreadPool::get_singleton()->add_native_task(static_fan_out_task, (void *)(intptr_t)(depth - 1), true);
+	WorkerThreadPool::TaskID right = WorkerThreadPool::get_singleton()->add_native_task(static_fan_out_task, (void *)(intptr_t)(depth - 1), true);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(left);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(right);
+}
+
+static void static_fan_out_group_task(void *p_arg, uint32_t p_index) {
+	counter[0].increment();
+}
+
+static void static_fan_out_groups_task(void *p_arg) {
+	int groups = (int)(intptr_t)p_arg;
+	for (int i = 0; i < groups; i++) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_fan_out_group_task, nullptr, 64, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Process tasks posted from pool threads") {
+	for (int iterations = 0; iterations < 20; iterations++) {
+		const int depth = Math::random(1, 10);
+
+		counter.clear();
+		counter.resize(1);
+		WorkerThreadPool::TaskID root = WorkerThreadPool::get_singleton()->add_native_task(static_fan_out_task, (void *)(intptr_t)depth, true);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(root);
+		CHECK(counter[0].get() == (2 << depth) - 1);
+	}
+
+	if (WorkerThreadPool::get_singleton()->get_thread_count() > 1) {
+		// Waiting for a group doesn't process other tasks, so the ones posted by the waiting thread need to be stolen.
+		counter.clear();
+		counter.resize(1);
+		WorkerThreadPool::TaskID root = WorkerThreadPool::get_singleton()->add_native_task(static_fan_out_groups_task, (void *)(intptr_t)50, true);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(root);
+		CHECK(counter[0].get() == 50 * 64);
+	}
+}
+
+static void static_child_task(void *p_arg) {
+	counter[1].increment();
+}
+
+static void static_posting_task(void *p_arg) {
+	counter[0].increment();
+	while (!exit.is_set()) {
+		// Posted from a pool thread, so this goes to its work-stealing queue and is taken back right away when waiting.
+		WorkerThreadPool::TaskID child = WorkerThreadPool::get_singleton()->add_native_task(static_child_task, nullptr, true);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(child);
+	}
+}
+
+static void static_exit_task(void *p_arg) {
+	exit.set();
+}
+
+TEST_CASE("[WorkerThreadPool] Tasks posted from outside the pool run while pool threads keep posting tasks") {
+	const int thread_count = WorkerThreadPool::get_singleton()->get_thread_count();
+	counter.clear();
+	counter.resize(2);
+	exit.clear();
+
+	LocalVector<WorkerThreadPool::TaskID> posting_tasks;
+	for (int i = 0; i < thread_count; i++) {
+		posting_tasks.push_back(WorkerThreadPool::get_singleton()->add_native_task(static_posting_task, nullptr, true));
+	}
+	while (counter[0].get() < thread_count) {
+		OS::get_singleton()->delay_usec(1);
+	}
+
+	// Every pool thread is busy with its own tasks, so this one only runs if they check the global queue too.
+	WorkerThreadPool::TaskID exit_task = WorkerThreadPool::get_singleton()->add_native_task(static_exit_task, nullptr, true);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(exit_task);
+	for (WorkerThreadPool::TaskID task : posting_tasks) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+	}
+	CHECK(exit.is_set());
+	CHECK(counter[1].get() > 0);
+}
+
+struct ParallelForTest {
+	LocalVector<SafeNumeric<uint32_t>> visits;
+	SafeNumeric<uint32_t> bad_participants;
+	uint32_t participant_count = 0;
+
+	void visit(uint32_t p_from, uint32_t p_to, uint32_t p_participant, uint32_t p_offset) {
+		if (p_participant >= participant_count) {
+			bad_participants.increment();
+		}
+		for (uint32_t i = p_from; i < p_to; i++) {
+			visits[i - p_offset].increment();
+		}
+	}
+
+	void sum(uint32_t p_from, uint32_t p_to, uint64_t &r_sum) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			r_sum += i;
+		}
+	}
+
+	void run(uint32_t p_begin, uint32_t p_end, uint32_t p_grain) {
+		participant_count = WorkerThreadPool::get_singleton()->get_parallel_for_participant_count();
+		visits.clear();
+		visits.resize(p_end - p_begin);
+		WorkerThreadPool::get_singleton()->parallel_for(this, &ParallelForTest::visit, p_begin, p_begin, p_end, p_grain);
+	}
+
+	bool all_visited_once() const {
+		for (const SafeNumeric<uint32_t> &visit_count : visits) {
+			if (visit_count.get() != 1) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static void run_from_pool_thread(void *p_arg) {
+		ParallelForTest *test = (ParallelForTest *)p_arg;
+		test->run(0, 10000, 7);
+	}
+};
+
+static uint64_t add_sums(const uint64_t &p_a, const uint64_t &p_b) {
+	return p_a + p_b;
+}
+
+TEST_CASE("[WorkerThreadPool] Parallel for") {
+	ParallelForTest test;
+
+	SUBCASE("Every element is processed once") {
+		for (int iterations = 0; iterations < 200; iterations++) {
+			const uint32_t begin = Math::random(0, 100);
+			const uint32_t count = Math::pow(2.0f, Math::random(0.0f, 14.0f));
+			const uint32_t grain = Math::pow(2.0f, Math::random(0.0f, 8.0f));
+			test.run(begin, begin + count, grain);
+			CHECK(test.all_visited_once());
+		}
+		CHECK(test.bad_participants.get() == 0);
+	}
+
+	SUBCASE("Empty range") {
+		test.run(10, 10, 1);
+		CHECK(test.visits.is_empty());
+	}
+
+	SUBCASE("From a pool thread") {
+		WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task(&ParallelForTest::run_from_pool_thread, &test, true);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+		CHECK(test.all_visited_once());
+		CHECK(test.bad_participants.get() == 0);
+	}
+
+	SUBCASE("Reduction") {
+		const uint32_t count = 100000;
+		uint64_t sum = WorkerThreadPool::get_singleton()->parallel_reduce(&test, &ParallelForTest::sum, (uint64_t)0, &add_sums, 0, count, 64);
+		CHECK(sum == (uint64_t)count * (count - 1) / 2);
+	}
+}
+
+struct DependencyStep {
+	LocalVector<DependencyStep *> dependencies;
+	uint32_t element_count = 1;
+	SafeNumeric<uint32_t> processed;
+	SafeFlag started_early;
+
+	void process() {
+		for (DependencyStep *dependency : dependencies) {
+			if (dependency->processed.get() != dependency->element_count) {
+				started_early.set();
+			}
+		}
+		OS::get_singleton()->delay_usec(100);
+		processed.increment();
+	}
+};
+
+static void static_dependency_task(void *p_arg) {
+	((DependencyStep *)p_arg)->process();
+}
+
+static void static_dependency_group_task(void *p_arg, uint32_t p_index) {
+	((DependencyStep *)p_arg)->process();
+}
+
+TEST_CASE("[WorkerThreadPool] Tasks with dependencies") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+
+	SUBCASE("Chain of tasks and groups") {
+		DependencyStep steps[4];
+		steps[2].element_count = 20;
+		for (int i = 1; i < 4; i++) {
+			steps[i].dependencies.push_back(&steps[i - 1]);
+		}
+
+		WorkerThreadPool::TaskID first = pool->add_native_task(static_dependency_task, &steps[0], true);
+		WorkerThreadPool::TaskID second = pool->add_native_task_with_dependencies(static_dependency_task, &steps[1], Span<WorkerThreadPool::TaskID>(&first, 1), true);
+		WorkerThreadPool::GroupID third = pool->add_native_group_task_with_dependencies(static_dependency_group_task, &steps[2], steps[2].element_count, Span<WorkerThreadPool::TaskID>(&second, 1), -1, true);
+		WorkerThreadPool::TaskID fourth = pool->add_native_task_with_dependencies(static_dependency_task, &steps[3], Span<WorkerThreadPool::TaskID>(&third, 1), true);
+
+		CHECK(pool->wait_for_task_completion(fourth) == OK);
+		CHECK(pool->is_task_completed(first));
+		CHECK(pool->is_task_completed(second));
+		CHECK(pool->is_group_task_completed(third));
+		for (int i = 0; i < 4; i++) {
+			CHECK(steps[i].processed.get() == steps[i].element_count);
+			CHECK_FALSE(steps[i].started_early.is_set());
+		}
+
+		pool->wait_for_task_completion(first);
+		pool->wait_for_task_completion(second);
+		pool->wait_for_group_task_completion(third);
+	}
+
+	SUBCASE("Several dependencies") {
+		DependencyStep steps[4];
+		for (int i = 0; i < 3; i++) {
+			steps[3].dependencies.push_back(&steps[i]);
+		}
+
+		WorkerThreadPool::TaskID dependencies[3];
+		for (int i = 0; i < 3; i++) {
+			dependencies[i] = pool->add_native_task(static_dependency_task, &steps[i], true);
+		}
+		WorkerThreadPool::TaskID last = pool->add_native_task_with_dependencies(static_dependency_task, &steps[3], Span<WorkerThreadPool::TaskID>(dependencies), true);
+		// An empty group completes once its dependencies have, so it can be used to wait for all of them at once.
+		WorkerThreadPool::GroupID join = pool->add_native_group_task_with_dependencies(static_dependency_group_task, nullptr, 0, Span<WorkerThreadPool::TaskID>(dependencies));
+
+		pool->wait_for_group_task_completion(join);
+		for (int i = 0; i < 3; i++) {
+			CHECK(pool->is_task_completed(dependencies[i]));
+		}
+		pool->wait_for_task_completion(last);
+		CHECK(steps[3].processed.get() == 1);
+		CHECK_FALSE(steps[3].started_early.is_set());
+		for (int i = 0; i < 3; i++) {
+			pool->wait_for_task_completion(dependencies[i]);
+		}
+	}
+
+	SUBCASE("Finished dependencies") {
+		DependencyStep steps[2];
+		steps[1].dependencies.push_back(&steps[0]);
+
+		WorkerThreadPool::TaskID done = pool->add_native_task(static_dependency_task, &steps[0], true);
+		pool->wait_for_task_completion(done);
+		// Its ID is no longer valid, so it counts as finished.
+		WorkerThreadPool::TaskID task = pool->add_native_task_with_dependencies(static_dependency_task, &steps[1], Span<WorkerThreadPool::TaskID>(&done, 1), true);
+		CHECK(pool->wait_for_task_completion(task) == OK);
+		CHECK(steps[1].processed.get() == 1);
+		CHECK_FALSE(steps[1].started_early.is_set());
+	}
+}
+
+static void static_cheap_group_task(void *p_arg, uint32_t p_index) {
+	float *values = (float *)p_arg;
+	values[p_index] = values[p_index] * 0.5f + 1.0f;
+}
+
+struct CheapKernel {
+	float *values = nullptr;
+
+	void process(uint32_t p_from, uint32_t p_to, uint32_t p_participant, void *p_userdata) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			values[i] = values[i] * 0.5f + 1.0f;
+		}
+	}
+};
+
+TEST_CASE_BENCHMARK("[WorkerThreadPool][Benchmark] Parallel for versus group task") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	const uint32_t count = 1 << 20;
+	const int frames = 20;
+	LocalVector<float> values;
+	values.resize(count);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < frames; i++) {
+		WorkerThreadPool::GroupID group = pool->add_native_group_task(static_cheap_group_task, values.ptr(), count, -1, true);
+		pool->wait_for_group_task_completion(group);
+	}
+	uint64_t group_elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CheapKernel kernel;
+	kernel.values = values.ptr();
+	for (uint32_t grain : { 1u, 64u, 1024u }) {
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < frames; i++) {
+			pool->parallel_for(&kernel, &CheapKernel::process, nullptr, 0, count, grain);
+		}
+		uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+		print_line(vformat("%d threads, %d elements: group task %.2f ms/frame, parallel_for (grain %d) %.2f ms/frame", pool->get_thread_count(), count, group_elapsed / 1000.0 / frames, grain, elapsed / 1000.0 / frames));
+	}
+}
+
+static void static_empty_task(void *p_arg) {
+}
+
+static void static_empty_group_task(void *p_arg, uint32_t p_index) {
+}
+
+static void static_latency_task(void *p_arg) {
+	*(uint64_t *)p_arg = OS::get_singleton()->get_ticks_usec();
+}
+
+static void static_latency_from_pool_task(void *p_arg) {
+	uint64_t *r_total = (uint64_t *)p_arg;
+	for (int i = 0; i < 1000; i++) {
+		uint64_t started = 0;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task(static_latency_task, &started, true);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+		*r_total += started - begin;
+	}
+}
+
+TEST_CASE_BENCHMARK("[WorkerThreadPool][Benchmark] Throughput") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	print_line(vformat("%d threads", pool->get_thread_count()));
+
+	{
+		const int count = 100000;
+		LocalVector<WorkerThreadPool::TaskID> tasks;
+		tasks.resize(count);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < count; i++) {
+			tasks[i] = pool->add_native_task(static_empty_task, nullptr, true);
+		}
+		for (int i = 0; i < count; i++) {
+			pool->wait_for_task_completion(tasks[i]);
+		}
+		uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, 1u);
+		print_line(vformat("Tasks posted from the main thread: %.2f M tasks/s", double(count) / double(elapsed)));
+	}
+
+	{
+		const int depth = 16;
+		counter.clear();
+		counter.resize(1);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		WorkerThreadPool::TaskID root = pool->add_native_task(static_fan_out_task, (void *)(intptr_t)depth, true);
+		pool->wait_for_task_completion(root);
+		uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, 1u);
+		CHECK(counter[0].get() == (2 << depth) - 1);
+		print_line(vformat("Tasks posted from pool threads (fan-out): %.2f M tasks/s", double(counter[0].get()) / double(elapsed)));
+	}
+
+	{
+		const int elements = 1 << 22;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		WorkerThreadPool::GroupID group = pool->add_native_group_task(static_empty_group_task, nullptr, elements, -1, true);
+		pool->wait_for_group_task_completion(group);
+		uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, 1u);
+		print_line(vformat("Group task with tiny elements: %.2f M elements/s", double(elements) / double(elapsed)));
+	}
+}
+
+TEST_CASE_BENCHMARK("[WorkerThreadPool][Benchmark] Latency") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+
+	{
+		const int count = 1000;
+		uint64_t total = 0;
+		for (int i = 0; i < count; i++) {
+			uint64_t started = 0;
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			WorkerThreadPool::TaskID task = pool->add_native_task(static_latency_task, &started, true);
+			pool->wait_for_task_completion(task);
+			total += started - begin;
+		}
+		print_line(vformat("Task start latency from the main thread: %.2f usec", double(total) / count));
+	}
+
+	{
+		uint64_t total = 0;
+		WorkerThreadPool::TaskID task = pool->add_native_task(static_latency_from_pool_task, &total, true);
+		pool->wait_for_task_completion(task);
+		print_line(vformat("Task start latency from a pool thread: %.2f usec", double(total) / 1000.0));
+	}
+}
+
 } // namespace TestWorkerThreadPool
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/os/os.h"
 #include "core/variant/array.h"
 #include "tests/test_macros.h"
 #include "tests/test_tools.h"
@@ -537,6 +538,45 @@ TEST_CASE("[Array] Hash recursive array") {
 	a2.clear();
 }
 
+TEST_CASE("[Array] Duplicate, hash and compare deeply nested arrays") {
+	// Comparisons count two levels of recursion per nested array.
+	const int depth = MAX_RECURSION / 2 - 1;
+
+	// Each level holds a plain value, a packed array, a typed array and the next level.
+	Array root;
+	Array level = root;
+	for (int i = 0; i < depth; i++) {
+		Array next;
+		level.push_back(i);
+		level.push_back(PackedInt32Array({ i }));
+		level.push_back(TypedArray<int>({ i, i }));
+		level.push_back(next);
+		level = next;
+	}
+
+	const Array copy = root.duplicate(true);
+	CHECK_EQ(copy, root);
+	CHECK_EQ(copy.hash(), root.hash());
+
+	Array copy_level = copy;
+	Array innermost_typed;
+	level = root;
+	for (int i = 0; i < depth; i++) {
+		CHECK_FALSE(copy_level.is_same_instance(level));
+		innermost_typed = copy_level[2];
+		CHECK_FALSE(innermost_typed.is_same_instance(level[2]));
+		CHECK(innermost_typed.is_typed());
+		copy_level = copy_level[3];
+		level = level[3];
+	}
+	CHECK(copy_level.is_empty());
+
+	// The hash and the comparison must reach all the way down.
+	innermost_typed.push_back(0);
+	CHECK_NE(copy, root);
+	CHECK_NE(copy.hash(), root.hash());
+}
+
 TEST_CASE("[Array] Empty comparison") {
 	Array a1;
 	Array a2;
@@ -786,4 +826,196 @@ TEST_CASE("[Array] Test typed arrays") {
 	CHECK_EQ(arr3.get_typed_class_name(), "Node");
 }
 
+// Only uses operations which don't need to box the elements of packed typed arrays.
+TEST_CASE("[Array] Packed typed arrays") {
+	TypedArray<int64_t> ints;
+	ints.push_back(3);
+	ints.push_back(1);
+	ints.push_back(2.0);
+	ints.push_front(0);
+	ints.insert(2, 5);
+	CHECK(ints == Array({ 0, 3, 5, 1, 2 }));
+	CHECK(ints.hash() == Array({ 0, 3, 5, 1, 2 }).hash());
+	CHECK_EQ(ints.get(2), Variant(5));
+	CHECK_EQ(ints.get(2).get_type(), Variant::INT);
+	CHECK_EQ(ints.find(1), 3);
+	CHECK_EQ(ints.rfind(3), 1);
+	CHECK_EQ(ints.count(5), 1);
+	CHECK(ints.has(2));
+	CHECK_EQ(ints.min(), Variant(0));
+	CHECK_EQ(ints.max(), Variant(5));
+
+	ints.sort();
+	CHECK(ints == Array({ 0, 1, 2, 3, 5 }));
+	CHECK_EQ(ints.bsearch(3), 3);
+	CHECK_EQ(ints.bsearch(4), 4);
+	ints.reverse();
+	CHECK(ints == Array({ 5, 3, 2, 1, 0 }));
+	ints.erase(2);
+	ints.remove_at(-1);
+	CHECK(ints == Array({ 5, 3, 1 }));
+	CHECK_EQ(ints.pop_front(), Variant(5));
+	CHECK_EQ(ints.pop_back(), Variant(1));
+	CHECK_EQ(ints.pop_at(0), Variant(3));
+	CHECK(ints.is_empty());
+	CHECK(ints.pop_back() == Variant());
+
+	ints.resize(3);
+	CHECK(ints == Array({ 0, 0, 0 }));
+	ints.fill(4);
+	ints.set(1, 7);
+	CHECK(ints == Array({ 4, 7, 4 }));
+
+	ERR_PRINT_OFF;
+	ints.push_back("wrong type");
+	ints.set(0, Vector2());
+	ERR_PRINT_ON;
+	CHECK(ints == Array({ 4, 7, 4 }));
+
+	// Copies share the elements, duplicates don't.
+	Array shared = ints;
+	Array duplicate = ints.duplicate(true);
+	shared.set(0, 1);
+	CHECK_EQ(ints.get(0), Variant(1));
+	CHECK_EQ(duplicate.get(0), Variant(4));
+	CHECK(duplicate.is_same_typed(ints));
+
+	CHECK(ints.slice(0, 3, 2) == Array({ 1, 4 }));
+	CHECK(ints.slice(-1, 0, -1) == Array({ 4, 7 }));
+	ints.append_array(duplicate);
+	ints.append_array(Array({ 8.0 }));
+	CHECK(ints == Array({ 1, 7, 4, 4, 7, 4, 8 }));
+
+	TypedArray<double> floats = ints;
+	CHECK_EQ(floats.get(0).get_type(), Variant::FLOAT);
+	CHECK_EQ(floats.size(), 7);
+	TypedArray<int64_t> ints_again = floats;
+	CHECK(ints_again == ints);
+
+	TypedArray<int64_t> assigned;
+	assigned.assign(Array({ 1, 2.0 }));
+	CHECK(assigned == Array({ 1, 2 }));
+	CHECK_EQ(assigned.get(1).get_type(), Variant::INT);
+
+	// New elements get the default value of their type.
+	TypedArray<Color> colors;
+	colors.resize(2);
+	CHECK_EQ(colors.get(1), Variant(Color()));
+	TypedArray<Vector3> vectors;
+	vectors.push_back(Vector3(1, 2, 3));
+	vectors.push_back(Vector3i(4, 5, 6));
+	vectors.resize(3);
+	CHECK(vectors == Array({ Vector3(1, 2, 3), Vector3(4, 5, 6), Vector3() }));
+	TypedArray<bool> bools;
+	bools.resize(2);
+	bools.set(1, true);
+	CHECK(bools == Array({ false, true }));
+}
+
+TEST_CASE("[Array] Packed typed arrays accessed by reference") {
+	TypedArray<int64_t> ints = { 1, 2, 3 };
+	Array shared = ints;
+
+	// Handing out a reference boxes the elements for every user of the array.
+	ints[1] = 5;
+	CHECK_EQ(shared.get(1), Variant(5));
+	const Variant &ref = shared[2];
+	CHECK_EQ(ref, Variant(3));
+
+	int64_t sum = 0;
+	for (const Variant &value : ints) {
+		sum += (int64_t)value;
+	}
+	CHECK_EQ(sum, 9);
+
+	ints.push_back(4);
+	ints.sort();
+	CHECK(ints == Array({ 1, 3, 4, 5 }));
+
+	// Emptying the array packs it again.
+	ints.clear();
+	ints.push_back(6);
+	CHECK(shared == Array({ 6 }));
+	CHECK_EQ(shared[0], Variant(6));
+}
+
+TEST_CASE("[Array] Packed typed arrays read by const reference") {
+	const int element_count = 1000;
+	TypedArray<int64_t> ints;
+	ints.resize(element_count);
+	for (int i = 0; i < element_count; i++) {
+		ints.set(i, i);
+	}
+	const Array &const_ints = ints;
+
+	// Reading through a const reference doesn't box the whole array.
+	const uint64_t memory = Memory::get_mem_usage();
+	int64_t sum = 0;
+	for (const Variant &value : const_ints) {
+		sum += (int64_t)value;
+	}
+	CHECK_EQ(sum, int64_t(element_count) * (element_count - 1) / 2);
+	const Variant &first = const_ints[1];
+	const Variant &second = const_ints[2];
+	CHECK_EQ(first, Variant(1));
+	CHECK_EQ(second, Variant(2));
+	CHECK_EQ(&const_ints[1], &first);
+	CHECK_LT(Memory::get_mem_usage() - memory, element_count * sizeof(Variant));
+
+	// Past a few elements, the array is boxed, and earlier references stay valid.
+	for (int i = 0; i < element_count; i++) {
+		CHECK_EQ(const_ints[i], Variant(i));
+	}
+	CHECK_EQ(first, Variant(1));
+	CHECK_EQ(second, Variant(2));
+
+	ints.set(1, 10);
+	CHECK_EQ(const_ints[1], Variant(10));
+	sum = 0;
+	for (const Variant &value : const_ints) {
+		sum += (int64_t)value;
+	}
+	CHECK_EQ(sum, int64_t(element_count) * (element_count - 1) / 2 + 9);
+}
+
+TEST_CASE_BENCHMARK("[Array][Benchmark] Packed typed arrays") {
+	const int element_count = 1000000;
+
+	uint64_t memory = Memory::get_mem_usage();
+	Array untyped;
+	untyped.resize(element_count);
+	for (int i = 0; i < element_count; i++) {
+		untyped.set(i, (int64_t)(element_count - i) * 7919 % element_count);
+	}
+	const uint64_t untyped_memory = Memory::get_mem_usage() - memory;
+
+	memory = Memory::get_mem_usage();
+	TypedArray<int64_t> typed = untyped;
+	const uint64_t typed_memory = Memory::get_mem_usage() - memory;
+
+	const Array arrays[] = { untyped, typed };
+	for (const Array &array : arrays) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		int64_t sum = 0;
+		for (int i = 0; i < element_count; i++) {
+			sum += (int64_t)array.get(i);
+		}
+		const uint64_t iterate = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		const int found = array.find(-1);
+		const uint64_t find = OS::get_singleton()->get_ticks_usec() - begin;
+
+		Array sorted = array.duplicate();
+		begin = OS::get_singleton()->get_ticks_usec();
+		sorted.sort();
+		const uint64_t sort = OS::get_singleton()->get_ticks_usec() - begin;
+
+		CHECK_EQ(found, -1);
+		print_line(vformat("%s: %.1f MiB, get() %.2f ns/element (sum %d), find() %d usec, sort() %d usec",
+				array.is_typed() ? "Array[int]" : "Array", (array.is_typed() ? typed_memory : untyped_memory) / (1024.0 * 1024.0),
+				iterate * 1000.0 / element_count, sum, find, sort));
+	}
+}
+
 } // namespace TestArray
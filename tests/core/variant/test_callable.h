@@ -32,6 +32,8 @@
 
 #include "core/object/class_db.h"
 #include "core/object/object.h"
+#include "core/object/ref_counted.h"
+#include "core/os/os.h"
 
 #include "tests/test_macros.h"
 
@@ -194,4 +196,69 @@ TEST_CASE("[Callable] Bound and unbound argument count") {
 	memdelete(test_instance);
 }
 
+TEST_CASE("[Callable] Bound arguments are kept until the callable is released") {
+	Ref<RefCounted> ref;
+	ref.instantiate();
+	TestBoundUnboundArgumentCount *test_instance = memnew(TestBoundUnboundArgumentCount);
+	Callable test_func = Callable(test_instance, "test_func");
+
+	{
+		Callable few = test_func.bind(ref);
+		// More arguments than fit in a pooled allocation.
+		Callable many = test_func.bind(ref, 1, 2, 3, 4, 5, 6, 7);
+		CHECK_EQ(ref->get_reference_count(), 3);
+
+		Callable copy = many;
+		CHECK(copy == many);
+		CHECK_EQ(few.call(0), Variant(Array{ 0, ref }));
+		CHECK_EQ(copy.call(0), Variant(Array{ 0, ref, 1, 2, 3, 4, 5, 6, 7 }));
+		CHECK(copy.get_bound_arguments() == Array{ ref, 1, 2, 3, 4, 5, 6, 7 });
+	}
+	CHECK_EQ(ref->get_reference_count(), 1);
+
+	memdelete(test_instance);
+}
+
+class CallableBenchmark : public Object {
+	GDCLASS(CallableBenchmark, Object);
+
+public:
+	int64_t total = 0;
+
+	void add(int p_value) { total += p_value; }
+	void add3(int p_a, int p_b, int p_c) { total += p_a + p_b + p_c; }
+};
+
+TEST_CASE_BENCHMARK("[Callable][Benchmark] Create, call and release") {
+	const int iterations = 1000000;
+	CallableBenchmark *benchmark = memnew(CallableBenchmark);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		Callable callable = callable_mp(benchmark, &CallableBenchmark::add);
+		callable.call(1);
+	}
+	const uint64_t method_pointer = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		Callable callable = callable_mp(benchmark, &CallableBenchmark::add).bind(1);
+		callable.call();
+	}
+	const uint64_t bind_one = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		Callable callable = callable_mp(benchmark, &CallableBenchmark::add3).bind(1, 1, 1);
+		callable.call();
+	}
+	const uint64_t bind_three = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK_EQ(benchmark->total, (int64_t)iterations * 5);
+	print_line(vformat("callable_mp: %.1f ns, callable_mp + bind 1: %.1f ns, callable_mp + bind 3: %.1f ns (per create, call and release)",
+			method_pointer * 1000.0 / iterations, bind_one * 1000.0 / iterations, bind_three * 1000.0 / iterations));
+
+	memdelete(benchmark);
+}
+
 } // namespace TestCallable
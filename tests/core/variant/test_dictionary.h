@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/os/os.h"
 #include "core/variant/typed_dictionary.h"
 #include "tests/test_macros.h"
 
@@ -747,4 +748,396 @@ TEST_CASE("[Dictionary] RefCounted value init") {
 	CHECK_EQ(tdict[5.0], Variant(b));
 }
 
+TEST_CASE("[Dictionary] Order is kept when erasing") {
+	Dictionary map;
+	for (int i = 0; i < 100; i++) {
+		map[i] = i * 2;
+	}
+
+	for (int i = 0; i < 100; i += 3) {
+		CHECK(map.erase(i));
+	}
+	CHECK_FALSE(map.erase(0));
+	CHECK_EQ(map.size(), 66);
+
+	int expected = 1;
+	for (const KeyValue<Variant, Variant> &kv : map) {
+		CHECK_EQ(int(kv.key), expected);
+		CHECK_EQ(int(kv.value), expected * 2);
+		expected += expected % 3 == 1 ? 1 : 2;
+	}
+	CHECK_EQ(expected, 100);
+	CHECK_EQ(int(map.get_key_at_index(2)), 4);
+	CHECK_EQ(int(map.get_value_at_index(65)), 196);
+	CHECK(map.get_key_at_index(66) == Variant());
+
+	// Keys added after erasing go at the end.
+	map[0] = "zero";
+	CHECK_EQ(int(map.get_key_at_index(66)), 0);
+	CHECK_EQ(map[0], Variant("zero"));
+	for (int i = 0; i < 100; i++) {
+		CHECK_EQ(map.has(i), i == 0 || i % 3 != 0);
+	}
+
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK(map.begin() == map.end());
+	map["a"] = 1;
+	CHECK_EQ(map.get_key_at_index(0), Variant("a"));
+}
+
+TEST_CASE("[Dictionary] Growing past the small map size") {
+	Dictionary map;
+	for (int i = 0; i < 1000; i++) {
+		CHECK_EQ(map.size(), i);
+		map[vformat("key%d", i)] = i;
+		// Every key must remain reachable while the storage changes representation.
+		for (int j = 0; j <= i; j += MAX(1, i / 8)) {
+			CHECK_EQ(int(map[vformat("key%d", j)]), j);
+		}
+	}
+
+	// String and StringName keys are the same key.
+	CHECK(map.has(StringName("key500")));
+	map[StringName("key500")] = -1;
+	CHECK_EQ(map.size(), 1000);
+	CHECK_EQ(int(map["key500"]), -1);
+
+	for (int i = 999; i >= 0; i--) {
+		CHECK(map.erase(vformat("key%d", i)));
+	}
+	CHECK(map.is_empty());
+}
+
+TEST_CASE("[Dictionary] References stay valid when inserting") {
+	Dictionary map;
+	map["first"] = 1;
+	Variant &first = map["first"];
+	const Variant *key = map.next();
+	for (int i = 0; i < 100; i++) {
+		map[i] = i;
+	}
+	first = 2;
+	CHECK_EQ(int(map["first"]), 2);
+	CHECK_EQ(*key, Variant("first"));
+
+	// The same when the right-hand side is evaluated first.
+	map["copy"] = map["first"];
+	CHECK_EQ(int(map["copy"]), 2);
+}
+
+TEST_CASE("[Dictionary] References stay valid when inserting and erasing") {
+	Dictionary map;
+	for (int i = 0; i < 60; i++) {
+		map[i] = i * 2;
+	}
+	Variant *value = map.getptr(55);
+	REQUIRE(value);
+
+	for (int i = 0; i < 50; i++) {
+		CHECK(map.erase(i));
+		CHECK_EQ(map.getptr(55), value);
+	}
+	CHECK_EQ(*value, Variant(110));
+	*value = "kept";
+
+	// Inserting into a mostly erased dictionary doesn't move the remaining entries.
+	map["new"] = 1;
+	CHECK_EQ(map.getptr(55), value);
+	CHECK_EQ(map.size(), 11);
+	CHECK_EQ(int(map.get_key_at_index(0)), 50);
+	CHECK_EQ(map.get_key_at_index(10), Variant("new"));
+	CHECK_EQ(map[55], Variant("kept"));
+	for (int i = 50; i < 60; i++) {
+		CHECK(map.has(i));
+	}
+
+	// Neither does growing it.
+	Variant *new_value = map.getptr("new");
+	for (int i = 100; i < 10000; i++) {
+		map[i] = i;
+	}
+	CHECK_EQ(map.getptr(55), value);
+	CHECK_EQ(map.getptr("new"), new_value);
+	for (int i = 100; i < 10000; i++) {
+		map.erase(i);
+	}
+	CHECK_EQ(map.size(), 11);
+
+	// Using the dictionary as a queue reuses the storage of erased entries, without moving the others.
+	for (int i = 50; i < 55; i++) {
+		map.erase(i);
+	}
+	for (int i = 10000; i < 20000; i++) {
+		map[i] = i;
+		map.erase(i - 10);
+	}
+	CHECK_EQ(map.getptr(55), value);
+	CHECK_EQ(map.getptr("new"), new_value);
+	CHECK_EQ(map.size(), 16);
+	CHECK_EQ(int(map.get_key_at_index(0)), 55);
+	CHECK_EQ(map.get_key_at_index(5), Variant("new"));
+	CHECK_EQ(int(map.get_key_at_index(6)), 19990);
+	CHECK_EQ(int(map.get_value_at_index(15)), 19999);
+
+	// Iterating while inserting and erasing other keys visits the remaining entries in order.
+	int visited = 0;
+	int last = -1;
+	for (const KeyValue<Variant, Variant> &kv : map) {
+		if (kv.key.get_type() == Variant::INT && int(kv.key) >= 19990) {
+			CHECK(int(kv.key) > last);
+			last = kv.key;
+			map[int(kv.key) + 100000] = 0;
+			map.erase(int(kv.key) + 100000);
+		}
+		visited++;
+	}
+	CHECK_EQ(visited, 16);
+	CHECK_EQ(last, 19999);
+}
+
+TEST_CASE("[Dictionary] next()") {
+	Dictionary map;
+	for (int i = 0; i < 20; i++) {
+		map[i] = i;
+	}
+	map.erase(5);
+	map.erase(19);
+
+	int count = 0;
+	int last = -1;
+	for (const Variant *key = map.next(); key; key = map.next(key)) {
+		CHECK(int(*key) > last);
+		CHECK(int(*key) != 5);
+		last = *key;
+		count++;
+	}
+	CHECK_EQ(count, 18);
+	CHECK_EQ(last, 18);
+}
+
+// A save state like structure with `p_entity_count` entities, each holding a few nested containers.
+static Dictionary make_save_state(int p_entity_count) {
+	Array entities;
+	for (int i = 0; i < p_entity_count; i++) {
+		Dictionary stats = { { "health", 100 - i % 100 }, { "speed", 1.5 + i }, { "alive", i % 3 != 0 } };
+		Array inventory;
+		for (int j = 0; j < i % 5; j++) {
+			inventory.push_back(Dictionary({ { "item", vformat("item_%d", j) }, { "count", j + 1 } }));
+		}
+		TypedArray<int> path = { i, i + 1, i + 2 };
+		entities.push_back(Dictionary({
+				{ "name", vformat("entity_%d", i) },
+				{ "position", Vector3(i, -i, 0.5) },
+				{ "tags", PackedStringArray({ "a", "b" }) },
+				{ "stats", stats },
+				{ "inventory", inventory },
+				{ "path", path },
+		}));
+	}
+	return Dictionary({ { "version", 3 }, { "entities", entities }, { Array({ "composite", 1 }), "key" } });
+}
+
+// The former recursive implementations, which the walker must agree with.
+static Variant recursive_duplicate_reference(const Variant &p_variant) {
+	switch (p_variant.get_type()) {
+		case Variant::ARRAY: {
+			const Array source = p_variant;
+			Array copy;
+			if (source.is_typed()) {
+				copy.set_typed(source.get_typed_builtin(), source.get_typed_class_name(), source.get_typed_script());
+			}
+			copy.resize(source.size());
+			for (int i = 0; i < source.size(); i++) {
+				copy[i] = recursive_duplicate_reference(source[i]);
+			}
+			return copy;
+		}
+		case Variant::DICTIONARY: {
+			const Dictionary source = p_variant;
+			Dictionary copy;
+			copy.reserve(source.size());
+			for (const KeyValue<Variant, Variant> &kv : source) {
+				copy[recursive_duplicate_reference(kv.key)] = recursive_duplicate_reference(kv.value);
+			}
+			return copy;
+		}
+		default:
+			return p_variant.duplicate();
+	}
+}
+
+static uint32_t recursive_hash_reference(const Variant &p_variant) {
+	switch (p_variant.get_type()) {
+		case Variant::ARRAY: {
+			uint32_t h = hash_murmur3_one_32(Variant::ARRAY);
+			for (const Variant &element : Array(p_variant)) {
+				h = hash_murmur3_one_32(recursive_hash_reference(element), h);
+			}
+			return hash_fmix32(h);
+		}
+		case Variant::DICTIONARY: {
+			uint32_t h = hash_murmur3_one_32(Variant::DICTIONARY);
+			for (const KeyValue<Variant, Variant> &kv : Dictionary(p_variant)) {
+				h = hash_murmur3_one_32(recursive_hash_reference(kv.key), h);
+				h = hash_murmur3_one_32(recursive_hash_reference(kv.value), h);
+			}
+			return hash_fmix32(h);
+		}
+		default:
+			return p_variant.hash();
+	}
+}
+
+// Checks that no container of `p_copy` is shared with `p_source`.
+static bool shares_containers(const Variant &p_source, const Variant &p_copy) {
+	if (p_source.get_type() == Variant::ARRAY) {
+		const Array source = p_source;
+		const Array copy = p_copy;
+		if (source.is_same_instance(copy)) {
+			return true;
+		}
+		for (int i = 0; i < source.size(); i++) {
+			if (shares_containers(source[i], copy[i])) {
+				return true;
+			}
+		}
+	} else if (p_source.get_type() == Variant::DICTIONARY) {
+		const Dictionary source = p_source;
+		const Dictionary copy = p_copy;
+		if (source.is_same_instance(copy)) {
+			return true;
+		}
+		for (int i = 0; i < source.size(); i++) {
+			if (shares_containers(source.get_key_at_index(i), copy.get_key_at_index(i)) || shares_containers(source.get_value_at_index(i), copy.get_value_at_index(i))) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+TEST_CASE("[Dictionary] Deep duplicate, hash and comparison of nested containers") {
+	const Dictionary state = make_save_state(20);
+
+	const Dictionary copy = state.duplicate(true);
+	CHECK_EQ(copy, state);
+	CHECK_EQ(copy, Dictionary(recursive_duplicate_reference(state)));
+	CHECK_FALSE(shares_containers(state, copy));
+	CHECK_EQ(copy.keys(), state.keys());
+
+	const Dictionary entity = Array(copy["entities"])[7];
+	CHECK(Array(entity["path"]).is_typed());
+	CHECK_EQ(Array(entity["path"]).get_typed_builtin(), Variant::INT);
+	Dictionary stats = entity["stats"];
+	Array path = entity["path"];
+	CHECK_EQ(PackedStringArray(entity["tags"]), PackedStringArray({ "a", "b" }));
+
+	CHECK_EQ(state.hash(), recursive_hash_reference(state));
+	CHECK_EQ(copy.hash(), state.hash());
+	CHECK_EQ(Variant(state).hash(), state.hash());
+
+	// Changes deep down are seen by both the hash and the comparison.
+	stats["health"] = -1;
+	CHECK_NE(copy, state);
+	CHECK_NE(copy.hash(), state.hash());
+	CHECK_EQ(copy.hash(), recursive_hash_reference(copy));
+	stats["health"] = 100 - 7;
+	CHECK_EQ(copy, state);
+
+	path.push_back(0);
+	CHECK_NE(copy, state);
+	path.pop_back();
+	CHECK_EQ(copy, state);
+
+	// A value of another type in a nested container.
+	stats["alive"] = 1;
+	CHECK_NE(copy, state);
+	CHECK_NE(state, copy);
+}
+
+TEST_CASE("[Dictionary] Deep duplicate keeps container types") {
+	TypedDictionary<String, Array> typed;
+	typed["a"] = Array({ 1, Dictionary({ { "b", TypedArray<String>({ "c" }) } }) });
+
+	const Dictionary copy = typed.duplicate(true);
+	CHECK_EQ(copy, typed);
+	CHECK(copy.is_same_typed(typed));
+	CHECK_FALSE(shares_containers(typed, copy));
+
+	const Array nested = Dictionary(Array(copy["a"])[1])["b"];
+	CHECK(nested.is_typed());
+	CHECK_EQ(nested.get_typed_builtin(), Variant::STRING);
+}
+
+TEST_CASE_BENCHMARK("[Dictionary][Benchmark] Deep duplicate, hash and comparison of nested containers") {
+	const Dictionary state = make_save_state(50000);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	const Dictionary reference_copy = recursive_duplicate_reference(state);
+	const uint64_t reference_duplicate = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	const Dictionary copy = state.duplicate(true);
+	const uint64_t duplicate = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	const uint32_t reference_hash = recursive_hash_reference(state);
+	const uint64_t reference_hashing = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	const uint32_t hash = state.hash();
+	const uint64_t hashing = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	const bool equal = copy == state;
+	const uint64_t compare = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(equal);
+	CHECK_EQ(hash, reference_hash);
+	CHECK_EQ(reference_copy, copy);
+	print_line(vformat("Duplicate: recursive %d usec, walker %d usec. Hash: recursive %d usec, walker %d usec. Compare: %d usec.",
+			reference_duplicate, duplicate, reference_hashing, hashing, compare));
+}
+
+TEST_CASE_BENCHMARK("[Dictionary][Benchmark] Construct, lookup and iterate") {
+	const int total_keys = 1000000;
+	for (int key_count : { 1, 10, 100, 1000, 10000 }) {
+		const int rounds = total_keys / key_count;
+		const int64_t memory = Memory::get_mem_usage();
+		LocalVector<Dictionary> dictionaries;
+		dictionaries.resize(rounds);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (Dictionary &map : dictionaries) {
+			for (int i = 0; i < key_count; i++) {
+				map[i] = i;
+			}
+		}
+		const uint64_t construct = OS::get_singleton()->get_ticks_usec() - begin;
+		const int64_t bytes = Memory::get_mem_usage() - memory;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		int64_t sum = 0;
+		for (const Dictionary &map : dictionaries) {
+			for (int i = 0; i < key_count; i++) {
+				sum += (int64_t)map[i];
+			}
+		}
+		const uint64_t lookup = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (const Dictionary &map : dictionaries) {
+			for (const KeyValue<Variant, Variant> &kv : map) {
+				sum += (int64_t)kv.value;
+			}
+		}
+		const uint64_t iterate = OS::get_singleton()->get_ticks_usec() - begin;
+
+		CHECK_EQ(sum, (int64_t)key_count * (key_count - 1) * rounds);
+		print_line(vformat("%d keys: %.1f bytes/key, construct %.1f ns/key, lookup %.1f ns/key, iterate %.1f ns/key",
+				key_count, (double)bytes / total_keys, construct * 1000.0 / total_keys, lookup * 1000.0 / total_keys, iterate * 1000.0 / total_keys));
+	}
+}
+
 } // namespace TestDictionary
@@ -0,0 +1,100 @@
+/**************************************************************************/
+/*  test_persistent_vector.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#pragma once
+
+#include "core/variant/persistent_array.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPersistentArray {
+
+TEST_CASE("[PersistentArray] From array and to array") {
+	Array array = { 1, "two", Vector2(3, 4) };
+	Ref<PersistentArray> persistent = PersistentArray::from_array(array);
+	REQUIRE(persistent.is_valid());
+	CHECK_EQ(persistent->size(), 3);
+	CHECK_FALSE(persistent->is_empty());
+	CHECK_EQ(persistent->get_element(0), Variant(1));
+	CHECK_EQ(persistent->get_element(1), Variant("two"));
+	CHECK_EQ(persistent->back(), Variant(Vector2(3, 4)));
+	CHECK_EQ(persistent->to_array(), array);
+
+	// Changing the source array doesn't affect the persistent copy.
+	array[0] = 10;
+	CHECK_EQ(persistent->get_element(0), Variant(1));
+
+	Ref<PersistentArray> empty = PersistentArray::from_array(Array());
+	REQUIRE(empty.is_valid());
+	CHECK(empty->is_empty());
+	CHECK(empty->to_array().is_empty());
+}
+
+TEST_CASE("[PersistentArray] With element") {
+	Ref<PersistentArray> persistent = PersistentArray::from_array({ 1, 2, 3 });
+	Ref<PersistentArray> changed = persistent->with_element(1, 20);
+	REQUIRE(changed.is_valid());
+	CHECK_EQ(changed->to_array(), Array({ 1, 20, 3 }));
+	CHECK_EQ(persistent->to_array(), Array({ 1, 2, 3 }));
+
+	ERR_PRINT_OFF;
+	CHECK(persistent->with_element(-1, 0).is_null());
+	CHECK(persistent->with_element(3, 0).is_null());
+	CHECK_EQ(persistent->get_element(3), Variant());
+	ERR_PRINT_ON;
+	CHECK_EQ(persistent->to_array(), Array({ 1, 2, 3 }));
+}
+
+TEST_CASE("[PersistentArray] Appended and without last") {
+	Ref<PersistentArray> empty = PersistentArray::from_array(Array());
+	Ref<PersistentArray> one = empty->appended("a");
+	Ref<PersistentArray> two = one->appended("b");
+	REQUIRE(two.is_valid());
+	CHECK(empty->is_empty());
+	CHECK_EQ(one->to_array(), Array({ "a" }));
+	CHECK_EQ(two->to_array(), Array({ "a", "b" }));
+
+	Ref<PersistentArray> shortened = two->without_last();
+	REQUIRE(shortened.is_valid());
+	CHECK_EQ(shortened->to_array(), Array({ "a" }));
+	CHECK_EQ(two->size(), 2);
+
+	Ref<PersistentArray> emptied = shortened->without_last();
+	REQUIRE(emptied.is_valid());
+	CHECK(emptied->is_empty());
+
+	ERR_PRINT_OFF;
+	CHECK(emptied->without_last().is_null());
+	CHECK_EQ(emptied->back(), Variant());
+	ERR_PRINT_ON;
+}
+
+} // namespace TestPersistentArray
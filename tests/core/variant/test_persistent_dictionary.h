@@ -0,0 +1,108 @@
+/**************************************************************************/
+/*  test_persistent_vector.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#pragma once
+
+#include "core/variant/persistent_dictionary.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPersistentDictionary {
+
+TEST_CASE("[PersistentDictionary] From dictionary and to dictionary") {
+	Dictionary dictionary;
+	dictionary[1] = "one";
+	dictionary["two"] = 2;
+	dictionary[Vector2(3, 4)] = Array({ 3, 4 });
+
+	Ref<PersistentDictionary> persistent = PersistentDictionary::from_dictionary(dictionary);
+	REQUIRE(persistent.is_valid());
+	CHECK_EQ(persistent->size(), 3);
+	CHECK_FALSE(persistent->is_empty());
+	CHECK(persistent->has(1));
+	CHECK_EQ(persistent->get_value("two"), Variant(2));
+	CHECK_EQ(persistent->get_value("missing", 5), Variant(5));
+
+	Dictionary result = persistent->to_dictionary();
+	CHECK_EQ(result.size(), 3);
+	CHECK_EQ(result[1], Variant("one"));
+	CHECK_EQ(result["two"], Variant(2));
+	CHECK_EQ(result[Vector2(3, 4)], Variant(Array({ 3, 4 })));
+
+	// Changing the source dictionary doesn't affect the persistent copy.
+	dictionary["two"] = 20;
+	CHECK_EQ(persistent->get_value("two"), Variant(2));
+
+	Ref<PersistentDictionary> empty = PersistentDictionary::from_dictionary(Dictionary());
+	REQUIRE(empty.is_valid());
+	CHECK(empty->is_empty());
+	CHECK(empty->to_dictionary().is_empty());
+}
+
+TEST_CASE("[PersistentDictionary] With value and without") {
+	Ref<PersistentDictionary> empty = PersistentDictionary::from_dictionary(Dictionary());
+	Ref<PersistentDictionary> one = empty->with_value("a", 1);
+	Ref<PersistentDictionary> two = one->with_value("b", 2);
+	REQUIRE(two.is_valid());
+	CHECK(empty->is_empty());
+	CHECK_EQ(one->size(), 1);
+	CHECK_EQ(two->size(), 2);
+
+	Ref<PersistentDictionary> replaced = two->with_value("a", 10);
+	CHECK_EQ(replaced->size(), 2);
+	CHECK_EQ(replaced->get_value("a"), Variant(10));
+	CHECK_EQ(two->get_value("a"), Variant(1));
+
+	Ref<PersistentDictionary> removed = two->without("a");
+	REQUIRE(removed.is_valid());
+	CHECK_EQ(removed->size(), 1);
+	CHECK_FALSE(removed->has("a"));
+	CHECK(two->has("a"));
+
+	// Removing a key that isn't there returns the same dictionary.
+	CHECK_EQ(two->without("missing"), two);
+	CHECK_EQ(empty->without("a"), empty);
+}
+
+TEST_CASE("[PersistentDictionary] String and StringName keys are equal") {
+	Ref<PersistentDictionary> persistent = PersistentDictionary::from_dictionary(Dictionary())->with_value("a", 1);
+	CHECK(persistent->has(StringName("a")));
+	CHECK_EQ(persistent->get_value(StringName("a")), Variant(1));
+
+	Ref<PersistentDictionary> replaced = persistent->with_value(StringName("a"), 2);
+	CHECK_EQ(replaced->size(), 1);
+	CHECK_EQ(replaced->get_value("a"), Variant(2));
+
+	Ref<PersistentDictionary> removed = replaced->without(StringName("a"));
+	CHECK(removed->is_empty());
+}
+
+} // namespace TestPersistentDictionary
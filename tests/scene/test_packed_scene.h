@@ -236,6 +236,41 @@ TEST_CASE("[PackedScene] Set Path") {
 	memdelete(scene);
 }
 
+TEST_CASE("[PackedScene] Groups Preserved when Bundling Scene") {
+	Node *scene = memnew(Node);
+	scene->set_name("TestScene");
+	scene->add_to_group("single", true);
+	Node *child = memnew(Node);
+	child->set_name("Child");
+	scene->add_child(child);
+	child->set_owner(scene);
+	// More groups than are stored in place.
+	child->add_to_group("first", true);
+	child->add_to_group("second", true);
+	child->add_to_group("third", true);
+
+	PackedScene packed_scene;
+	packed_scene.pack(scene);
+
+	Ref<SceneState> state = memnew(SceneState);
+	state->set_bundled_scene(packed_scene.get_state()->get_bundled_scene());
+	REQUIRE(state->get_node_count() == 2);
+	CHECK(state->get_node_groups(0) == Vector<StringName>{ "single" });
+	CHECK(state->get_node_groups(1).size() == 3);
+
+	packed_scene.replace_state(state);
+	Node *instance = packed_scene.instantiate();
+	REQUIRE(instance != nullptr);
+	CHECK(instance->is_in_group("single"));
+	Node *instance_child = instance->get_node(NodePath("Child"));
+	CHECK(instance_child->is_in_group("first"));
+	CHECK(instance_child->is_in_group("second"));
+	CHECK(instance_child->is_in_group("third"));
+
+	memdelete(instance);
+	memdelete(scene);
+}
+
 TEST_CASE("[PackedScene] Replace State") {
 	// Create a scene to pack.
 	Node *scene = memnew(Node);
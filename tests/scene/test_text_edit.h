@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/os/os.h"
 #include "scene/gui/text_edit.h"
 
 #include "tests/test_macros.h"
@@ -8361,4 +8362,115 @@ TEST_CASE("[SceneTree][TextEdit] gutters") {
 	memdelete(text_edit);
 }
 
+TEST_CASE("[SceneTree][TextEdit] insert and remove lines in the middle") {
+	TextEdit *text_edit = memnew(TextEdit);
+	SceneTree::get_singleton()->get_root()->add_child(text_edit);
+
+	text_edit->set_text("a\nb\nc\nd");
+	text_edit->set_line_background_color(3, Color(1, 0, 0));
+
+	text_edit->insert_text("x\ny\nz", 1, 1);
+	CHECK(text_edit->get_text() == "a\nbx\ny\nz\nc\nd");
+	CHECK(text_edit->get_line_count() == 6);
+	CHECK(text_edit->get_line(5) == "d");
+	CHECK(text_edit->get_line_background_color(5) == Color(1, 0, 0));
+
+	text_edit->remove_text(1, 1, 3, 1);
+	CHECK(text_edit->get_text() == "a\nb\nc\nd");
+	CHECK(text_edit->get_line_background_color(3) == Color(1, 0, 0));
+
+	text_edit->undo();
+	CHECK(text_edit->get_line_count() == 6);
+	text_edit->undo();
+	CHECK(text_edit->get_text() == "a\nb\nc\nd");
+
+	memdelete(text_edit);
+}
+
+TEST_CASE("[SceneTree][TextEdit] large documents") {
+	TextEdit *text_edit = memnew(TextEdit);
+	SceneTree::get_singleton()->get_root()->add_child(text_edit);
+
+	// Enough lines to span several line chunks and to defer shaping.
+	const int line_count = 5000;
+	String document;
+	for (int i = 0; i < line_count; i++) {
+		if (i > 0) {
+			document += "\n";
+		}
+		document += vformat("line %d", i);
+	}
+	text_edit->set_text(document);
+	CHECK(text_edit->get_line_count() == line_count);
+	CHECK(text_edit->get_line(4321) == "line 4321");
+
+	SUBCASE("[TextEdit] edits across line chunks") {
+		text_edit->insert_text("a\nb\n", 1000, 0);
+		CHECK(text_edit->get_line_count() == line_count + 2);
+		CHECK(text_edit->get_line(999) == "line 999");
+		CHECK(text_edit->get_line(1000) == "a");
+		CHECK(text_edit->get_line(1001) == "b");
+		CHECK(text_edit->get_line(1002) == "line 1000");
+		CHECK(text_edit->get_line(line_count + 1) == vformat("line %d", line_count - 1));
+
+		text_edit->remove_text(10, 0, 3000, 0);
+		CHECK(text_edit->get_line_count() == line_count + 2 - 2990);
+		CHECK(text_edit->get_line(9) == "line 9");
+		CHECK(text_edit->get_line(10) == "line 2998");
+		CHECK(text_edit->get_line(text_edit->get_line_count() - 1) == vformat("line %d", line_count - 1));
+
+		text_edit->undo();
+		text_edit->undo();
+		CHECK(text_edit->get_text() == document);
+	}
+
+	SUBCASE("[TextEdit] lines are shaped on access") {
+		text_edit->set_line(4000, "a much longer line than the ones around it");
+		CHECK(text_edit->get_line_width(4000) > text_edit->get_line_width(3999));
+		CHECK(text_edit->get_line_wrap_count(4000) == 0);
+
+		// Wrapping needs every line shaped.
+		text_edit->set_line_wrapping_mode(TextEdit::LineWrappingMode::LINE_WRAPPING_BOUNDARY);
+		text_edit->set_size(Size2(110, 100));
+		MessageQueue::get_singleton()->flush();
+		CHECK(text_edit->is_line_wrapped(4000));
+	}
+
+	memdelete(text_edit);
+}
+
+TEST_CASE_BENCHMARK("[SceneTree][TextEdit][Benchmark] Large document editing") {
+	TextEdit *text_edit = memnew(TextEdit);
+	SceneTree::get_singleton()->get_root()->add_child(text_edit);
+
+	const int line_count = 200000;
+	String document;
+	for (int i = 0; i < line_count; i++) {
+		document += vformat("%d: The quick brown fox jumps over the lazy dog.\n", i);
+	}
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	text_edit->set_text(document);
+	print_line(vformat("Open %d lines: %d usec.", line_count, OS::get_singleton()->get_ticks_usec() - begin));
+
+	const int edits = 1000;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < edits; i++) {
+		text_edit->insert_text("inserted\nline\n", line_count / 2, 0);
+	}
+	print_line(vformat("Insert %d multi-line edits mid-document: %d usec.", edits, OS::get_singleton()->get_ticks_usec() - begin));
+	CHECK(text_edit->get_line_count() == line_count + 1 + edits * 2);
+
+	// The undo stack keeps the last 50 operations by default.
+	const int undos = 50;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < undos; i++) {
+		text_edit->undo();
+	}
+	print_line(vformat("Undo %d edits: %d usec.", undos, OS::get_singleton()->get_ticks_usec() - begin));
+	CHECK(text_edit->get_line_count() == line_count + 1 + (edits - undos) * 2);
+
+	memdelete(text_edit);
+}
+
 } // namespace TestTextEdit
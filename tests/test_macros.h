@@ -44,6 +44,9 @@
 // The test is skipped with this, run pending tests with `--test --no-skip`.
 #define TEST_CASE_PENDING(name) TEST_CASE(name *doctest::skip())
 
+// Benchmarks are skipped by default, run them with `--test --no-skip --test-case="*[Benchmark]*"`.
+#define TEST_CASE_BENCHMARK(name) TEST_CASE(name *doctest::skip())
+
 // The test case is marked as failed, but does not fail the entire test run.
 #define TEST_CASE_MAY_FAIL(name) TEST_CASE(name *doctest::may_fail())
 
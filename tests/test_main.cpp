@@ -69,6 +69,7 @@
 #include "tests/core/math/test_aabb.h"
 #include "tests/core/math/test_astar.h"
 #include "tests/core/math/test_basis.h"
+#include "tests/core/math/test_bulk_math.h"
 #include "tests/core/math/test_color.h"
 #include "tests/core/math/test_expression.h"
 #include "tests/core/math/test_geometry_2d.h"
@@ -92,10 +93,14 @@
 #include "tests/core/object/test_method_bind.h"
 #include "tests/core/object/test_object.h"
 #include "tests/core/object/test_undo_redo.h"
+#include "tests/core/os/test_frame_arena.h"
+#include "tests/core/os/test_memory.h"
 #include "tests/core/os/test_os.h"
 #include "tests/core/string/test_fuzzy_search.h"
 #include "tests/core/string/test_node_path.h"
 #include "tests/core/string/test_string.h"
+#include "tests/core/string/test_string_name.h"
+#include "tests/core/string/test_string_simd.h"
 #include "tests/core/string/test_translation.h"
 #include "tests/core/string/test_translation_server.h"
 #include "tests/core/templates/test_a_hash_map.h"
@@ -107,11 +112,16 @@
 #include "tests/core/templates/test_local_vector.h"
 #include "tests/core/templates/test_lru.h"
 #include "tests/core/templates/test_paged_array.h"
+#include "tests/core/templates/test_persistent_hash_map.h"
+#include "tests/core/templates/test_persistent_vector.h"
 #include "tests/core/templates/test_rid.h"
 #include "tests/core/templates/test_self_list.h"
+#include "tests/core/templates/test_small_vector.h"
 #include "tests/core/templates/test_span.h"
+#include "tests/core/templates/test_swiss_hash_map.h"
 #include "tests/core/templates/test_vector.h"
 #include "tests/core/templates/test_vset.h"
+#include "tests/core/templates/test_work_stealing_deque.h"
 #include "tests/core/test_crypto.h"
 #include "tests/core/test_hashing_context.h"
 #include "tests/core/test_time.h"
@@ -119,6 +129,8 @@
 #include "tests/core/variant/test_array.h"
 #include "tests/core/variant/test_callable.h"
 #include "tests/core/variant/test_dictionary.h"
+#include "tests/core/variant/test_persistent_array.h"
+#include "tests/core/variant/test_persistent_dictionary.h"
 #include "tests/core/variant/test_variant.h"
 #include "tests/core/variant/test_variant_utility.h"
 #include "tests/scene/test_animation.h"